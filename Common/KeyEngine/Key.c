@@ -0,0 +1,49 @@
+/* Common/KeyEngine/Key.c */
+#include "Key.h"
+
+void Key_Init(Key_t *key, uint8_t id, void *port, uint32_t pin, uint8_t active_level)
+{
+    // 1. 保存参数
+    key->Port = port;
+    key->Pin = pin;
+    key->ActiveLevel = active_level;
+    key->ID = id;
+
+    // 2. 初始化状态
+    key->DebounceState = 0;
+    key->DebounceTick = 0;
+    key->IsPressed = 0;
+
+    // 3. 硬件初始化 (时钟等平台细节由移植层负责)
+    Key_HAL_Init_Pin(port, pin, active_level);
+}
+
+void Key_Update(Key_t *key)
+{
+    // 读取物理电平
+    uint8_t raw_level = Key_HAL_Read_Pin(key->Port, key->Pin);
+    uint8_t is_active = (raw_level == key->ActiveLevel);
+    uint32_t now = Key_HAL_GetTick();
+
+    // 简单的去抖状态机
+    if (is_active != key->DebounceState) {
+        // 状态发生变化，重置计时器
+        key->DebounceState = is_active;
+        key->DebounceTick = now;
+    } else {
+        // 状态稳定
+        if ((now - key->DebounceTick) >= KEY_DEBOUNCE_TIME_MS) {
+            key->IsPressed = is_active;
+        }
+    }
+}
+
+uint8_t Key_GetState(Key_t *key)
+{
+    return key->IsPressed;
+}
+
+uint8_t Key_IsSettled(Key_t *key)
+{
+    return (key->DebounceState == key->IsPressed);
+}
@@ -0,0 +1,87 @@
+/* Common/KeyEngine/Key.h */
+#ifndef __KEY_H
+#define __KEY_H
+
+#include <stdint.h>
+#include "KeyConfig.h"
+
+/**
+  ******************************************************************************
+  * @file    Key.h
+  * @brief   单键对象与移植层接口 (STM32 / ESP32 共用)
+  * @note    V2.0: 去除对具体芯片头文件的依赖，硬件访问全部经由 Key_HAL_* 完成，
+  *                由各平台的 key_port_xxx.c 实现。
+  *                Port 为平台相关的端口句柄 (STM32 为 GPIO_TypeDef*，ESP32 不使用，传 NULL)
+  *          V2.1: 去抖时间改用 KeyConfig.h 的 KEY_DEBOUNCE_TIME_MS (原为写死的 15ms)
+  ******************************************************************************
+  */
+
+// GCC (ESP-IDF / 主机) 没有 __weak 关键字，这里统一映射到 weak 属性
+#if !defined(__CC_ARM) && !defined(__weak)
+#define __weak __attribute__((weak))
+#endif
+
+// --- 1. 核心定义 ---
+
+#define KEY_MAX_COUNT           32
+typedef uint32_t KeyMask_t;
+
+typedef enum {
+    KEY_EVT_NONE = 0,
+
+    KEY_EVT_DOWN,           // 按下 (组合确认后)
+    KEY_EVT_UP,             // 松开
+
+    KEY_EVT_CLICK,          // 单击
+    KEY_EVT_DOUBLE_CLICK,   // 双击
+    KEY_EVT_TRIPLE_CLICK,   // 三连击
+    KEY_EVT_QUAD_CLICK,     // 四连击 (及以上)
+
+    KEY_EVT_HOLD_START,     // 长按开始
+    KEY_EVT_HOLDING,        // 长按保持
+    KEY_EVT_HOLD_END,       // 长按结束
+
+    KEY_EVT_MODIFIER_CLICK  // 修饰键点击
+} KeyEventType_t;
+
+typedef struct {
+    KeyMask_t       Mask;       // 按键掩码
+    KeyEventType_t  Type;       // 事件类型
+    uint32_t        Timestamp;  // 事件发生时间
+    uint32_t        Param;      // [新增] 附带参数 (如长按持续时间ms)
+} KeyEvent_t;
+
+// --- 2. 单键对象 ---
+
+typedef struct {
+    void*           Port;       // 平台端口句柄 (可为 NULL)
+    uint32_t        Pin;        // 引脚 (STM32 为 GPIO_Pin_x，ESP32 为 GPIO 编号)
+    uint8_t         ActiveLevel;
+    uint8_t         ID;
+
+    uint8_t         DebounceState;
+    uint32_t        DebounceTick;
+    uint8_t         IsPressed;
+} Key_t;
+
+// --- 3. 接口 ---
+
+void Key_Init(Key_t *key, uint8_t id, void *port, uint32_t pin, uint8_t active_level);
+void Key_Update(Key_t *key);
+uint8_t Key_GetState(Key_t *key);
+
+/**
+ * @brief  按键是否处于稳定状态 (去抖计时未在进行中)
+ * @retval 1: 稳定, 0: 电平刚变化，仍在去抖
+ */
+uint8_t Key_IsSettled(Key_t *key);
+
+#define KEY_MASK(id)    ((uint32_t)1 << (id))
+
+// --- 4. 移植层接口 (由 key_port_xxx.c 实现) ---
+
+void Key_HAL_Init_Pin(void *port, uint32_t pin, uint8_t active_level);
+uint8_t Key_HAL_Read_Pin(void *port, uint32_t pin);
+uint32_t Key_HAL_GetTick(void);
+
+#endif
@@ -0,0 +1,37 @@
+/* Common/KeyEngine/KeyConfig.h */
+#ifndef __KEY_CONFIG_H
+#define __KEY_CONFIG_H
+
+/**
+  ******************************************************************************
+  * @file    KeyConfig.h
+  * @brief   按键引擎时序参数 (STM32 / ESP32 共用)
+  * @note    V1.0: 由 Key.c 与 KeyManager.c 直接包含，不再依赖各工程的 Config.h
+  *                (两端同名的 Config.h 曾导致参数不一致)。
+  *                需要修改时在编译选项中预定义同名宏即可
+  ******************************************************************************
+  */
+
+#ifndef KEY_DEBOUNCE_TIME_MS
+#define KEY_DEBOUNCE_TIME_MS        20      // 消抖时间 (电平稳定持续该时间才确认)
+#endif
+
+#ifndef KEY_COMBO_WINDOW_MS
+#define KEY_COMBO_WINDOW_MS         50      // 组合键判定窗口
+#endif
+
+#ifndef KEY_HOLD_TIME_MS
+#define KEY_HOLD_TIME_MS            800     // 长按触发阈值
+#endif
+
+#ifndef KEY_REPEAT_RATE_MS
+#define KEY_REPEAT_RATE_MS          0       // 长按连发间隔 (0=关闭)
+#endif
+
+// 连击判定窗口
+// 松手后，如果在此时间内再次按下，则判定为连击；否则结算为单击
+#ifndef KEY_MULTI_CLICK_GAP_MS
+#define KEY_MULTI_CLICK_GAP_MS      250
+#endif
+
+#endif
@@ -0,0 +1,387 @@
+/* Common/KeyEngine/KeyManager.c */
+#include "KeyManager.h"
+#include <string.h>
+
+// --- 跟踪器状态 ---
+typedef enum {
+    KM_STATE_FREE = 0,      // 未使用
+    KM_STATE_COMBO_WAIT,    // 组合窗口 (等待多键按下)
+    KM_STATE_PRESSING,      // 按下确认 (等待松开或长按)
+    KM_STATE_MULTI_WAIT,    // 连击等待 (松开后等待再次按下)
+    KM_STATE_REPRESS,       // 连击中再次按下，组合窗口内确认是否同一组合
+    KM_STATE_HOLDING        // 长按中
+} KM_State_t;
+
+#define KM_NO_COMBO     0xFF
+
+/**
+  * @brief 编译后的组合描述符 (每个掩码一份)
+  */
+typedef struct {
+    KeyMask_t       Mask;
+    uint8_t         MaxClicks;                  // 声明的最大连击数 (0: 无连击模式)
+    uint8_t         HasModifier;
+    uint16_t        HoldMs;                     // 0: 无长按模式
+    uint16_t        RepeatMs;
+    KeyEventType_t  ClickEvt[KM_MAX_CLICKS + 1]; // 下标为连击次数
+} KM_Combo_t;
+
+/**
+  * @brief 组合跟踪器 (每个进行中的手势一份，计时相互独立)
+  */
+typedef struct {
+    uint8_t    State;       // KM_State_t
+    uint8_t    Combo;       // 匹配到的组合描述符下标
+    uint8_t    Clicks;
+    KeyMask_t  Mask;        // 手势主体按键
+    KeyMask_t  Pending;     // REPRESS 阶段累积的按键
+    KeyMask_t  ModMask;     // 长按期间按下的修饰键
+    uint32_t   StateTick;   // 当前阶段开始时刻
+    uint32_t   PressTick;   // 本次按下时刻 (用于长按判定与时长)
+    uint32_t   RepeatTick;  // 上一次连发时刻
+} KM_Tracker_t;
+
+// --- 内部变量 ---
+static Key_t*       s_RegisteredKeys[KM_MAX_KEYS];
+static uint8_t      s_KeyCount = 0;
+static KeyMask_t    s_PrevMask = 0;
+
+static KM_Combo_t   s_Combos[KM_MAX_COMBOS];
+static uint8_t      s_ComboCount = 0;
+static KM_Tracker_t s_Trackers[KM_MAX_TRACKERS];
+
+// 默认模式表：与 V2.0 手写状态机的行为一致
+static const KeyPattern_t s_DefaultPatterns[] = {
+    KM_CLICK(KM_ANY_KEY, 1, KEY_EVT_CLICK),
+    KM_CLICK(KM_ANY_KEY, 2, KEY_EVT_DOUBLE_CLICK),
+    KM_CLICK(KM_ANY_KEY, 3, KEY_EVT_TRIPLE_CLICK),
+    KM_CLICK(KM_ANY_KEY, 4, KEY_EVT_QUAD_CLICK),
+    KM_HOLD (KM_ANY_KEY, KEY_HOLD_TIME_MS, KEY_REPEAT_RATE_MS),
+    KM_MODIFIER(KM_ANY_KEY),
+};
+
+/* ============================================================
+ *                 内部函数
+ * ============================================================ */
+
+// 事件钩子 (默认空实现，应用层重写后把事件投递到自己的队列)
+__weak void KeyManager_Hook_OnEvent(const KeyEvent_t *evt) { (void)evt; }
+
+// 事件立即交给钩子，同一 Tick 内产生的多个事件不会互相覆盖
+static void _PushEvent(KeyMask_t mask, KeyEventType_t type, uint32_t param) {
+    KeyEvent_t evt;
+    evt.Mask = mask;
+    evt.Type = type;
+    evt.Timestamp = Key_HAL_GetTick();
+    evt.Param = param;
+    KeyManager_Hook_OnEvent(&evt);
+}
+
+static KeyMask_t _ScanCurrentMask(void) {
+    KeyMask_t mask = 0;
+    for (int i = 0; i < s_KeyCount; i++) {
+        Key_Update(s_RegisteredKeys[i]);
+        if (Key_GetState(s_RegisteredKeys[i])) {
+            mask |= KEY_MASK(s_RegisteredKeys[i]->ID);
+        }
+    }
+    return mask;
+}
+
+static uint8_t _FindCombo(KeyMask_t mask) {
+    uint8_t i, any = KM_NO_COMBO;
+    for (i = 0; i < s_ComboCount; i++) {
+        if (s_Combos[i].Mask == mask) return i;
+        if (s_Combos[i].Mask == KM_ANY_KEY) any = i;
+    }
+    return any;
+}
+
+// 结算连击：精确匹配优先，否则取不超过实际次数的最大声明
+static void _EmitClicks(KM_Tracker_t *t) {
+    uint8_t n;
+    if (t->Combo == KM_NO_COMBO || t->Clicks == 0) return;
+
+    n = (t->Clicks > KM_MAX_CLICKS) ? KM_MAX_CLICKS : t->Clicks;
+    while (n > 0 && s_Combos[t->Combo].ClickEvt[n] == KEY_EVT_NONE) n--;
+    if (n > 0) _PushEvent(t->Mask, s_Combos[t->Combo].ClickEvt[n], t->Clicks);
+}
+
+static KM_Tracker_t* _AllocTracker(void) {
+    uint8_t i;
+    for (i = 0; i < KM_MAX_TRACKERS; i++) {
+        if (s_Trackers[i].State == KM_STATE_FREE) return &s_Trackers[i];
+    }
+    return NULL; // 同时进行的手势过多，忽略新按键
+}
+
+// 开始一个新手势
+static void _StartGesture(KM_Tracker_t *t, KeyMask_t mask, uint32_t now) {
+    memset(t, 0, sizeof(*t));
+    t->Mask = mask;
+    t->Combo = KM_NO_COMBO;
+    t->StateTick = now;
+    t->PressTick = now;
+    t->State = KM_STATE_COMBO_WAIT;
+}
+
+// 组合确认后进入按下态
+static void _ConfirmPress(KM_Tracker_t *t, uint32_t now) {
+    t->Combo = _FindCombo(t->Mask);
+    t->StateTick = now;
+    t->State = KM_STATE_PRESSING;
+}
+
+/* ============================================================
+ *                 按键沿处理
+ * ============================================================ */
+
+static void _OnKeyDown(KeyMask_t bit, uint32_t now) {
+    uint8_t i;
+    KM_Tracker_t *t;
+
+    // 1. 加入组合窗口内的手势 / 连击中的再次按下 / 长按中的修饰键
+    for (i = 0; i < KM_MAX_TRACKERS; i++) {
+        t = &s_Trackers[i];
+        switch (t->State) {
+            case KM_STATE_COMBO_WAIT:
+                t->Mask |= bit;
+                return;
+
+            case KM_STATE_REPRESS:
+                t->Pending |= bit;
+                return;
+
+            case KM_STATE_MULTI_WAIT:
+                if (t->Mask & bit) {
+                    t->Pending = bit;
+                    t->StateTick = now;
+                    t->PressTick = now;
+                    t->State = KM_STATE_REPRESS;
+                    return;
+                }
+                break;
+
+            case KM_STATE_HOLDING:
+                if (t->Combo != KM_NO_COMBO && s_Combos[t->Combo].HasModifier) {
+                    t->ModMask |= bit;
+                    _PushEvent(t->Mask | bit, KEY_EVT_MODIFIER_CLICK, 0);
+                    return;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    // 2. 与现有手势无关：开始新的手势
+    t = _AllocTracker();
+    if (t != NULL) _StartGesture(t, bit, now);
+}
+
+static void _OnKeyUp(KeyMask_t bit, uint32_t now) {
+    uint8_t i;
+
+    for (i = 0; i < KM_MAX_TRACKERS; i++) {
+        KM_Tracker_t *t = &s_Trackers[i];
+
+        // 修饰键松开只清除标记
+        if (t->ModMask & bit) {
+            t->ModMask &= ~bit;
+            return;
+        }
+
+        switch (t->State) {
+            case KM_STATE_COMBO_WAIT:
+            case KM_STATE_REPRESS:
+                // 组合窗口内就松开 (快速点击)：先确认组合，再按松开处理
+                if (t->State == KM_STATE_REPRESS) {
+                    if (!(t->Pending & bit)) break;
+                    if (t->Pending != t->Mask) {
+                        // 换了组合：结算旧连击，以新组合重新开始
+                        _EmitClicks(t);
+                        t->Mask = t->Pending;
+                        t->Clicks = 0;
+                    }
+                } else if (!(t->Mask & bit)) {
+                    break;
+                }
+                _ConfirmPress(t, now);
+                /* fall through */
+
+            case KM_STATE_PRESSING:
+                if (!(t->Mask & bit)) break;
+                t->Clicks++;
+                _PushEvent(t->Mask, KEY_EVT_UP, 0);
+
+                // 已达该组合声明的最大连击数：立即结算
+                if (t->Combo != KM_NO_COMBO && t->Clicks >= s_Combos[t->Combo].MaxClicks) {
+                    _EmitClicks(t);
+                    t->State = KM_STATE_FREE;
+                } else {
+                    t->StateTick = now;
+                    t->State = KM_STATE_MULTI_WAIT;
+                }
+                return;
+
+            case KM_STATE_HOLDING:
+                if (!(t->Mask & bit)) break;
+                _PushEvent(t->Mask, KEY_EVT_HOLD_END, now - t->PressTick);
+                _PushEvent(t->Mask, KEY_EVT_UP, 0);
+                t->State = KM_STATE_FREE;
+                return;
+
+            default:
+                break;
+        }
+    }
+}
+
+/* ============================================================
+ *                 超时处理
+ * ============================================================ */
+
+static void _UpdateTracker(KM_Tracker_t *t, uint32_t now) {
+    const KM_Combo_t *c;
+
+    switch (t->State) {
+        case KM_STATE_COMBO_WAIT:
+            if ((now - t->StateTick) > KEY_COMBO_WINDOW_MS) _ConfirmPress(t, now);
+            break;
+
+        case KM_STATE_REPRESS:
+            if ((now - t->StateTick) > KEY_COMBO_WINDOW_MS) {
+                if (t->Pending != t->Mask) {
+                    _EmitClicks(t);
+                    t->Mask = t->Pending;
+                    t->Clicks = 0;
+                }
+                _ConfirmPress(t, now);
+            }
+            break;
+
+        case KM_STATE_PRESSING:
+            if (t->Combo == KM_NO_COMBO) break;
+            c = &s_Combos[t->Combo];
+            if (c->HoldMs > 0 && (now - t->PressTick) >= c->HoldMs) {
+                _PushEvent(t->Mask, KEY_EVT_HOLD_START, now - t->PressTick);
+                t->Clicks = 0; // 长按会打断连击
+                t->RepeatTick = now;
+                t->State = KM_STATE_HOLDING;
+            }
+            break;
+
+        case KM_STATE_MULTI_WAIT:
+            if ((now - t->StateTick) > KEY_MULTI_CLICK_GAP_MS) {
+                _EmitClicks(t);
+                t->State = KM_STATE_FREE;
+            }
+            break;
+
+        case KM_STATE_HOLDING:
+            c = &s_Combos[t->Combo];
+            if (c->RepeatMs > 0 && (now - t->RepeatTick) >= c->RepeatMs) {
+                _PushEvent(t->Mask, KEY_EVT_HOLDING, now - t->PressTick);
+                t->RepeatTick = now;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/* ============================================================
+ *                 接口实现
+ * ============================================================ */
+
+void KeyManager_Init(void) {
+    s_KeyCount = 0;
+    s_PrevMask = 0;
+    memset(s_RegisteredKeys, 0, sizeof(s_RegisteredKeys));
+    KeyManager_SetPatterns(s_DefaultPatterns, sizeof(s_DefaultPatterns) / sizeof(s_DefaultPatterns[0]));
+}
+
+uint8_t KeyManager_Register(Key_t *key) {
+    if (s_KeyCount >= KM_MAX_KEYS) return 1;
+    s_RegisteredKeys[s_KeyCount++] = key;
+    return 0;
+}
+
+uint8_t KeyManager_SetPatterns(const KeyPattern_t *table, uint8_t count) {
+    uint8_t i, j, err = 0;
+
+    memset(s_Combos, 0, sizeof(s_Combos));
+    memset(s_Trackers, 0, sizeof(s_Trackers));
+    s_ComboCount = 0;
+
+    for (i = 0; i < count; i++) {
+        const KeyPattern_t *p = &table[i];
+        KM_Combo_t *c = NULL;
+
+        // 按掩码归组
+        for (j = 0; j < s_ComboCount; j++) {
+            if (s_Combos[j].Mask == p->Mask) { c = &s_Combos[j]; break; }
+        }
+        if (c == NULL) {
+            if (s_ComboCount >= KM_MAX_COMBOS) { err = 1; continue; }
+            c = &s_Combos[s_ComboCount++];
+            c->Mask = p->Mask;
+        }
+
+        switch (p->Kind) {
+            case KM_PAT_CLICK:
+                if (p->Count == 0 || p->Count > KM_MAX_CLICKS) { err = 1; break; }
+                c->ClickEvt[p->Count] = p->Event;
+                if (p->Count > c->MaxClicks) c->MaxClicks = p->Count;
+                break;
+            case KM_PAT_HOLD:
+                c->HoldMs = p->TimeMs;
+                c->RepeatMs = p->RepeatMs;
+                break;
+            case KM_PAT_MODIFIER:
+                c->HasModifier = 1;
+                break;
+            default:
+                err = 1;
+                break;
+        }
+    }
+    return err;
+}
+
+void KeyManager_Tick(void) {
+    uint32_t now = Key_HAL_GetTick();
+    KeyMask_t curr_mask = _ScanCurrentMask();
+    KeyMask_t changed = curr_mask ^ s_PrevMask;
+    uint8_t i;
+
+    // 1. 按键沿 (逐键处理，按下与松开各自计时)
+    for (i = 0; changed != 0 && i < KEY_MAX_COUNT; i++) {
+        KeyMask_t bit = KEY_MASK(i);
+        if (!(changed & bit)) continue;
+        changed &= ~bit;
+        if (curr_mask & bit) _OnKeyDown(bit, now);
+        else                 _OnKeyUp(bit, now);
+    }
+    s_PrevMask = curr_mask;
+
+    // 2. 各跟踪器的超时判定
+    for (i = 0; i < KM_MAX_TRACKERS; i++) {
+        if (s_Trackers[i].State != KM_STATE_FREE) _UpdateTracker(&s_Trackers[i], now);
+    }
+}
+
+uint8_t KeyManager_IsIdle(void) {
+    uint8_t i;
+
+    if (s_PrevMask != 0) return 0;
+    for (i = 0; i < s_KeyCount; i++) {
+        if (!Key_IsSettled(s_RegisteredKeys[i])) return 0;
+    }
+    for (i = 0; i < KM_MAX_TRACKERS; i++) {
+        if (s_Trackers[i].State != KM_STATE_FREE) return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,94 @@
+/* Common/KeyEngine/KeyManager.h */
+#ifndef __KEY_MANAGER_H
+#define __KEY_MANAGER_H
+
+#include "Key.h"
+
+/**
+  ******************************************************************************
+  * @file    KeyManager.h
+  * @brief   按键手势识别器 (V3.0 表驱动)
+  * @note    1. 手势由模式表声明 (连击次数 / 长按阈值 / 连发 / 修饰键)，
+  *             KeyManager_SetPatterns 把模式表编译成按组合分组的描述符
+  *          2. 每个按下的按键组合由独立的跟踪器计时，不同按键可同时处于
+  *             不同阶段 (例如 A 在长按、B 在连击)
+  *          3. 事件产生时立即通过 KeyManager_Hook_OnEvent 输出，不会互相覆盖
+  *          4. V3.1: 与平台无关，STM32 与 ESP32 共用本文件，时间与电平均经由
+  *             Key_HAL_* 获取。KeyManager_IsIdle 供事件驱动的移植层判断何时可以
+  *             停止轮询、改为等待引脚中断唤醒
+  ******************************************************************************
+  */
+
+// --- 配置参数 ---
+#define KM_MAX_KEYS             5       // 系统中注册的最大按键数
+#define KM_MAX_TRACKERS         4       // 同时跟踪的按键组合数
+#define KM_MAX_COMBOS           8       // 模式表中不同组合 (掩码) 的最大数量
+#define KM_MAX_CLICKS           7       // 可识别的最大连击次数
+
+// --- 模式表 ---
+
+typedef enum {
+    KM_PAT_CLICK = 0,       // N 连击
+    KM_PAT_HOLD,            // 长按 (可带连发)
+    KM_PAT_MODIFIER         // 长按期间按下其他键
+} KeyPatternKind_t;
+
+typedef struct {
+    KeyMask_t       Mask;       // 按键组合，KM_ANY_KEY 表示未单独声明的所有组合
+    uint8_t         Kind;       // KeyPatternKind_t
+    uint8_t         Count;      // 连击次数 (CLICK)
+    uint16_t        TimeMs;     // 长按阈值 (HOLD)
+    uint16_t        RepeatMs;   // 连发间隔 (HOLD)，0 表示不连发
+    KeyEventType_t  Event;      // 匹配时输出的事件
+} KeyPattern_t;
+
+#define KM_ANY_KEY                  0
+
+#define KM_CLICK(mask, n, evt)      { (mask), KM_PAT_CLICK, (n), 0, 0, (evt) }
+#define KM_HOLD(mask, ms, repeat)   { (mask), KM_PAT_HOLD, 0, (ms), (repeat), KEY_EVT_HOLD_START }
+#define KM_MODIFIER(mask)           { (mask), KM_PAT_MODIFIER, 0, 0, 0, KEY_EVT_MODIFIER_CLICK }
+
+// --- 接口 ---
+
+/**
+ * @brief  初始化按键管理器 (加载与 V2.0 行为一致的默认模式表)
+ */
+void KeyManager_Init(void);
+
+/**
+ * @brief  注册一个按键对象到管理器
+ * @param  key: 已初始化的 Key_t 对象指针
+ * @retval 0: 成功, 1: 失败(满)
+ */
+uint8_t KeyManager_Register(Key_t *key);
+
+/**
+ * @brief  加载并编译手势模式表
+ * @param  table: 模式表 (需在程序运行期间保持有效，通常为 static const)
+ * @retval 0: 成功, 1: 组合数或连击数超出配置上限
+ * @note   连击次数达到该组合声明的最大值时立即输出，无需等待连击窗口
+ */
+uint8_t KeyManager_SetPatterns(const KeyPattern_t *table, uint8_t count);
+
+/**
+ * @brief  管理器核心任务 (需周期性调用，建议 5ms-10ms)
+ * @note   内部会调用所有注册按键的 Key_Update
+ */
+void KeyManager_Tick(void);
+
+/**
+ * @brief  查询管理器是否空闲
+ * @retval 1: 无按键按下、无去抖进行中、无未结算的手势 (此后只有引脚变化才会产生事件)
+ *         0: 仍需继续周期性调用 KeyManager_Tick
+ */
+uint8_t KeyManager_IsIdle(void);
+
+/**
+ * @brief  事件输出钩子 (弱定义，在 KeyManager_Tick 中同步调用)
+ * @param  evt: 事件内容，仅在回调期间有效。
+ *              连击事件的 Param 为实际连击次数，长按类事件的 Param 为按下时长
+ * @note   替代原来的单槽 KeyManager_GetEvent：应用层在此把事件投递到事件队列
+ */
+void KeyManager_Hook_OnEvent(const KeyEvent_t *evt);
+
+#endif
@@ -0,0 +1,10 @@
+#pragma once
+
+/**
+ * @file    gpio.h
+ * @brief   主机测试用 GPIO 驱动替身：只提供类型，被测组件不访问引脚
+ */
+
+#include <stdint.h>
+
+typedef int gpio_num_t;
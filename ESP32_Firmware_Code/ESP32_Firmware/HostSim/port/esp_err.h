@@ -0,0 +1,22 @@
+#pragma once
+
+/**
+ * @file    esp_err.h
+ * @brief   主机测试用 ESP-IDF 错误码替身
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef int esp_err_t;
+
+#define ESP_OK          0
+#define ESP_FAIL        -1
+#define ESP_ERR_NO_MEM  0x101
+#define ESP_ERR_TIMEOUT 0x107
+
+#define ESP_ERROR_CHECK(x) do { \
+    esp_err_t err_rc_ = (x); \
+    if (err_rc_ != ESP_OK) { fprintf(stderr, "ESP_ERROR_CHECK 失败: %d (%s)\n", err_rc_, #x); abort(); } \
+} while (0)
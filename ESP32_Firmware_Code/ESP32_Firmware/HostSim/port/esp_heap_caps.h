@@ -0,0 +1,17 @@
+#pragma once
+
+/**
+ * @file    esp_heap_caps.h
+ * @brief   主机测试用 heap_caps 替身：各能力的堆统计由测试经 Host_SetHeap 设定
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_SPIRAM       (1 << 10)
+#define MALLOC_CAP_INTERNAL     (1 << 11)
+
+size_t heap_caps_get_total_size(uint32_t caps);
+size_t heap_caps_get_free_size(uint32_t caps);
+size_t heap_caps_get_minimum_free_size(uint32_t caps);
+size_t heap_caps_get_largest_free_block(uint32_t caps);
@@ -0,0 +1,18 @@
+#pragma once
+
+/**
+ * @file    esp_log.h
+ * @brief   主机测试用 ESP-IDF 日志替身：设置环境变量 HOST_LOG=1 时输出到 stderr
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define _HOST_LOG(level, tag, format, ...) do { \
+    if (getenv("HOST_LOG")) fprintf(stderr, level " (%s) " format "\n", tag, ##__VA_ARGS__); \
+} while (0)
+
+#define ESP_LOGE(tag, format, ...) _HOST_LOG("E", tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) _HOST_LOG("W", tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) _HOST_LOG("I", tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) do { (void)(tag); } while (0)
@@ -0,0 +1,11 @@
+#pragma once
+
+/**
+ * @file    esp_timer.h
+ * @brief   主机测试用 esp_timer 替身：时间取 FreeRTOS 替身的虚拟节拍
+ *          (上电以来的微秒数，节拍内不前进)
+ */
+
+#include <stdint.h>
+
+int64_t esp_timer_get_time(void);
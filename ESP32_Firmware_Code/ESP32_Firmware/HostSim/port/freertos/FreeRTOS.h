@@ -0,0 +1,55 @@
+#pragma once
+
+/**
+ * @file    FreeRTOS.h
+ * @brief   主机测试用 FreeRTOS 替身 (单线程，时间由测试推进)
+ * @note    只提供业务组件用到的类型与宏，任务不会真正运行：xTaskCreate 只登记，
+ *          vTaskDelay/vTaskDelayUntil 推进虚拟节拍，互斥锁与临界区在单线程下只检查是否重入
+ *          任务状态与运行时统计 (uxTaskGetSystemState) 由测试通过 host_freertos.h 设定
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef uint32_t TickType_t;
+typedef int      BaseType_t;
+typedef unsigned UBaseType_t;
+
+#define pdFALSE             0
+#define pdTRUE              1
+#define pdPASS              pdTRUE
+#define pdFAIL              pdFALSE
+#define portMAX_DELAY       ((TickType_t)0xFFFFFFFFUL)
+
+#define configTICK_RATE_HZ  1000
+#define portTICK_PERIOD_MS  (1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000))
+
+#define configMAX_TASK_NAME_LEN     16
+
+// 运行时诊断相关配置，与工程 sdkconfig.defaults 一致 (双核 ESP32)；测试可用 -D 覆盖
+#ifndef configUSE_TRACE_FACILITY
+#define configUSE_TRACE_FACILITY        1
+#endif
+#ifndef configGENERATE_RUN_TIME_STATS
+#define configGENERATE_RUN_TIME_STATS   1
+#endif
+#ifndef portNUM_PROCESSORS
+#define portNUM_PROCESSORS              2
+#endif
+#define configSTACK_DEPTH_TYPE          uint32_t
+#define configRUN_TIME_COUNTER_TYPE     uint32_t
+
+// 临界区 (portMUX 自旋锁)：单线程下嵌套进入同一把锁视为错误
+typedef struct {
+    uint32_t Held;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED    { 0 }
+
+void Host_EnterCritical(portMUX_TYPE *mux);
+void Host_ExitCritical(portMUX_TYPE *mux);
+
+#define taskENTER_CRITICAL(mux)         Host_EnterCritical(mux)
+#define taskEXIT_CRITICAL(mux)          Host_ExitCritical(mux)
@@ -0,0 +1,13 @@
+#pragma once
+
+/**
+ * @file    queue.h
+ * @brief   主机测试用队列替身：只支持不存在的 / 空的队列，接收总是立即返回 pdFALSE
+ */
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"     // 与 FreeRTOS 的 queue.h 相同
+
+typedef struct HostQueue *QueueHandle_t;
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t timeout);
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct HostTask *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *arg);
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth,
+                       void *arg, UBaseType_t priority, TaskHandle_t *handle);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack_depth,
+                                   void *arg, UBaseType_t priority, TaskHandle_t *handle,
+                                   BaseType_t core);
+
+TickType_t xTaskGetTickCount(void);
+void       vTaskDelay(TickType_t ticks);
+void       vTaskDelayUntil(TickType_t *prev_wake, TickType_t increment);
+void       vTaskDelete(TaskHandle_t task);
+
+typedef enum {
+    eRunning = 0,
+    eReady,
+    eBlocked,
+    eSuspended,
+    eDeleted,
+    eInvalid
+} eTaskState;
+
+typedef struct {
+    TaskHandle_t                xHandle;
+    const char                 *pcTaskName;
+    UBaseType_t                 xTaskNumber;
+    eTaskState                  eCurrentState;
+    UBaseType_t                 uxCurrentPriority;
+    UBaseType_t                 uxBasePriority;
+    configRUN_TIME_COUNTER_TYPE ulRunTimeCounter;
+    uint8_t                    *pxStackBase;
+    configSTACK_DEPTH_TYPE      usStackHighWaterMark;
+    BaseType_t                  xCoreID;
+} TaskStatus_t;
+
+UBaseType_t uxTaskGetNumberOfTasks(void);
+
+/**
+ * @brief 与 FreeRTOS 相同：数组不足以容纳全部任务时返回 0
+ */
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *array, UBaseType_t size,
+                                 configRUN_TIME_COUNTER_TYPE *total_run_time);
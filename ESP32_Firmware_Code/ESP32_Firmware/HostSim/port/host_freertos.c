@@ -0,0 +1,196 @@
+/**
+ * @file    host_freertos.c
+ * @brief   FreeRTOS 替身实现 (见 freertos/FreeRTOS.h)
+ */
+#include "host_freertos.h"
+#include "freertos/semphr.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct HostSemaphore {
+    uint8_t Held;
+};
+
+static HostTask_t s_Tasks[HOST_MAX_TASKS];
+static uint32_t   s_TaskCount = 0;
+static TickType_t s_Tick = 0;
+static uint32_t   s_RunTime = 0;
+
+void Host_RtosReset(void)
+{
+    memset(s_Tasks, 0, sizeof(s_Tasks));
+    s_TaskCount = 0;
+    s_Tick = 0;
+    s_RunTime = 0;
+}
+
+void Host_SetTick(TickType_t tick)
+{
+    s_Tick = tick;
+}
+
+const HostTask_t *Host_FindTask(const char *name)
+{
+    for (uint32_t i = 0; i < s_TaskCount; i++) {
+        if (!s_Tasks[i].Deleted && strcmp(s_Tasks[i].Name, name) == 0) return &s_Tasks[i];
+    }
+    return NULL;
+}
+
+void Host_SetRunTime(uint32_t total)
+{
+    s_RunTime = total;
+}
+
+void Host_TaskAddRunTime(TaskHandle_t task, uint32_t delta)
+{
+    task->RunTime += delta;
+}
+
+void Host_TaskSetStackFree(TaskHandle_t task, uint32_t bytes)
+{
+    task->StackFree = bytes;
+}
+
+/* ============================================================
+ *                 semphr.h
+ * ============================================================ */
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return calloc(1, sizeof(struct HostSemaphore));
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t timeout)
+{
+    if (!sem->Held) {
+        sem->Held = 1;
+        return pdTRUE;
+    }
+    if (timeout == 0) return pdFALSE;
+    fprintf(stderr, "xSemaphoreTake: 单线程下等待已持有的锁 (死锁)\n");
+    abort();
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    if (!sem->Held) return pdFALSE;
+    sem->Held = 0;
+    return pdTRUE;
+}
+
+/* ============================================================
+ *                 queue.h
+ * ============================================================ */
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t timeout)
+{
+    (void)queue; (void)item; (void)timeout;
+    return pdFALSE;
+}
+
+/* ============================================================
+ *                 临界区
+ * ============================================================ */
+
+void Host_EnterCritical(portMUX_TYPE *mux)
+{
+    if (mux->Held) {
+        fprintf(stderr, "taskENTER_CRITICAL: 单线程下重入同一临界区\n");
+        abort();
+    }
+    mux->Held = 1;
+}
+
+void Host_ExitCritical(portMUX_TYPE *mux)
+{
+    mux->Held = 0;
+}
+
+/* ============================================================
+ *                 task.h
+ * ============================================================ */
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack_depth,
+                                   void *arg, UBaseType_t priority, TaskHandle_t *handle,
+                                   BaseType_t core)
+{
+    HostTask_t *t;
+
+    if (s_TaskCount >= HOST_MAX_TASKS) return pdFAIL;
+    t = &s_Tasks[s_TaskCount++];
+    snprintf(t->Name, sizeof(t->Name), "%s", name);
+    t->Fn = fn;
+    t->Arg = arg;
+    t->StackDepth = stack_depth;
+    t->Priority = priority;
+    t->Core = core;
+    t->Number = s_TaskCount;
+    t->StackFree = stack_depth;
+    if (handle) *handle = t;
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth,
+                       void *arg, UBaseType_t priority, TaskHandle_t *handle)
+{
+    return xTaskCreatePinnedToCore(fn, name, stack_depth, arg, priority, handle, -1);
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return s_Tick;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    s_Tick += ticks;
+}
+
+void vTaskDelayUntil(TickType_t *prev_wake, TickType_t increment)
+{
+    *prev_wake += increment;
+    if ((int32_t)(*prev_wake - s_Tick) > 0) s_Tick = *prev_wake;
+}
+
+// 单线程下没有"当前任务"，task 为 NULL 时不做处理
+void vTaskDelete(TaskHandle_t task)
+{
+    if (task) task->Deleted = 1;
+}
+
+UBaseType_t uxTaskGetNumberOfTasks(void)
+{
+    UBaseType_t n = 0;
+
+    for (uint32_t i = 0; i < s_TaskCount; i++) {
+        if (!s_Tasks[i].Deleted) n++;
+    }
+    return n;
+}
+
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *array, UBaseType_t size,
+                                 configRUN_TIME_COUNTER_TYPE *total_run_time)
+{
+    UBaseType_t n = 0;
+
+    if (size < uxTaskGetNumberOfTasks()) return 0;
+    for (uint32_t i = 0; i < s_TaskCount; i++) {
+        HostTask_t *t = &s_Tasks[i];
+        if (t->Deleted) continue;
+        memset(&array[n], 0, sizeof(array[n]));
+        array[n].xHandle = t;
+        array[n].pcTaskName = t->Name;
+        array[n].xTaskNumber = t->Number;
+        array[n].eCurrentState = eReady;
+        array[n].uxCurrentPriority = t->Priority;
+        array[n].uxBasePriority = t->Priority;
+        array[n].ulRunTimeCounter = t->RunTime;
+        array[n].usStackHighWaterMark = t->StackFree;
+        array[n].xCoreID = t->Core;
+        n++;
+    }
+    if (total_run_time) *total_run_time = s_RunTime;
+    return n;
+}
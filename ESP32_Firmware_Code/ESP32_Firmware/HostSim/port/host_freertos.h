@@ -0,0 +1,38 @@
+#pragma once
+
+/**
+ * @file    host_freertos.h
+ * @brief   FreeRTOS 替身的测试接口 (host_freertos.c)
+ */
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+typedef struct HostTask {
+    char           Name[configMAX_TASK_NAME_LEN];
+    TaskFunction_t Fn;
+    void          *Arg;
+    uint32_t       StackDepth;
+    UBaseType_t    Priority;
+    BaseType_t     Core;
+    UBaseType_t    Number;          // 任务编号 (创建顺序，不复用)
+    uint32_t       RunTime;         // 运行时间计数 (与 Host_SetRunTime 同单位)
+    uint32_t       StackFree;       // 栈高水位 (字节)，创建时为 StackDepth
+    uint8_t        Deleted;
+} HostTask_t;
+
+#define HOST_MAX_TASKS      16
+
+/**
+ * @brief 清空已登记的任务并把节拍归零
+ */
+void              Host_RtosReset(void);
+void              Host_SetTick(TickType_t tick);
+const HostTask_t *Host_FindTask(const char *name);
+
+/**
+ * @brief 运行时统计：总计数器 (uxTaskGetSystemState 的 total，单核计时) 与各任务的计数
+ */
+void              Host_SetRunTime(uint32_t total);
+void              Host_TaskAddRunTime(TaskHandle_t task, uint32_t delta);
+void              Host_TaskSetStackFree(TaskHandle_t task, uint32_t bytes);
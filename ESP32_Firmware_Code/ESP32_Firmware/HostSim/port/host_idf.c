@@ -0,0 +1,54 @@
+/**
+ * @file    host_idf.c
+ * @brief   ESP-IDF 替身实现 (见 esp_heap_caps.h、esp_timer.h)
+ */
+#include "host_idf.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <string.h>
+
+typedef struct {
+    size_t Total, Free, MinFree, Largest;
+} HostHeap_t;
+
+static HostHeap_t s_Internal, s_Psram;
+
+// 只区分内部 RAM 与 PSRAM 两类
+static HostHeap_t *_Heap(uint32_t caps)
+{
+    return (caps & MALLOC_CAP_SPIRAM) ? &s_Psram : &s_Internal;
+}
+
+void Host_IdfReset(void)
+{
+    memset(&s_Internal, 0, sizeof(s_Internal));
+    memset(&s_Psram, 0, sizeof(s_Psram));
+}
+
+void Host_SetHeap(uint32_t caps, size_t total, size_t free, size_t min_free, size_t largest)
+{
+    HostHeap_t *h = _Heap(caps);
+
+    h->Total = total;
+    h->Free = free;
+    h->MinFree = min_free;
+    h->Largest = largest;
+}
+
+/* ============================================================
+ *                 esp_heap_caps.h
+ * ============================================================ */
+
+size_t heap_caps_get_total_size(uint32_t caps)          { return _Heap(caps)->Total; }
+size_t heap_caps_get_free_size(uint32_t caps)           { return _Heap(caps)->Free; }
+size_t heap_caps_get_minimum_free_size(uint32_t caps)   { return _Heap(caps)->MinFree; }
+size_t heap_caps_get_largest_free_block(uint32_t caps)  { return _Heap(caps)->Largest; }
+
+/* ============================================================
+ *                 esp_timer.h
+ * ============================================================ */
+
+int64_t esp_timer_get_time(void)
+{
+    return (int64_t)xTaskGetTickCount() * portTICK_PERIOD_MS * 1000;
+}
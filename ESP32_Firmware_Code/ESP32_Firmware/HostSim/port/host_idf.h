@@ -0,0 +1,15 @@
+#pragma once
+
+/**
+ * @file    host_idf.h
+ * @brief   ESP-IDF 替身 (heap_caps、esp_timer) 的测试接口 (host_idf.c)
+ */
+
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+
+/**
+ * @brief 设定某一能力 (MALLOC_CAP_INTERNAL / MALLOC_CAP_SPIRAM) 的堆统计，total 为 0 表示不存在
+ */
+void Host_SetHeap(uint32_t caps, size_t total, size_t free, size_t min_free, size_t largest);
+void Host_IdfReset(void);
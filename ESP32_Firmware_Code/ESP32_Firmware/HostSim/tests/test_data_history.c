@@ -0,0 +1,226 @@
+/**
+ * @file    test_data_history.c
+ * @brief   DataHistory (1_DataRepo/data_history.c) 的汇总、空缺补位与环形回绕
+ * @note    1. 采样直接经 DataHistory_AddSample 写入，时间线按阶段单调推进 (模块状态为静态变量)
+ *          2. 期望值按固件的取整规则手算：均值四舍五入，负数远离 0
+ *          3. 末尾输出 MQTT 历史应答的字节数 (分块格式见 agent_mqtt.c)，
+ *             并与逐条 JSON 的大小对比
+ */
+#include "host_test.h"
+#include "host_freertos.h"
+#include "data_history.h"
+#include <string.h>
+
+#define T0              1767225600UL    // 2026-01-01 00:00:00 UTC (整点)
+#define MIN_REC_SIZE    sizeof(DH_MinuteRec_t)
+#define HOUR_REC_SIZE   sizeof(DH_HourRec_t)
+
+// 与 agent_mqtt.c 的历史应答一致：16 字节块头，每块最多 128 条
+#define CHUNK_HDR       16
+#define CHUNK_RECS      128
+
+/* --- 采样任务依赖的数据中心接口 (测试不经过采样任务) --- */
+void DataCenter_Get_Lighting(DC_LightingData_t *out) { memset(out, 0, sizeof(*out)); }
+void DataCenter_Get_Env(DC_EnvData_t *out) { memset(out, 0, sizeof(*out)); }
+
+static void _Sample(uint32_t ts, int8_t temp, uint8_t hum, uint16_t lux,
+                    uint8_t power, uint8_t bri, uint8_t cct)
+{
+    DC_LightingData_t light = { .power = power, .brightness = bri, .color_temp = cct };
+    DC_EnvData_t env = { .indoor_temp = temp, .indoor_hum = hum, .indoor_lux = lux };
+    DataHistory_AddSample(ts, &light, &env);
+}
+
+// 每分钟 1 次采样的平稳数据，从 from 到 to (不含)
+static void _Steady(uint32_t from, uint32_t to, int8_t temp)
+{
+    for (uint32_t ts = from; ts < to; ts += 60) _Sample(ts, temp, 50, 300, 1, 60, 40);
+}
+
+static uint32_t _WireBytes(DH_Resolution_t res, uint32_t recs)
+{
+    uint32_t chunks = recs ? (recs + CHUNK_RECS - 1) / CHUNK_RECS : 1;
+    return chunks * CHUNK_HDR + recs * (uint32_t)DataHistory_RecordSize(res);
+}
+
+/* ============================================================ */
+
+static DH_MinuteRec_t s_Min[DH_MINUTE_SLOTS];
+static DH_HourRec_t   s_Hour[DH_HOUR_SLOTS];
+
+static void _TestInit(void)
+{
+    const HostTask_t *task;
+    uint32_t first = 0;
+
+    Host_RtosReset();
+    DataHistory_Init();
+    task = Host_FindTask("DH_Sample");
+    TEST_CHECK(task != NULL);
+    if (task) TEST_EQ(task->Priority, 1);
+
+    // 时间未同步的采样被忽略
+    _Sample(1000, 20, 50, 300, 1, 50, 50);
+    _Sample(1060, 20, 50, 300, 1, 50, 50);
+    TEST_EQ(DataHistory_Range(DH_RES_MINUTE, 0, 0, &first), 0);
+    TEST_EQ(DataHistory_StepSeconds(DH_RES_MINUTE), 60);
+    TEST_EQ(DataHistory_RecordSize(DH_RES_HOUR), 16);
+}
+
+// 第 0 小时：每分钟 6 次采样，20~24 分钟没有数据
+static void _TestRollup(void)
+{
+    uint32_t first = 0, ts, n;
+
+    for (uint32_t m = 0; m < 60; m++) {
+        if (m >= 20 && m < 25) continue;
+        for (uint32_t k = 0; k < 6; k++) {
+            // 前 3 次开灯 (亮度 80)；温度 0..-5，湿度 40..45
+            _Sample(T0 + m * 60 + k * 10, (int8_t)-(int)k, (uint8_t)(40 + k), (uint16_t)(100 * m),
+                    k < 3, 80, 30);
+        }
+    }
+    // 下一小时的两个采样：结算第 59 分钟与第 0 小时
+    _Sample(T0 + 3600, 10, 50, 0, 0, 0, 0);
+    _Sample(T0 + 3660, 10, 50, 0, 0, 0, 0);
+
+    n = DataHistory_Range(DH_RES_MINUTE, T0, T0 + 3599, &first);
+    TEST_EQ(n, 60);
+    TEST_EQ(first, T0);
+    ts = T0;
+    TEST_EQ(DataHistory_Read(DH_RES_MINUTE, &ts, s_Min, 60), 60);
+    TEST_EQ(ts, T0);
+
+    // 分钟均值：温度 -15/6 = -2.5 -> -3，湿度 255/6 = 42.5 -> 43，亮度 240/6 = 40，开灯 50%
+    TEST_EQ(s_Min[0].temp, -3);
+    TEST_EQ(s_Min[0].hum, 43);
+    TEST_EQ(s_Min[0].brightness, 40);
+    TEST_EQ(s_Min[0].color_temp, 30);
+    TEST_EQ(s_Min[0].on_pct, 50);
+    TEST_EQ(s_Min[0].valid, 6);
+    TEST_EQ(s_Min[37].lux, 3700);
+
+    // 空缺的分钟以空记录占位
+    for (uint32_t m = 20; m < 25; m++) TEST_EQ(s_Min[m].valid, 0);
+    TEST_EQ(s_Min[25].valid, 6);
+
+    // 小时汇总：55 个有效分钟，光照 0..5900 (去掉 2000..2400)
+    n = DataHistory_Range(DH_RES_HOUR, T0, 0, &first);
+    TEST_EQ(n, 1);
+    ts = T0;
+    TEST_EQ(DataHistory_Read(DH_RES_HOUR, &ts, s_Hour, 1), 1);
+    TEST_EQ(s_Hour[0].minutes, 55);
+    TEST_EQ(s_Hour[0].temp_min, -3);
+    TEST_EQ(s_Hour[0].temp_max, -3);
+    TEST_EQ(s_Hour[0].temp_avg, -3);
+    TEST_EQ(s_Hour[0].hum_avg, 43);
+    TEST_EQ(s_Hour[0].lux_min, 0);
+    TEST_EQ(s_Hour[0].lux_max, 5900);
+    TEST_EQ(s_Hour[0].lux_avg, 3018);       // 166000 / 55 = 3018.2
+    TEST_EQ(s_Hour[0].brightness_avg, 40);
+    TEST_EQ(s_Hour[0].on_pct, 50);
+}
+
+static void _TestWrap(void)
+{
+    uint32_t first = 0, ts, n, newest;
+
+    // 连续 31 天，分钟环与小时环都回绕
+    _Steady(T0 + 3720, T0 + 31 * 86400 + 120, 22);
+    newest = T0 + 31 * 86400;       // 最后一个采样所在的分钟尚未结算
+
+    n = DataHistory_Range(DH_RES_MINUTE, 0, 0, &first);
+    TEST_EQ(n, DH_MINUTE_SLOTS);
+    TEST_EQ(first, newest - (DH_MINUTE_SLOTS - 1) * 60);
+
+    // 起点已被挤出：改为实际最早的记录
+    ts = T0;
+    TEST_EQ(DataHistory_Read(DH_RES_MINUTE, &ts, s_Min, DH_MINUTE_SLOTS), DH_MINUTE_SLOTS);
+    TEST_EQ(ts, first);
+    TEST_EQ(s_Min[0].temp, 22);
+    TEST_EQ(s_Min[DH_MINUTE_SLOTS - 1].valid, 1);
+
+    // 区间截断到保留范围
+    TEST_EQ(DataHistory_Range(DH_RES_MINUTE, newest - 600, newest + 6000, &first), 11);
+    TEST_EQ(first, newest - 600);
+
+    n = DataHistory_Range(DH_RES_HOUR, 0, 0, &first);
+    TEST_EQ(n, DH_HOUR_SLOTS);
+    ts = T0;
+    TEST_EQ(DataHistory_Read(DH_RES_HOUR, &ts, s_Hour, DH_HOUR_SLOTS), DH_HOUR_SLOTS);
+    TEST_EQ(ts, first);
+    TEST_EQ(s_Hour[0].minutes, 60);
+    TEST_EQ(s_Hour[0].temp_avg, 22);
+    TEST_EQ(s_Hour[DH_HOUR_SLOTS - 1].minutes, 60);
+    TEST_EQ(first + (DH_HOUR_SLOTS - 1) * 3600, (newest - 3600) / 3600 * 3600);
+}
+
+static void _TestClockJumps(void)
+{
+    uint32_t first = 0, ts, now = (T0 + 31 * 86400 + 120) / 60 * 60;
+
+    // 时间回拨 10 分钟 (仍在保留范围内)：覆盖该分钟
+    _Sample(now - 600, -7, 50, 300, 1, 60, 40);
+    _Sample(now + 60, 22, 50, 300, 1, 60, 40);
+    ts = now - 600;
+    TEST_EQ(DataHistory_Read(DH_RES_MINUTE, &ts, s_Min, 1), 1);
+    TEST_EQ(ts, now - 600);
+    TEST_EQ(s_Min[0].temp, -7);
+
+    // 向前跳 2 天：分钟环只剩新数据，小时环用空记录补齐
+    now += 2 * 86400;
+    _Sample(now, 18, 50, 300, 1, 60, 40);
+    _Sample(now + 60, 18, 50, 300, 1, 60, 40);
+    TEST_EQ(DataHistory_Range(DH_RES_MINUTE, 0, 0, &first), 1);
+    TEST_EQ(first, now);
+
+    _Sample(now + 3600, 18, 50, 300, 1, 60, 40);
+    _Sample(now + 3660, 18, 50, 300, 1, 60, 40);
+    TEST_EQ(DataHistory_Range(DH_RES_HOUR, now - 86400, now, &first), 25);
+    ts = first;
+    TEST_EQ(DataHistory_Read(DH_RES_HOUR, &ts, s_Hour, 25), 25);
+    TEST_EQ(s_Hour[0].minutes, 0);
+    TEST_EQ(s_Hour[24].minutes, 2);
+    TEST_EQ(s_Hour[24].temp_avg, 18);
+}
+
+// MQTT 历史应答字节数：24 小时分钟数据 / 24 小时与 30 天小时数据，对比逐条 JSON
+static void _ReportWire(void)
+{
+    uint32_t first = 0, now = (T0 + 40 * 86400) / 3600 * 3600;
+    uint32_t n_min, n_hour24, n_hour30, json_min = 0, json_raw = 0;
+    char buf[160];
+
+    _Steady(now - 86400 - 120, now + 120, 21);
+    n_min = DataHistory_Range(DH_RES_MINUTE, now - 86400, 0, &first);
+    n_hour24 = DataHistory_Range(DH_RES_HOUR, now - 86400, 0, &first);
+    n_hour30 = DataHistory_Range(DH_RES_HOUR, 0, 0, &first);
+    TEST_EQ(n_min, DH_MINUTE_SLOTS);
+    TEST_EQ(_WireBytes(DH_RES_MINUTE, n_min), 11712);
+
+    // 同样的分钟数据逐条 JSON，以及 24 小时原始状态上报 (每 10 秒一条)
+    for (uint32_t i = 0; i < n_min; i++) {
+        json_min += (uint32_t)snprintf(buf, sizeof(buf),
+            "{\"ts\":%u,\"temp\":21,\"hum\":50,\"lux\":300,\"brightness\":60,\"color_temp\":40,\"on_pct\":100}",
+            (unsigned)(first + i * 60));
+    }
+    json_raw = 8640u * (uint32_t)snprintf(buf, sizeof(buf),
+        "{\"power\":1,\"brightness\":60,\"color_temp\":40,\"temp\":21,\"hum\":50,\"lux\":300}");
+
+    printf("历史应答字节数 (块头 %d B，每块 %d 条):\n", CHUNK_HDR, CHUNK_RECS);
+    printf("  24 小时分钟数据  %4u 条  %6u B\n", (unsigned)n_min, (unsigned)_WireBytes(DH_RES_MINUTE, n_min));
+    printf("  24 小时小时数据  %4u 条  %6u B\n", (unsigned)n_hour24, (unsigned)_WireBytes(DH_RES_HOUR, n_hour24));
+    printf("  30 天小时数据    %4u 条  %6u B\n", (unsigned)n_hour30, (unsigned)_WireBytes(DH_RES_HOUR, n_hour30));
+    printf("  对比: 分钟数据逐条 JSON %u B，24 小时原始状态消息 %u B\n",
+           (unsigned)json_min, (unsigned)json_raw);
+}
+
+int main(void)
+{
+    _TestInit();
+    _TestRollup();
+    _TestWrap();
+    _TestClockJumps();
+    _ReportWire();
+    TEST_DONE();
+}
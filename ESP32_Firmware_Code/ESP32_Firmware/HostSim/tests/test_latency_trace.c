@@ -0,0 +1,352 @@
+/**
+ * @file    test_latency_trace.c
+ * @brief   延迟追踪 (latency_trace.c) 与 Dev_STM32 中 tid 的处理
+ * @note    1. 时间取 esp_timer 替身 (虚拟节拍，1ms 分辨率)，hop 偏移为 1000 的整数倍
+ *          2. Dev_STM32 的接收任务原样运行：uart_read_bytes 替身逐段送出脚本数据，
+ *             脚本用完后 longjmp 回到测试 (任务中 malloc 的接收缓冲区不再释放)
+ *          3. DataCenter / EventBus 由本文件替身记录调用
+ */
+#include "latency_trace.h"
+#include "dev_stm32.h"
+#include "data_center.h"
+#include "event_bus.h"
+#include "driver/uart.h"
+#include "host_freertos.h"
+#include "host_idf.h"
+#include "host_test.h"
+#include <setjmp.h>
+#include <stdio.h>
+#include <string.h>
+
+static char s_Json[256];
+
+static void _At(uint32_t ms) { Host_SetTick(pdMS_TO_TICKS(ms)); }
+
+// 结束追踪并检查输出
+static void _Finish(uint32_t tid, const char *expect)
+{
+    size_t n = Trace_Finish(tid, s_Json, sizeof(s_Json));
+
+    if (expect == NULL) {
+        TEST_EQ(n, 0);
+        return;
+    }
+    TEST_EQ(n, strlen(expect));
+    if (strcmp(s_Json, expect) != 0) fprintf(stderr, "  得到 %s\n  期望 %s\n", s_Json, expect);
+    TEST_CHECK(strcmp(s_Json, expect) == 0);
+}
+
+/* ============================================================
+ *                 latency_trace.c
+ * ============================================================ */
+
+// 各跳相对起点的偏移，未经过的 hop 不输出
+static void test_hop_offsets(void)
+{
+    Host_RtosReset();
+    _At(5000);
+    Trace_Begin(7, TRACE_ORIGIN_PANEL, TRACE_HOP_MQTT_RX);
+    _At(5002);
+    TEST_EQ(Trace_Pending(TRACE_ORIGIN_PANEL, TRACE_HOP_UART_TX), 7);
+    TEST_EQ(Trace_Pending(TRACE_ORIGIN_STM32, TRACE_HOP_UART_TX), 0);
+    Trace_Mark(7, TRACE_HOP_UART_TX);
+    TEST_EQ(Trace_Pending(TRACE_ORIGIN_PANEL, TRACE_HOP_UART_TX), 0);
+    _At(5013);
+    Trace_Mark(7, TRACE_HOP_UART_RX);
+    Trace_SetRemote(7, 95);
+    _At(5015);
+    _Finish(7, "{\"tid\":7,\"src\":\"panel\",\"hops\":{\"mqtt_rx\":0,\"uart_tx\":2000,"
+               "\"uart_rx\":13000,\"mqtt_tx\":15000},\"stm32_us\":95,\"drop\":0}");
+
+    // 已结束的追踪不能再结束
+    _Finish(7, NULL);
+
+    // STM32 发起：起点为 uart_rx，未经过 mqtt_rx / uart_tx，无 STM32 耗时时不输出该字段
+    _At(6000);
+    Trace_Begin(42, TRACE_ORIGIN_STM32, TRACE_HOP_UART_RX);
+    _At(6001);
+    _Finish(42, "{\"tid\":42,\"src\":\"stm32\",\"hops\":{\"uart_rx\":0,\"mqtt_tx\":1000},\"drop\":0}");
+}
+
+// tid 0 不追踪；编号不符或重复记录的 hop 被忽略
+static void test_ignored_marks(void)
+{
+    Host_RtosReset();
+    Trace_Begin(0, TRACE_ORIGIN_PANEL, TRACE_HOP_MQTT_RX);
+    TEST_EQ(Trace_Pending(TRACE_ORIGIN_PANEL, TRACE_HOP_UART_TX), 0);
+    _Finish(0, NULL);
+
+    _At(100);
+    Trace_Begin(3, TRACE_ORIGIN_PANEL, TRACE_HOP_MQTT_RX);
+    _At(104);
+    Trace_Mark(4, TRACE_HOP_UART_TX);
+    Trace_Mark(0, TRACE_HOP_UART_TX);
+    Trace_SetRemote(4, 123);
+    Trace_Mark(3, TRACE_HOP_UART_TX);
+    _At(109);
+    Trace_Mark(3, TRACE_HOP_UART_TX);      // 保留首次记录
+    Trace_Begin(0, TRACE_ORIGIN_STM32, TRACE_HOP_UART_RX);   // 不覆盖进行中的追踪
+    _At(110);
+    _Finish(3, "{\"tid\":3,\"src\":\"panel\",\"hops\":{\"mqtt_rx\":0,\"uart_tx\":4000,"
+               "\"mqtt_tx\":10000},\"drop\":0}");
+}
+
+// 新追踪覆盖未完成的旧追踪：旧 tid 无法结束，丢弃数随下一条输出并清零
+static void test_replace_live(void)
+{
+    Host_RtosReset();
+    _At(1000);
+    Trace_Begin(1, TRACE_ORIGIN_PANEL, TRACE_HOP_MQTT_RX);
+    _At(1010);
+    Trace_Begin(2, TRACE_ORIGIN_PANEL, TRACE_HOP_MQTT_RX);
+    _At(1020);
+    Trace_Begin(3, TRACE_ORIGIN_STM32, TRACE_HOP_UART_RX);
+    TEST_EQ(Trace_Pending(TRACE_ORIGIN_PANEL, TRACE_HOP_UART_TX), 0);
+    Trace_Mark(2, TRACE_HOP_UART_RX);
+    _Finish(1, NULL);
+    _Finish(2, NULL);
+    _At(1021);
+    _Finish(3, "{\"tid\":3,\"src\":\"stm32\",\"hops\":{\"uart_rx\":0,\"mqtt_tx\":1000},\"drop\":2}");
+
+    _At(1030);
+    Trace_Begin(4, TRACE_ORIGIN_PANEL, TRACE_HOP_MQTT_RX);
+    _Finish(4, "{\"tid\":4,\"src\":\"panel\",\"hops\":{\"mqtt_rx\":0,\"mqtt_tx\":0},\"drop\":0}");
+}
+
+// 超过 TRACE_TIMEOUT_MS 的追踪作废并计入丢弃 (恰好等于时仍有效)
+static void test_timeout_drop(void)
+{
+    Host_RtosReset();
+    _At(2000);
+    Trace_Begin(5, TRACE_ORIGIN_PANEL, TRACE_HOP_MQTT_RX);
+    _At(2000 + TRACE_TIMEOUT_MS);
+    TEST_EQ(Trace_Pending(TRACE_ORIGIN_PANEL, TRACE_HOP_UART_TX), 5);
+    _At(2000 + TRACE_TIMEOUT_MS + 1);
+    TEST_EQ(Trace_Pending(TRACE_ORIGIN_PANEL, TRACE_HOP_UART_TX), 0);
+    _Finish(5, NULL);
+
+    // 超时只计一次：之后的 Begin 不再把它算作被覆盖
+    _At(4000);
+    Trace_Begin(6, TRACE_ORIGIN_PANEL, TRACE_HOP_MQTT_RX);
+    _At(4000 + TRACE_TIMEOUT_MS + 1);
+    _Finish(6, NULL);
+    _At(6000);
+    Trace_Begin(8, TRACE_ORIGIN_STM32, TRACE_HOP_UART_RX);
+    Trace_SetRemote(8, 3000);
+    _Finish(8, "{\"tid\":8,\"src\":\"stm32\",\"hops\":{\"uart_rx\":0,\"mqtt_tx\":0},"
+               "\"stm32_us\":3000,\"drop\":2}");
+}
+
+// 缓冲区不足时返回 0 且不越界；恰好容纳 (含结束符) 时完整输出
+static void test_finish_truncation(void)
+{
+    static const char full[] = "{\"tid\":9,\"src\":\"panel\",\"hops\":{\"mqtt_rx\":0,\"uart_tx\":1000,"
+                               "\"uart_rx\":2000,\"mqtt_tx\":3000},\"stm32_us\":95,\"drop\":0}";
+    char buf[sizeof(full) + 8];
+    size_t len, i, n;
+    uint8_t ok = 1;
+
+    Host_RtosReset();
+    for (len = 0; len <= sizeof(full); len++) {
+        _At(100);
+        Trace_Begin(9, TRACE_ORIGIN_PANEL, TRACE_HOP_MQTT_RX);
+        _At(101);
+        Trace_Mark(9, TRACE_HOP_UART_TX);
+        _At(102);
+        Trace_Mark(9, TRACE_HOP_UART_RX);
+        Trace_SetRemote(9, 95);
+        _At(103);
+
+        memset(buf, '#', sizeof(buf));
+        n = Trace_Finish(9, buf, len);
+        for (i = len; i < sizeof(buf); i++) {
+            if (buf[i] != '#') ok = 0;      // 越界写入
+        }
+        if (len > 0 && memchr(buf, '\0', len) == NULL) ok = 0;
+        if (len < sizeof(full)) {
+            if (n != 0) ok = 0;
+        } else if (n != sizeof(full) - 1 || strcmp(buf, full) != 0) {
+            ok = 0;
+        }
+        // 输出失败的追踪同样已结束
+        if (Trace_Finish(9, s_Json, sizeof(s_Json)) != 0) ok = 0;
+    }
+    TEST_CHECK(ok);
+}
+
+/* ============================================================
+ *                 Dev_STM32 的替身环境
+ * ============================================================ */
+
+static char     s_Tx[512];
+static size_t   s_TxLen;
+static const char *s_Rx;                // 待送出的接收脚本 (NULL 结束)
+static uint32_t s_RxAt;                 // 送出时刻 (ms)
+static jmp_buf  s_RxDone;
+
+static DC_LightingData_t s_Light;
+static DC_EnvData_t      s_Env;
+static uint32_t          s_LightSets, s_TraceDone, s_TraceDoneTid;
+
+void DataCenter_Get_Lighting(DC_LightingData_t *out)        { *out = s_Light; }
+void DataCenter_Set_Lighting(const DC_LightingData_t *in)   { s_Light = *in; s_LightSets++; }
+void DataCenter_Get_Env(DC_EnvData_t *out)                  { *out = s_Env; }
+void DataCenter_Set_Env(const DC_EnvData_t *in)             { s_Env = *in; }
+
+esp_err_t EventBus_Send(EventType_t type, void *data, int len)
+{
+    (void)len;
+    if (type == EVT_TRACE_DONE) {
+        s_TraceDone++;
+        s_TraceDoneTid = (uint32_t)(uintptr_t)data;
+    }
+    return ESP_OK;
+}
+
+esp_err_t uart_driver_install(uart_port_t uart_num, int rx_buffer_size, int tx_buffer_size,
+                              int queue_size, QueueHandle_t *uart_queue, int intr_alloc_flags)
+{
+    (void)uart_num; (void)rx_buffer_size; (void)tx_buffer_size; (void)queue_size; (void)intr_alloc_flags;
+    if (uart_queue) *uart_queue = NULL;
+    return ESP_OK;
+}
+
+esp_err_t uart_param_config(uart_port_t uart_num, const uart_config_t *uart_config)
+{
+    (void)uart_num; (void)uart_config;
+    return ESP_OK;
+}
+
+esp_err_t uart_set_pin(uart_port_t uart_num, int tx_io_num, int rx_io_num, int rts_io_num, int cts_io_num)
+{
+    (void)uart_num; (void)tx_io_num; (void)rx_io_num; (void)rts_io_num; (void)cts_io_num;
+    return ESP_OK;
+}
+
+int uart_write_bytes(uart_port_t uart_num, const void *src, size_t size)
+{
+    (void)uart_num;
+    if (s_TxLen + size < sizeof(s_Tx)) {
+        memcpy(s_Tx + s_TxLen, src, size);
+        s_TxLen += size;
+        s_Tx[s_TxLen] = '\0';
+    }
+    return (int)size;
+}
+
+// 在 s_RxAt 时刻一次送出整段脚本，下一次调用结束接收任务
+int uart_read_bytes(uart_port_t uart_num, void *buf, uint32_t length, TickType_t ticks_to_wait)
+{
+    size_t n;
+
+    (void)uart_num; (void)ticks_to_wait;
+    if (s_Rx == NULL) longjmp(s_RxDone, 1);
+    n = strlen(s_Rx);
+    if (n > length) n = length;
+    memcpy(buf, s_Rx, n);
+    s_Rx = NULL;
+    _At(s_RxAt);
+    return (int)n;
+}
+
+// 运行接收任务直到脚本用完
+static void _StmRx(uint32_t at_ms, const char *lines)
+{
+    const HostTask_t *task = Host_FindTask("stm32_rx");
+
+    TEST_CHECK(task != NULL);
+    if (task == NULL) return;
+    s_Rx = lines;
+    s_RxAt = at_ms;
+    if (setjmp(s_RxDone) == 0) task->Fn(task->Arg);
+}
+
+static void _DevInit(void)
+{
+    Host_RtosReset();
+    Dev_STM32_Init();
+    s_TxLen = 0;
+    s_Tx[0] = '\0';
+    s_LightSets = s_TraceDone = s_TraceDoneTid = 0;
+}
+
+/* ============================================================
+ *                 Dev_STM32 中的 tid
+ * ============================================================ */
+
+// 面板发起：调光指令附带 tid 并记录 uart_tx，回执记录 uart_rx 与 STM32 耗时后通知发布
+static void test_dev_panel_trace(void)
+{
+    _DevInit();
+    _At(300);
+    Trace_Begin(77, TRACE_ORIGIN_PANEL, TRACE_HOP_MQTT_RX);
+    _At(301);
+    Dev_STM32_Set_Light(300, 200);
+    TEST_CHECK(strcmp(s_Tx, "{\"cmd\":\"light\",\"warm\":300,\"cold\":200,\"tid\":77}\r\n") == 0);
+
+    // 同一追踪的后续调光 (拖动滑块) 不再附带 tid
+    s_TxLen = 0;
+    Dev_STM32_Set_Light(310, 200);
+    TEST_CHECK(strcmp(s_Tx, "{\"cmd\":\"light\",\"warm\":310,\"cold\":200}\r\n") == 0);
+
+    // 编号不符的回执只通知，不改动当前追踪
+    _StmRx(305, "{\"ev\":\"trace\",\"tid\":76,\"us\":11}\r\n");
+    TEST_EQ(s_TraceDone, 1);
+    TEST_EQ(s_TraceDoneTid, 76);
+
+    _StmRx(309, "{\"ev\":\"trace\",\"tid\":77,\"us\":95}\r\n");
+    TEST_EQ(s_TraceDone, 2);
+    TEST_EQ(s_TraceDoneTid, 77);
+    TEST_EQ(s_LightSets, 0);
+    _At(310);
+    _Finish(77, "{\"tid\":77,\"src\":\"panel\",\"hops\":{\"mqtt_rx\":0,\"uart_tx\":1000,"
+                "\"uart_rx\":9000,\"mqtt_tx\":10000},\"stm32_us\":95,\"drop\":0}");
+}
+
+// 没有追踪时调光指令不带 tid
+static void test_dev_untraced(void)
+{
+    _DevInit();
+    _At(400);
+    Dev_STM32_Set_Light(0, 1000);
+    TEST_CHECK(strcmp(s_Tx, "{\"cmd\":\"light\",\"warm\":0,\"cold\":1000}\r\n") == 0);
+    _Finish(0, NULL);
+}
+
+// STM32 发起：带 tid 的 state 上报开始追踪，age (ms) 作为 STM32 耗时；
+// 不带 tid 的上报只更新数据；多条上报在同一次读取中到达时后者覆盖前者
+static void test_dev_stm32_trace(void)
+{
+    _DevInit();
+    _StmRx(500, "{\"ev\":\"state\",\"warm\":500,\"cold\":500,\"tid\":42,\"age\":3}\r\n");
+    TEST_EQ(s_LightSets, 1);
+    TEST_EQ(s_Light.brightness, 100);
+    TEST_EQ(s_Light.color_temp, 50);
+    _At(502);
+    _Finish(42, "{\"tid\":42,\"src\":\"stm32\",\"hops\":{\"uart_rx\":0,\"mqtt_tx\":2000},"
+                "\"stm32_us\":3000,\"drop\":0}");
+
+    _StmRx(600, "{\"ev\":\"state\",\"warm\":100,\"cold\":0}\r\n");
+    TEST_EQ(s_LightSets, 2);
+    _Finish(42, NULL);
+
+    _StmRx(700, "{\"ev\":\"state\",\"warm\":100,\"cold\":100,\"tid\":43,\"age\":250}\n"
+                "{\"ev\":\"state\",\"warm\":200,\"cold\":100,\"tid\":44,\"age\":7}\n");
+    TEST_EQ(s_LightSets, 4);
+    _Finish(43, NULL);
+    _Finish(44, "{\"tid\":44,\"src\":\"stm32\",\"hops\":{\"uart_rx\":0,\"mqtt_tx\":0},"
+                "\"stm32_us\":7000,\"drop\":1}");
+}
+
+int main(void)
+{
+    test_hop_offsets();
+    test_ignored_marks();
+    test_replace_live();
+    test_timeout_drop();
+    test_finish_truncation();
+    test_dev_panel_trace();
+    test_dev_untraced();
+    test_dev_stm32_trace();
+    TEST_DONE();
+}
@@ -0,0 +1,244 @@
+/**
+ * @file    test_svc_diag.c
+ * @brief   Svc_Diag：任务 CPU 千分比 (双核、窗口差分、新建/删除任务)、栈高水位关注表、
+ *          堆统计与 JSON 编码 (截断时 more 计数)
+ * @note    1. 任务状态与运行时计数由 FreeRTOS 替身提供，单位与 ESP-IDF 一致 (us)
+ *          2. 同一源文件另按 configUSE_TRACE_FACILITY / configGENERATE_RUN_TIME_STATS
+ *             关闭编译 (test_svc_diag_nocpu / _notask)，检查缺省字段
+ */
+#include "svc_diag.h"
+#include "host_freertos.h"
+#include "host_idf.h"
+#include "event_bus.h"
+#include "dev_stm32.h"
+#include "host_test.h"
+#include <stdio.h>
+#include <string.h>
+
+#define HAS_TASKS   (configUSE_TRACE_FACILITY == 1)
+#define HAS_CPU     (HAS_TASKS && configGENERATE_RUN_TIME_STATS == 1)
+
+/* ============================================================
+ *                 被采样组件的替身
+ * ============================================================ */
+
+static EventBus_Stats_t  s_Evq  = { 3, 32, 17, 2 };
+static Dev_STM32_Stats_t s_Uart = { 1000, 1, 2, 3, 4, 5, 6, 7 };
+
+void EventBus_GetStats(EventBus_Stats_t *stats)     { *stats = s_Evq; }
+void Dev_STM32_GetStats(Dev_STM32_Stats_t *stats)   { *stats = s_Uart; }
+
+static void _TaskFn(void *arg) { (void)arg; }
+
+static TaskHandle_t _Create(const char *name, uint32_t stack)
+{
+    TaskHandle_t h = NULL;
+    xTaskCreate(_TaskFn, name, stack, NULL, 5, &h);
+    return h;
+}
+
+static Diag_Snapshot_t s_Snap;
+static char            s_Buf[DIAG_JSON_MAX];
+
+static const Diag_Task_t *_Find(const char *name)
+{
+    for (uint16_t i = 0; i < s_Snap.task_count; i++) {
+        if (strcmp(s_Snap.tasks[i].name, name) == 0) return &s_Snap.tasks[i];
+    }
+    return NULL;
+}
+
+/* ============================================================
+ *                 用例
+ * ============================================================ */
+
+static TaskHandle_t s_Idle0, s_Idle1, s_Core, s_Rx, s_Asr;
+
+// 上电 10s 后首次采样：窗口为上电以来，千分比以两个核心的总时间为分母
+static void test_first_sample(void)
+{
+    Host_RtosReset();
+    Host_IdfReset();
+    Host_SetHeap(MALLOC_CAP_INTERNAL, 300000, 120000, 90000, 60000);
+
+    s_Idle0 = _Create("IDLE0", 1024);
+    s_Idle1 = _Create("IDLE1", 1024);
+    s_Core  = _Create("Svc_Core", 4096);
+    s_Rx    = _Create("stm32_rx", 3072);
+    s_Asr   = _Create("ASR_Task", 8192);
+    Host_TaskSetStackFree(s_Core, 2040);
+    Host_TaskSetStackFree(s_Rx, 1820);
+    Host_TaskSetStackFree(s_Asr, 900);
+
+    Host_SetTick(10000);
+    Host_SetRunTime(10000000);
+    Host_TaskAddRunTime(s_Idle0, 9500000);
+    Host_TaskAddRunTime(s_Idle1, 9800000);
+    Host_TaskAddRunTime(s_Core, 500000);
+    Host_TaskAddRunTime(s_Rx, 200000);
+    Svc_Diag_Sample(&s_Snap);
+
+    TEST_EQ(s_Snap.uptime_s, 10);
+    TEST_EQ(s_Snap.heap.free, 120000);
+    TEST_EQ(s_Snap.heap.min_free, 90000);
+    TEST_EQ(s_Snap.heap.largest, 60000);
+    TEST_EQ(s_Snap.psram.free, 0);
+    TEST_EQ(s_Snap.evq_depth, 3);
+    TEST_EQ(s_Snap.evq_cap, 32);
+    TEST_EQ(s_Snap.evq_peak, 17);
+    TEST_EQ(s_Snap.evq_drops, 2);
+    TEST_EQ(s_Snap.uart_ovf, 1);
+    TEST_EQ(s_Snap.uart_bad, 7);
+
+#if HAS_TASKS
+    TEST_EQ(s_Snap.task_num, 5);
+    TEST_EQ(s_Snap.task_count, 5);
+    TEST_EQ(s_Snap.watch_min[0], 1820);     // stm32_rx
+    TEST_EQ(s_Snap.watch_min[1], 2040);     // Svc_Core
+    TEST_EQ(s_Snap.watch_min[2], 900);      // ASR_Task
+    TEST_EQ(s_Snap.watch_min[3], -1);       // LampMind_Task 未出现
+#if HAS_CPU
+    TEST_EQ(s_Snap.window_ms, 10000);
+    // CPU 降序
+    TEST_CHECK(strcmp(s_Snap.tasks[0].name, "IDLE1") == 0);
+    TEST_EQ(s_Snap.tasks[0].cpu_permille, 490);
+    TEST_CHECK(strcmp(s_Snap.tasks[1].name, "IDLE0") == 0);
+    TEST_EQ(s_Snap.tasks[1].cpu_permille, 475);
+    TEST_EQ(_Find("Svc_Core")->cpu_permille, 25);
+    TEST_EQ(_Find("stm32_rx")->cpu_permille, 10);
+    TEST_EQ(_Find("ASR_Task")->cpu_permille, 0);
+#else
+    TEST_EQ(s_Snap.window_ms, 0);
+    TEST_EQ(_Find("IDLE0")->cpu_permille, -1);
+    // CPU 未知时栈余量少的在前
+    TEST_CHECK(strcmp(s_Snap.tasks[0].name, "ASR_Task") == 0);
+#endif
+#else
+    TEST_EQ(s_Snap.task_num, 0);
+    TEST_EQ(s_Snap.task_count, 0);
+    TEST_EQ(s_Snap.window_ms, 0);
+    TEST_EQ(s_Snap.watch_min[0], -1);
+#endif
+}
+
+// 第二个窗口：只统计窗口内的增量；删除的任务保留最低栈余量，新建任务从 0 计起
+static void test_second_window(void)
+{
+    TaskHandle_t mind;
+
+    Host_SetTick(15000);
+    Host_SetRunTime(15000000);
+    vTaskDelete(s_Asr);
+    mind = _Create("LampMind_Task", 6144);
+    Host_TaskSetStackFree(mind, 1500);
+    Host_TaskSetStackFree(s_Rx, 2000);          // 高水位只会下降，关注表保留更低值
+    Host_TaskAddRunTime(s_Idle0, 4000000);
+    Host_TaskAddRunTime(s_Idle1, 4600000);
+    Host_TaskAddRunTime(s_Core, 300000);
+    Host_TaskAddRunTime(s_Rx, 100000);
+    Host_TaskAddRunTime(mind, 1000000);
+    Svc_Diag_Sample(&s_Snap);
+
+    TEST_EQ(s_Snap.uptime_s, 15);
+#if HAS_TASKS
+    TEST_EQ(s_Snap.task_num, 5);
+    TEST_CHECK(_Find("ASR_Task") == NULL);
+    TEST_EQ(s_Snap.watch_min[0], 1820);
+    TEST_EQ(s_Snap.watch_min[2], 900);
+    TEST_EQ(s_Snap.watch_min[3], 1500);
+#if HAS_CPU
+    TEST_EQ(s_Snap.window_ms, 5000);
+    TEST_EQ(_Find("IDLE1")->cpu_permille, 460);
+    TEST_EQ(_Find("IDLE0")->cpu_permille, 400);
+    TEST_EQ(_Find("LampMind_Task")->cpu_permille, 100);
+    TEST_EQ(_Find("Svc_Core")->cpu_permille, 30);
+    TEST_EQ(_Find("stm32_rx")->cpu_permille, 10);
+    // 各任务之和约为 1000
+    {
+        int sum = 0;
+        for (uint16_t i = 0; i < s_Snap.task_count; i++) sum += s_Snap.tasks[i].cpu_permille;
+        TEST_EQ(sum, 1000);
+    }
+#endif
+#endif
+}
+
+static void test_encode(void)
+{
+    char expect[DIAG_JSON_MAX];
+    size_t n;
+
+    n = Svc_Diag_Encode(&s_Snap, s_Buf, sizeof(s_Buf));
+    TEST_EQ(n, strlen(s_Buf));
+
+    // 碎片率 = 100 - 最大块/剩余；未接 PSRAM 时不输出 psram
+#if HAS_CPU
+    snprintf(expect, sizeof(expect),
+             "{\"up\":15,\"win\":5000,\"heap\":[120000,90000,60000,50],\"evq\":[3,17,32,2],"
+             "\"uart\":{\"ovf\":1,\"full\":2,\"frame\":3,\"parity\":4,\"brk\":5,\"long\":6,\"bad\":7},"
+             "\"watch\":{\"stm32_rx\":1820,\"Svc_Core\":2040,\"ASR_Task\":900,\"LampMind_Task\":1500},"
+             "\"tasks\":[[\"IDLE1\",460,1024],[\"IDLE0\",400,1024],[\"LampMind_Task\",100,1500],"
+             "[\"Svc_Core\",30,2040],[\"stm32_rx\",10,2000]],\"more\":0}");
+    TEST_CHECK(strcmp(s_Buf, expect) == 0);
+#elif HAS_TASKS
+    TEST_CHECK(strstr(s_Buf, "{\"up\":15,\"win\":0,") == s_Buf);
+    TEST_CHECK(strstr(s_Buf, "[\"IDLE0\",-1,1024]") != NULL);
+#else
+    snprintf(expect, sizeof(expect),
+             "{\"up\":15,\"win\":0,\"heap\":[120000,90000,60000,50],\"evq\":[3,17,32,2],"
+             "\"uart\":{\"ovf\":1,\"full\":2,\"frame\":3,\"parity\":4,\"brk\":5,\"long\":6,\"bad\":7}}");
+    TEST_CHECK(strcmp(s_Buf, expect) == 0);
+#endif
+    (void)expect;
+
+    // 缓冲区不足以放下结尾预留时不输出
+    TEST_EQ(Svc_Diag_Encode(&s_Snap, s_Buf, 20), 0);
+}
+
+// 放不下的任务计入 more，输出仍是完整的 JSON
+static void test_encode_truncated(void)
+{
+#if HAS_TASKS
+    char full[DIAG_JSON_MAX];
+    size_t n_full, n, cut;
+    const char *more, *p;
+    unsigned rest = 0;
+    char tail[24];
+
+    n_full = Svc_Diag_Encode(&s_Snap, full, sizeof(full));
+    cut = (size_t)(strstr(full, "[\"Svc_Core\"") - full);
+    for (p = full + cut; (p = strstr(p, "[\"")) != NULL; p++) rest++;
+    n = Svc_Diag_Encode(&s_Snap, s_Buf, cut + 20);
+    TEST_CHECK(n > 0 && n < n_full);
+    TEST_EQ(s_Buf[n - 1], '}');
+    TEST_CHECK(strncmp(s_Buf, full, cut - 1) == 0);
+    more = strstr(s_Buf, "],\"more\":");
+    TEST_CHECK(more != NULL);
+    snprintf(tail, sizeof(tail), "],\"more\":%u}", rest);
+    if (more) TEST_CHECK(strcmp(more, tail) == 0);
+#endif
+}
+
+// 任务名中的引号与反斜杠替换为下划线；接 PSRAM 时输出 psram
+static void test_escape_and_psram(void)
+{
+    _Create("a\"b\\c", 1024);
+    Host_SetHeap(MALLOC_CAP_SPIRAM, 4194304, 4000000, 3900000, 3800000);
+    Svc_Diag_Sample(&s_Snap);
+    Svc_Diag_Encode(&s_Snap, s_Buf, sizeof(s_Buf));
+
+    TEST_CHECK(strstr(s_Buf, ",\"psram\":[4000000,3900000,3800000,5],") != NULL);
+#if HAS_TASKS
+    TEST_CHECK(strstr(s_Buf, "[\"a_b_c\",") != NULL);
+#endif
+}
+
+int main(void)
+{
+    test_first_sample();
+    test_second_window();
+    test_encode();
+    test_encode_truncated();
+    test_escape_and_psram();
+    TEST_DONE();
+}
@@ -0,0 +1,94 @@
+/**
+ * @file    data_history.h
+ * @brief   环境与灯光状态的历史记录 (多分辨率环形存储)
+ * @note    1. 每 DH_SAMPLE_PERIOD_S 秒从数据中心采样一次，按分钟求平均写入分钟环
+ *             (保留 24 小时)，分钟记录再按小时汇总为 min/max/avg 写入小时环 (保留 30 天)。
+ *          2. 记录不含时间戳：槽位由绝对分钟/小时号取模决定，读取时由起始时间与
+ *             步长推算每条记录的时间；没有数据的时段以 valid/minutes 为 0 的空记录占位。
+ *          3. 记录使用系统时间 (SNTP 同步后的 UNIX 秒)，时间未同步前不记录。
+ *          4. 所有接口线程安全。
+ *          5. [修改] 采样由独立的低优先级任务完成 (原为软件定时器，回调中等待互斥锁会阻塞
+ *             定时器服务任务)，采样数据经 DataHistory_AddSample 写入，主机测试也直接调用它。
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "data_center.h"
+
+// ============================================================
+// 1. 配置
+// ============================================================
+
+#define DH_SAMPLE_PERIOD_S      10      /*!< 采样周期 (秒) */
+#define DH_MINUTE_SLOTS         1440    /*!< 分钟环容量 (24 小时) */
+#define DH_HOUR_SLOTS           720     /*!< 小时环容量 (30 天) */
+
+// ============================================================
+// 2. 记录格式 (紧凑存储，也是 MQTT 历史应答的线上格式，小端)
+// ============================================================
+
+typedef enum {
+    DH_RES_MINUTE = 0,      /*!< 分钟平均 */
+    DH_RES_HOUR   = 1       /*!< 小时 min/max/avg */
+} DH_Resolution_t;
+
+/** @brief 分钟记录 (8 字节) */
+typedef struct __attribute__((packed)) {
+    int8_t   temp;          /*!< 温度均值 (摄氏度) */
+    uint8_t  hum;           /*!< 湿度均值 (%) */
+    uint16_t lux;           /*!< 光照均值 (0-1000) */
+    uint8_t  brightness;    /*!< 亮度均值 (%)，关灯时计 0 */
+    uint8_t  color_temp;    /*!< 色温均值 (%) */
+    uint8_t  on_pct;        /*!< 开灯时间占比 (%) */
+    uint8_t  valid;         /*!< 本分钟的采样数，0 表示无数据 */
+} DH_MinuteRec_t;
+
+/** @brief 小时记录 (16 字节) */
+typedef struct __attribute__((packed)) {
+    int8_t   temp_min, temp_max, temp_avg;
+    uint8_t  hum_min, hum_max, hum_avg;
+    uint16_t lux_min, lux_max, lux_avg;
+    uint8_t  brightness_avg;
+    uint8_t  color_temp_avg;
+    uint8_t  on_pct;
+    uint8_t  minutes;       /*!< 参与汇总的有效分钟数，0 表示无数据 */
+} DH_HourRec_t;
+
+// ============================================================
+// 3. 接口
+// ============================================================
+
+/**
+ * @brief 初始化历史记录并启动周期采样 (需在 DataCenter_Init 之后调用)
+ */
+void DataHistory_Init(void);
+
+/**
+ * @brief 写入一次采样 (采样任务调用；时间未同步 (早于 2020 年) 时忽略)
+ * @param now   UNIX 秒
+ */
+void DataHistory_AddSample(uint32_t now, const DC_LightingData_t *light, const DC_EnvData_t *env);
+
+/**
+ * @brief 计算某分辨率下 [from, to] 区间内实际可读的范围
+ * @param from/to   UNIX 秒，to 为 0 表示到最新
+ * @param first_ts  [out] 第一条记录对应时段的起始时间
+ * @return 记录条数 (含空记录)，0 表示区间内没有保留的数据
+ */
+uint32_t DataHistory_Range(DH_Resolution_t res, uint32_t from, uint32_t to, uint32_t *first_ts);
+
+/**
+ * @brief 从 *start_ts 开始按时间顺序拷贝最多 max_recs 条记录
+ * @param start_ts  [in/out] 起始时段；若该时段已被新数据挤出，返回时改为实际读取的起点
+ * @param out       DH_MinuteRec_t 或 DH_HourRec_t 数组
+ * @return 实际拷贝的条数
+ */
+uint32_t DataHistory_Read(DH_Resolution_t res, uint32_t *start_ts, void *out, uint32_t max_recs);
+
+/**
+ * @brief 记录大小与时间步长 (秒)
+ */
+size_t   DataHistory_RecordSize(DH_Resolution_t res);
+uint32_t DataHistory_StepSeconds(DH_Resolution_t res);
@@ -45,7 +45,10 @@ typedef enum {
     EVT_DATA_LIGHT_CHANGED = 0x600, // 灯光数据已更新
     EVT_DATA_ENV_CHANGED,           // 环境数据已更新 (温湿度/天气)
     EVT_DATA_TIMER_CHANGED,         // 定时器数据已更新
-    EVT_DATA_SYS_CHANGED            // 系统状态已更新
+    EVT_DATA_SYS_CHANGED,           // 系统状态已更新
+
+    // 7. 诊断事件 [新增]
+    EVT_TRACE_DONE = 0x700          // 面板发起的延迟追踪已收到 STM32 回执 (参数: tid)
 } EventType_t;
 
 // --- 事件结构体 ---
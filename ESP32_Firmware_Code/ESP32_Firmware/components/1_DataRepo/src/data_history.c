@@ -0,0 +1,265 @@
+#include "data_history.h"
+#include "data_center.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "app_config.h" // 引入调试宏
+#include <string.h>
+#include <time.h>
+
+static const char *TAG = "DataHistory";
+
+// 早于 2020-01-01 的系统时间视为尚未同步
+#define DH_TIME_VALID_MIN   1577836800UL
+
+// 采样任务 (最低业务优先级：只读数据中心并累加，错过一个周期不影响分钟平均)
+#define DH_TASK_STACK       2048
+#define DH_TASK_PRIORITY    1
+
+// ============================================================
+// 环形存储 (分钟环与小时环共用)
+// ============================================================
+
+typedef struct {
+    uint8_t  *slots;
+    size_t   rec_size;
+    uint32_t capacity;
+    uint32_t step;          // 每个槽位代表的秒数
+    uint32_t newest;        // 最新记录的绝对槽号 (时间 / step)
+    uint32_t count;         // 已保留的槽数 (含空记录)
+} DH_Ring_t;
+
+static DH_MinuteRec_t s_MinuteSlots[DH_MINUTE_SLOTS];
+static DH_HourRec_t   s_HourSlots[DH_HOUR_SLOTS];
+
+static DH_Ring_t s_Rings[2] = {
+    [DH_RES_MINUTE] = { (uint8_t *)s_MinuteSlots, sizeof(DH_MinuteRec_t), DH_MINUTE_SLOTS, 60,   0, 0 },
+    [DH_RES_HOUR]   = { (uint8_t *)s_HourSlots,   sizeof(DH_HourRec_t),   DH_HOUR_SLOTS,   3600, 0, 0 },
+};
+
+static uint8_t *_slot(DH_Ring_t *ring, uint32_t idx) {
+    return ring->slots + (idx % ring->capacity) * ring->rec_size;
+}
+
+/**
+ * @brief 写入绝对槽号 idx 的记录，中间跳过的时段清零为空记录
+ */
+static void _ring_commit(DH_Ring_t *ring, uint32_t idx, const void *rec) {
+    if (ring->count == 0) {
+        ring->count = 1;
+    } else if (idx <= ring->newest) {
+        // 时间回拨：仍在保留范围内则覆盖，否则丢弃
+        if (ring->newest - idx >= ring->count) return;
+        memcpy(_slot(ring, idx), rec, ring->rec_size);
+        return;
+    } else {
+        uint32_t gap = idx - ring->newest;
+        if (gap >= ring->capacity) {
+            ring->count = 1;
+        } else {
+            for (uint32_t i = ring->newest + 1; i < idx; i++) {
+                memset(_slot(ring, i), 0, ring->rec_size);
+            }
+            ring->count = (ring->count + gap > ring->capacity) ? ring->capacity : ring->count + gap;
+        }
+    }
+    ring->newest = idx;
+    memcpy(_slot(ring, idx), rec, ring->rec_size);
+}
+
+// ============================================================
+// 分钟 / 小时汇总
+// ============================================================
+
+typedef struct {
+    uint32_t minute;
+    uint32_t n;
+    int32_t  temp;
+    uint32_t hum, lux, bri, cct, on;
+} DH_MinuteAcc_t;
+
+typedef struct {
+    uint32_t hour;
+    uint32_t minutes;
+    int8_t   temp_min, temp_max;
+    uint8_t  hum_min, hum_max;
+    uint16_t lux_min, lux_max;
+    int32_t  temp;
+    uint32_t hum, lux, bri, cct, on;
+} DH_HourAcc_t;
+
+static DH_MinuteAcc_t    s_MinAcc;
+static DH_HourAcc_t      s_HourAcc;
+static SemaphoreHandle_t s_Mutex = NULL;
+static TaskHandle_t      s_Task = NULL;
+
+// 四舍五入的整数平均 (支持负数)
+static int32_t _avg(int32_t sum, uint32_t n) {
+    int32_t half = (int32_t)(n / 2);
+    return (sum >= 0 ? sum + half : sum - half) / (int32_t)n;
+}
+
+static void _finish_hour(void) {
+    DH_HourAcc_t *a = &s_HourAcc;
+    DH_HourRec_t rec = {
+        .temp_min = a->temp_min, .temp_max = a->temp_max,
+        .temp_avg = (int8_t)_avg(a->temp, a->minutes),
+        .hum_min = a->hum_min, .hum_max = a->hum_max,
+        .hum_avg = (uint8_t)_avg((int32_t)a->hum, a->minutes),
+        .lux_min = a->lux_min, .lux_max = a->lux_max,
+        .lux_avg = (uint16_t)_avg((int32_t)a->lux, a->minutes),
+        .brightness_avg = (uint8_t)_avg((int32_t)a->bri, a->minutes),
+        .color_temp_avg = (uint8_t)_avg((int32_t)a->cct, a->minutes),
+        .on_pct = (uint8_t)_avg((int32_t)a->on, a->minutes),
+        .minutes = (uint8_t)a->minutes,
+    };
+    _ring_commit(&s_Rings[DH_RES_HOUR], a->hour, &rec);
+    a->minutes = 0;
+}
+
+// 分钟记录并入小时汇总，跨小时时先结算上一小时
+static void _hour_add(uint32_t hour, const DH_MinuteRec_t *m) {
+    DH_HourAcc_t *a = &s_HourAcc;
+    if (a->minutes && hour != a->hour) _finish_hour();
+
+    if (a->minutes == 0) {
+        memset(a, 0, sizeof(*a));
+        a->hour = hour;
+        a->temp_min = a->temp_max = m->temp;
+        a->hum_min = a->hum_max = m->hum;
+        a->lux_min = a->lux_max = m->lux;
+    }
+    if (m->temp < a->temp_min) a->temp_min = m->temp;
+    if (m->temp > a->temp_max) a->temp_max = m->temp;
+    if (m->hum < a->hum_min) a->hum_min = m->hum;
+    if (m->hum > a->hum_max) a->hum_max = m->hum;
+    if (m->lux < a->lux_min) a->lux_min = m->lux;
+    if (m->lux > a->lux_max) a->lux_max = m->lux;
+    a->temp += m->temp;
+    a->hum += m->hum;
+    a->lux += m->lux;
+    a->bri += m->brightness;
+    a->cct += m->color_temp;
+    a->on += m->on_pct;
+    a->minutes++;
+}
+
+static void _finish_minute(void) {
+    DH_MinuteAcc_t *a = &s_MinAcc;
+    DH_MinuteRec_t rec = {
+        .temp = (int8_t)_avg(a->temp, a->n),
+        .hum = (uint8_t)_avg((int32_t)a->hum, a->n),
+        .lux = (uint16_t)_avg((int32_t)a->lux, a->n),
+        .brightness = (uint8_t)_avg((int32_t)a->bri, a->n),
+        .color_temp = (uint8_t)_avg((int32_t)a->cct, a->n),
+        .on_pct = (uint8_t)_avg((int32_t)(a->on * 100), a->n),
+        .valid = (uint8_t)a->n,
+    };
+    _ring_commit(&s_Rings[DH_RES_MINUTE], a->minute, &rec);
+    _hour_add(a->minute / 60, &rec);
+    a->n = 0;
+}
+
+/**
+ * @brief 采样任务：周期读取数据中心
+ * @note  [修改] 原为软件定时器回调。数据中心与本模块的互斥锁都可能阻塞，
+ *        放在定时器服务任务中会拖住其它定时器，因此改为独立的低优先级任务
+ */
+static void _sample_task(void *arg) {
+    (void)arg;
+    TickType_t last = xTaskGetTickCount();
+
+    for (;;) {
+        vTaskDelayUntil(&last, pdMS_TO_TICKS(DH_SAMPLE_PERIOD_S * 1000));
+
+        DC_LightingData_t light;
+        DC_EnvData_t env;
+        DataCenter_Get_Lighting(&light);
+        DataCenter_Get_Env(&env);
+        DataHistory_AddSample((uint32_t)time(NULL), &light, &env);
+    }
+}
+
+// ============================================================
+// 接口实现
+// ============================================================
+
+void DataHistory_Init(void) {
+    if (s_Mutex == NULL) {
+        s_Mutex = xSemaphoreCreateMutex();
+    }
+    if (s_Task == NULL) {
+        xTaskCreate(_sample_task, "DH_Sample", DH_TASK_STACK, NULL, DH_TASK_PRIORITY, &s_Task);
+    }
+    APP_LOGI(TAG, "History: %u min + %u hour slots, %u bytes",
+             DH_MINUTE_SLOTS, DH_HOUR_SLOTS,
+             (unsigned)(sizeof(s_MinuteSlots) + sizeof(s_HourSlots)));
+}
+
+void DataHistory_AddSample(uint32_t now, const DC_LightingData_t *light, const DC_EnvData_t *env) {
+    if (now < DH_TIME_VALID_MIN) return;
+    uint32_t minute = now / 60;
+
+    xSemaphoreTake(s_Mutex, portMAX_DELAY);
+    DH_MinuteAcc_t *a = &s_MinAcc;
+    if (a->n && minute != a->minute) _finish_minute();
+    if (a->n == 0) {
+        memset(a, 0, sizeof(*a));
+        a->minute = minute;
+    }
+    a->temp += env->indoor_temp;
+    a->hum += env->indoor_hum;
+    a->lux += env->indoor_lux;
+    a->bri += light->power ? light->brightness : 0;
+    a->cct += light->color_temp;
+    a->on += light->power ? 1 : 0;
+    a->n++;
+    xSemaphoreGive(s_Mutex);
+}
+
+uint32_t DataHistory_Range(DH_Resolution_t res, uint32_t from, uint32_t to, uint32_t *first_ts) {
+    DH_Ring_t *ring = &s_Rings[res];
+    uint32_t n = 0;
+
+    xSemaphoreTake(s_Mutex, portMAX_DELAY);
+    if (ring->count) {
+        uint32_t oldest = ring->newest - ring->count + 1;
+        uint32_t f = from / ring->step;
+        uint32_t t = (to == 0) ? ring->newest : to / ring->step;
+        if (f < oldest) f = oldest;
+        if (t > ring->newest) t = ring->newest;
+        if (f <= t) {
+            n = t - f + 1;
+            if (first_ts) *first_ts = f * ring->step;
+        }
+    }
+    xSemaphoreGive(s_Mutex);
+    return n;
+}
+
+uint32_t DataHistory_Read(DH_Resolution_t res, uint32_t *start_ts, void *out, uint32_t max_recs) {
+    DH_Ring_t *ring = &s_Rings[res];
+    uint8_t *dst = (uint8_t *)out;
+    uint32_t n = 0;
+
+    xSemaphoreTake(s_Mutex, portMAX_DELAY);
+    if (ring->count) {
+        uint32_t oldest = ring->newest - ring->count + 1;
+        uint32_t idx = *start_ts / ring->step;
+        if (idx < oldest) idx = oldest;
+        *start_ts = idx * ring->step;
+        for (; idx <= ring->newest && n < max_recs; idx++, n++) {
+            memcpy(dst + n * ring->rec_size, _slot(ring, idx), ring->rec_size);
+        }
+    }
+    xSemaphoreGive(s_Mutex);
+    return n;
+}
+
+size_t DataHistory_RecordSize(DH_Resolution_t res) {
+    return s_Rings[res].rec_size;
+}
+
+uint32_t DataHistory_StepSeconds(DH_Resolution_t res) {
+    return s_Rings[res].step;
+}
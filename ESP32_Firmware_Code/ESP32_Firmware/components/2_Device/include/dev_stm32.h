@@ -18,3 +18,22 @@ void Dev_STM32_Set_Light(uint16_t warm, uint16_t cold);
  * @param mode 0: Local 模式, 1: Remote UI 模式
  */
 void Dev_STM32_Set_Mode(uint8_t mode);
+
+/**
+ * @brief [新增] 串口接收统计 (上电累计)
+ */
+typedef struct {
+    uint32_t rx_lines;      // 收到的完整行数
+    uint32_t fifo_ovf;      // 硬件 FIFO 溢出
+    uint32_t buf_full;      // 驱动环形缓冲区满
+    uint32_t frame_err;     // 帧错误
+    uint32_t parity_err;    // 校验错误
+    uint32_t brk;           // 线路 break
+    uint32_t line_ovf;      // 超长行 (被截断)
+    uint32_t bad_json;      // 无法解析的行
+} Dev_STM32_Stats_t;
+
+/**
+ * @brief [新增] 读取串口接收统计
+ */
+void Dev_STM32_GetStats(Dev_STM32_Stats_t *stats);
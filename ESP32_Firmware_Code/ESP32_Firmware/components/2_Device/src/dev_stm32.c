@@ -4,6 +4,8 @@
 #include "esp_log.h"
 #include "cJSON.h"
 #include "data_center.h"
+#include "event_bus.h"
+#include "latency_trace.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include <string.h>
@@ -18,6 +20,10 @@ static const char *TAG = "Dev_STM32";
 // [新增] 串口发送互斥锁，保证多任务并发发送时 JSON 帧不被截断
 static SemaphoreHandle_t s_tx_mutex = NULL;
 
+// [新增] 驱动事件队列 (只用于统计线路错误，数据仍由接收任务直接读取) 与接收统计
+static QueueHandle_t s_uart_queue = NULL;
+static Dev_STM32_Stats_t s_stats = {0};
+
 // 发送原始 JSON 字符串 (自动追加 \r\n)
 static void _send_raw(const char *json_str) {
     if (!s_tx_mutex) return;
@@ -35,8 +41,16 @@ static void _send_raw(const char *json_str) {
 
 void Dev_STM32_Set_Light(uint16_t warm, uint16_t cold) {
     char buf[128];
-    snprintf(buf, sizeof(buf), "{\"cmd\":\"light\",\"warm\":%d,\"cold\":%d}", warm, cold);
+    // [新增] 面板指令正在追踪时附带 tid，STM32 执行后回执 {"ev":"trace"}
+    uint32_t tid = Trace_Pending(TRACE_ORIGIN_PANEL, TRACE_HOP_UART_TX);
+    if (tid) {
+        snprintf(buf, sizeof(buf), "{\"cmd\":\"light\",\"warm\":%d,\"cold\":%d,\"tid\":%lu}",
+                 warm, cold, (unsigned long)tid);
+    } else {
+        snprintf(buf, sizeof(buf), "{\"cmd\":\"light\",\"warm\":%d,\"cold\":%d}", warm, cold);
+    }
     _send_raw(buf);
+    Trace_Mark(tid, TRACE_HOP_UART_TX);
 }
 
 void Dev_STM32_Set_Mode(uint8_t mode) {
@@ -45,14 +59,31 @@ void Dev_STM32_Set_Mode(uint8_t mode) {
     _send_raw(buf);
 }
 
+// [新增] 统计驱动上报的线路错误 (数据事件直接丢弃)
+static void _drain_uart_events(void) {
+    uart_event_t uevt;
+    while (s_uart_queue && xQueueReceive(s_uart_queue, &uevt, 0) == pdTRUE) {
+        switch (uevt.type) {
+            case UART_FIFO_OVF:    s_stats.fifo_ovf++;   break;
+            case UART_BUFFER_FULL: s_stats.buf_full++;   break;
+            case UART_FRAME_ERR:   s_stats.frame_err++;  break;
+            case UART_PARITY_ERR:  s_stats.parity_err++; break;
+            case UART_BREAK:       s_stats.brk++;        break;
+            default: break;
+        }
+    }
+}
+
 // 串口接收任务
 static void stm32_rx_task(void *arg) {
     uint8_t *data = (uint8_t *) malloc(BUF_SIZE);
     char line_buf[512];
     int line_len = 0;
+    bool line_ovf = false;
 
     while (1) {
         int len = uart_read_bytes(UART_NUM, data, BUF_SIZE - 1, pdMS_TO_TICKS(20));
+        _drain_uart_events();
         if (len > 0) {
             for (int i = 0; i < len; i++) {
                 char c = (char)data[i];
@@ -60,6 +91,11 @@ static void stm32_rx_task(void *arg) {
                     if (line_len > 0) {
                         line_buf[line_len] = '\0';
                         ESP_LOGI(TAG, "[STM32_RX] %s", line_buf);
+                        s_stats.rx_lines++;
+                        if (line_ovf) {
+                            s_stats.line_ovf++;
+                            line_ovf = false;
+                        }
 
                         cJSON *json = cJSON_Parse(line_buf);
                         if (json) {
@@ -121,17 +157,45 @@ static void stm32_rx_task(void *arg) {
                                         light.color_temp = new_cct;
                                         light.power = (total_pwm > 0);
                                         
+                                        // [新增] 本地操作的追踪：在发布状态前开始，age 为 STM32 侧的耗时
+                                        cJSON *tid = cJSON_GetObjectItem(json, "tid");
+                                        cJSON *age = cJSON_GetObjectItem(json, "age");
+                                        if (cJSON_IsNumber(tid)) {
+                                            uint32_t tid_val = (uint32_t)tid->valuedouble;
+                                            Trace_Begin(tid_val, TRACE_ORIGIN_STM32, TRACE_HOP_UART_RX);
+                                            if (cJSON_IsNumber(age)) {
+                                                Trace_SetRemote(tid_val, (uint32_t)age->valuedouble * 1000);
+                                            }
+                                        }
+
                                         DataCenter_Set_Lighting(&light);
                                     }
                                 }
+                                // 3. [新增] 追踪回执：面板指令已在 STM32 上生效
+                                else if (strcmp(ev->valuestring, "trace") == 0) {
+                                    cJSON *tid = cJSON_GetObjectItem(json, "tid");
+                                    cJSON *us = cJSON_GetObjectItem(json, "us");
+                                    if (cJSON_IsNumber(tid)) {
+                                        uint32_t tid_val = (uint32_t)tid->valuedouble;
+                                        Trace_Mark(tid_val, TRACE_HOP_UART_RX);
+                                        if (cJSON_IsNumber(us)) {
+                                            Trace_SetRemote(tid_val, (uint32_t)us->valuedouble);
+                                        }
+                                        EventBus_Send(EVT_TRACE_DONE, (void *)(uintptr_t)tid_val, 0);
+                                    }
+                                }
                             }
                             cJSON_Delete(json);
+                        } else {
+                            s_stats.bad_json++;
                         }
                         line_len = 0;
                     }
                 } else {
                     if (line_len < sizeof(line_buf) - 1) {
                         line_buf[line_len++] = c;
+                    } else {
+                        line_ovf = true;
                     }
                 }
             }
@@ -156,7 +220,7 @@ void Dev_STM32_Init(void) {
         .source_clk = UART_SCLK_DEFAULT,
     };
     
-    ESP_ERROR_CHECK(uart_driver_install(UART_NUM, BUF_SIZE * 2, 0, 0, NULL, 0));
+    ESP_ERROR_CHECK(uart_driver_install(UART_NUM, BUF_SIZE * 2, 0, 16, &s_uart_queue, 0));
     ESP_ERROR_CHECK(uart_param_config(UART_NUM, &uart_config));
     ESP_ERROR_CHECK(uart_set_pin(UART_NUM, TX_PIN, RX_PIN, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE));
 
@@ -166,3 +230,8 @@ void Dev_STM32_Init(void) {
     // 启动时强制让 STM32 进入 Remote UI 模式
     Dev_STM32_Set_Mode(1); 
 }
+
+void Dev_STM32_GetStats(Dev_STM32_Stats_t *stats) {
+    // 计数只由接收任务累加，32 位读取不会撕裂
+    *stats = s_stats;
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <stdbool.h>
+#include <stdint.h>
 
 /**
  * @brief 初始化并启动 MQTT 客户端
@@ -17,3 +18,16 @@ void Agent_MQTT_Stop(void);
  * @note  通常在数据中心发生变化时调用
  */
 void Agent_MQTT_Publish_Status(void);
+
+/**
+ * @brief [新增] 结束延迟追踪并发布到 MQTT_TOPIC_TRACE
+ * @param tid 追踪编号 (已被新追踪覆盖或超时则不发布)
+ */
+void Agent_MQTT_Publish_Trace(uint32_t tid);
+
+/**
+ * @brief [新增] 采样运行时诊断并发布到 MQTT_TOPIC_DIAG
+ * @note  未连接时仍采样 (保持 CPU 统计窗口与栈高水位连续)，只是不发布；
+ *        应固定在同一任务中周期调用
+ */
+void Agent_MQTT_Publish_Diag(void);
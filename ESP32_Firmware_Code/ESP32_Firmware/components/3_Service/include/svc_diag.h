@@ -0,0 +1,71 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @file    svc_diag.h
+ * @brief   [新增] 运行时诊断快照 (任务 CPU、栈高水位、堆、事件队列、串口错误)
+ * @note    1. 任务列表需开启 CONFIG_FREERTOS_USE_TRACE_FACILITY，CPU 占用另需
+ *             CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS (工程 sdkconfig.defaults 已开启)；
+ *             未开启时对应字段缺省。
+ *          2. CPU 占用为相邻两次采样之间占全部核心时间的千分比 (首次采样为上电以来)，
+ *             各任务之和 (含 IDLE) 约为 1000。
+ *          3. 栈高水位单位为字节 (ESP-IDF 中栈以字节计)。
+ *          4. 采样只依赖 FreeRTOS 任务接口、heap_caps、EventBus_GetStats 与 Dev_STM32_GetStats，
+ *             编码只依赖采样结果，可在主机上配合这些接口的替身单独编译
+ *             (HostSim/tests/test_svc_diag.c，三种配置各编译一份)。
+ *          5. 非线程安全，应固定在同一任务中周期调用。
+ */
+
+#define DIAG_MAX_TASKS          32      /*!< 任务数超过时本次不输出任务列表 */
+#define DIAG_JSON_MAX           1024    /*!< 编码缓冲区建议大小 */
+#define DIAG_WATCH_NUM          4       /*!< 关注栈余量的任务数，名称见 svc_diag.c */
+
+typedef struct {
+    char     name[16];
+    int16_t  cpu_permille;      // -1 表示未知
+    uint32_t stack_free;        // 栈高水位 (字节)
+} Diag_Task_t;
+
+typedef struct {
+    uint32_t free;
+    uint32_t min_free;          // 上电以来最低剩余
+    uint32_t largest;           // 最大连续空闲块
+} Diag_Heap_t;
+
+typedef struct {
+    uint32_t    uptime_s;
+    uint32_t    window_ms;      // CPU 统计窗口，0 表示未开启运行时统计
+
+    uint16_t    task_num;       // 实际任务数
+    uint16_t    task_count;     // tasks[] 有效条数 (按 CPU 降序)
+    Diag_Task_t tasks[DIAG_MAX_TASKS];
+
+    int32_t     watch_min[DIAG_WATCH_NUM];  // 关注任务的最低栈余量 (上电以来，-1 表示从未出现)
+
+    Diag_Heap_t heap;           // 内部 RAM
+    Diag_Heap_t psram;          // 未接 PSRAM 时全部为 0
+
+    uint32_t    evq_depth, evq_peak, evq_cap, evq_drops;
+    uint32_t    uart_ovf, uart_full, uart_frame, uart_parity, uart_brk;
+    uint32_t    uart_long, uart_bad;
+} Diag_Snapshot_t;
+
+/**
+ * @brief 采样一次
+ */
+void Svc_Diag_Sample(Diag_Snapshot_t *snap);
+
+/**
+ * @brief 编码为紧凑 JSON
+ * @return 写入长度 (不含结尾 0)，0 表示缓冲区不足
+ * @note   格式示例:
+ *         {"up":600,"win":10000,
+ *          "heap":[free,min,largest,frag%],"psram":[...],
+ *          "evq":[depth,peak,cap,drops],
+ *          "uart":{"ovf":0,"full":0,"frame":0,"parity":0,"brk":0,"long":0,"bad":0},
+ *          "watch":{"stm32_rx":1820,"Svc_Core":2040,"ASR_Task":-1,"LampMind_Task":-1},
+ *          "tasks":[["IDLE1",962,832],["Svc_Core",3,2040],...],"more":0}
+ *         tasks 每项为 [名称, CPU‰(-1 未知), 栈余量]；缓冲区放不下的任务计入 more
+ */
+size_t Svc_Diag_Encode(const Diag_Snapshot_t *snap, char *buf, size_t len);
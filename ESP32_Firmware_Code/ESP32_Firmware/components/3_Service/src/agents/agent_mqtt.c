@@ -3,12 +3,20 @@
 #include "esp_log.h"
 #include "cJSON.h"
 #include "data_center.h"
+#include "data_history.h"
+#include "latency_trace.h"
+#include "svc_diag.h"
 #include "app_config.h"
 
 static const char *TAG = "Agent_MQTT";
 static esp_mqtt_client_handle_t s_client = NULL;
 static bool s_is_connected = false;
 
+// [新增] 控制指令序号 (面板拖动滑块时连续发送，用于丢弃乱序到达的旧指令)
+static bool     s_seq_valid = false;
+static uint32_t s_last_sid = 0;     // 发送方会话ID (面板每次启动随机生成)
+static uint16_t s_last_seq = 0;     // 最近一次应用的序号
+
 // ============================================================
 // 内部逻辑：处理收到的控制指令
 // ============================================================
@@ -16,6 +24,8 @@ static bool s_is_connected = false;
 /**
  * @brief 解析来自 Python 的 JSON 指令
  * 格式示例: {"power":1, "brightness":80, "color_temp":20}
+ * 可选字段: "sid" 会话ID, "seq" 16位序号。同一会话中序号不比上一条新的指令直接丢弃
+ *           "tid" 追踪编号，指令在 STM32 上生效后发布 MQTT_TOPIC_TRACE
  */
 static void _handle_ctrl_msg(const char *data, int len) {
     // 1. 解析 JSON
@@ -25,6 +35,30 @@ static void _handle_ctrl_msg(const char *data, int len) {
         return;
     }
 
+    // 1.1 [新增] 序号检查 (不带 seq 的指令不受影响)
+    cJSON *seq = cJSON_GetObjectItem(json, "seq");
+    if (cJSON_IsNumber(seq)) {
+        cJSON *sid = cJSON_GetObjectItem(json, "sid");
+        uint32_t sid_val = cJSON_IsNumber(sid) ? (uint32_t)sid->valueint : 0;
+        uint16_t seq_val = (uint16_t)seq->valueint;
+
+        // 16 位回绕比较：差值为负或为 0 表示旧指令 / 重复指令
+        if (s_seq_valid && sid_val == s_last_sid && (int16_t)(seq_val - s_last_seq) <= 0) {
+            ESP_LOGW(TAG, "Drop stale ctrl: seq=%u last=%u", seq_val, s_last_seq);
+            cJSON_Delete(json);
+            return;
+        }
+        s_last_sid = sid_val;
+        s_last_seq = seq_val;
+        s_seq_valid = true;
+    }
+
+    // 1.2 [新增] 延迟追踪 (需在写数据中心之前开始，下发串口时才能带上 tid)
+    cJSON *tid = cJSON_GetObjectItem(json, "tid");
+    if (cJSON_IsNumber(tid)) {
+        Trace_Begin((uint32_t)tid->valuedouble, TRACE_ORIGIN_PANEL, TRACE_HOP_MQTT_RX);
+    }
+
     // 2. 获取当前数据中心的状态作为基础 (避免覆盖未修改的字段)
     DC_LightingData_t light_data;
     DataCenter_Get_Lighting(&light_data);
@@ -63,6 +97,90 @@ static void _handle_ctrl_msg(const char *data, int len) {
     cJSON_Delete(json);
 }
 
+// ============================================================
+// [新增] 历史数据请求
+// ============================================================
+
+/**
+ * @brief 历史应答分块头 (16 字节，小端)
+ * @note  每块后紧跟 count 条 DH_MinuteRec_t / DH_HourRec_t 记录。
+ *        第 i 条记录的时段起点为 first_ts + i * 步长 (分钟 60s / 小时 3600s)。
+ *        区间内没有数据时只发一块，chunks = 1, count = 0。
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t  magic;         // 'H'
+    uint8_t  version;       // 1
+    uint8_t  res;           // DH_Resolution_t
+    uint8_t  rec_size;      // 单条记录字节数
+    uint16_t req_id;        // 原样返回请求中的 id
+    uint16_t chunk;         // 本块序号 (从 0 开始)
+    uint16_t chunks;        // 总块数
+    uint16_t count;         // 本块记录数
+    uint32_t first_ts;      // 本块第一条记录的时段起点 (UNIX 秒)
+} HistoryChunkHdr_t;
+
+#define HISTORY_CHUNK_RECS      128
+
+static uint8_t s_history_buf[sizeof(HistoryChunkHdr_t) + HISTORY_CHUNK_RECS * sizeof(DH_HourRec_t)];
+
+/**
+ * @brief 处理历史请求，按块发布二进制应答
+ * 格式示例: {"res":"min", "from":1767225600, "to":0, "id":7}  (to 为 0 表示到最新)
+ */
+static void _handle_history_req(const char *data, int len) {
+    cJSON *json = cJSON_ParseWithLength(data, len);
+    if (!json) {
+        ESP_LOGE(TAG, "History Req Parse Failed");
+        return;
+    }
+
+    cJSON *res_item = cJSON_GetObjectItem(json, "res");
+    cJSON *from_item = cJSON_GetObjectItem(json, "from");
+    cJSON *to_item = cJSON_GetObjectItem(json, "to");
+    cJSON *id_item = cJSON_GetObjectItem(json, "id");
+
+    DH_Resolution_t res = (cJSON_IsString(res_item) && strcmp(res_item->valuestring, "hour") == 0)
+                          ? DH_RES_HOUR : DH_RES_MINUTE;
+    uint32_t from = cJSON_IsNumber(from_item) ? (uint32_t)from_item->valuedouble : 0;
+    uint32_t to = cJSON_IsNumber(to_item) ? (uint32_t)to_item->valuedouble : 0;
+    uint16_t req_id = cJSON_IsNumber(id_item) ? (uint16_t)id_item->valueint : 0;
+    cJSON_Delete(json);
+
+    uint32_t first_ts = 0;
+    uint32_t total = DataHistory_Range(res, from, to, &first_ts);
+    uint32_t step = DataHistory_StepSeconds(res);
+    size_t rec_size = DataHistory_RecordSize(res);
+    uint16_t chunks = (total == 0) ? 1 : (uint16_t)((total + HISTORY_CHUNK_RECS - 1) / HISTORY_CHUNK_RECS);
+
+    HistoryChunkHdr_t *hdr = (HistoryChunkHdr_t *)s_history_buf;
+    uint32_t sent = 0;
+    for (uint16_t c = 0; c < chunks; c++) {
+        uint32_t want = total - sent;
+        if (want > HISTORY_CHUNK_RECS) want = HISTORY_CHUNK_RECS;
+        uint32_t ts = first_ts + sent * step;
+        uint32_t got = (want > 0)
+                       ? DataHistory_Read(res, &ts, s_history_buf + sizeof(*hdr), want) : 0;
+
+        hdr->magic = 'H';
+        hdr->version = 1;
+        hdr->res = (uint8_t)res;
+        hdr->rec_size = (uint8_t)rec_size;
+        hdr->req_id = req_id;
+        hdr->chunk = c;
+        hdr->chunks = chunks;
+        hdr->count = (uint16_t)got;
+        hdr->first_ts = ts;
+
+        // enqueue 拷贝数据后立即返回，不阻塞 MQTT 任务
+        esp_mqtt_client_enqueue(s_client, MQTT_TOPIC_HISTORY_RESP, (const char *)s_history_buf,
+                                (int)(sizeof(*hdr) + got * rec_size), 0, 0, true);
+        sent += got;
+    }
+
+    ESP_LOGI(TAG, "History Req id=%u res=%d: %lu recs in %u chunks",
+             req_id, res, (unsigned long)total, chunks);
+}
+
 // ============================================================
 // MQTT 事件回调
 // ============================================================
@@ -76,6 +194,7 @@ static void mqtt_event_handler(void *handler_args, esp_event_base_t base, int32_
             s_is_connected = true;
             // 连接成功后，订阅控制主题
             esp_mqtt_client_subscribe(s_client, MQTT_TOPIC_CTRL, 1);
+            esp_mqtt_client_subscribe(s_client, MQTT_TOPIC_HISTORY_REQ, 0);
             // 上线时主动上报一次当前状态
             Agent_MQTT_Publish_Status();
             break;
@@ -90,6 +209,8 @@ static void mqtt_event_handler(void *handler_args, esp_event_base_t base, int32_
             // 判断是否是控制主题
             if (strncmp(event->topic, MQTT_TOPIC_CTRL, event->topic_len) == 0) {
                 _handle_ctrl_msg(event->data, event->data_len);
+            } else if (strncmp(event->topic, MQTT_TOPIC_HISTORY_REQ, event->topic_len) == 0) {
+                _handle_history_req(event->data, event->data_len);
             }
             break;
 
@@ -148,6 +269,18 @@ void Agent_MQTT_Publish_Status(void) {
     // 环境数据 (如果有传感器)
     cJSON_AddNumberToObject(root, "temp", env.indoor_temp);
     cJSON_AddNumberToObject(root, "hum", env.indoor_hum);
+    cJSON_AddNumberToObject(root, "lux", env.indoor_lux); // [新增] 供面板记录光照历史
+
+    // [新增] 回显最近应用的指令序号，面板据此计算操作到回显的延迟
+    if (s_seq_valid) {
+        cJSON_AddNumberToObject(root, "ack_seq", s_last_seq);
+    }
+
+    // [新增] 本地操作引起的状态变化：附带 tid，面板据此关联滑块更新与追踪结果
+    uint32_t tid = Trace_Pending(TRACE_ORIGIN_STM32, TRACE_HOP_MQTT_TX);
+    if (tid) {
+        cJSON_AddNumberToObject(root, "tid", tid);
+    }
 
     // 3. 发送
     char *json_str = cJSON_PrintUnformatted(root);
@@ -158,4 +291,32 @@ void Agent_MQTT_Publish_Status(void) {
     }
     
     cJSON_Delete(root);
+
+    if (tid) {
+        Agent_MQTT_Publish_Trace(tid);
+    }
+}
+
+void Agent_MQTT_Publish_Trace(uint32_t tid) {
+    if (!s_client || !s_is_connected) return;
+
+    char buf[192];
+    size_t len = Trace_Finish(tid, buf, sizeof(buf));
+    if (len) {
+        esp_mqtt_client_publish(s_client, MQTT_TOPIC_TRACE, buf, (int)len, 0, 0);
+    }
+}
+
+void Agent_MQTT_Publish_Diag(void) {
+    // 快照约 1KB，使用静态缓冲区避免占用调用任务的栈
+    static Diag_Snapshot_t s_snap;
+    static char s_buf[DIAG_JSON_MAX];
+
+    Svc_Diag_Sample(&s_snap);
+    if (!s_client || !s_is_connected) return;
+
+    size_t len = Svc_Diag_Encode(&s_snap, s_buf, sizeof(s_buf));
+    if (len) {
+        esp_mqtt_client_publish(s_client, MQTT_TOPIC_DIAG, s_buf, (int)len, 0, 0);
+    }
 }
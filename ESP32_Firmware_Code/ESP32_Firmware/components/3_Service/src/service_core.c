@@ -126,6 +126,11 @@ void Service_Core_Task(void *pvParameters) {
                 Agent_MQTT_Publish_Status();
             }
 
+            // [场景2.1] 面板指令已在 STM32 上生效，发布延迟追踪结果
+            else if (evt.type == EVT_TRACE_DONE) {
+                Agent_MQTT_Publish_Trace((uint32_t)(uintptr_t)evt.data);
+            }
+
             // [场景3] 网络连接成功
             else if (evt.type == EVT_NET_CONNECTED) {
                 ESP_LOGI(TAG, "Global: Network Connected -> Start MQTT");
@@ -0,0 +1,265 @@
+#include "svc_diag.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_heap_caps.h"
+#include "event_bus.h"
+#include "dev_stm32.h"
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifndef portNUM_PROCESSORS
+#define portNUM_PROCESSORS      1
+#endif
+
+#define DIAG_HAS_TASKS          (configUSE_TRACE_FACILITY == 1)
+#define DIAG_HAS_CPU            (DIAG_HAS_TASKS && configGENERATE_RUN_TIME_STATS == 1)
+
+// 关注栈余量的任务 (ASR_Task / LampMind_Task 为临时任务，退出后保留最低值)
+static const char *const s_watch_names[DIAG_WATCH_NUM] = {
+    "stm32_rx", "Svc_Core", "ASR_Task", "LampMind_Task"
+};
+static int32_t s_watch_min[DIAG_WATCH_NUM] = { -1, -1, -1, -1 };
+
+#if DIAG_HAS_TASKS
+static TaskStatus_t s_status[DIAG_MAX_TASKS];
+
+// uxTaskGetSystemState 的总运行时间参数在未开启运行时统计时同样需要
+#ifdef configRUN_TIME_COUNTER_TYPE
+typedef configRUN_TIME_COUNTER_TYPE Diag_RunTime_t;
+#else
+typedef uint32_t Diag_RunTime_t;
+#endif
+#endif
+
+#if DIAG_HAS_CPU
+// 上次采样的各任务运行时间，按任务编号 (xTaskNumber，不复用) 匹配
+typedef struct {
+    UBaseType_t    id;
+    Diag_RunTime_t runtime;
+} Diag_PrevRun_t;
+
+static Diag_PrevRun_t s_prev[DIAG_MAX_TASKS];
+static UBaseType_t    s_prev_num = 0;
+static Diag_RunTime_t s_prev_total = 0;
+static TickType_t     s_prev_tick = 0;
+
+static Diag_RunTime_t _prev_runtime(UBaseType_t id) {
+    for (UBaseType_t i = 0; i < s_prev_num; i++) {
+        if (s_prev[i].id == id) return s_prev[i].runtime;
+    }
+    return 0; // 窗口内新建的任务
+}
+#endif
+
+// ============================================================
+// 采样
+// ============================================================
+
+static void _update_watch(const char *name, uint32_t stack_free) {
+    for (int i = 0; i < DIAG_WATCH_NUM; i++) {
+        if (strcmp(name, s_watch_names[i]) == 0) {
+            if (s_watch_min[i] < 0 || stack_free < (uint32_t)s_watch_min[i]) {
+                s_watch_min[i] = (int32_t)stack_free;
+            }
+            return;
+        }
+    }
+}
+
+// CPU 降序；CPU 未知或相同时栈余量少的在前
+static void _sort_tasks(Diag_Task_t *tasks, uint16_t n) {
+    for (uint16_t i = 1; i < n; i++) {
+        Diag_Task_t key = tasks[i];
+        int j = i - 1;
+        while (j >= 0 && (tasks[j].cpu_permille < key.cpu_permille ||
+                          (tasks[j].cpu_permille == key.cpu_permille &&
+                           tasks[j].stack_free > key.stack_free))) {
+            tasks[j + 1] = tasks[j];
+            j--;
+        }
+        tasks[j + 1] = key;
+    }
+}
+
+static void _sample_tasks(Diag_Snapshot_t *snap, TickType_t now) {
+#if DIAG_HAS_TASKS
+    Diag_RunTime_t total = 0;
+    UBaseType_t n;
+
+    snap->task_num = (uint16_t)uxTaskGetNumberOfTasks();
+    n = uxTaskGetSystemState(s_status, DIAG_MAX_TASKS, &total); // 数组不足时返回 0
+
+#if DIAG_HAS_CPU
+    uint64_t span = (uint64_t)(Diag_RunTime_t)(total - s_prev_total) * portNUM_PROCESSORS;
+#endif
+
+    for (UBaseType_t i = 0; i < n; i++) {
+        const TaskStatus_t *ts = &s_status[i];
+        Diag_Task_t *t = &snap->tasks[i];
+
+        strncpy(t->name, ts->pcTaskName, sizeof(t->name) - 1);
+        t->name[sizeof(t->name) - 1] = '\0';
+        for (char *c = t->name; *c; c++) {
+            if (*c == '"' || *c == '\\') *c = '_'; // 保证可直接写入 JSON
+        }
+        t->stack_free = ts->usStackHighWaterMark;
+        t->cpu_permille = -1;
+        _update_watch(t->name, t->stack_free);
+
+#if DIAG_HAS_CPU
+        if (span > 0) {
+            Diag_RunTime_t delta = ts->ulRunTimeCounter - _prev_runtime(ts->xTaskNumber);
+            uint64_t permille = (uint64_t)delta * 1000 / span;
+            t->cpu_permille = (int16_t)(permille > 1000 ? 1000 : permille);
+        }
+#endif
+    }
+    snap->task_count = (uint16_t)n;
+
+#if DIAG_HAS_CPU
+    if (n > 0) {
+        for (UBaseType_t i = 0; i < n; i++) {
+            s_prev[i].id = s_status[i].xTaskNumber;
+            s_prev[i].runtime = s_status[i].ulRunTimeCounter;
+        }
+        s_prev_num = n;
+        s_prev_total = total;
+        snap->window_ms = (uint32_t)((now - s_prev_tick) * portTICK_PERIOD_MS);
+        s_prev_tick = now;
+    }
+#else
+    (void)now;
+#endif
+
+    _sort_tasks(snap->tasks, snap->task_count);
+#else
+    (void)snap;
+    (void)now;
+#endif
+}
+
+static void _sample_heap(Diag_Heap_t *h, uint32_t caps) {
+    h->free = heap_caps_get_free_size(caps);
+    h->min_free = heap_caps_get_minimum_free_size(caps);
+    h->largest = heap_caps_get_largest_free_block(caps);
+}
+
+void Svc_Diag_Sample(Diag_Snapshot_t *snap) {
+    TickType_t now = xTaskGetTickCount();
+    EventBus_Stats_t evq;
+    Dev_STM32_Stats_t uart;
+
+    memset(snap, 0, sizeof(*snap));
+    snap->uptime_s = (uint32_t)((uint64_t)now * portTICK_PERIOD_MS / 1000);
+
+    _sample_tasks(snap, now);
+    memcpy(snap->watch_min, s_watch_min, sizeof(s_watch_min));
+
+    _sample_heap(&snap->heap, MALLOC_CAP_INTERNAL);
+    if (heap_caps_get_total_size(MALLOC_CAP_SPIRAM) > 0) {
+        _sample_heap(&snap->psram, MALLOC_CAP_SPIRAM);
+    }
+
+    EventBus_GetStats(&evq);
+    snap->evq_depth = evq.depth;
+    snap->evq_peak = evq.peak;
+    snap->evq_cap = evq.capacity;
+    snap->evq_drops = evq.drops;
+
+    Dev_STM32_GetStats(&uart);
+    snap->uart_ovf = uart.fifo_ovf;
+    snap->uart_full = uart.buf_full;
+    snap->uart_frame = uart.frame_err;
+    snap->uart_parity = uart.parity_err;
+    snap->uart_brk = uart.brk;
+    snap->uart_long = uart.line_ovf;
+    snap->uart_bad = uart.bad_json;
+}
+
+// ============================================================
+// 编码
+// ============================================================
+
+typedef struct {
+    char  *buf;
+    size_t len;     // 可写上限 (不含结尾 0)
+    size_t pos;
+    bool   ok;
+} Diag_Writer_t;
+
+// 写入失败时回退到写入前的位置
+static bool _put(Diag_Writer_t *w, const char *fmt, ...) {
+    if (!w->ok) return false;
+
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(w->buf + w->pos, w->len - w->pos + 1, fmt, args);
+    va_end(args);
+
+    if (n < 0 || (size_t)n > w->len - w->pos) {
+        w->buf[w->pos] = '\0';
+        return false;
+    }
+    w->pos += (size_t)n;
+    return true;
+}
+
+static void _put_heap(Diag_Writer_t *w, const char *key, const Diag_Heap_t *h) {
+    uint32_t frag = (h->free > 0) ? 100 - (uint32_t)((uint64_t)h->largest * 100 / h->free) : 0;
+    w->ok = _put(w, ",\"%s\":[%lu,%lu,%lu,%lu]", key, (unsigned long)h->free,
+                 (unsigned long)h->min_free, (unsigned long)h->largest, (unsigned long)frag);
+}
+
+size_t Svc_Diag_Encode(const Diag_Snapshot_t *snap, char *buf, size_t len) {
+    // 任务列表末尾 ],"more":N} 预留
+    const size_t tail = 20;
+
+    if (len <= tail) return 0;
+    Diag_Writer_t w = { buf, len - 1, 0, true };
+
+    w.ok = _put(&w, "{\"up\":%lu,\"win\":%lu", (unsigned long)snap->uptime_s,
+                (unsigned long)snap->window_ms);
+    _put_heap(&w, "heap", &snap->heap);
+    if (snap->psram.free || snap->psram.min_free) {
+        _put_heap(&w, "psram", &snap->psram);
+    }
+    w.ok = _put(&w, ",\"evq\":[%lu,%lu,%lu,%lu]", (unsigned long)snap->evq_depth,
+                (unsigned long)snap->evq_peak, (unsigned long)snap->evq_cap,
+                (unsigned long)snap->evq_drops);
+    w.ok = _put(&w, ",\"uart\":{\"ovf\":%lu,\"full\":%lu,\"frame\":%lu,\"parity\":%lu,"
+                    "\"brk\":%lu,\"long\":%lu,\"bad\":%lu}",
+                (unsigned long)snap->uart_ovf, (unsigned long)snap->uart_full,
+                (unsigned long)snap->uart_frame, (unsigned long)snap->uart_parity,
+                (unsigned long)snap->uart_brk, (unsigned long)snap->uart_long,
+                (unsigned long)snap->uart_bad);
+
+    if (snap->task_num > 0) {
+        w.ok = _put(&w, ",\"watch\":{");
+        for (int i = 0; i < DIAG_WATCH_NUM; i++) {
+            w.ok = _put(&w, "%s\"%s\":%ld", i ? "," : "", s_watch_names[i],
+                        (long)snap->watch_min[i]);
+        }
+        w.ok = _put(&w, "}");
+
+        // 任务列表放在最后，放不下的计入 more
+        uint16_t written = 0;
+        w.ok = _put(&w, ",\"tasks\":[");
+        if (w.ok && w.pos + tail <= w.len) {
+            w.len -= tail;
+            for (; written < snap->task_count; written++) {
+                const Diag_Task_t *t = &snap->tasks[written];
+                if (!_put(&w, "%s[\"%s\",%d,%lu]", written ? "," : "", t->name,
+                          t->cpu_permille, (unsigned long)t->stack_free)) {
+                    break;
+                }
+            }
+            w.len += tail;
+        }
+        w.ok = _put(&w, "],\"more\":%u", (unsigned)(snap->task_num - written));
+    }
+
+    w.ok = _put(&w, "}");
+    return w.ok ? w.pos : 0;
+}
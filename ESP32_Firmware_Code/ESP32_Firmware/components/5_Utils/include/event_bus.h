@@ -1,6 +1,15 @@
 #pragma once
 #include "system_types.h"
 #include "esp_err.h"
+#include <stdint.h>
+
+// [新增] 事件队列统计
+typedef struct {
+    uint32_t depth;     // 当前排队事件数
+    uint32_t capacity;  // 队列深度
+    uint32_t peak;      // 上次读取统计以来的最大排队数
+    uint32_t drops;     // 队列满被丢弃的事件数 (累计)
+} EventBus_Stats_t;
 
 // 初始化事件总线
 esp_err_t EventBus_Init(void);
@@ -12,3 +21,6 @@ esp_err_t EventBus_Send(EventType_t type, void *data, int len);
 // 接收事件 (阻塞等待)
 // timeout_ms: 等待超时时间，portMAX_DELAY 表示无限等待
 esp_err_t EventBus_Receive(SystemEvent_t *evt, uint32_t timeout_ms);
+
+// [新增] 读取队列统计 (读取后 peak 从当前排队数重新开始统计)
+void EventBus_GetStats(EventBus_Stats_t *stats);
@@ -0,0 +1,61 @@
+/**
+ * @file    latency_trace.h
+ * @brief   端到端延迟追踪 (面板 <-> ESP32 <-> STM32)
+ * @note    1. 追踪编号 tid 由发起方生成 (面板指令中的 "tid" / STM32 state 上报中的 "tid")，
+ *             0 表示不追踪。
+ *          2. 同一时刻只保留一条追踪：新的追踪会覆盖未完成的旧追踪 (拖动滑块时只跟踪最新一条)，
+ *             超过 TRACE_TIMEOUT_MS 未完成的追踪视为丢弃。
+ *          3. 各跳时间取 esp_timer 微秒，输出时换算为相对起点的偏移；
+ *             STM32 侧耗时由其自行测量后上报，两端时钟不同步，只使用各自的差值。
+ *          4. 所有接口线程安全。
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define TRACE_TIMEOUT_MS        1000    /*!< 追踪超时 (ms) */
+
+typedef enum {
+    TRACE_ORIGIN_PANEL = 0,     /*!< 面板下发指令 -> PWM 生效 */
+    TRACE_ORIGIN_STM32          /*!< 本地旋钮/手势 -> 面板状态更新 */
+} Trace_Origin_t;
+
+typedef enum {
+    TRACE_HOP_MQTT_RX = 0,      /*!< 收到面板指令 (面板发起的起点) */
+    TRACE_HOP_UART_TX,          /*!< 指令写入 STM32 串口 */
+    TRACE_HOP_UART_RX,          /*!< 收到 STM32 回执 / 状态上报 (STM32 发起的起点) */
+    TRACE_HOP_MQTT_TX,          /*!< 追踪结果发布 */
+    TRACE_HOP_NUM
+} Trace_Hop_t;
+
+/**
+ * @brief 开始一条追踪，并记录起点 hop 的时间
+ */
+void Trace_Begin(uint32_t tid, Trace_Origin_t origin, Trace_Hop_t hop);
+
+/**
+ * @brief 查询是否有指定来源、且 hop 尚未记录的进行中追踪
+ * @return 追踪编号，0 表示没有
+ */
+uint32_t Trace_Pending(Trace_Origin_t origin, Trace_Hop_t hop);
+
+/**
+ * @brief 记录 hop 的时间 (tid 与当前追踪不符时忽略)
+ */
+void Trace_Mark(uint32_t tid, Trace_Hop_t hop);
+
+/**
+ * @brief 记录 STM32 侧测得的耗时 (us)
+ * @note  面板发起：收到整帧到 PWM 生效；STM32 发起：首次本地改动到串口上报
+ */
+void Trace_SetRemote(uint32_t tid, uint32_t stm32_us);
+
+/**
+ * @brief 记录发布时间并结束追踪，输出 JSON
+ * @return 写入 buf 的长度，0 表示 tid 对应的追踪已被覆盖或超时
+ * @note   格式: {"tid":7,"src":"panel","hops":{"mqtt_rx":0,"uart_tx":812,...},"stm32_us":95,"drop":0}
+ *         hops 为相对起点的微秒偏移，未经过的 hop 不输出；drop 为上次输出以来被丢弃的追踪数
+ */
+size_t Trace_Finish(uint32_t tid, char *buf, size_t len);
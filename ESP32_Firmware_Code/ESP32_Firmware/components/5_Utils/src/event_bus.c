@@ -8,6 +8,10 @@ static QueueHandle_t s_event_queue = NULL;
 
 #define EVENT_QUEUE_SIZE 20 // 队列深度
 
+// [新增] 诊断计数 (多任务/中断并发累加，偶发少计可接受)
+static volatile uint32_t s_peak = 0;
+static volatile uint32_t s_drops = 0;
+
 esp_err_t EventBus_Init(void) {
     if (s_event_queue) return ESP_OK;
 
@@ -32,18 +36,24 @@ esp_err_t EventBus_Send(EventType_t type, void *data, int len) {
     if (xPortInIsrContext()) {
         BaseType_t xHigherPriorityTaskWoken = pdFALSE;
         if (xQueueSendFromISR(s_event_queue, &evt, &xHigherPriorityTaskWoken) != pdTRUE) {
+            s_drops++;
             return ESP_FAIL; // 队列满
         }
+        UBaseType_t n = uxQueueMessagesWaitingFromISR(s_event_queue);
+        if (n > s_peak) s_peak = n;
         if (xHigherPriorityTaskWoken) {
             portYIELD_FROM_ISR();
         }
     } else {
         if (xQueueSend(s_event_queue, &evt, 0) != pdTRUE) {
+            s_drops++;
             ESP_LOGW(TAG, "Queue full, event dropped: %d", type);
             // 注意：如果 data 是动态分配的，这里应该释放，防止内存泄漏
             // 但为了通用性，暂不处理，调用者需注意
             return ESP_FAIL;
         }
+        UBaseType_t n = uxQueueMessagesWaiting(s_event_queue);
+        if (n > s_peak) s_peak = n;
     }
     return ESP_OK;
 }
@@ -56,3 +66,13 @@ esp_err_t EventBus_Receive(SystemEvent_t *evt, uint32_t timeout_ms) {
     }
     return ESP_ERR_TIMEOUT;
 }
+
+void EventBus_GetStats(EventBus_Stats_t *stats) {
+    uint32_t depth = s_event_queue ? (uint32_t)uxQueueMessagesWaiting(s_event_queue) : 0;
+
+    stats->depth = depth;
+    stats->capacity = EVENT_QUEUE_SIZE;
+    stats->peak = (s_peak > depth) ? s_peak : depth;
+    stats->drops = s_drops;
+    s_peak = depth;
+}
@@ -0,0 +1,118 @@
+#include "latency_trace.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char *s_HopNames[TRACE_HOP_NUM] = { "mqtt_rx", "uart_tx", "uart_rx", "mqtt_tx" };
+
+typedef struct {
+    uint32_t tid;               // 0 表示空闲
+    uint8_t  origin;
+    uint8_t  marked;            // 已记录的 hop 位图
+    int64_t  start_us;
+    int64_t  hop_us[TRACE_HOP_NUM];
+    uint32_t stm32_us;
+    uint8_t  has_stm32;
+} Trace_Ctx_t;
+
+static Trace_Ctx_t  s_Ctx;
+static uint32_t     s_Dropped = 0;
+static portMUX_TYPE s_Lock = portMUX_INITIALIZER_UNLOCKED;
+
+// 调用方需持有 s_Lock
+static uint8_t _is_live(int64_t now) {
+    if (s_Ctx.tid == 0) return 0;
+    if (now - s_Ctx.start_us > (int64_t)TRACE_TIMEOUT_MS * 1000) {
+        s_Ctx.tid = 0;
+        s_Dropped++;
+        return 0;
+    }
+    return 1;
+}
+
+void Trace_Begin(uint32_t tid, Trace_Origin_t origin, Trace_Hop_t hop) {
+    if (tid == 0) return;
+    int64_t now = esp_timer_get_time();
+
+    taskENTER_CRITICAL(&s_Lock);
+    if (_is_live(now)) s_Dropped++; // 覆盖未完成的追踪
+    memset(&s_Ctx, 0, sizeof(s_Ctx));
+    s_Ctx.tid = tid;
+    s_Ctx.origin = (uint8_t)origin;
+    s_Ctx.start_us = now;
+    s_Ctx.hop_us[hop] = now;
+    s_Ctx.marked = (uint8_t)(1u << hop);
+    taskEXIT_CRITICAL(&s_Lock);
+}
+
+uint32_t Trace_Pending(Trace_Origin_t origin, Trace_Hop_t hop) {
+    uint32_t tid = 0;
+    int64_t now = esp_timer_get_time();
+
+    taskENTER_CRITICAL(&s_Lock);
+    if (_is_live(now) && s_Ctx.origin == origin && !(s_Ctx.marked & (1u << hop))) {
+        tid = s_Ctx.tid;
+    }
+    taskEXIT_CRITICAL(&s_Lock);
+    return tid;
+}
+
+void Trace_Mark(uint32_t tid, Trace_Hop_t hop) {
+    int64_t now = esp_timer_get_time();
+
+    taskENTER_CRITICAL(&s_Lock);
+    if (tid != 0 && s_Ctx.tid == tid && !(s_Ctx.marked & (1u << hop))) {
+        s_Ctx.hop_us[hop] = now;
+        s_Ctx.marked |= (uint8_t)(1u << hop);
+    }
+    taskEXIT_CRITICAL(&s_Lock);
+}
+
+void Trace_SetRemote(uint32_t tid, uint32_t stm32_us) {
+    taskENTER_CRITICAL(&s_Lock);
+    if (tid != 0 && s_Ctx.tid == tid) {
+        s_Ctx.stm32_us = stm32_us;
+        s_Ctx.has_stm32 = 1;
+    }
+    taskEXIT_CRITICAL(&s_Lock);
+}
+
+size_t Trace_Finish(uint32_t tid, char *buf, size_t len) {
+    Trace_Ctx_t ctx;
+    uint32_t dropped;
+    int64_t now = esp_timer_get_time();
+
+    taskENTER_CRITICAL(&s_Lock);
+    if (tid == 0 || !_is_live(now) || s_Ctx.tid != tid) {
+        taskEXIT_CRITICAL(&s_Lock);
+        return 0;
+    }
+    s_Ctx.hop_us[TRACE_HOP_MQTT_TX] = now;
+    s_Ctx.marked |= (uint8_t)(1u << TRACE_HOP_MQTT_TX);
+    ctx = s_Ctx;
+    dropped = s_Dropped;
+    s_Ctx.tid = 0;
+    s_Dropped = 0;
+    taskEXIT_CRITICAL(&s_Lock);
+
+    // 临界区外格式化
+    int n = snprintf(buf, len, "{\"tid\":%lu,\"src\":\"%s\",\"hops\":{", (unsigned long)ctx.tid,
+                     ctx.origin == TRACE_ORIGIN_PANEL ? "panel" : "stm32");
+    const char *sep = "";
+    for (int i = 0; i < TRACE_HOP_NUM && n > 0 && (size_t)n < len; i++) {
+        if (!(ctx.marked & (1u << i))) continue;
+        n += snprintf(buf + n, len - n, "%s\"%s\":%lld", sep, s_HopNames[i],
+                      (long long)(ctx.hop_us[i] - ctx.start_us));
+        sep = ",";
+    }
+    if (n > 0 && (size_t)n < len && ctx.has_stm32) {
+        n += snprintf(buf + n, len - n, "},\"stm32_us\":%lu", (unsigned long)ctx.stm32_us);
+    } else if (n > 0 && (size_t)n < len) {
+        n += snprintf(buf + n, len - n, "}");
+    }
+    if (n > 0 && (size_t)n < len) {
+        n += snprintf(buf + n, len - n, ",\"drop\":%lu}", (unsigned long)dropped);
+    }
+    return (n > 0 && (size_t)n < len) ? (size_t)n : 0;
+}
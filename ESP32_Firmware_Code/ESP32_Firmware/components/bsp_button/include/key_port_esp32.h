@@ -0,0 +1,13 @@
+#ifndef __KEY_PORT_ESP32_H
+#define __KEY_PORT_ESP32_H
+
+#include <stdint.h>
+
+/**
+ * @brief  创建按键任务 (需在所有按键 Key_Init / KeyManager_Register 之后调用)
+ * @note   任务空闲时阻塞等待 GPIO 任意沿中断，有按键活动时才以 10ms 周期轮询。
+ *         事件通过 KeyManager_Hook_OnEvent 在该任务上下文中输出
+ */
+void Key_Port_StartTask(uint32_t stack_size, uint32_t priority);
+
+#endif
@@ -1,23 +1,50 @@
 #include "Key.h"
+#include "KeyManager.h"
+#include "key_port_esp32.h"
 #include "driver/gpio.h"
 #include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 
-// 硬件初始化适配
-void Key_HAL_Init_Pin(uint32_t pin, uint8_t active_level)
+// 有按键活动时的轮询周期 (ms)，空闲时任务阻塞等待引脚中断
+#define KEY_ACTIVE_POLL_MS      10
+
+static TaskHandle_t s_KeyTask = NULL;
+
+// 任意沿中断：只负责唤醒按键任务，去抖与识别仍在任务中完成
+static void IRAM_ATTR _Key_Isr(void *arg)
+{
+    BaseType_t woken = pdFALSE;
+    (void)arg;
+    if (s_KeyTask != NULL) {
+        vTaskNotifyGiveFromISR(s_KeyTask, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+}
+
+// 硬件初始化适配 (port 在 ESP32 上不使用)
+void Key_HAL_Init_Pin(void *port, uint32_t pin, uint8_t active_level)
 {
+    (void)port;
     gpio_reset_pin((gpio_num_t)pin);
     gpio_set_direction((gpio_num_t)pin, GPIO_MODE_INPUT);
-    
+
     if (active_level == 0) {
         gpio_set_pull_mode((gpio_num_t)pin, GPIO_PULLUP_ONLY); // 低电平有效 -> 上拉
     } else {
         gpio_set_pull_mode((gpio_num_t)pin, GPIO_PULLDOWN_ONLY); // 高电平有效 -> 下拉
     }
+
+    // 中断服务可能已被其他组件安装，ESP_ERR_INVALID_STATE 视为成功
+    gpio_install_isr_service(0);
+    gpio_set_intr_type((gpio_num_t)pin, GPIO_INTR_ANYEDGE);
+    gpio_isr_handler_add((gpio_num_t)pin, _Key_Isr, NULL);
 }
 
 // 硬件读取适配
-uint8_t Key_HAL_Read_Pin(uint32_t pin)
+uint8_t Key_HAL_Read_Pin(void *port, uint32_t pin)
 {
+    (void)port;
     return (uint8_t)gpio_get_level((gpio_num_t)pin);
 }
 
@@ -27,3 +54,24 @@ uint32_t Key_HAL_GetTick(void)
     // esp_timer_get_time() 返回微秒，除以 1000 转毫秒
     return (uint32_t)(esp_timer_get_time() / 1000);
 }
+
+static void _Key_Task(void *pvParameters)
+{
+    (void)pvParameters;
+    while (1) {
+        KeyManager_Tick();
+
+        if (KeyManager_IsIdle()) {
+            // 空闲：阻塞直到引脚变化。检查与阻塞之间发生的沿会留下通知，不会丢失
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        } else {
+            // 去抖 / 连击窗口 / 长按计时进行中：短周期轮询
+            vTaskDelay(pdMS_TO_TICKS(KEY_ACTIVE_POLL_MS));
+        }
+    }
+}
+
+void Key_Port_StartTask(uint32_t stack_size, uint32_t priority)
+{
+    xTaskCreate(_Key_Task, "Key_Task", stack_size, NULL, priority, &s_KeyTask);
+}
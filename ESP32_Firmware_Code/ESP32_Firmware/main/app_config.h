@@ -54,5 +54,13 @@
 #define MQTT_TOPIC_CTRL         "device/lamp/ctrl"
 // 发布主题：向 Python 发送当前状态
 #define MQTT_TOPIC_STATUS       "device/lamp/status"
+// [新增] 历史数据请求 (JSON) / 应答 (二进制分块，格式见 agent_mqtt.c)
+#define MQTT_TOPIC_HISTORY_REQ  "device/lamp/history/req"
+#define MQTT_TOPIC_HISTORY_RESP "device/lamp/history/resp"
+// [新增] 延迟追踪结果 (JSON，格式见 latency_trace.h)
+#define MQTT_TOPIC_TRACE        "device/lamp/trace"
+// [新增] 运行时诊断快照 (JSON，格式见 svc_diag.h)
+#define MQTT_TOPIC_DIAG         "device/lamp/diag"
+#define DIAG_PUBLISH_PERIOD_S   10      // 诊断采样/发布周期 (s)，0 关闭
 
 #endif // APP_CONFIG_H
\ No newline at end of file
@@ -10,39 +10,35 @@
 #include "service_core.h"
 #include "event_bus.h"
 #include "data_center.h"
+#include "data_history.h"
+#include "agents/agent_mqtt.h" // [新增] 运行时诊断发布
 
 #include "KeyManager.h"
 #include "Key.h"
+#include "key_port_esp32.h"
 
 static const char *TAG = "MAIN";
 
 #define MY_WIFI_SSID      "CMCC-2079"
 #define MY_WIFI_PASS      "88888888"
 
-void Key_Task(void *pvParameters) {
-    ESP_LOGI(TAG, "Key Task Started");
-    KeyEvent_t key_evt;
-    while (1) {
-        KeyManager_Tick();
-        if (KeyManager_GetEvent(&key_evt)) {
-            switch (key_evt.Type) {
-                case KEY_EVT_CLICK:
-                    ESP_LOGI(TAG, "Physical Key Click!");
-                    EventBus_Send(EVT_KEY_CLICK, NULL, 0);
-                    break;
-                case KEY_EVT_DOUBLE_CLICK:
-                    ESP_LOGI(TAG, "Physical Key Double Click!");
-                    EventBus_Send(EVT_KEY_DOUBLE_CLICK, NULL, 0);
-                    break;
-                case KEY_EVT_HOLD_START:
-                    ESP_LOGI(TAG, "Physical Key Hold Start");
-                    EventBus_Send(EVT_KEY_LONG_PRESS, NULL, 0);
-                    break;
-                default:
-                    break;
-            }
-        }
-        vTaskDelay(pdMS_TO_TICKS(10)); 
+// 按键事件钩子：在按键任务上下文中调用，转发到事件总线
+void KeyManager_Hook_OnEvent(const KeyEvent_t *evt) {
+    switch (evt->Type) {
+        case KEY_EVT_CLICK:
+            ESP_LOGI(TAG, "Physical Key Click!");
+            EventBus_Send(EVT_KEY_CLICK, NULL, 0);
+            break;
+        case KEY_EVT_DOUBLE_CLICK:
+            ESP_LOGI(TAG, "Physical Key Double Click!");
+            EventBus_Send(EVT_KEY_DOUBLE_CLICK, NULL, 0);
+            break;
+        case KEY_EVT_HOLD_START:
+            ESP_LOGI(TAG, "Physical Key Hold Start");
+            EventBus_Send(EVT_KEY_LONG_PRESS, NULL, 0);
+            break;
+        default:
+            break;
     }
 }
 
@@ -51,6 +47,7 @@ void app_main(void) {
 
     // 1. 基础初始化
     DataCenter_Init(); 
+    DataHistory_Init(); // [新增] 环境与灯光历史记录
     Mgr_Wifi_Init();
     
     Audio_Config_t audio_cfg = {
@@ -67,9 +64,9 @@ void app_main(void) {
     // 2. 按键初始化
     KeyManager_Init();
     static Key_t s_UserKey; 
-    Key_Init(&s_UserKey, 1, BOARD_BUTTON_PIN, 0); 
+    Key_Init(&s_UserKey, 1, NULL, BOARD_BUTTON_PIN, 0); 
     KeyManager_Register(&s_UserKey);
-    xTaskCreate(Key_Task, "Key_Task", 2048, NULL, 5, NULL);
+    Key_Port_StartTask(2048, 5); // 空闲时由引脚中断唤醒，不再固定 10ms 轮询
 
     // 3. 启动神经中枢
     Service_Core_Init();
@@ -83,6 +80,12 @@ void app_main(void) {
         if (loop_count % 5 == 0) {
             DataCenter_PrintStatus();
         }
+#if DIAG_PUBLISH_PERIOD_S > 0
+        // [新增] 任务 CPU / 栈 / 堆 / 事件队列 / 串口错误快照
+        if (loop_count % DIAG_PUBLISH_PERIOD_S == 0) {
+            Agent_MQTT_Publish_Diag();
+        }
+#endif
         loop_count++;
         vTaskDelay(pdMS_TO_TICKS(1000));
     }
@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+多设备模式吞吐测试（无界面，见 panel_harness.py）
+用法: python bench/bench_fleet.py [--devices 100,300,1000] [--rate 每台每秒条数] [--seconds 秒]
+- 模拟 N 台灯各自按 rate 发布 device/<id>/status，消息从模拟网络线程进入 on_message
+- 统计：面板处理的消息速率、帧耗时分位数、最大队列积压、发布结束到队列清空的时间、
+  设备列表的行刷新次数（同一帧内同一设备只刷新一次）
+- 最后全选所有设备发一条控制指令，统计扇出发布耗时
+"""
+
+import argparse
+import json
+import time
+
+from panel_harness import FakeClient, FakeMessage, Producer, instrument_frames, make_panel, percentile
+
+
+def run(devices: int, rate: float, seconds: float) -> dict:
+    app = make_panel(fleet_mode=True)
+    stats = instrument_frames(app)
+    ids = [f"desk-{i:04d}" for i in range(devices)]
+    payloads = [
+        json.dumps({"power": 1, "brightness": b % 101, "color_temp": 50, "temp": 25, "hum": 60}).encode()
+        for b in range(101)
+    ]
+
+    def emit(i: int) -> None:
+        device = ids[i % devices]
+        app.on_message(None, None, FakeMessage(f"device/{device}/status", payloads[i % 101]))
+
+    producer = Producer(rate * devices, seconds, emit)
+    started = time.perf_counter()
+    producer.start()
+    app.root.run_for(seconds)
+    producer.join()
+    # 发布结束后继续运行，直到队列清空
+    while app.ui_queue.qsize() > 0 and time.perf_counter() - producer.finished_at < 30:
+        app.root.run_for(0.005)
+    drained_s = time.perf_counter() - producer.finished_at
+    elapsed = time.perf_counter() - started
+
+    tree = app.device_tree
+    row_updates = tree.row_updates
+
+    # 扇出：全选后发一条亮度指令
+    sent = []
+    FakeClient.sink = lambda topic, payload: sent.append(topic)
+    app.on_select_all()
+    t0 = time.perf_counter()
+    app.publish_control({"brightness": 42})
+    fanout_ms = (time.perf_counter() - t0) * 1000
+    FakeClient.sink = None
+
+    frames = stats["frame_ms"]
+    return {
+        "devices": devices,
+        "msgs": producer.sent,
+        "msg_rate": producer.sent / elapsed,
+        "rows": len(tree.rows),
+        "row_updates": row_updates,
+        "frames": len(frames),
+        "p50": percentile(frames, 50),
+        "p99": percentile(frames, 99),
+        "max": max(frames) if frames else 0.0,
+        "backlog": max(stats["backlog"]) if stats["backlog"] else 0,
+        "drain_ms": drained_s * 1000,
+        "fanout": len(sent),
+        "fanout_ms": fanout_ms,
+    }
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="多设备模式吞吐测试")
+    parser.add_argument("--devices", default="100,300,1000", help="设备数，逗号分隔")
+    parser.add_argument("--rate", type=float, default=1.0, help="每台设备每秒上报条数")
+    parser.add_argument("--seconds", type=float, default=5.0, help="发布时长")
+    args = parser.parse_args()
+
+    print(f"每台 {args.rate:g} 条/秒，持续 {args.seconds:g} s，帧间隔 100 ms（不含 Tk 重绘）")
+    print(
+        f"{'设备':>6}{'消息':>8}{'条/秒':>8}{'行数':>6}{'行刷新':>8}{'帧':>5}"
+        f"{'p50 ms':>8}{'p99 ms':>8}{'max ms':>8}{'积压':>7}{'清空 ms':>9}{'扇出':>6}{'扇出 ms':>9}"
+    )
+    for devices in (int(n) for n in args.devices.split(",")):
+        r = run(devices, args.rate, args.seconds)
+        print(
+            f"{r['devices']:>6}{r['msgs']:>8}{r['msg_rate']:>8.0f}{r['rows']:>6}{r['row_updates']:>8}"
+            f"{r['frames']:>5}{r['p50']:>8.2f}{r['p99']:>8.2f}{r['max']:>8.2f}{r['backlog']:>7}"
+            f"{r['drain_ms']:>9.0f}{r['fanout']:>6}{r['fanout_ms']:>9.2f}"
+        )
+
+
+if __name__ == "__main__":
+    main()
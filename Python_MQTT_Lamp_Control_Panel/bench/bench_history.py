@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+状态历史记录测试（TelemetryRecorder / query_history，不需要界面）
+用法: python bench/bench_history.py [--messages 1000000] [--devices 20] [--days 10]
+- 在临时目录新建数据库，把 N 条状态均匀分布在最近 days 天、devices 台设备上，从调用线程尽快 record()
+- 统计：入队速率、写库速率（record 开始到后台线程全部写完）、close() 时的汇总耗时、数据库大小
+- 再对第一台设备查询 1 小时 / 24 小时（原始数据）、7 天（分钟汇总）、30 天 / 1 年（小时汇总），
+  每档取 5 次的中位数
+"""
+
+import argparse
+import json
+import os
+import sqlite3
+import statistics
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent))
+
+from telemetry import TelemetryRecorder, query_history  # noqa: E402
+
+RANGES = (("1 小时", 3600), ("24 小时", 86400), ("7 天", 7 * 86400), ("30 天", 30 * 86400), ("1 年", 365 * 86400))
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="状态历史记录测试")
+    parser.add_argument("--messages", type=int, default=1_000_000)
+    parser.add_argument("--devices", type=int, default=20)
+    parser.add_argument("--days", type=float, default=10.0, help="数据分布的天数（原始数据保留 14 天）")
+    parser.add_argument("--points", type=int, default=600, help="曲线点数（与 HistoryView 相同）")
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as tmp:
+        db = os.path.join(tmp, "telemetry.db")
+        ids = [f"desk-{i:04d}" for i in range(args.devices)]
+        # 与面板一样传入解析后的字典（JSON 解析不计入）
+        samples = [
+            json.loads(json.dumps({"power": 1, "brightness": b, "color_temp": 50, "temp": 25.0, "hum": 60, "lux": 300}))
+            for b in range(101)
+        ]
+        end = time.time()
+        start = end - args.days * 86400
+        step = (end - start) / args.messages
+
+        recorder = TelemetryRecorder(db)
+        t0 = time.perf_counter()
+        for i in range(args.messages):
+            recorder.record(ids[i % args.devices], samples[i % 101], start + i * step)
+        enqueued = time.perf_counter() - t0
+        while recorder.recorded < args.messages:
+            time.sleep(0.01)
+        written = time.perf_counter() - t0
+        t1 = time.perf_counter()
+        recorder.close()
+        closed = time.perf_counter() - t1
+
+        print(f"{args.messages} 条，{args.devices} 台设备，分布在最近 {args.days:g} 天")
+        print(f"  入队        {enqueued:7.2f} s  {args.messages / enqueued:10.0f} 条/秒")
+        print(f"  写库完成    {written:7.2f} s  {args.messages / written:10.0f} 条/秒")
+        print(f"  close/汇总  {closed:7.2f} s")
+        print(f"  数据库      {os.path.getsize(db) / 1e6:7.1f} MB（不含 WAL）")
+
+        conn = sqlite3.connect(db)
+        rollups = conn.execute("SELECT res, COUNT(*) FROM rollup GROUP BY res").fetchall()
+        print("  汇总行数    " + "，".join(f"{res} s: {n}" for res, n in rollups))
+        print(f"  查询 {ids[0]}（{args.points} 点，5 次中位数）")
+        for title, span in RANGES:
+            times, data = [], []
+            for _ in range(5):
+                q0 = time.perf_counter()
+                data = query_history(conn, ids[0], end - span, end, args.points)
+                times.append((time.perf_counter() - q0) * 1000)
+            print(f"    {title:<8}{statistics.median(times):8.1f} ms  {len(data):4} 点")
+        conn.close()
+
+
+if __name__ == "__main__":
+    main()
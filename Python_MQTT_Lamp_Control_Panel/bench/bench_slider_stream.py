@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+滑块实时发送测试（无界面，见 panel_harness.py）
+用法: python bench/bench_slider_stream.py [--drag-s 秒] [--motion-hz 鼠标事件频率] [--link-ms 最小,最大]
+- 本机没有 MQTT 代理时，用进程内的模拟链路代替：控制消息经随机单程延迟（默认 5~40 ms，
+  会乱序）到达模拟设备，设备按 ESP32 agent_mqtt.c 的规则（同一 sid 中 16 位回绕比较，
+  不比上一条新的丢弃）应用指令，经 --device-ms 后回报带 ack_seq 的状态，再经单程延迟回到 on_message
+- 拖动亮度滑块：按 --motion-hz 产生 <B1-Motion>，数值在 0~100 之间往返，最后松开
+- 对比实时发送（--rates 中的各档限速）与只在松开时发送（rate 0）
+- 统计：发送条数与最小发送间隔、设备丢弃的乱序指令、发送到回显延迟（面板 _update_latency 看到的值，
+  含 100 ms 帧合并）、松开到最终值回显的时间，以及设备最终亮度是否等于滑块值
+"""
+
+import argparse
+import heapq
+import itertools
+import json
+import random
+import threading
+import time
+
+from panel_harness import FakeClient, FakeMessage, make_panel, percentile
+
+
+class LinkSim(threading.Thread):
+    """模拟网络与设备：按到达时刻投递消息（单独线程，相当于 paho 的网络线程）"""
+
+    def __init__(self, app, link_ms: tuple, device_ms: float, seed: int) -> None:
+        super().__init__(name="LinkSim", daemon=True)
+        self.app = app
+        self.link_ms = link_ms
+        self.device_ms = device_ms
+        self.rng = random.Random(seed)
+        self._heap = []
+        self._order = itertools.count()
+        self._cv = threading.Condition()
+        self._stop = False
+        # 模拟设备状态
+        self.brightness = 50
+        self.last_sid = None
+        self.last_seq = None
+        self.received = 0
+        self.dropped = 0
+
+    def _delay(self) -> float:
+        return self.rng.uniform(*self.link_ms) / 1000.0
+
+    def _at(self, due: float, func) -> None:
+        with self._cv:
+            heapq.heappush(self._heap, (due, next(self._order), func))
+            self._cv.notify()
+
+    def publish(self, topic: str, payload: str) -> None:
+        """面板发布（UI线程）：经单程延迟到达设备"""
+        self._at(time.perf_counter() + self._delay(), lambda: self._device_rx(payload))
+
+    def _device_rx(self, payload: str) -> None:
+        self.received += 1
+        msg = json.loads(payload)
+        seq, sid = msg.get("seq"), msg.get("sid")
+        if seq is not None:
+            if self.last_seq is not None and sid == self.last_sid:
+                diff = (seq - self.last_seq) & 0xFFFF
+                if diff == 0 or diff >= 0x8000:
+                    self.dropped += 1
+                    return
+            self.last_sid, self.last_seq = sid, seq
+        if "brightness" in msg:
+            self.brightness = max(0, min(100, int(msg["brightness"])))
+        status = {"power": 1, "brightness": self.brightness, "color_temp": 50, "temp": 25, "hum": 60}
+        if self.last_seq is not None:
+            status["ack_seq"] = self.last_seq
+        body = json.dumps(status).encode()
+        due = time.perf_counter() + self.device_ms / 1000.0 + self._delay()
+        self._at(due, lambda: self.app.on_message(None, None, FakeMessage("device/lamp/status", body)))
+
+    def run(self) -> None:
+        while True:
+            with self._cv:
+                while not self._stop and (not self._heap or self._heap[0][0] > time.perf_counter()):
+                    timeout = self._heap[0][0] - time.perf_counter() if self._heap else None
+                    self._cv.wait(timeout)
+                if self._stop:
+                    return
+                _due, _n, func = heapq.heappop(self._heap)
+            func()
+
+    def stop(self) -> None:
+        with self._cv:
+            self._stop = True
+            self._cv.notify()
+
+
+def run(rate_hz: int, args, seed: int) -> dict:
+    app = make_panel(stream_sliders=rate_hz > 0, stream_rate_hz=max(1, rate_hz))
+    link = LinkSim(app, args.link_ms, args.device_ms, seed)
+    sends = []
+    FakeClient.sink = lambda topic, payload: (sends.append(time.perf_counter()), link.publish(topic, payload))
+    link.start()
+
+    # 发送到回显：在 _update_latency 取走发送时刻之前计算
+    echo_ms = []
+    acked = set()
+    final = {"seq": None, "value": None, "released": None, "echo_ms": None}
+    update_latency = app._update_latency
+
+    def wrapped(ack_seq: int) -> None:
+        sent = app.sent_times.get(ack_seq)
+        now = time.perf_counter()
+        if sent is not None:
+            echo_ms.append((now - sent) * 1000)
+        acked.add(ack_seq)
+        if final["released"] is not None and final["echo_ms"] is None and ack_seq == final["seq"]:
+            final["echo_ms"] = (now - final["released"]) * 1000
+        update_latency(ack_seq)
+
+    app._update_latency = wrapped
+
+    # 拖动：数值在 0~100 之间往返（周期 1 s）
+    motions = [0]
+    started = time.perf_counter()
+    period = 1.0 / args.motion_hz
+    var = app.brightness_var
+
+    def step() -> None:
+        t = time.perf_counter() - started
+        if t >= motions[0] * period:
+            phase = (t % 1.0) * 2
+            var.set(100 * (phase if phase <= 1 else 2 - phase))
+            app._on_slider_drag("brightness", var, app.brightness_value_label)
+            motions[0] += 1
+
+    app.dragging.add("brightness")
+    app.root.run_for(args.drag_s, step=step)
+    drag_sends = len(sends)
+    final["released"] = time.perf_counter()
+    app.on_brightness_release()
+    final["seq"] = app.seq
+    final["value"] = int(round(var.get()))
+    # 松开时的值与最后一条实时发送相同则不再发送，此时最终值可能已经回显
+    if final["seq"] in acked:
+        final["echo_ms"] = 0.0
+    app.root.run_for(1.0)
+    link.stop()
+    FakeClient.sink = None
+
+    # 限速只约束拖动中的发送，松开时的补发不受限
+    gaps = [(b - a) * 1000 for a, b in zip(sends[:drag_sends], sends[1:drag_sends])]
+    return {
+        "rate": rate_hz,
+        "motions": motions[0],
+        "sent": len(sends),
+        "min_gap": min(gaps) if gaps else 0.0,
+        "dropped": link.dropped,
+        "p50": percentile(echo_ms, 50),
+        "p99": percentile(echo_ms, 99),
+        "final_ms": final["echo_ms"],
+        "match": link.brightness == final["value"],
+    }
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="滑块实时发送测试")
+    parser.add_argument("--rates", default="20,50,0", help="实时发送限速（Hz），0 为只在松开时发送")
+    parser.add_argument("--drag-s", type=float, default=3.0, help="拖动时长")
+    parser.add_argument("--motion-hz", type=float, default=120.0, help="鼠标移动事件频率")
+    parser.add_argument(
+        "--link-ms",
+        type=lambda s: tuple(float(v) for v in s.split(",")),
+        default=(5.0, 40.0),
+        help="单程延迟范围（毫秒）",
+    )
+    parser.add_argument("--device-ms", type=float, default=30.0, help="设备应用指令到回报状态的耗时")
+    parser.add_argument("--runs", type=int, default=3, help="每档重复次数（随机种子不同）")
+    args = parser.parse_args()
+
+    print(
+        f"拖动 {args.drag_s:g} s，鼠标 {args.motion_hz:g} Hz，单程 {args.link_ms[0]:g}~{args.link_ms[1]:g} ms，"
+        f"设备 {args.device_ms:g} ms，帧间隔 100 ms"
+    )
+    print(
+        f"{'限速':>6}{'移动':>6}{'发送':>6}{'最小间隔':>10}{'乱序丢弃':>9}"
+        f"{'回显p50':>9}{'回显p99':>9}{'松开->最终':>11}{'一致':>5}"
+    )
+    for rate in (int(r) for r in args.rates.split(",")):
+        for seed in range(args.runs):
+            r = run(rate, args, seed)
+            final_ms = "--" if r["final_ms"] is None else f"{r['final_ms']:.0f} ms"
+            print(
+                f"{(str(r['rate']) + ' Hz') if r['rate'] else '松开':>6}{r['motions']:>6}{r['sent']:>6}"
+                f"{r['min_gap']:>8.1f}ms{r['dropped']:>9}{r['p50']:>7.0f}ms{r['p99']:>7.0f}ms"
+                f"{final_ms:>11}{'是' if r['match'] else '否':>5}"
+            )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+高频上报下的帧耗时测试（无界面，见 panel_harness.py）
+用法: python bench/bench_ui_frame.py [--rates 1000,2000,5000,10000] [--devices 1] [--seconds 秒]
+- 模拟网络线程按总速率把状态消息送入 on_message（每条同时产生一条接收日志）
+- 对比两种帧处理：
+  batch  当前的 _process_ui_queue（按设备合并状态、日志整批插入、单帧条数上限）
+  naive  逐条处理（合并前的做法：每条日志单独插入并滚动，每条状态单独刷新控件）
+- 统计：帧耗时分位数、每帧控件调用次数、最大队列积压、发布结束到队列清空的时间、日志框行数
+"""
+
+import argparse
+import json
+import queue
+import time
+
+import panel_harness
+from panel_harness import FakeMessage, Producer, instrument_frames, make_panel, percentile
+
+
+def naive_frame(app) -> None:
+    """逐条处理队列（不合并），与 batch 使用相同的控件更新函数"""
+    while True:
+        try:
+            event, payload = app.ui_queue.get_nowait()
+        except queue.Empty:
+            break
+        if event == "log":
+            app._log(str(payload))
+        elif event == "device_status":
+            device_id, data = payload
+            if device_id is not None:
+                app._update_device_row(device_id, data)
+            if device_id is None or device_id == app.focus_id:
+                app._apply_device_status(data)
+        else:
+            app._set_conn_status(event == "connected")
+    app.root.after(app.UI_FRAME_MS, app._process_ui_queue)
+
+
+def run(mode: str, rate: float, devices: int, seconds: float) -> dict:
+    app = make_panel(fleet_mode=devices > 1)
+    if mode == "naive":
+        app._process_ui_queue = lambda: naive_frame(app)
+    stats = instrument_frames(app)
+    if devices > 1:
+        app.on_select_all()  # 没有设备时为空，首批上报后焦点设备由下面指定
+    payloads = [
+        json.dumps({"power": 1, "brightness": b, "color_temp": 100 - b, "temp": 25, "hum": 60}).encode()
+        for b in range(101)
+    ]
+
+    def emit(i: int) -> None:
+        topic = f"device/desk-{i % devices:04d}/status" if devices > 1 else "device/lamp/status"
+        app.on_message(None, None, FakeMessage(topic, payloads[i % 101]))
+
+    calls_before = panel_harness.tk_calls()
+    producer = Producer(rate, seconds, emit)
+    started = time.perf_counter()
+    producer.start()
+    if devices > 1:
+        app.root.run_for(0.2)
+        app.focus_id = "desk-0000"
+        app.root.run_for(seconds - 0.2)
+    else:
+        app.root.run_for(seconds)
+    producer.join()
+    while app.ui_queue.qsize() > 0 and time.perf_counter() - producer.finished_at < 60:
+        app.root.run_for(0.005)
+    drained_ms = (time.perf_counter() - producer.finished_at) * 1000
+    elapsed = time.perf_counter() - started
+
+    frames = stats["frame_ms"]
+    return {
+        "msgs": producer.sent,
+        "msg_rate": producer.sent / elapsed,
+        "frames": len(frames),
+        "p50": percentile(frames, 50),
+        "p99": percentile(frames, 99),
+        "max": max(frames) if frames else 0.0,
+        "calls": (panel_harness.tk_calls() - calls_before) / max(1, len(frames)),
+        "backlog": max(stats["backlog"]) if stats["backlog"] else 0,
+        "drain_ms": drained_ms,
+        "log_lines": len(app.log_text.lines),
+    }
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="高频上报下的帧耗时测试")
+    parser.add_argument("--rates", default="1000,2000,5000,10000", help="总消息速率，逗号分隔")
+    parser.add_argument("--devices", type=int, default=1, help="设备数（1 为单设备模式）")
+    parser.add_argument("--seconds", type=float, default=5.0, help="发布时长")
+    args = parser.parse_args()
+
+    print(f"{args.devices} 台设备，持续 {args.seconds:g} s，帧间隔 100 ms（不含 Tk 重绘）")
+    print(
+        f"{'模式':>6}{'条/秒':>8}{'消息':>8}{'帧':>5}{'p50 ms':>8}{'p99 ms':>8}{'max ms':>8}"
+        f"{'调用/帧':>9}{'积压':>8}{'清空 ms':>9}{'日志行':>7}"
+    )
+    for rate in (float(r) for r in args.rates.split(",")):
+        for mode in ("batch", "naive"):
+            r = run(mode, rate, args.devices, args.seconds)
+            print(
+                f"{mode:>6}{r['msg_rate']:>8.0f}{r['msgs']:>8}{r['frames']:>5}{r['p50']:>8.2f}"
+                f"{r['p99']:>8.2f}{r['max']:>8.2f}{r['calls']:>9.0f}{r['backlog']:>8}"
+                f"{r['drain_ms']:>9.0f}{r['log_lines']:>7}"
+            )
+
+
+if __name__ == "__main__":
+    main()
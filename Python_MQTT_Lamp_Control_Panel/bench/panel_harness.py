@@ -0,0 +1,363 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+控制面板无界面测试工具（bench/ 下各测试脚本共用）
+- 用假的 tkinter 控件与 MQTT 客户端构造 LampControlPanel，__init__ 与各回调原样执行，
+  不需要显示器、paho-mqtt 与 MQTT 代理
+- FakeRoot.after 维护定时器，run_for() 按真实时间驱动 _process_ui_queue 与滑块尾沿定时器
+- 控件只保存数据不绘制：测得的帧耗时只含面板自身的 Python 处理，不含 Tk 重绘；
+  tk_calls() 统计控件方法与变量写入的调用次数，可作为 Tk 侧开销的参照
+"""
+
+import heapq
+import itertools
+import sys
+import threading
+import time
+import types
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent))
+
+
+# ---------------- MQTT 客户端替身 ----------------
+
+
+class FakeClient:
+    """paho Client 替身：publish 交给 sink(topic, payload)，连接相关调用为空操作"""
+
+    sink = None
+
+    def __init__(self, client_id=None, protocol=None) -> None:
+        self.client_id = client_id
+        self.subscriptions = []
+        self.published = 0
+        self.on_connect = self.on_disconnect = self.on_message = None
+
+    def connect(self, *_args, **_kwargs) -> None:
+        pass
+
+    def loop_start(self) -> None:
+        pass
+
+    def loop_stop(self) -> None:
+        pass
+
+    def disconnect(self) -> None:
+        pass
+
+    def reconnect_delay_set(self, **_kwargs) -> None:
+        pass
+
+    def is_connected(self) -> bool:
+        return True
+
+    def subscribe(self, topic, qos=0) -> None:
+        self.subscriptions.append(topic)
+
+    def publish(self, topic, payload=None, qos=0):
+        self.published += 1
+        if FakeClient.sink is not None:
+            FakeClient.sink(topic, payload)
+        return types.SimpleNamespace(rc=0)
+
+
+def _install_fake_paho() -> None:
+    """本机没有 paho-mqtt 时注册一个同名模块，保证 lamp_control_panel 可以导入"""
+    try:
+        import paho.mqtt.client  # noqa: F401
+        return
+    except ImportError:
+        pass
+    client = types.ModuleType("paho.mqtt.client")
+    client.Client = FakeClient
+    client.MQTTv311 = 4
+    client.MQTT_ERR_SUCCESS = 0
+    mqtt_pkg = types.ModuleType("paho.mqtt")
+    mqtt_pkg.client = client
+    paho = types.ModuleType("paho")
+    paho.mqtt = mqtt_pkg
+    sys.modules.update({"paho": paho, "paho.mqtt": mqtt_pkg, "paho.mqtt.client": client})
+
+
+class FakeMessage:
+    """on_message 收到的消息对象"""
+
+    __slots__ = ("topic", "payload")
+
+    def __init__(self, topic: str, payload: bytes) -> None:
+        self.topic = topic
+        self.payload = payload
+
+
+# ---------------- tkinter 替身 ----------------
+
+_tk_calls = 0
+
+
+def tk_calls() -> int:
+    """截至目前的控件/变量调用次数（布局、配置、插入、写变量等，读取不计）"""
+    return _tk_calls
+
+
+def _count() -> None:
+    global _tk_calls
+    _tk_calls += 1
+
+
+class FakeVar:
+    def __init__(self, master=None, value=None) -> None:
+        self._value = value
+
+    def get(self):
+        return self._value
+
+    def set(self, value) -> None:
+        _count()
+        self._value = value
+
+
+class FakeWidget:
+    """通用控件：记录 configure 的选项，布局与绑定调用为空操作"""
+
+    def __init__(self, *_args, **kwargs) -> None:
+        self.options = dict(kwargs)
+        self.bindings = {}
+
+    def configure(self, **kwargs) -> None:
+        _count()
+        self.options.update(kwargs)
+
+    config = configure
+
+    def bind(self, sequence, func) -> None:
+        self.bindings[sequence] = func
+
+    def __getattr__(self, name):
+        if name.startswith("__"):
+            raise AttributeError(name)
+        return lambda *_a, **_k: _count()
+
+
+class FakeText(FakeWidget):
+    """ScrolledText 替身：按行保存内容，支持面板用到的 insert/index/delete"""
+
+    def __init__(self, *args, **kwargs) -> None:
+        super().__init__(*args, **kwargs)
+        self.lines = []
+
+    def insert(self, _index, text: str) -> None:
+        _count()
+        self.lines.extend(text.splitlines(keepends=True))
+
+    def index(self, spec: str) -> str:
+        # 只用到 "end-1c"：内容以换行结尾时位于最后一行之后
+        return f"{len(self.lines) + 1}.0"
+
+    def delete(self, first: str, last: str = None) -> None:
+        _count()
+        if last == "end":
+            self.lines.clear()
+        else:
+            del self.lines[: int(last.split(".")[0]) - 1]
+
+
+class FakeTree(FakeWidget):
+    """Treeview 替身：iid -> values，selection_set 与 Tk 一样触发 <<TreeviewSelect>>"""
+
+    def __init__(self, *args, **kwargs) -> None:
+        super().__init__(*args, **kwargs)
+        self.rows = {}
+        self.row_updates = 0
+        self._selection = ()
+
+    def insert(self, _parent, _index, iid=None, text="", values=()) -> str:
+        _count()
+        self.rows[iid] = list(values)
+        self.row_updates += 1
+        return iid
+
+    def item(self, iid, values=None) -> None:
+        if values is not None:
+            _count()
+            self.rows[iid] = list(values)
+            self.row_updates += 1
+
+    def get_children(self, _item="") -> tuple:
+        return tuple(self.rows)
+
+    def delete(self, *iids) -> None:
+        for iid in iids:
+            self.rows.pop(iid, None)
+
+    def selection(self) -> tuple:
+        return self._selection
+
+    def selection_set(self, items) -> None:
+        self._selection = tuple(items)
+        handler = self.bindings.get("<<TreeviewSelect>>")
+        if handler is not None:
+            handler(None)
+
+
+class FakeRoot(FakeWidget):
+    """Tk 根窗口替身：after() 定时器按真实时间在 run_for() 中执行（单线程，相当于 mainloop）"""
+
+    def __init__(self, *args, **kwargs) -> None:
+        super().__init__(*args, **kwargs)
+        self._timers = []
+        self._ids = itertools.count(1)
+        self._cancelled = set()
+
+    def after(self, ms: int, func) -> str:
+        timer_id = f"after#{next(self._ids)}"
+        heapq.heappush(self._timers, (time.perf_counter() + ms / 1000.0, timer_id, func))
+        return timer_id
+
+    def after_cancel(self, timer_id: str) -> None:
+        self._cancelled.add(timer_id)
+
+    def run_pending(self) -> None:
+        """执行所有已到期的定时器"""
+        now = time.perf_counter()
+        while self._timers and self._timers[0][0] <= now:
+            _due, timer_id, func = heapq.heappop(self._timers)
+            if timer_id in self._cancelled:
+                self._cancelled.discard(timer_id)
+                continue
+            func()
+
+    def run_for(self, seconds: float, step=None) -> None:
+        """运行事件循环 seconds 秒；step() 在每轮空闲时调用（用于模拟鼠标等界面输入）"""
+        end = time.perf_counter() + seconds
+        while True:
+            now = time.perf_counter()
+            if now >= end:
+                break
+            self.run_pending()
+            if step is not None:
+                step()
+            wake = min(end, self._timers[0][0] if self._timers else end)
+            if step is not None:
+                wake = min(wake, now + 0.001)
+            delay = wake - time.perf_counter()
+            if delay > 0:
+                time.sleep(delay)
+
+
+fake_tk = types.SimpleNamespace(
+    Tk=FakeRoot,
+    Misc=FakeWidget,
+    Toplevel=FakeWidget,
+    StringVar=FakeVar,
+    IntVar=FakeVar,
+    BooleanVar=FakeVar,
+    X="x",
+    Y="y",
+    BOTH="both",
+    LEFT="left",
+    RIGHT="right",
+    W="w",
+    E="e",
+    END="end",
+    NORMAL="normal",
+    DISABLED="disabled",
+    WORD="word",
+    HORIZONTAL="horizontal",
+    VERTICAL="vertical",
+    CENTER="center",
+)
+
+fake_ttk = types.SimpleNamespace(
+    Frame=FakeWidget,
+    LabelFrame=FakeWidget,
+    Label=FakeWidget,
+    Entry=FakeWidget,
+    Checkbutton=FakeWidget,
+    Button=FakeWidget,
+    Scale=FakeWidget,
+    Scrollbar=FakeWidget,
+    Combobox=FakeWidget,
+    Treeview=FakeTree,
+)
+
+
+# ---------------- 面板构造 ----------------
+
+_install_fake_paho()
+import lamp_control_panel as panel_module  # noqa: E402
+
+panel_module.tk = fake_tk
+panel_module.ttk = fake_ttk
+panel_module.ScrolledText = FakeText
+panel_module.mqtt = types.SimpleNamespace(
+    Client=FakeClient, MQTTv311=4, MQTT_ERR_SUCCESS=0
+)
+
+
+def make_panel(**overrides):
+    """按默认配置 + overrides 构造面板并模拟连接成功（不读写 app_config.json）
+
+    默认关闭历史记录与延迟追踪，需要时由 overrides 打开。
+    """
+    cls = panel_module.LampControlPanel
+    config = dict(cls.DEFAULT_CONFIG, record_history=False, trace=False)
+    config.update(overrides)
+    cls._load_config = lambda self: dict(config)
+    cls._save_config = lambda self, cfg: None
+
+    app = cls(FakeRoot())
+    app.on_connect(app.client, None, None, 0)
+    # 跑过第一帧：取走连接事件，控制区启用
+    app.root.run_for(cls.UI_FRAME_MS / 1000 + 0.01)
+    return app
+
+
+def instrument_frames(app) -> dict:
+    """统计每帧 _process_ui_queue 的耗时与开始时的队列积压
+
+    返回的字典随运行累积：frame_ms / backlog 为逐帧列表。
+    """
+    stats = {"frame_ms": [], "backlog": []}
+    original = app._process_ui_queue
+
+    def wrapped():
+        stats["backlog"].append(app.ui_queue.qsize())
+        started = time.perf_counter()
+        original()
+        stats["frame_ms"].append((time.perf_counter() - started) * 1000)
+
+    app._process_ui_queue = wrapped
+    return stats
+
+
+class Producer(threading.Thread):
+    """按固定总速率调用 emit(i)，模拟 MQTT 网络线程（每 1 ms 补齐应发的条数）"""
+
+    def __init__(self, rate: float, seconds: float, emit) -> None:
+        super().__init__(name="Producer", daemon=True)
+        self.rate = rate
+        self.seconds = seconds
+        self.emit = emit
+        self.sent = 0
+        self.finished_at = None
+
+    def run(self) -> None:
+        started = time.perf_counter()
+        total = int(self.rate * self.seconds)
+        while self.sent < total:
+            due = min(total, int((time.perf_counter() - started) * self.rate))
+            while self.sent < due:
+                self.emit(self.sent)
+                self.sent += 1
+            time.sleep(0.001)
+        self.finished_at = time.perf_counter()
+
+
+def percentile(values: list, p: float) -> float:
+    """与 trace_report.py 相同的最近秩分位数"""
+    if not values:
+        return 0.0
+    ordered = sorted(values)
+    k = min(len(ordered) - 1, max(0, int(round(p / 100 * (len(ordered) - 1)))))
+    return ordered[k]
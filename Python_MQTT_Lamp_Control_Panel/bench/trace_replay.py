@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+延迟追踪回放核对（无界面）
+用法: python bench/trace_replay.py trace.jsonl
+      python bench/trace_replay.py --sim 路径/trace_e2e_sim [仿真参数...]
+- 输入为 STM32 HostSim 中 trace_e2e_sim --json 的输出：面板侧按时间收到的消息
+  （发送、状态到达、设备追踪结果、界面应用），设备追踪结果由 ESP32 的 latency_trace.c 生成
+- 按消息时刻驱动 tracing.TraceLog（time.perf_counter 替换为仿真时钟），
+  每条完成的记录与仿真给出的 expect 逐跳比较，误差超过 0.01 ms 或记录缺失时返回 1
+- --sim 时先运行仿真生成临时文件，其余参数原样传给仿真
+"""
+
+import json
+import subprocess
+import sys
+import tempfile
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent))
+
+import tracing  # noqa: E402
+
+TOLERANCE_MS = 0.011    # 记录保留两位小数
+
+
+class SimClock:
+    """替换 tracing 模块中的 time.perf_counter：返回当前消息的仿真时刻（秒）"""
+
+    def __init__(self) -> None:
+        self.now = 0.0
+
+    def perf_counter(self) -> float:
+        return self.now
+
+    def time(self) -> float:
+        return 0.0
+
+
+def replay(lines) -> int:
+    clock = SimClock()
+    tracing.time = clock
+    records = []
+    with tempfile.TemporaryDirectory() as tmp:
+        log = tracing.TraceLog(str(Path(tmp) / "trace.log"), on_record=records.append)
+        log._next_tid = 1  # 仿真中面板指令的 tid 从 1 起顺序分配
+
+        checked, errors = {"panel": 0, "stm32": 0}, []
+        for n, line in enumerate(lines, 1):
+            msg = json.loads(line)
+            if "expect" in msg:
+                exp = msg["expect"]
+                rec = records.pop(0) if records else None
+                if rec is None or rec["src"] != exp["src"] or rec["tid"] != exp["tid"]:
+                    errors.append(f"第 {n} 行: 期望 {exp['src']} tid={exp['tid']} 的记录，得到 {rec}")
+                    continue
+                for hop, want in exp.items():
+                    if hop in ("src", "tid"):
+                        continue
+                    got = rec.get(hop)
+                    if got is None or abs(got - want) > TOLERANCE_MS:
+                        errors.append(f"第 {n} 行: {exp['src']} tid={exp['tid']} {hop} = {got}，期望 {want}")
+                checked[exp["src"]] += 1
+                continue
+
+            clock.now = msg["t"] / 1e6
+            if "sent" in msg:
+                tid = log.new_tid()
+                if tid != msg["sent"]:
+                    errors.append(f"第 {n} 行: 面板分配 tid={tid}，仿真为 {msg['sent']}")
+            elif "device" in msg:
+                log.on_trace("lamp", msg["device"])
+            elif "status" in msg:
+                log.on_status("lamp", msg["status"])
+            elif "applied" in msg:
+                log.on_status_applied("lamp", msg["applied"])
+
+    errors += [f"多出的记录: {rec}" for rec in records]
+    for e in errors[:20]:
+        print(e)
+    print(f"核对 面板 {checked['panel']} 条, 本地 {checked['stm32']} 条, 不一致 {len(errors)} 处")
+    return 1 if errors or not (checked["panel"] and checked["stm32"]) else 0
+
+
+def main() -> int:
+    args = sys.argv[1:]
+    if len(args) >= 2 and args[0] == "--sim":
+        with tempfile.TemporaryDirectory() as tmp:
+            path = Path(tmp) / "trace.jsonl"
+            sim = subprocess.run([args[1], *args[2:], "--json", str(path)], stdout=subprocess.DEVNULL)
+            if sim.returncode != 0:
+                print(f"仿真返回 {sim.returncode}")
+                return 1
+            return replay(path.read_text(encoding="utf-8").splitlines())
+    if len(args) == 1:
+        return replay(Path(args[0]).read_text(encoding="utf-8").splitlines())
+    print(__doc__)
+    return 2
+
+
+if __name__ == "__main__":
+    sys.exit(main())
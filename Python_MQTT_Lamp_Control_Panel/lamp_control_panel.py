@@ -5,16 +5,24 @@
 - GUI: tkinter
 - MQTT: paho-mqtt
 - 协议: JSON
+- 多设备模式: 通配订阅 device/+/status，按设备维护状态表，控制消息扇出到选中设备
+- 延迟追踪: 控制消息附带 tid，订阅设备发布的追踪结果，逐条记录各跳耗时
 """
 
 import json
 import queue
+import random
+import re
+import time
 from datetime import datetime
 from pathlib import Path
 import tkinter as tk
 from tkinter import ttk
 from tkinter.scrolledtext import ScrolledText
 
+from telemetry import HistoryView, TelemetryRecorder
+from tracing import TraceLog
+
 try:
     import paho.mqtt.client as mqtt
 except ImportError as exc:  # pragma: no cover
@@ -31,8 +39,42 @@ class LampControlPanel:
         "client_id": "Python_Control_Panel",
         "topic_ctrl": "device/lamp/ctrl",
         "topic_status": "device/lamp/status",
+        # 多设备模式：状态主题中的第一个通配段即设备ID，控制主题用 {id} 占位
+        "fleet_mode": False,
+        "fleet_topic_status": "device/+/status",
+        "fleet_topic_ctrl": "device/{id}/ctrl",
+        "groups": {},
+        # 拖动滑块时按限速实时发送（关闭则只在松开时发送）
+        "stream_sliders": True,
+        "stream_rate_hz": 20,
+        # 状态历史记录（SQLite，相对路径基于程序目录）
+        "record_history": True,
+        "history_db": "telemetry.db",
+        # 端到端延迟追踪（结果逐行写入 trace_log，用 trace_report.py 统计）
+        "trace": False,
+        "topic_trace": "device/lamp/trace",
+        "fleet_topic_trace": "device/+/trace",
+        "trace_log": "trace.log",
     }
 
+    # UI刷新节奏：每帧处理队列的上限与间隔，日志框最多保留的行数
+    UI_FRAME_MS = 100
+    UI_MAX_ITEMS_PER_FRAME = 5000
+    LOG_MAX_LINES = 1000
+
+    # 已发送序号的发送时刻最多保留的条数（用于计算回显延迟）
+    SEQ_HISTORY = 64
+
+    # 设备列表显示的列（字段名, 标题, 宽度）
+    FLEET_COLUMNS = (
+        ("power", "电源", 50),
+        ("brightness", "亮度", 60),
+        ("color_temp", "色温", 60),
+        ("temp", "温度", 60),
+        ("hum", "湿度", 60),
+        ("last_seen", "最后上报", 90),
+    )
+
     def __init__(self, root: tk.Tk) -> None:
         self.root = root
         self.root.title("物联网智能灯控制面板")
@@ -40,6 +82,8 @@ class LampControlPanel:
         self.root.minsize(520, 520)
         self.config_path = Path(__file__).with_name("app_config.json")
         self.config = self._load_config()
+        # 分组表会被修改，避免与 DEFAULT_CONFIG 共享同一个字典
+        self.config["groups"] = dict(self.config["groups"])
 
         # 设备上报更新UI时，抑制本地控件回调发布，避免回环
         self.updating_from_device = False
@@ -54,8 +98,29 @@ class LampControlPanel:
         # MQTT线程与UI线程之间的消息队列
         self.ui_queue = queue.Queue()
 
+        # 多设备模式：设备ID -> 最近一次上报的状态（仅在UI线程访问）
+        self.devices = {}
+        self.selected_ids = ()
+        self.focus_id = None
+        self.status_matcher = None
+        self.trace_matcher = None
+
+        # 控制指令序号：sid 每次启动随机生成，设备据 (sid, seq) 丢弃乱序到达的旧指令
+        self.session_id = random.getrandbits(31)
+        self.seq = 0
+        self.sent_times = {}
+
+        # 滑块实时发送：字段 -> {"last_sent", "last_time", "timer"}，dragging 为拖动中的字段
+        self.stream = {
+            "brightness": {"last_sent": None, "last_time": 0.0, "timer": None},
+            "color_temp": {"last_sent": None, "last_time": 0.0, "timer": None},
+        }
+        self.dragging = set()
+
         # Tk变量
         self.conn_text = tk.StringVar(value="MQTT：已断开")
+        self.queue_text = tk.StringVar(value="队列：0，帧耗时：0 ms")
+        self.latency_text = tk.StringVar(value="回显延迟：-- ms")
         self.power_text = tk.StringVar(value="开灯")
         self.temp_text = tk.StringVar(value="温度：-- °C")
         self.hum_text = tk.StringVar(value="湿度：-- %")
@@ -64,15 +129,32 @@ class LampControlPanel:
         self.client_id_var = tk.StringVar(value=self.config["client_id"])
         self.topic_ctrl_var = tk.StringVar(value=self.config["topic_ctrl"])
         self.topic_status_var = tk.StringVar(value=self.config["topic_status"])
+        self.fleet_var = tk.BooleanVar(value=bool(self.config["fleet_mode"]))
+        self.stream_var = tk.BooleanVar(value=bool(self.config["stream_sliders"]))
+        self.group_var = tk.StringVar()
+        self.fleet_text = tk.StringVar(value="设备：0，已选：0")
 
         self.brightness_var = tk.IntVar(value=self.state["brightness"])
         self.color_temp_var = tk.IntVar(value=self.state["color_temp"])
 
+        self.history_db = str(self.config_path.with_name(self.config["history_db"]))
+        self.recorder = (
+            TelemetryRecorder(self.history_db) if self.config["record_history"] else None
+        )
+        self.tracer = (
+            TraceLog(
+                str(self.config_path.with_name(self.config["trace_log"])),
+                on_record=lambda rec: self.ui_queue.put(("log", self._format_trace(rec))),
+            )
+            if self.config["trace"]
+            else None
+        )
+
         self._build_ui()
         self._init_mqtt()
 
         # 轮询处理来自MQTT线程的UI更新任务
-        self.root.after(100, self._process_ui_queue)
+        self.root.after(self.UI_FRAME_MS, self._process_ui_queue)
         self.root.protocol("WM_DELETE_WINDOW", self.on_close)
 
     def _build_ui(self) -> None:
@@ -108,6 +190,9 @@ class LampControlPanel:
         ttk.Entry(mqtt_cfg_frame, textvariable=self.topic_status_var).grid(
             row=2, column=1, sticky="ew", padx=(6, 8), pady=(6, 0)
         )
+        ttk.Checkbutton(mqtt_cfg_frame, text="多设备模式", variable=self.fleet_var).grid(
+            row=2, column=2, sticky="w", pady=(6, 0)
+        )
         ttk.Button(
             mqtt_cfg_frame,
             text="保存并重连",
@@ -118,7 +203,9 @@ class LampControlPanel:
         conn_frame = ttk.LabelFrame(main, text="连接状态", padding=10)
         conn_frame.pack(fill=tk.X, pady=(0, 10))
         self.conn_label = ttk.Label(conn_frame, textvariable=self.conn_text)
-        self.conn_label.pack(anchor=tk.W)
+        self.conn_label.pack(side=tk.LEFT)
+        ttk.Label(conn_frame, textvariable=self.queue_text).pack(side=tk.RIGHT)
+        ttk.Label(conn_frame, textvariable=self.latency_text).pack(side=tk.RIGHT, padx=(0, 12))
 
         # 灯光控制
         ctrl_frame = ttk.LabelFrame(main, text="灯光控制", padding=10)
@@ -130,7 +217,13 @@ class LampControlPanel:
             command=self.on_power_toggle,
             width=10,
         )
-        self.power_button.pack(anchor=tk.W, pady=(0, 12))
+        self.power_button.pack(anchor=tk.W, pady=(0, 4))
+        ttk.Checkbutton(
+            ctrl_frame,
+            text=f"拖动时实时发送（≤{self.config['stream_rate_hz']} 次/秒）",
+            variable=self.stream_var,
+            command=self.on_stream_toggle,
+        ).pack(anchor=tk.W, pady=(0, 8))
 
         ttk.Label(ctrl_frame, text="亮度（0-100）").pack(anchor=tk.W)
         self.brightness_scale = ttk.Scale(
@@ -146,12 +239,15 @@ class LampControlPanel:
         )
         self.brightness_value_label.pack(anchor=tk.W, pady=(2, 10))
 
-        # 只在释放滑块时发送，避免拖动时过多消息
+        # 拖动时按限速实时发送（可关闭），松开时补发最终值
+        self.brightness_scale.bind(
+            "<ButtonPress-1>", lambda _e: self.dragging.add("brightness")
+        )
         self.brightness_scale.bind("<ButtonRelease-1>", self.on_brightness_release)
         self.brightness_scale.bind(
             "<B1-Motion>",
-            lambda _e: self.brightness_value_label.config(
-                text=f"当前值：{int(round(self.brightness_var.get()))}"
+            lambda _e: self._on_slider_drag(
+                "brightness", self.brightness_var, self.brightness_value_label
             ),
         )
 
@@ -169,11 +265,14 @@ class LampControlPanel:
         )
         self.color_temp_value_label.pack(anchor=tk.W, pady=(2, 0))
 
+        self.color_temp_scale.bind(
+            "<ButtonPress-1>", lambda _e: self.dragging.add("color_temp")
+        )
         self.color_temp_scale.bind("<ButtonRelease-1>", self.on_color_temp_release)
         self.color_temp_scale.bind(
             "<B1-Motion>",
-            lambda _e: self.color_temp_value_label.config(
-                text=f"当前值：{int(round(self.color_temp_var.get()))}"
+            lambda _e: self._on_slider_drag(
+                "color_temp", self.color_temp_var, self.color_temp_value_label
             ),
         )
 
@@ -182,10 +281,12 @@ class LampControlPanel:
         env_frame.pack(fill=tk.X, pady=(0, 10))
         ttk.Label(env_frame, textvariable=self.temp_text).pack(anchor=tk.W)
         ttk.Label(env_frame, textvariable=self.hum_text).pack(anchor=tk.W, pady=(4, 0))
+        ttk.Button(env_frame, text="历史曲线", command=self.on_show_history).pack(anchor=tk.E)
 
         # 日志区域
         log_frame = ttk.LabelFrame(main, text="消息日志", padding=10)
         log_frame.pack(fill=tk.BOTH, expand=True)
+        self.log_frame = log_frame
         self.log_text = ScrolledText(log_frame, height=12, wrap=tk.WORD)
         self.log_text.pack(fill=tk.BOTH, expand=True)
         self.log_text.configure(state=tk.DISABLED)
@@ -194,12 +295,83 @@ class LampControlPanel:
         log_btn_row.pack(fill=tk.X, pady=(8, 0))
         ttk.Button(log_btn_row, text="清空日志", command=self.clear_log).pack(anchor=tk.E)
 
+        self._build_fleet_ui(main)
+
         # 初始未连接时禁用控制区，连接成功后自动启用
         self._set_controls_enabled(False)
 
+    def _build_fleet_ui(self, main: ttk.Frame) -> None:
+        """构建多设备列表（仅多设备模式下显示，位于日志区域之前）"""
+        self.fleet_frame = ttk.LabelFrame(main, text="设备列表", padding=10)
+
+        tree_row = ttk.Frame(self.fleet_frame)
+        tree_row.pack(fill=tk.BOTH, expand=True)
+        self.device_tree = ttk.Treeview(
+            tree_row,
+            columns=[c[0] for c in self.FLEET_COLUMNS],
+            height=8,
+            selectmode="extended",
+        )
+        self.device_tree.heading("#0", text="设备ID")
+        self.device_tree.column("#0", width=120, stretch=True)
+        for key, title, width in self.FLEET_COLUMNS:
+            self.device_tree.heading(key, text=title)
+            self.device_tree.column(key, width=width, anchor=tk.CENTER, stretch=False)
+        tree_scroll = ttk.Scrollbar(tree_row, orient=tk.VERTICAL, command=self.device_tree.yview)
+        self.device_tree.configure(yscrollcommand=tree_scroll.set)
+        self.device_tree.pack(side=tk.LEFT, fill=tk.BOTH, expand=True)
+        tree_scroll.pack(side=tk.RIGHT, fill=tk.Y)
+        self.device_tree.bind("<<TreeviewSelect>>", self.on_device_select)
+
+        group_row = ttk.Frame(self.fleet_frame)
+        group_row.pack(fill=tk.X, pady=(8, 0))
+        ttk.Label(group_row, textvariable=self.fleet_text).pack(side=tk.LEFT)
+        ttk.Button(group_row, text="全选", command=self.on_select_all).pack(side=tk.RIGHT)
+        ttk.Button(group_row, text="保存分组", command=self.on_save_group).pack(
+            side=tk.RIGHT, padx=(0, 6)
+        )
+        ttk.Button(group_row, text="选择分组", command=self.on_select_group).pack(
+            side=tk.RIGHT, padx=(0, 6)
+        )
+        self.group_combo = ttk.Combobox(
+            group_row,
+            textvariable=self.group_var,
+            values=sorted(self.config["groups"]),
+            width=12,
+        )
+        self.group_combo.pack(side=tk.RIGHT, padx=(0, 6))
+
+        self._update_fleet_visibility()
+
+    def _update_fleet_visibility(self) -> None:
+        """按当前模式显示/隐藏设备列表"""
+        if self.config["fleet_mode"]:
+            self.fleet_frame.pack(fill=tk.BOTH, expand=True, pady=(0, 10), before=self.log_frame)
+        else:
+            self.fleet_frame.pack_forget()
+
+    @staticmethod
+    def _compile_topic_pattern(pattern: str):
+        """把MQTT通配主题编译为正则，第一个通配段作为设备ID捕获"""
+        parts = []
+        for level in pattern.split("/"):
+            if level == "+":
+                parts.append("([^/]+)")
+            elif level == "#":
+                parts.append("(.+)")
+            else:
+                parts.append(re.escape(level))
+        return re.compile("^" + "/".join(parts) + "$")
+
     def _init_mqtt(self) -> None:
         """初始化并连接MQTT客户端"""
         client_id = self.config["client_id"]
+        self.status_matcher = (
+            self._compile_topic_pattern(self.config["fleet_topic_status"])
+            if self.config["fleet_mode"]
+            else None
+        )
+        self.trace_matcher = self._compile_topic_pattern(self._trace_topic())
         self.client = mqtt.Client(client_id=client_id, protocol=mqtt.MQTTv311)
         self.client.on_connect = self.on_connect
         self.client.on_disconnect = self.on_disconnect
@@ -221,11 +393,13 @@ class LampControlPanel:
     def on_connect(self, client, _userdata, _flags, rc):
         """MQTT连接回调（MQTT线程）"""
         if rc == 0:
-            client.subscribe(self.config["topic_status"], qos=0)
+            topic = self._status_topic()
+            client.subscribe(topic, qos=0)
+            if self.tracer is not None:
+                topic = f"{topic}, {self._trace_topic()}"
+                client.subscribe(self._trace_topic(), qos=0)
             self.ui_queue.put(("connected", None))
-            self.ui_queue.put(
-                ("log", f"[MQTT] 已连接，已订阅：{self.config['topic_status']}")
-            )
+            self.ui_queue.put(("log", f"[MQTT] 已连接，已订阅：{topic}"))
         else:
             self.ui_queue.put(("disconnected", None))
             self.ui_queue.put(("log", f"[错误] MQTT连接被拒绝，返回码：{rc}"))
@@ -243,33 +417,104 @@ class LampControlPanel:
         payload_text = msg.payload.decode("utf-8", errors="ignore")
         self.ui_queue.put(("log", f"[接收] {msg.topic}: {payload_text}"))
 
+        if self.tracer is not None and self.trace_matcher.match(msg.topic):
+            self._on_trace_message(msg.topic, payload_text)
+            return
+
+        device_id = None
+        if self.status_matcher is not None:
+            match = self.status_matcher.match(msg.topic)
+            if match is None or not match.groups():
+                return
+            device_id = match.group(1)
+
         try:
             data = json.loads(payload_text)
             if isinstance(data, dict):
-                self.ui_queue.put(("device_status", data))
+                if self.tracer is not None and isinstance(data.get("tid"), int):
+                    self.tracer.on_status(device_id, data["tid"])
+                self.ui_queue.put(("device_status", (device_id, data)))
+                if self.recorder is not None:
+                    # 单设备模式没有设备ID，以状态主题作为记录的设备名
+                    self.recorder.record(device_id if device_id is not None else msg.topic, data)
             else:
                 self.ui_queue.put(("log", "[错误] 状态消息不是JSON对象"))
         except json.JSONDecodeError as exc:
             self.ui_queue.put(("log", f"[错误] 状态JSON解析失败：{exc}"))
 
+    def _on_trace_message(self, topic: str, payload_text: str) -> None:
+        """设备发布的追踪结果（MQTT线程），设备ID与状态主题保持一致，单设备模式为 None"""
+        match = self.trace_matcher.match(topic)
+        device_id = match.group(1) if self.config["fleet_mode"] and match.groups() else None
+        try:
+            data = json.loads(payload_text)
+        except json.JSONDecodeError as exc:
+            self.ui_queue.put(("log", f"[错误] 追踪JSON解析失败：{exc}"))
+            return
+        if isinstance(data, dict):
+            self.tracer.on_trace(device_id, data)
+
+    @staticmethod
+    def _format_trace(rec: dict) -> str:
+        """一条追踪结果的日志摘要"""
+        def ms(key):
+            value = rec.get(key)
+            return "--" if value is None else f"{value:.1f}"
+
+        if rec["src"] == "panel":
+            return (
+                f"[追踪] 指令->PWM 约 {ms('to_pwm')} ms（MQTT往返 {ms('mqtt_rtt')}，"
+                f"ESP32 {ms('esp_to_uart')}，串口往返 {ms('uart_rtt')}，STM32 {ms('stm32')}）"
+            )
+        return (
+            f"[追踪] 本地->滑块 约 {ms('to_slider')} ms（STM32 {ms('stm32')}，ESP32 {ms('esp')}，"
+            f"MQTT单程估计 {ms('mqtt_est')}，界面 {ms('ui')}）"
+        )
+
     def _process_ui_queue(self) -> None:
-        """在主线程处理MQTT线程投递的事件"""
-        while True:
+        """在主线程处理MQTT线程投递的事件
+
+        每帧把队列中的事件合并后一次性应用：同一设备的多条状态只保留合并后的
+        最新值，日志整批插入，避免高频上报时逐条刷新控件导致界面卡顿。
+        单帧处理数量有上限，剩余事件留到下一帧，保证界面始终可响应。
+        """
+        started = time.perf_counter()
+        log_lines = []
+        statuses = {}  # 设备ID(单设备模式为None) -> 合并后的状态，dict 保持首次出现顺序
+
+        for _ in range(self.UI_MAX_ITEMS_PER_FRAME):
             try:
                 event, payload = self.ui_queue.get_nowait()
             except queue.Empty:
                 break
 
-            if event == "connected":
-                self._set_conn_status(True)
-            elif event == "disconnected":
-                self._set_conn_status(False)
-            elif event == "log":
-                self._log(str(payload))
+            if event == "log":
+                log_lines.append(self._format_log(str(payload)))
             elif event == "device_status":
-                self._apply_device_status(payload)
-
-        self.root.after(100, self._process_ui_queue)
+                device_id, data = payload
+                statuses.setdefault(device_id, {}).update(data)
+            else:
+                # 连接状态变化需要与日志保持先后顺序，先刷出已积累的内容
+                self._flush_batch(log_lines, statuses)
+                log_lines, statuses = [], {}
+                self._set_conn_status(event == "connected")
+
+        self._flush_batch(log_lines, statuses)
+
+        elapsed_ms = (time.perf_counter() - started) * 1000
+        self.queue_text.set(f"队列：{self.ui_queue.qsize()}，帧耗时：{elapsed_ms:.0f} ms")
+        self.root.after(self.UI_FRAME_MS, self._process_ui_queue)
+
+    def _flush_batch(self, log_lines: list, statuses: dict) -> None:
+        """应用一帧内合并后的状态与日志"""
+        for device_id, data in statuses.items():
+            if device_id is not None:
+                self._update_device_row(device_id, data)
+            if device_id is None or device_id == self.focus_id:
+                self._apply_device_status(data)
+            if self.tracer is not None and isinstance(data.get("tid"), int):
+                self.tracer.on_status_applied(device_id, data["tid"])
+        self._append_log_lines(log_lines)
 
     def _set_conn_status(self, connected: bool) -> None:
         """更新连接状态标签"""
@@ -283,11 +528,27 @@ class LampControlPanel:
         self.brightness_scale.configure(state=target_state)
         self.color_temp_scale.configure(state=target_state)
 
+    @staticmethod
+    def _format_log(text: str) -> str:
+        timestamp = datetime.now().strftime("%H:%M:%S")
+        return f"[{timestamp}] {text}\n"
+
     def _log(self, text: str) -> None:
         """追加日志到文本框"""
-        timestamp = datetime.now().strftime("%H:%M:%S")
+        self._append_log_lines([self._format_log(text)])
+
+    def _append_log_lines(self, lines: list) -> None:
+        """整批插入日志，超过 LOG_MAX_LINES 时从头部裁剪"""
+        if not lines:
+            return
+        # 一帧内的日志多于上限时，只插入最后的部分
+        lines = lines[-self.LOG_MAX_LINES :]
         self.log_text.configure(state=tk.NORMAL)
-        self.log_text.insert(tk.END, f"[{timestamp}] {text}\n")
+        self.log_text.insert(tk.END, "".join(lines))
+        # Text 末尾总有一个空行，行数为 end-1 的行号
+        excess = int(self.log_text.index("end-1c").split(".")[0]) - 1 - self.LOG_MAX_LINES
+        if excess > 0:
+            self.log_text.delete("1.0", f"{excess + 1}.0")
         self.log_text.see(tk.END)
         self.log_text.configure(state=tk.DISABLED)
 
@@ -297,6 +558,72 @@ class LampControlPanel:
         self.log_text.delete("1.0", tk.END)
         self.log_text.configure(state=tk.DISABLED)
 
+    def _update_device_row(self, device_id: str, data: dict) -> None:
+        """合并设备上报到状态表，并只刷新该设备所在的一行"""
+        entry = self.devices.get(device_id)
+        is_new = entry is None
+        if is_new:
+            entry = {}
+            self.devices[device_id] = entry
+        entry.update(data)
+        entry["last_seen"] = datetime.now().strftime("%H:%M:%S")
+
+        values = [entry.get(key, "--") for key, _title, _width in self.FLEET_COLUMNS]
+        if is_new:
+            self.device_tree.insert("", tk.END, iid=device_id, text=device_id, values=values)
+            self._update_fleet_text()
+        else:
+            self.device_tree.item(device_id, values=values)
+
+    def _update_fleet_text(self) -> None:
+        self.fleet_text.set(f"设备：{len(self.devices)}，已选：{len(self.selected_ids)}")
+
+    def on_device_select(self, _event=None) -> None:
+        """设备选择变化：首个选中设备作为焦点，其状态显示在灯光控制区"""
+        self.selected_ids = self.device_tree.selection()
+        self.focus_id = self.selected_ids[0] if self.selected_ids else None
+        self._update_fleet_text()
+        if self.focus_id in self.devices:
+            self._apply_device_status(self.devices[self.focus_id])
+
+    def on_select_all(self) -> None:
+        self.device_tree.selection_set(self.device_tree.get_children())
+
+    def on_select_group(self) -> None:
+        """选中分组内当前在线（已上报过）的设备"""
+        members = self.config["groups"].get(self.group_var.get().strip(), [])
+        known = [d for d in members if d in self.devices]
+        self.device_tree.selection_set(known)
+        if len(known) < len(members):
+            self._log(f"[系统] 分组中 {len(members) - len(known)} 台设备尚未上报，未选中")
+
+    def on_save_group(self) -> None:
+        """把当前选择保存为分组（写入配置文件）"""
+        name = self.group_var.get().strip()
+        if not name or not self.selected_ids:
+            self._log("[警告] 请先选择设备并填写分组名")
+            return
+        self.config["groups"][name] = list(self.selected_ids)
+        self._save_config(self.config)
+        self.group_combo.configure(values=sorted(self.config["groups"]))
+        self._log(f"[系统] 已保存分组 {name}（{len(self.selected_ids)} 台）")
+
+    def _status_topic(self) -> str:
+        if self.config["fleet_mode"]:
+            return self.config["fleet_topic_status"]
+        return self.config["topic_status"]
+
+    def _trace_topic(self) -> str:
+        if self.config["fleet_mode"]:
+            return self.config["fleet_topic_trace"]
+        return self.config["topic_trace"]
+
+    def _ctrl_topics(self) -> list:
+        """当前控制目标：单设备模式为固定主题，多设备模式为选中设备的主题"""
+        if not self.config["fleet_mode"]:
+            return [self.config["topic_ctrl"]]
+        return [self.config["fleet_topic_ctrl"].format(id=d) for d in self.selected_ids]
+
     def _apply_device_status(self, data: dict) -> None:
         """根据设备上报状态更新UI，不触发二次发布"""
         self.updating_from_device = True
@@ -305,13 +632,17 @@ class LampControlPanel:
                 self.state["power"] = 1 if int(data["power"]) else 0
                 self.power_text.set("关灯" if self.state["power"] else "开灯")
 
-            if "brightness" in data:
+            if "ack_seq" in data:
+                self._update_latency(int(data["ack_seq"]))
+
+            # 正在拖动的滑块不被回显覆盖，否则会跳回较旧的值
+            if "brightness" in data and "brightness" not in self.dragging:
                 b = max(0, min(100, int(data["brightness"])))
                 self.state["brightness"] = b
                 self.brightness_var.set(b)
                 self.brightness_value_label.config(text=f"当前值：{b}")
 
-            if "color_temp" in data:
+            if "color_temp" in data and "color_temp" not in self.dragging:
                 c = max(0, min(100, int(data["color_temp"])))
                 self.state["color_temp"] = c
                 self.color_temp_var.set(c)
@@ -336,14 +667,34 @@ class LampControlPanel:
             self._log("[警告] MQTT未连接，控制消息未发送")
             return
 
-        try:
-            payload = json.dumps(partial_payload, ensure_ascii=False)
-            result = self.client.publish(self.config["topic_ctrl"], payload=payload, qos=0)
+        topics = self._ctrl_topics()
+        if not topics:
+            self._log("[警告] 未选择设备，控制消息未发送")
+            return
+
+        self.seq = (self.seq + 1) & 0xFFFF
+        self.sent_times[self.seq] = time.perf_counter()
+        if len(self.sent_times) > self.SEQ_HISTORY:
+            self.sent_times.pop(next(iter(self.sent_times)))
 
-            if result.rc == mqtt.MQTT_ERR_SUCCESS:
-                self._log(f"[发送] {self.config['topic_ctrl']}: {payload}")
+        try:
+            # 扇出时负载只序列化一次，发布为异步入队，日志按批次汇总一条
+            message = dict(partial_payload, sid=self.session_id, seq=self.seq)
+            if self.tracer is not None:
+                message["tid"] = self.tracer.new_tid()
+            payload = json.dumps(message, ensure_ascii=False)
+            failed, last_rc = 0, mqtt.MQTT_ERR_SUCCESS
+            for topic in topics:
+                result = self.client.publish(topic, payload=payload, qos=0)
+                if result.rc != mqtt.MQTT_ERR_SUCCESS:
+                    failed, last_rc = failed + 1, result.rc
+
+            if failed:
+                self._log(f"[错误] 发布失败 {failed}/{len(topics)}，错误码：{last_rc}")
+            elif len(topics) == 1:
+                self._log(f"[发送] {topics[0]}: {payload}")
             else:
-                self._log(f"[错误] 发布失败，错误码：{result.rc}")
+                self._log(f"[发送] {len(topics)} 台设备: {payload}")
         except Exception as exc:
             self._log(f"[错误] 发布控制消息失败：{exc}")
 
@@ -359,6 +710,11 @@ class LampControlPanel:
             merged = dict(self.DEFAULT_CONFIG)
             merged.update(data)
             merged["port"] = int(merged["port"])
+            merged["fleet_mode"] = bool(merged["fleet_mode"])
+            merged["stream_rate_hz"] = max(1, int(merged["stream_rate_hz"]))
+            merged["trace"] = bool(merged["trace"])
+            if not isinstance(merged["groups"], dict):
+                merged["groups"] = {}
             return merged
         except Exception:
             # 配置损坏时回退默认值，保证程序可启动
@@ -382,6 +738,24 @@ class LampControlPanel:
                 "topic_status": self.topic_status_var.get().strip()
                 or self.DEFAULT_CONFIG["topic_status"],
             }
+            # 多设备主题与分组只在配置文件中编辑，这里沿用当前值
+            for key in (
+                "fleet_topic_status",
+                "fleet_topic_ctrl",
+                "groups",
+                "stream_sliders",
+                "stream_rate_hz",
+                "record_history",
+                "history_db",
+                "trace",
+                "topic_trace",
+                "fleet_topic_trace",
+                "trace_log",
+            ):
+                new_cfg[key] = self.config[key]
+            new_cfg["fleet_mode"] = bool(self.fleet_var.get())
+            if new_cfg["fleet_mode"] and "{id}" not in new_cfg["fleet_topic_ctrl"]:
+                raise ValueError("fleet_topic_ctrl 必须包含 {id} 占位符")
             if new_cfg["port"] <= 0 or new_cfg["port"] > 65535:
                 raise ValueError("端口必须在1-65535之间")
         except Exception as exc:
@@ -392,6 +766,14 @@ class LampControlPanel:
         self._save_config(new_cfg)
         self._log("[系统] 配置已保存，正在重连MQTT...")
 
+        # 切换模式后清空设备表，重连后按新订阅重新收集
+        self.devices.clear()
+        self.device_tree.delete(*self.device_tree.get_children())
+        self.selected_ids = ()
+        self.focus_id = None
+        self._update_fleet_text()
+        self._update_fleet_visibility()
+
         try:
             self.client.loop_stop()
             self.client.disconnect()
@@ -410,35 +792,95 @@ class LampControlPanel:
 
     def on_brightness_release(self, _event=None) -> None:
         """亮度滑块释放事件"""
-        value = int(round(self.brightness_var.get()))
-        self.brightness_var.set(value)
-        self.brightness_value_label.config(text=f"当前值：{value}")
+        self._on_slider_release("brightness", self.brightness_var, self.brightness_value_label)
 
-        if self.updating_from_device:
+    def on_color_temp_release(self, _event=None) -> None:
+        """色温滑块释放事件"""
+        self._on_slider_release("color_temp", self.color_temp_var, self.color_temp_value_label)
+
+    def on_stream_toggle(self) -> None:
+        """切换拖动实时发送，并保存到配置文件"""
+        self.config["stream_sliders"] = bool(self.stream_var.get())
+        self._save_config(self.config)
+
+    def _on_slider_drag(self, field: str, var: tk.IntVar, label: ttk.Label) -> None:
+        """拖动中：刷新数值；开启实时发送时按限速发送
+
+        前沿：距上次发送超过最小间隔则立即发送；否则登记一个定时器，
+        在间隔到期时发送届时的最新值（尾沿），保证停顿时设备也能跟上。
+        """
+        value = int(round(var.get()))
+        label.config(text=f"当前值：{value}")
+        if self.updating_from_device or not self.stream_var.get():
             return
 
-        self.state["brightness"] = value
-        self.publish_control({"brightness": value})
+        st = self.stream[field]
+        if st["timer"] is not None:
+            return  # 尾沿定时器到期时会读取最新值
+        wait_s = st["last_time"] + 1.0 / self.config["stream_rate_hz"] - time.perf_counter()
+        if wait_s <= 0:
+            self._stream_send(field, value)
+        else:
+            st["timer"] = self.root.after(
+                int(wait_s * 1000) + 1, lambda: self._stream_flush(field, var)
+            )
 
-    def on_color_temp_release(self, _event=None) -> None:
-        """色温滑块释放事件"""
-        value = int(round(self.color_temp_var.get()))
-        self.color_temp_var.set(value)
-        self.color_temp_value_label.config(text=f"当前值：{value}")
+    def _stream_flush(self, field: str, var: tk.IntVar) -> None:
+        """尾沿定时器：发送拖动中的最新值"""
+        self.stream[field]["timer"] = None
+        if field in self.dragging:
+            self._stream_send(field, int(round(var.get())))
+
+    def _stream_send(self, field: str, value: int) -> None:
+        st = self.stream[field]
+        if value == st["last_sent"]:
+            return
+        st["last_sent"] = value
+        st["last_time"] = time.perf_counter()
+        self.state[field] = value
+        self.publish_control({field: value})
+
+    def _on_slider_release(self, field: str, var: tk.IntVar, label: ttk.Label) -> None:
+        """松开：取消待发的尾沿，立即发送最终值（与实时发送的最后一条相同则不重复发送）"""
+        self.dragging.discard(field)
+        st = self.stream[field]
+        if st["timer"] is not None:
+            self.root.after_cancel(st["timer"])
+            st["timer"] = None
+
+        value = int(round(var.get()))
+        var.set(value)
+        label.config(text=f"当前值：{value}")
 
         if self.updating_from_device:
             return
 
-        self.state["color_temp"] = value
-        self.publish_control({"color_temp": value})
+        self._stream_send(field, value)
+        st["last_sent"] = None  # 下一次拖动重新开始，允许再次发送相同的值
+
+    def _update_latency(self, ack_seq: int) -> None:
+        """设备回显了某条指令的序号：显示从发送到回显的延迟"""
+        sent = self.sent_times.pop(ack_seq, None)
+        if sent is not None:
+            self.latency_text.set(f"回显延迟：{(time.perf_counter() - sent) * 1000:.0f} ms")
+
+    def on_show_history(self) -> None:
+        """打开历史曲线窗口（默认显示当前设备）"""
+        if self.config["fleet_mode"]:
+            devices = list(self.selected_ids)
+        else:
+            devices = [self.config["topic_status"]]
+        HistoryView(self.root, self.history_db, devices)
 
     def on_close(self) -> None:
-        """窗口关闭时清理MQTT连接"""
+        """窗口关闭时清理MQTT连接，并写完尚未入库的历史数据"""
         try:
             self.client.loop_stop()
             self.client.disconnect()
         except Exception:
             pass
+        if self.recorder is not None:
+            self.recorder.close()
         self.root.destroy()
 
 
@@ -0,0 +1,296 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+遥测记录与历史曲线
+- TelemetryRecorder: 后台线程把状态消息批量写入 SQLite，并定期汇总为分钟/小时数据
+- HistoryView: 历史曲线窗口（tkinter Canvas 绘制，不依赖额外绘图库）
+"""
+
+import queue
+import sqlite3
+import threading
+import time
+import tkinter as tk
+from datetime import datetime
+from tkinter import ttk
+
+# 记录的字段（与设备状态JSON字段同名）
+FIELDS = ("power", "brightness", "color_temp", "temp", "hum", "lux")
+
+SCHEMA = """
+CREATE TABLE IF NOT EXISTS samples (
+    device TEXT NOT NULL,
+    ts REAL NOT NULL,
+    power INTEGER, brightness INTEGER, color_temp INTEGER,
+    temp REAL, hum REAL, lux REAL
+);
+CREATE INDEX IF NOT EXISTS idx_samples_device_ts ON samples(device, ts);
+CREATE INDEX IF NOT EXISTS idx_samples_ts ON samples(ts);
+CREATE TABLE IF NOT EXISTS rollup (
+    device TEXT NOT NULL,
+    res INTEGER NOT NULL,
+    bucket INTEGER NOT NULL,
+    n INTEGER NOT NULL,
+    power REAL, brightness REAL, color_temp REAL,
+    temp REAL, hum REAL, lux REAL,
+    PRIMARY KEY (device, res, bucket)
+) WITHOUT ROWID;
+"""
+
+
+class TelemetryRecorder:
+    """状态消息记录器
+
+    record() 可在任意线程调用，只做入队；写库、汇总与过期清理都在后台线程完成：
+    - 消息攒批后在一个事务内 executemany 写入（满 BATCH_SIZE 条或每 FLUSH_INTERVAL 秒）
+    - 每 ROLLUP_INTERVAL 秒把新数据汇总到 rollup 表（分钟、小时两档）
+    - 原始数据与分钟汇总按保留期清理，小时汇总长期保留
+    """
+
+    BATCH_SIZE = 500
+    FLUSH_INTERVAL = 1.0
+    ROLLUP_INTERVAL = 60.0
+    ROLLUP_RESOLUTIONS = (60, 3600)
+    RAW_RETENTION_DAYS = 14
+    MINUTE_RETENTION_DAYS = 180
+
+    def __init__(self, db_path: str) -> None:
+        self.db_path = db_path
+        self.queue = queue.Queue()
+        self.recorded = 0
+        self._stop = threading.Event()
+        self._thread = threading.Thread(target=self._run, name="TelemetryRecorder", daemon=True)
+        self._thread.start()
+
+    def record(self, device: str, data: dict, ts: float = None) -> None:
+        """记录一条状态（只取已知字段，没有已知字段的消息忽略）"""
+        if not any(key in data for key in FIELDS):
+            return
+        row = [device, time.time() if ts is None else ts]
+        for key in FIELDS:
+            value = data.get(key)
+            row.append(value if isinstance(value, (int, float)) else None)
+        self.queue.put(row)
+
+    def close(self) -> None:
+        """写完队列中剩余的数据后退出后台线程"""
+        self._stop.set()
+        self._thread.join()
+
+    # ---------------- 后台线程 ----------------
+
+    def _run(self) -> None:
+        conn = sqlite3.connect(self.db_path)
+        # WAL 模式下历史曲线的读连接不会被写入阻塞
+        conn.execute("PRAGMA journal_mode=WAL")
+        conn.execute("PRAGMA synchronous=NORMAL")
+        conn.executescript(SCHEMA)
+        watermark = self._load_watermark(conn)
+
+        batch = []
+        last_flush = last_rollup = time.monotonic()
+        while True:
+            try:
+                batch.append(self.queue.get(timeout=self.FLUSH_INTERVAL))
+                # 一次取空已到达的数据，减少逐条唤醒
+                while len(batch) < self.BATCH_SIZE:
+                    batch.append(self.queue.get_nowait())
+            except queue.Empty:
+                pass
+
+            now = time.monotonic()
+            stopping = self._stop.is_set() and self.queue.empty()
+            if batch and (
+                len(batch) >= self.BATCH_SIZE or now - last_flush >= self.FLUSH_INTERVAL or stopping
+            ):
+                with conn:
+                    conn.executemany("INSERT INTO samples VALUES (?,?,?,?,?,?,?,?)", batch)
+                self.recorded += len(batch)
+                batch = []
+                last_flush = now
+
+            if now - last_rollup >= self.ROLLUP_INTERVAL or stopping:
+                watermark = self._rollup(conn, watermark)
+                last_rollup = now
+
+            if stopping and not batch:
+                break
+        conn.close()
+
+    @staticmethod
+    def _load_watermark(conn: sqlite3.Connection) -> float:
+        """从已有汇总的最后一个小时桶开始，重启后只重算未完成的部分"""
+        row = conn.execute("SELECT MAX(bucket) FROM rollup WHERE res = 3600").fetchone()
+        return float(row[0]) if row[0] is not None else 0.0
+
+    def _rollup(self, conn: sqlite3.Connection, watermark: float) -> float:
+        """汇总 watermark 之后的原始数据（最后一个桶未满，下次会整桶重算覆盖）"""
+        row = conn.execute("SELECT MAX(ts) FROM samples").fetchone()
+        if row[0] is None:
+            return watermark
+        newest = row[0]
+
+        with conn:
+            for res in self.ROLLUP_RESOLUTIONS:
+                start = int(watermark // res) * res
+                conn.execute(
+                    """
+                    INSERT OR REPLACE INTO rollup
+                    SELECT device, ?, CAST(ts / ? AS INTEGER) * ?, COUNT(*),
+                           AVG(power), AVG(brightness), AVG(color_temp),
+                           AVG(temp), AVG(hum), AVG(lux)
+                    FROM samples INDEXED BY idx_samples_ts WHERE ts >= ?
+                    GROUP BY device, CAST(ts / ? AS INTEGER)
+                    """,
+                    (res, res, res, start, res),
+                )
+
+            now = time.time()
+            conn.execute(
+                "DELETE FROM samples WHERE ts < ?", (now - self.RAW_RETENTION_DAYS * 86400,)
+            )
+            conn.execute(
+                "DELETE FROM rollup WHERE res = 60 AND bucket < ?",
+                (now - self.MINUTE_RETENTION_DAYS * 86400,),
+            )
+        return newest
+
+
+def query_history(conn: sqlite3.Connection, device: str, start: float, end: float, points: int):
+    """查询 [start, end] 区间的曲线数据，返回 (ts, {字段: 值}) 列表
+
+    按区间长度选择数据源（1天内原始数据，30天内分钟汇总，更长用小时汇总），
+    再在 SQL 中按 (区间/points) 宽度分桶平均，返回点数不超过 points。
+    """
+    span = max(end - start, 1.0)
+    width = max(span / points, 1.0)
+    columns = ", ".join(f"AVG({key})" for key in FIELDS)
+    if span <= 86400:
+        sql = (
+            f"SELECT CAST(ts / ? AS INTEGER) AS b, {columns} FROM samples "
+            "WHERE device = ? AND ts BETWEEN ? AND ? GROUP BY b ORDER BY b"
+        )
+        args = (width, device, start, end)
+    else:
+        res = 60 if span <= 30 * 86400 else 3600
+        width = max(width, res)
+        sql = (
+            f"SELECT CAST(bucket / ? AS INTEGER) AS b, {columns} FROM rollup "
+            "WHERE device = ? AND res = ? AND bucket BETWEEN ? AND ? GROUP BY b ORDER BY b"
+        )
+        args = (width, device, res, start, end)
+
+    result = []
+    for row in conn.execute(sql, args):
+        values = {key: row[i + 1] for i, key in enumerate(FIELDS)}
+        result.append((row[0] * width, values))
+    return result
+
+
+class HistoryView:
+    """历史曲线窗口：每个字段一条曲线，纵向排列"""
+
+    RANGES = (
+        ("1 小时", 3600),
+        ("24 小时", 86400),
+        ("7 天", 7 * 86400),
+        ("30 天", 30 * 86400),
+        ("1 年", 365 * 86400),
+    )
+    SERIES = (
+        ("brightness", "亮度 %", "#d08000"),
+        ("color_temp", "色温 %", "#3070c0"),
+        ("temp", "温度 °C", "#c03030"),
+        ("hum", "湿度 %", "#20a060"),
+        ("lux", "光照", "#806020"),
+    )
+    MAX_POINTS = 600
+
+    def __init__(self, master: tk.Misc, db_path: str, devices: list) -> None:
+        self.conn = sqlite3.connect(db_path)
+        self.conn.executescript(SCHEMA)  # 未开启记录时数据库可能还是空的
+        self.win = tk.Toplevel(master)
+        self.win.title("历史曲线")
+        self.win.geometry("720x620")
+        self.win.protocol("WM_DELETE_WINDOW", self.close)
+
+        bar = ttk.Frame(self.win, padding=8)
+        bar.pack(fill=tk.X)
+        known = sorted(set(self._known_devices()) | set(devices))
+        self.device_var = tk.StringVar(value=(devices or known or [""])[0])
+        self.range_var = tk.StringVar(value=self.RANGES[1][0])
+        ttk.Label(bar, text="设备").pack(side=tk.LEFT)
+        ttk.Combobox(bar, textvariable=self.device_var, values=known, width=20).pack(
+            side=tk.LEFT, padx=(6, 12)
+        )
+        ttk.Label(bar, text="范围").pack(side=tk.LEFT)
+        range_box = ttk.Combobox(
+            bar,
+            textvariable=self.range_var,
+            values=[r[0] for r in self.RANGES],
+            state="readonly",
+            width=8,
+        )
+        range_box.pack(side=tk.LEFT, padx=(6, 12))
+        range_box.bind("<<ComboboxSelected>>", lambda _e: self.refresh())
+        ttk.Button(bar, text="刷新", command=self.refresh).pack(side=tk.LEFT)
+        self.info_text = tk.StringVar()
+        ttk.Label(bar, textvariable=self.info_text).pack(side=tk.RIGHT)
+
+        self.canvas = tk.Canvas(self.win, background="white", highlightthickness=0)
+        self.canvas.pack(fill=tk.BOTH, expand=True)
+        self.canvas.bind("<Configure>", lambda _e: self.refresh())
+
+    def _known_devices(self) -> list:
+        rows = self.conn.execute("SELECT DISTINCT device FROM rollup WHERE res = 3600").fetchall()
+        return sorted(r[0] for r in rows)
+
+    def refresh(self) -> None:
+        span = dict(self.RANGES)[self.range_var.get()]
+        end = time.time()
+        started = time.perf_counter()
+        data = query_history(self.conn, self.device_var.get(), end - span, end, self.MAX_POINTS)
+        query_ms = (time.perf_counter() - started) * 1000
+        self.info_text.set(f"{len(data)} 点，查询 {query_ms:.0f} ms")
+        self._draw(data, end - span, end)
+
+    def _draw(self, data: list, start: float, end: float) -> None:
+        c = self.canvas
+        c.delete("all")
+        w, h = c.winfo_width(), c.winfo_height()
+        if w < 100 or h < 100:
+            return
+        left, right, top = 70, 10, 10
+        row_h = (h - top - 24) / len(self.SERIES)
+        fmt = "%H:%M" if end - start <= 86400 else "%m-%d"
+        c.create_text(left, h - 12, text=datetime.fromtimestamp(start).strftime(fmt), anchor="w")
+        c.create_text(w - right, h - 12, text=datetime.fromtimestamp(end).strftime(fmt), anchor="e")
+
+        for i, (key, title, color) in enumerate(self.SERIES):
+            y0 = top + i * row_h
+            y1 = y0 + row_h - 8
+            c.create_rectangle(left, y0, w - right, y1, outline="#cccccc")
+            c.create_text(6, (y0 + y1) / 2, text=title, anchor="w")
+
+            pts = [(ts, v[key]) for ts, v in data if v[key] is not None]
+            if not pts:
+                continue
+            lo = min(p[1] for p in pts)
+            hi = max(p[1] for p in pts)
+            if hi - lo < 1e-6:
+                lo, hi = lo - 1, hi + 1
+            c.create_text(left - 4, y0 + 2, text=f"{hi:.0f}", anchor="ne", fill="#888888")
+            c.create_text(left - 4, y1 - 2, text=f"{lo:.0f}", anchor="se", fill="#888888")
+
+            coords = []
+            for ts, value in pts:
+                coords.append(left + (ts - start) / (end - start) * (w - right - left))
+                coords.append(y1 - (value - lo) / (hi - lo) * (y1 - y0))
+            if len(coords) >= 4:
+                c.create_line(*coords, fill=color, width=1.5)
+            else:
+                c.create_oval(coords[0] - 2, coords[1] - 2, coords[0] + 2, coords[1] + 2, fill=color)
+
+    def close(self) -> None:
+        self.conn.close()
+        self.win.destroy()
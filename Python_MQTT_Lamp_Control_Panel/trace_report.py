@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+延迟追踪日志统计
+用法: python trace_report.py [trace.log] [--since 分钟]
+按追踪来源分别输出每一跳的分位数与直方图（字段含义见 tracing.py）
+"""
+
+import argparse
+import json
+import time
+from pathlib import Path
+
+from tracing import PANEL_HOPS, STM32_HOPS
+
+# 直方图桶上界（毫秒），最后一桶收容更大的值
+BUCKETS_MS = (1, 2, 5, 10, 20, 50, 100, 200, 500, 1000)
+BAR_WIDTH = 40
+
+TITLES = {
+    "panel": "面板指令 -> PWM 生效",
+    "stm32": "本地操作 -> 面板滑块",
+}
+
+
+def load(path: Path, since: float) -> dict:
+    """读取日志，按来源分组，跳过损坏的行"""
+    groups = {"panel": [], "stm32": []}
+    with path.open("r", encoding="utf-8") as f:
+        for line in f:
+            try:
+                rec = json.loads(line)
+            except json.JSONDecodeError:
+                continue
+            if rec.get("ts", 0) >= since and rec.get("src") in groups:
+                groups[rec["src"]].append(rec)
+    return groups
+
+
+def percentile(values: list, p: float) -> float:
+    k = min(len(values) - 1, max(0, int(round(p / 100 * (len(values) - 1)))))
+    return values[k]
+
+
+def histogram(values: list) -> list:
+    counts = [0] * (len(BUCKETS_MS) + 1)
+    for v in values:
+        i = 0
+        while i < len(BUCKETS_MS) and v > BUCKETS_MS[i]:
+            i += 1
+        counts[i] += 1
+    peak = max(counts) or 1
+    # 只输出首个到最后一个非空桶之间的行
+    used = [i for i, n in enumerate(counts) if n]
+    lines = []
+    for i in range(used[0], used[-1] + 1):
+        n = counts[i]
+        label = f"<= {BUCKETS_MS[i]}" if i < len(BUCKETS_MS) else f" > {BUCKETS_MS[-1]}"
+        bar = "#" * max(1 if n else 0, round(n / peak * BAR_WIDTH))
+        lines.append(f"    {label:>7} ms |{bar:<{BAR_WIDTH}}| {n}")
+    return lines
+
+
+def report(src: str, records: list, hops: tuple, show_hist: bool) -> None:
+    dropped = sum(r.get("drop") or 0 for r in records)
+    print(f"== {TITLES[src]}：{len(records)} 条（设备端覆盖/超时丢弃 {dropped} 条）")
+    if not records:
+        return
+    print(f"  {'跳':<12}{'p50':>9}{'p90':>9}{'p99':>9}{'max':>9}")
+    for hop in hops:
+        values = sorted(r[hop] for r in records if isinstance(r.get(hop), (int, float)))
+        if not values:
+            continue
+        row = "".join(f"{percentile(values, p):9.1f}" for p in (50, 90, 99))
+        print(f"  {hop:<12}{row}{values[-1]:9.1f}")
+        if show_hist:
+            print("\n".join(histogram(values)))
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="延迟追踪日志统计")
+    parser.add_argument("log", nargs="?", default=str(Path(__file__).with_name("trace.log")))
+    parser.add_argument("--since", type=float, default=0, help="只统计最近 N 分钟（0 为全部）")
+    parser.add_argument("--no-hist", action="store_true", help="只输出分位数")
+    args = parser.parse_args()
+
+    path = Path(args.log)
+    if not path.exists():
+        raise SystemExit(f"找不到追踪日志：{path}")
+    since = time.time() - args.since * 60 if args.since > 0 else 0
+    groups = load(path, since)
+    report("panel", groups["panel"], PANEL_HOPS, not args.no_hist)
+    print()
+    report("stm32", groups["stm32"], STM32_HOPS, not args.no_hist)
+
+
+if __name__ == "__main__":
+    main()
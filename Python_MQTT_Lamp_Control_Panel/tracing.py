@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+端到端延迟追踪
+- 面板发起（tid 由面板生成）：面板发送 -> ESP32 收到 -> 写入 STM32 串口 -> PWM 生效 -> 回执 -> 面板
+- 本地发起（tid 由 STM32 生成）：旋钮/手势 -> STM32 上报 -> ESP32 发布状态 -> 面板滑块更新
+设备发布的追踪结果只含各自时钟下的差值（格式见 ESP32 latency_trace.h），
+本模块结合面板侧的发送/到达/界面更新时刻拆分出每一跳的耗时，逐条写入 JSON Lines 日志。
+"""
+
+import json
+import random
+import threading
+import time
+
+# 各跳字段（毫秒），trace_report.py 按此顺序统计
+PANEL_HOPS = ("mqtt_rtt", "esp_to_uart", "uart_rtt", "stm32", "esp_publish", "to_pwm", "total")
+STM32_HOPS = ("stm32", "esp", "mqtt_est", "ui", "to_slider")
+
+
+class TraceLog:
+    """追踪结果的拼接与记录（线程安全）
+
+    面板发起的追踪在收到设备的追踪结果时完成；本地发起的追踪还需等待
+    带同一 tid 的状态在界面上应用后才完成，两者先后顺序不定。
+    """
+
+    MAX_PENDING = 256
+
+    def __init__(self, path: str, on_record=None) -> None:
+        """on_record(rec) 在完成一条追踪后调用（可能在MQTT线程或UI线程）"""
+        self.path = path
+        self.on_record = on_record
+        self._lock = threading.Lock()
+        self._next_tid = random.getrandbits(30) + 1
+        self._sent = {}  # tid -> 发送时刻
+        self._pending = {}  # (设备, tid) -> 本地发起追踪的部分结果
+        self._mqtt_rtt_ms = None  # 最近一次测得的 MQTT 往返，用于估算单程
+
+    def new_tid(self) -> int:
+        """为一条控制消息分配追踪编号（31 位，不为 0）"""
+        with self._lock:
+            tid = self._next_tid
+            self._next_tid = (self._next_tid % 0x7FFFFFFF) + 1
+            self._sent[tid] = time.perf_counter()
+            self._trim(self._sent)
+            return tid
+
+    def on_trace(self, device: str, data: dict) -> None:
+        """收到设备的追踪结果（MQTT线程）"""
+        now = time.perf_counter()
+        tid = data.get("tid")
+        hops = data.get("hops") or {}
+        if not isinstance(tid, int) or not isinstance(hops, dict):
+            return
+        if data.get("src") == "panel":
+            with self._lock:
+                # 多设备扇出时同一 tid 会收到多条结果，发送时刻不删除，由 _trim 淘汰
+                sent = self._sent.get(tid)
+            if sent is not None:
+                self._write(self._panel_record(device, data, hops, now - sent))
+        else:
+            self._merge(device, tid, {"data": data, "hops": hops})
+
+    def on_status(self, device: str, tid: int) -> None:
+        """带 tid 的状态到达（MQTT线程）"""
+        self._merge(device, tid, {"status_at": time.perf_counter()})
+
+    def on_status_applied(self, device: str, tid: int) -> None:
+        """带 tid 的状态已更新到界面（UI线程）"""
+        self._merge(device, tid, {"applied_at": time.perf_counter()})
+
+    # ---------------- 内部 ----------------
+
+    def _merge(self, device: str, tid: int, part: dict) -> None:
+        key = (device, tid)
+        with self._lock:
+            entry = self._pending.setdefault(key, {})
+            entry.update(part)
+            if not {"data", "status_at", "applied_at"} <= entry.keys():
+                self._trim(self._pending)
+                return
+            del self._pending[key]
+            rtt = self._mqtt_rtt_ms
+        self._write(self._stm32_record(device, tid, entry, rtt))
+
+    def _trim(self, table: dict) -> None:
+        while len(table) > self.MAX_PENDING:
+            table.pop(next(iter(table)))
+
+    def _panel_record(self, device: str, data: dict, hops: dict, total_s: float) -> dict:
+        us = lambda name: hops.get(name, 0)  # noqa: E731
+        total = total_s * 1000
+        stm32 = data.get("stm32_us", 0) / 1000
+        mqtt_rtt = max(total - us("mqtt_tx") / 1000, 0.0)
+        uart_rtt = max((us("uart_rx") - us("uart_tx")) / 1000 - stm32, 0.0)
+        with self._lock:
+            self._mqtt_rtt_ms = mqtt_rtt
+        rec = {
+            "mqtt_rtt": mqtt_rtt,
+            "esp_to_uart": us("uart_tx") / 1000,
+            "uart_rtt": uart_rtt,
+            "stm32": stm32,
+            "esp_publish": (us("mqtt_tx") - us("uart_rx")) / 1000,
+            "total": total,
+        }
+        # 指令到 PWM 生效：去程取往返的一半
+        rec["to_pwm"] = mqtt_rtt / 2 + rec["esp_to_uart"] + uart_rtt / 2 + stm32
+        return self._finish("panel", device, data, rec)
+
+    def _stm32_record(self, device: str, tid: int, entry: dict, rtt) -> dict:
+        data, hops = entry["data"], entry["hops"]
+        rec = {
+            "stm32": data.get("stm32_us", 0) / 1000,
+            "esp": (hops.get("mqtt_tx", 0) - hops.get("uart_rx", 0)) / 1000,
+            # 两端时钟不同步，单程取最近一次面板发起追踪测得往返的一半
+            "mqtt_est": rtt / 2 if rtt is not None else None,
+            "ui": (entry["applied_at"] - entry["status_at"]) * 1000,
+        }
+        rec["to_slider"] = sum(v for v in rec.values() if v is not None)
+        return self._finish("stm32", device, data, rec)
+
+    def _finish(self, src: str, device: str, data: dict, hops_ms: dict) -> dict:
+        rec = {
+            "ts": round(time.time(), 3),
+            "src": src,
+            "device": device,
+            "tid": data.get("tid"),
+            "drop": data.get("drop", 0),
+        }
+        rec.update({k: (round(v, 2) if v is not None else None) for k, v in hops_ms.items()})
+        return rec
+
+    def _write(self, rec: dict) -> None:
+        try:
+            with open(self.path, "a", encoding="utf-8") as f:
+                f.write(json.dumps(rec, ensure_ascii=False) + "\n")
+        except OSError:
+            pass  # 日志写入失败不影响控制
+        if self.on_record is not None:
+            self.on_record(rec)
@@ -0,0 +1,169 @@
+/**
+  ******************************************************************************
+  * @file    host_clock.c
+  * @brief   虚拟时钟，替代 System/SystemSupport.c
+  * @note    1. 节拍由虚拟时间直接换算 (1ms)，不需要 SysTick 中断
+  *          2. Delay_* 与各替身的建模耗时都经 Host_Advance 推进时间，期间
+  *             按时间顺序投递外设事件，相当于忙等时被中断抢占
+  *          3. DWT->CYCCNT 随虚拟时间按 72MHz 递增，Profiler 探针读取到的是
+  *             建模耗时 (总线、Flash、延时)；Host_SetCpuScale 非 0 时 PROF_NOW
+  *             (Host_ProfNow) 另把主机上纯计算的时间按倍数折算进来
+  ******************************************************************************
+  */
+#include "host_internal.h"
+#include "SystemSupport.h"
+#include <time.h>
+
+#define HOST_DWT_CYCCNT     (*(volatile uint32_t *)0xE0001004)
+
+static uint64_t s_NowNs = 0;
+static double   s_CpuScale = 0.0;
+static uint64_t s_CpuMarkNs = 0;
+static uint8_t  s_InAdvance = 0;
+
+static uint64_t _ThreadCpuNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// CYCCNT 按纳秒换算 (而非整微秒)，折算主机 CPU 时间时短探针也有周期级分辨率
+static void _AddNs(uint64_t ns)
+{
+    uint64_t before = s_NowNs * (HOST_CORE_CLOCK_HZ / 1000000) / 1000;
+
+    s_NowNs += ns;
+    HOST_DWT_CYCCNT += (uint32_t)(s_NowNs * (HOST_CORE_CLOCK_HZ / 1000000) / 1000 - before);
+}
+
+void Host_Clock_Reset(void)
+{
+    s_NowNs = 0;
+    s_CpuScale = 0.0;
+    s_InAdvance = 0;
+    s_CpuMarkNs = _ThreadCpuNs();
+}
+
+void Host_SetCpuScale(double scale)
+{
+    s_CpuScale = scale;
+    s_CpuMarkNs = _ThreadCpuNs();
+}
+
+void Host_Clock_Sync(void)
+{
+    uint64_t cpu;
+
+    if (s_CpuScale <= 0.0) return;
+    cpu = _ThreadCpuNs();
+    _AddNs((uint64_t)((double)(cpu - s_CpuMarkNs) * s_CpuScale));
+    s_CpuMarkNs = cpu;
+}
+
+uint64_t Host_NowUs(void)
+{
+    Host_Clock_Sync();
+    return s_NowNs / 1000;
+}
+
+static void _RunUntilNs(uint64_t target)
+{
+    uint64_t next;
+
+    Host_Clock_Sync();
+    // 外设事件处理函数中的建模耗时只推进时间，不再嵌套投递
+    if (s_InAdvance) {
+        if (target > s_NowNs) _AddNs(target - s_NowNs);
+        return;
+    }
+
+    s_InAdvance = 1;
+    for (;;) {
+        next = Host_Periph_NextEvent();
+        // PRIMASK 置位期间中断挂起，在 __enable_irq 处补投递
+        if (!Host_IrqMasked() && next != HOST_NO_EVENT && next * 1000 <= target) {
+            if (next * 1000 > s_NowNs) _AddNs(next * 1000 - s_NowNs);
+            Host_Periph_Service(s_NowNs / 1000);
+            continue;
+        }
+        break;
+    }
+    if (target > s_NowNs) _AddNs(target - s_NowNs);
+    s_InAdvance = 0;
+
+    // 仿真器自身的开销不计入固件
+    if (s_CpuScale > 0.0) s_CpuMarkNs = _ThreadCpuNs();
+}
+
+void Host_RunUntil(uint64_t us)
+{
+    _RunUntilNs(us * 1000);
+}
+
+void Host_Clock_AdvanceNs(uint32_t ns)
+{
+    Host_Clock_Sync();
+    _RunUntilNs(s_NowNs + ns);
+}
+
+uint32_t Host_ProfNow(void)
+{
+    Host_Clock_Sync();
+    return HOST_DWT_CYCCNT;
+}
+
+void Host_ProfCounterReset(void)
+{
+    HOST_DWT_CYCCNT = 0;
+}
+
+void Host_Advance(uint32_t us)
+{
+    Host_RunUntil(Host_NowUs() + us);
+}
+
+// 休眠到下一个中断：外设事件或下一个毫秒节拍，取较早者
+void Host_Idle(void)
+{
+    uint64_t now = Host_NowUs();
+    uint64_t wake = (now / SYSTEM_TICK_PERIOD_US + 1) * SYSTEM_TICK_PERIOD_US;
+    uint64_t next = Host_Periph_NextEvent();
+
+    if (next != HOST_NO_EVENT && next > now && next < wake) wake = next;
+    Host_RunUntil(wake);
+}
+
+/* ============================================================
+ *                 SystemSupport.h
+ * ============================================================ */
+
+void System_Init(void)
+{
+    NVIC_PriorityGroupConfig(NVIC_PriorityGroup_2);
+    SysTick_Config(SystemCoreClock / SYSTEM_TICK_FREQ);
+}
+
+uint32_t System_GetTick(void)
+{
+    return (uint32_t)(Host_NowUs() / SYSTEM_TICK_PERIOD_US);
+}
+
+void System_IncTick(void)
+{
+}
+
+uint32_t System_GetMicros(void)
+{
+    return (uint32_t)Host_NowUs();
+}
+
+void Delay_us(uint32_t us)
+{
+    Host_Advance(us);
+}
+
+void Delay_ms(uint32_t ms)
+{
+    Host_Advance(ms * 1000);
+}
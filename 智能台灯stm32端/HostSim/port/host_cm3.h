@@ -0,0 +1,69 @@
+#ifndef __HOST_CM3_H
+#define __HOST_CM3_H
+
+/**
+  ******************************************************************************
+  * @file    host_cm3.h
+  * @brief   主机侧构建的 Cortex-M3 内核替身 (由编译选项 -include 强制包含)
+  * @note    1. 预先定义 core_cm3.h 的包含保护，stm32f10x.h 中的 #include "core_cm3.h"
+  *             随之失效，内核寄存器类型与内建函数改由本文件提供
+  *          2. 外设、Flash 与内核私有区地址保持芯片原值，由 host_mcu.c 在启动时
+  *             映射为主机内存；可执行文件按非 PIE 链接，静态缓冲区地址可放入
+  *             32 位 DMA 地址寄存器
+  *          3. 内建函数的主机语义见 host_mcu.c
+  *          4. Profiler 的 PROF_NOW / PROF_COUNTER_RESET 在此替换为虚拟时钟的计数器
+  ******************************************************************************
+  */
+
+#define __CM3_CORE_H__
+
+#include <stdint.h>
+
+#define __I     volatile const
+#define __O     volatile
+#define __IO    volatile
+
+#define __ASM   __asm
+#define __INLINE inline
+#define __weak  __attribute__((weak))
+
+#define __CM3_CMSIS_VERSION_MAIN  (0x01)
+#define __CM3_CMSIS_VERSION_SUB   (0x30)
+#define __CORTEX_M                (0x03)
+
+/* --- SysTick (只用到寄存器布局，计时由 host_clock.c 的虚拟时钟完成) --- */
+typedef struct
+{
+  __IO uint32_t CTRL;
+  __IO uint32_t LOAD;
+  __IO uint32_t VAL;
+  __I  uint32_t CALIB;
+} SysTick_Type;
+
+#define SCS_BASE            (0xE000E000)
+#define SysTick_BASE        (SCS_BASE +  0x0010)
+#define SysTick             ((SysTick_Type *) SysTick_BASE)
+
+/* --- 内建函数 --- */
+void     __enable_irq(void);
+void     __disable_irq(void);
+void     __WFI(void);
+void     __NOP(void);
+void     __DMB(void);
+void     __DSB(void);
+void     __ISB(void);
+uint32_t __LDREXW(uint32_t *addr);
+uint32_t __STREXW(uint32_t value, uint32_t *addr);
+void     __CLREX(void);
+
+uint32_t SysTick_Config(uint32_t ticks);
+
+/* --- Profiler 周期计数器 (host_clock.c) ---
+ * 读取前先把主机 CPU 时间折算进虚拟时钟 (Host_SetCpuScale)，探针因此能计入纯计算耗时；
+ * 直接读 DWT->CYCCNT 地址只能看到上一次推进虚拟时间时的值 */
+uint32_t Host_ProfNow(void);
+void     Host_ProfCounterReset(void);
+#define PROF_NOW()              Host_ProfNow()
+#define PROF_COUNTER_RESET()    Host_ProfCounterReset()
+
+#endif
@@ -0,0 +1,102 @@
+/**
+  ******************************************************************************
+  * @file    host_dev_oled.c
+  * @brief   SSD1306 128x64 器件模型 (页寻址模式)
+  * @note    1. 控制字节 0x00 后为命令流，0x40 后为显存数据流
+  *          2. 带参数的命令可能被拆成多次传输 (OLED_WriteCommand 逐字节发送)，
+  *             待接收的参数个数跨事务保留
+  ******************************************************************************
+  */
+#include "host_internal.h"
+#include <stdio.h>
+#include <string.h>
+
+#define OLED_PAGES      8
+#define OLED_COLS       128
+
+static uint8_t s_Gddram[OLED_PAGES][OLED_COLS];
+static uint8_t s_Page, s_Col;
+static uint8_t s_ParamLeft;
+static Host_I2CDev_t s_Dev;
+
+// 带参数命令的参数个数
+static uint8_t _ParamCount(uint8_t cmd)
+{
+    switch (cmd) {
+        case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5:
+        case 0xD9: case 0xDA: case 0xDB: case 0x20:
+            return 1;
+        case 0x21: case 0x22:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+static void _Command(uint8_t cmd)
+{
+    if (s_ParamLeft) {
+        s_ParamLeft--;
+        return;
+    }
+    if (cmd >= 0xB0 && cmd <= 0xB7)      s_Page = cmd & 0x07;
+    else if (cmd <= 0x0F)                s_Col = (uint8_t)((s_Col & 0xF0) | cmd);
+    else if (cmd >= 0x10 && cmd <= 0x1F) s_Col = (uint8_t)((s_Col & 0x0F) | ((cmd & 0x0F) << 4));
+    else                                 s_ParamLeft = _ParamCount(cmd);
+}
+
+static uint8_t _Write(Host_I2CDev_t *dev, const uint8_t *data, uint16_t len)
+{
+    uint16_t i;
+
+    (void)dev;
+    if (len == 0) return 0;
+    if (data[0] == 0x40) {
+        for (i = 1; i < len; i++) {
+            s_Gddram[s_Page][s_Col & (OLED_COLS - 1)] = data[i];
+            s_Col = (uint8_t)((s_Col + 1) & (OLED_COLS - 1));   // 页寻址模式列地址在页内回绕
+        }
+    } else {
+        for (i = 1; i < len; i++) _Command(data[i]);
+    }
+    return 0;
+}
+
+Host_I2CDev_t *Host_OledAttach(void)
+{
+    memset(s_Gddram, 0, sizeof(s_Gddram));
+    s_Page = s_Col = s_ParamLeft = 0;
+    s_Dev.Txn = s_Dev.Bytes = 0;
+    s_Dev.BusyUs = 0;
+    s_Dev.Name = "oled";
+    s_Dev.Bus = I2C1;
+    s_Dev.Addr = 0x78;
+    s_Dev.Write = _Write;
+    Host_I2CAttach(&s_Dev);
+    return &s_Dev;
+}
+
+const uint8_t *Host_OledGddram(void)
+{
+    return &s_Gddram[0][0];
+}
+
+// 输出 P4 格式 (点亮的像素为黑色)
+uint8_t Host_OledWritePbm(const char *path)
+{
+    FILE *fp = fopen(path, "wb");
+    uint8_t row[OLED_COLS / 8];
+    uint8_t y, x;
+
+    if (!fp) return 1;
+    fprintf(fp, "P4\n%d %d\n", OLED_COLS, OLED_PAGES * 8);
+    for (y = 0; y < OLED_PAGES * 8; y++) {
+        memset(row, 0, sizeof(row));
+        for (x = 0; x < OLED_COLS; x++) {
+            if (s_Gddram[y / 8][x] & (1 << (y % 8))) row[x / 8] |= (uint8_t)(0x80 >> (x % 8));
+        }
+        fwrite(row, 1, sizeof(row), fp);
+    }
+    fclose(fp);
+    return 0;
+}
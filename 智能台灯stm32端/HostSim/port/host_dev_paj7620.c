@@ -0,0 +1,94 @@
+/**
+  ******************************************************************************
+  * @file    host_dev_paj7620.c
+  * @brief   PAJ7620U2 寄存器模型
+  * @note    1. 两个 Bank 各 256 字节，0xEF 选择 Bank，连续读写地址自增
+  *          2. Bank 0 的 INT_FLAG1/2 (0x43/0x44) 读后清零；两者都清零时释放 INT
+  *          3. INT 为低电平有效的开漏输出；未接线时 PB5 保持上拉高电平
+  ******************************************************************************
+  */
+#include "host_internal.h"
+#include <string.h>
+
+#define PAJ_REG_BANK_SEL    0xEF
+#define PAJ_REG_INT_FLAG1   0x43
+#define PAJ_REG_INT_FLAG2   0x44
+#define PAJ_REG_OBJ_BRIGHT  0xB0
+
+static uint8_t s_Regs[2][256];
+static uint8_t s_Bank;
+static uint8_t s_IntWired;
+static Host_I2CDev_t s_Dev;
+
+static void _UpdateInt(void)
+{
+    uint8_t asserted = (s_Regs[0][PAJ_REG_INT_FLAG1] | s_Regs[0][PAJ_REG_INT_FLAG2]) ? 1 : 0;
+
+    if (s_IntWired) Host_SetPin(GPIOB, GPIO_Pin_5, asserted ? 0 : 1);
+}
+
+static uint8_t _Write(Host_I2CDev_t *dev, const uint8_t *data, uint16_t len)
+{
+    uint8_t reg;
+    uint16_t i;
+
+    (void)dev;
+    if (len == 0) return 0;
+    reg = data[0];
+    for (i = 1; i < len; i++, reg++) {
+        if (reg == PAJ_REG_BANK_SEL) s_Bank = data[i] & 0x01;
+        else s_Regs[s_Bank][reg] = data[i];
+    }
+    return 0;
+}
+
+static uint8_t _Read(Host_I2CDev_t *dev, uint8_t reg, uint8_t *data, uint16_t len)
+{
+    uint16_t i;
+    uint8_t cleared = 0;
+
+    (void)dev;
+    for (i = 0; i < len; i++, reg++) {
+        if (reg == PAJ_REG_BANK_SEL) {
+            data[i] = s_Bank;
+            continue;
+        }
+        data[i] = s_Regs[s_Bank][reg];
+        if (s_Bank == 0 && (reg == PAJ_REG_INT_FLAG1 || reg == PAJ_REG_INT_FLAG2)) {
+            s_Regs[0][reg] = 0;
+            cleared = 1;
+        }
+    }
+    if (cleared) _UpdateInt();
+    return 0;
+}
+
+Host_I2CDev_t *Host_PajAttach(uint8_t int_wired)
+{
+    memset(s_Regs, 0, sizeof(s_Regs));
+    s_Regs[0][0x00] = 0x20;     // PART_ID_L
+    s_Regs[0][0x01] = 0x76;     // PART_ID_H
+    s_Bank = 0;
+    s_IntWired = int_wired;
+    s_Dev.Txn = s_Dev.Bytes = 0;
+    s_Dev.BusyUs = 0;
+    s_Dev.Name = "paj7620";
+    s_Dev.Bus = I2C2;
+    s_Dev.Addr = 0xE6;
+    s_Dev.Write = _Write;
+    s_Dev.Read = _Read;
+    Host_I2CAttach(&s_Dev);
+    return &s_Dev;
+}
+
+void Host_PajGesture(uint8_t flag1, uint8_t flag2)
+{
+    s_Regs[0][PAJ_REG_INT_FLAG1] |= flag1;
+    s_Regs[0][PAJ_REG_INT_FLAG2] |= flag2;
+    _UpdateInt();
+}
+
+void Host_PajObject(uint8_t brightness)
+{
+    s_Regs[0][PAJ_REG_OBJ_BRIGHT] = brightness;
+}
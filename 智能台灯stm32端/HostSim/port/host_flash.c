@@ -0,0 +1,151 @@
+/**
+  ******************************************************************************
+  * @file    host_flash.c
+  * @brief   片内 Flash 替身 (FLASH_* StdPeriph 函数)，带掉电注入
+  * @note    1. 映射在 0x08000000 的 64KB RAM 上，固件照常按地址直接读取
+  *          2. NOR 语义：擦除置 0xFF，编程只能把 1 写成 0；对未擦除的半字
+  *             编程返回 FLASH_ERROR_PG (与 F1 的 PGERR 一致)
+  *          3. 耗时按 F103 手册典型值：半字编程 52us，页擦除 20ms
+  *          4. ProgramWord 按硬件行为拆成两次半字编程，掉电可能落在两者之间
+  ******************************************************************************
+  */
+#include "host_internal.h"
+#include <string.h>
+
+#define HOST_FLASH_BASE         0x08000000UL
+#define HOST_FLASH_SIZE         (64 * 1024)
+#define HOST_FLASH_PAGE         1024
+#define HOST_FLASH_PROG_US      52
+#define HOST_FLASH_ERASE_US     20000
+
+#define FLASH_MEM               ((volatile uint8_t *)HOST_FLASH_BASE)
+
+static Host_FlashStats_t s_Stats;
+static uint8_t  s_Locked = 1;
+
+// 掉电注入
+static uint8_t  s_CutArmed = 0;
+static uint32_t s_CutOps = 0;
+static uint8_t  s_CutTorn = 0;
+static void   (*s_OnCut)(void) = NULL;
+
+void Host_Flash_Init(void)
+{
+    Host_FlashReset();
+}
+
+void Host_FlashReset(void)
+{
+    memset((void *)FLASH_MEM, 0xFF, HOST_FLASH_SIZE);
+    memset(&s_Stats, 0, sizeof(s_Stats));
+    s_Locked = 1;
+    Host_FlashDisarmCut();
+}
+
+void Host_GetFlashStats(Host_FlashStats_t *stats) { *stats = s_Stats; }
+
+void Host_FlashArmCut(uint32_t ops, uint8_t torn, void (*on_cut)(void))
+{
+    s_CutArmed = 1;
+    s_CutOps = ops;
+    s_CutTorn = torn;
+    s_OnCut = on_cut;
+}
+
+void Host_FlashDisarmCut(void)
+{
+    s_CutArmed = 0;
+    s_OnCut = NULL;
+}
+
+// 返回 1 表示本次操作遭遇掉电
+static uint8_t _CutNow(void)
+{
+    if (!s_CutArmed) return 0;
+    if (s_CutOps > 0) {
+        s_CutOps--;
+        return 0;
+    }
+    return 1;
+}
+
+static void _Cut(void)
+{
+    void (*on_cut)(void) = s_OnCut;
+
+    Host_FlashDisarmCut();
+    s_Locked = 1;
+    if (on_cut) on_cut();
+}
+
+static uint8_t _InRange(uint32_t addr, uint32_t len)
+{
+    return (addr >= HOST_FLASH_BASE && addr + len <= HOST_FLASH_BASE + HOST_FLASH_SIZE) ? 1 : 0;
+}
+
+static FLASH_Status _ProgramHalf(uint32_t addr, uint16_t data)
+{
+    volatile uint16_t *cell;
+
+    if (s_Locked || (addr & 1) || !_InRange(addr, 2)) {
+        s_Stats.Errors++;
+        return FLASH_ERROR_WRP;
+    }
+    cell = (volatile uint16_t *)(uintptr_t)addr;
+    if (_CutNow()) {
+        if (s_CutTorn) *cell &= (uint16_t)(data | 0xFF00);  // 只写入了低字节
+        _Cut();
+        return FLASH_TIMEOUT;
+    }
+    Host_Advance(HOST_FLASH_PROG_US);
+    s_Stats.BusyUs += HOST_FLASH_PROG_US;
+    s_Stats.Programs++;
+    // F1 只在目标半字为 0xFFFF 时编程 (写 0x0000 除外)
+    if (*cell != 0xFFFF && data != 0x0000) {
+        s_Stats.Errors++;
+        return FLASH_ERROR_PG;
+    }
+    *cell &= data;
+    return FLASH_COMPLETE;
+}
+
+/* ============================================================
+ *                 stm32f10x_flash.h
+ * ============================================================ */
+
+void FLASH_Unlock(void) { s_Locked = 0; }
+void FLASH_Lock(void) { s_Locked = 1; }
+void FLASH_ClearFlag(uint32_t FLASH_FLAG) { (void)FLASH_FLAG; }
+
+FLASH_Status FLASH_ErasePage(uint32_t Page_Address)
+{
+    uint32_t base = Page_Address & ~(uint32_t)(HOST_FLASH_PAGE - 1);
+
+    if (s_Locked || !_InRange(base, HOST_FLASH_PAGE)) {
+        s_Stats.Errors++;
+        return FLASH_ERROR_WRP;
+    }
+    if (_CutNow()) {
+        if (s_CutTorn) memset((void *)(uintptr_t)base, 0xFF, HOST_FLASH_PAGE / 2);
+        _Cut();
+        return FLASH_TIMEOUT;
+    }
+    Host_Advance(HOST_FLASH_ERASE_US);
+    s_Stats.BusyUs += HOST_FLASH_ERASE_US;
+    s_Stats.Erases++;
+    memset((void *)(uintptr_t)base, 0xFF, HOST_FLASH_PAGE);
+    return FLASH_COMPLETE;
+}
+
+FLASH_Status FLASH_ProgramHalfWord(uint32_t Address, uint16_t Data)
+{
+    return _ProgramHalf(Address, Data);
+}
+
+FLASH_Status FLASH_ProgramWord(uint32_t Address, uint32_t Data)
+{
+    FLASH_Status status = _ProgramHalf(Address, (uint16_t)Data);
+
+    if (status != FLASH_COMPLETE) return status;
+    return _ProgramHalf(Address + 2, (uint16_t)(Data >> 16));
+}
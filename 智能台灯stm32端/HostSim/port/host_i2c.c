@@ -0,0 +1,121 @@
+/**
+  ******************************************************************************
+  * @file    host_i2c.c
+  * @brief   I2C_Lib 替身 (替代 Hardware/I2C_Driver/I2C_Driver.c 的软件 I2C)
+  * @note    1. 按 (总线, 地址) 分发到挂接的器件模型，无器件时地址字节不应答
+  *          2. 每次调用计 1 个事务，线上字节含地址字节：
+  *             Write = 地址 + 寄存器 + n，Read = 地址 + 寄存器 + 地址 + n，
+  *             WriteDirect = 地址 + n，IsDeviceReady = 地址
+  *          3. 按 HOST_I2C_US_PER_BYTE 推进虚拟时间 (软件 I2C 期间 CPU 忙等)
+  ******************************************************************************
+  */
+#include "host_internal.h"
+#include "I2C_Driver.h"
+#include <string.h>
+
+#define HOST_I2C_MAX_XFER   300
+
+static Host_I2CDev_t *s_Devs = NULL;
+
+void Host_I2CAttach(Host_I2CDev_t *dev)
+{
+    Host_I2CDev_t *p;
+
+    for (p = s_Devs; p; p = p->Next) {
+        if (p == dev) return;   // 器件模型重新挂接 (复位) 时已在链表中
+    }
+    dev->Next = s_Devs;
+    s_Devs = dev;
+}
+
+void Host_I2CDetachAll(void)
+{
+    s_Devs = NULL;
+}
+
+void Host_I2CClearStats(void)
+{
+    Host_I2CDev_t *dev;
+
+    for (dev = s_Devs; dev; dev = dev->Next) {
+        dev->Txn = 0;
+        dev->Bytes = 0;
+        dev->BusyUs = 0;
+    }
+}
+
+static Host_I2CDev_t *_Find(I2C_TypeDef *bus, uint8_t addr)
+{
+    Host_I2CDev_t *dev;
+
+    for (dev = s_Devs; dev; dev = dev->Next) {
+        if (dev->Bus == bus && dev->Addr == (addr & 0xFE)) return dev;
+    }
+    return NULL;
+}
+
+// 记账并推进时间；无器件时只有地址字节上线
+static void _Account(Host_I2CDev_t *dev, uint32_t bytes)
+{
+    uint32_t us;
+
+    if (!dev) bytes = 1;
+    us = bytes * HOST_I2C_US_PER_BYTE;
+    if (dev) {
+        dev->Txn++;
+        dev->Bytes += bytes;
+        dev->BusyUs += us;
+    }
+    Host_Advance(us);
+}
+
+/* ============================================================
+ *                 I2C_Driver.h
+ * ============================================================ */
+
+void I2C_Lib_Init(I2C_TypeDef* I2Cx)
+{
+    (void)I2Cx;
+}
+
+uint8_t I2C_Lib_Write(I2C_TypeDef* I2Cx, uint8_t DevAddr, uint8_t RegAddr, uint8_t* pData, uint16_t Size)
+{
+    Host_I2CDev_t *dev = _Find(I2Cx, DevAddr);
+    uint8_t buf[HOST_I2C_MAX_XFER + 1];
+
+    _Account(dev, 2u + Size);
+    if (!dev || Size > HOST_I2C_MAX_XFER) return 1;
+    buf[0] = RegAddr;
+    memcpy(&buf[1], pData, Size);
+    return dev->Write ? dev->Write(dev, buf, (uint16_t)(Size + 1)) : 0;
+}
+
+uint8_t I2C_Lib_Read(I2C_TypeDef* I2Cx, uint8_t DevAddr, uint8_t RegAddr, uint8_t* pData, uint16_t Size)
+{
+    Host_I2CDev_t *dev = _Find(I2Cx, DevAddr);
+
+    _Account(dev, 3u + Size);
+    if (!dev) return 1;
+    if (!dev->Read) {
+        memset(pData, 0xFF, Size);
+        return 0;
+    }
+    return dev->Read(dev, RegAddr, pData, Size);
+}
+
+uint8_t I2C_Lib_WriteDirect(I2C_TypeDef* I2Cx, uint8_t DevAddr, uint8_t* pData, uint16_t Size)
+{
+    Host_I2CDev_t *dev = _Find(I2Cx, DevAddr);
+
+    _Account(dev, 1u + Size);
+    if (!dev) return 1;
+    return dev->Write ? dev->Write(dev, pData, Size) : 0;
+}
+
+uint8_t I2C_Lib_IsDeviceReady(I2C_TypeDef* I2Cx, uint8_t DevAddr)
+{
+    Host_I2CDev_t *dev = _Find(I2Cx, DevAddr);
+
+    _Account(dev, 1);
+    return dev ? 0 : 1;
+}
@@ -0,0 +1,35 @@
+#ifndef __HOST_INTERNAL_H
+#define __HOST_INTERNAL_H
+
+/**
+  ******************************************************************************
+  * @file    host_internal.h
+  * @brief   port/ 内部各替身之间的接口 (仿真器与测试不应包含)
+  ******************************************************************************
+  */
+
+#include "host_port.h"
+
+#define HOST_CORE_CLOCK_HZ      72000000UL
+#define HOST_NO_EVENT           UINT64_MAX
+
+/* --- host_mcu.c --- */
+void     Host_Mcu_Reset(void);
+void     Host_RaiseIrq(IRQn_Type irq);  /*!< NVIC 未使能时忽略 */
+
+/* --- host_clock.c --- */
+void     Host_Clock_Reset(void);
+void     Host_Clock_Sync(void);         /*!< 折算主机 CPU 时间 (Host_SetCpuScale) */
+void     Host_Clock_AdvanceNs(uint32_t ns); /*!< 同 Host_Advance，纳秒分辨率 (亚微秒的建模耗时) */
+
+/* --- host_periph.c --- */
+void     Host_Periph_Reset(void);
+void     Host_Periph_OnDmaCmd(DMA_Channel_TypeDef *ch, FunctionalState state);
+uint64_t Host_Periph_NextEvent(void);   /*!< 下一个外设事件的时刻 */
+uint16_t Host_Periph_AdcSample(void);   /*!< 当前时刻的 LDR 输入 (软件触发转换) */
+void     Host_Periph_Service(uint64_t now);
+
+/* --- host_flash.c --- */
+void     Host_Flash_Init(void);
+
+#endif
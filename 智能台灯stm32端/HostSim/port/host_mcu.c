@@ -0,0 +1,562 @@
+/**
+  ******************************************************************************
+  * @file    host_mcu.c
+  * @brief   主机侧 MCU 替身：地址空间映射、内建函数、NVIC/GPIO/EXTI/RCC/TIM/
+  *          USART/ADC 的 StdPeriph 函数
+  * @note    1. Flash (0x08000000)、外设 (0x40000000) 与内核私有区 (0xE0000000)
+  *             在程序启动前映射为主机内存，驱动中直接访问寄存器的代码 (如
+  *             TIM4->CNT、DMA1_Channel4->CNDTR、USART2->DR) 原样生效
+  *          2. StdPeriph 函数只实现固件用到的部分，语义与参考手册一致但不等待
+  *             硬件状态 (校准、忙标志立即完成)
+  *          3. 中断在 Host_RaiseIrq 处同步调用处理函数，模拟"外设事件到来时
+  *             抢占主循环"；未被固件实现的向量为空的弱函数 (同启动文件)
+  *          4. ADC 软件触发的一次转换在启动时按采样时间 + 12.5 个 ADC 时钟推进
+  *             虚拟时间，随即置 EOC (对应启动后忙等 EOC 的写法)
+  ******************************************************************************
+  */
+#include "host_internal.h"
+#include <sys/mman.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HOST_FLASH_SIZE     0x10000     // STM32F103C8: 64KB
+#define HOST_PERIPH_SIZE    0x30000     // APB1 / APB2 / AHB
+#define HOST_CORE_BASE      0xE0000000
+#define HOST_CORE_SIZE      0x10000     // ITM / DWT / SCS
+
+uint32_t SystemCoreClock = HOST_CORE_CLOCK_HZ;
+
+static volatile uint8_t s_Primask = 0;
+static uint32_t *s_ExclAddr = NULL;             // 独占监视器
+static uint8_t (*s_PreemptHook)(uint8_t site) = NULL;
+static uint8_t s_InPreempt = 0;
+static uint8_t s_IrqEnabled[64];
+static void (*s_IdleHook)(void) = NULL;
+
+/* ============================================================
+ *                 地址空间
+ * ============================================================ */
+
+static void _Map(uintptr_t base, size_t size)
+{
+    void *p = mmap((void *)base, size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if (p != (void *)base) {
+        fprintf(stderr, "host: 无法映射 0x%08lX (需按非 PIE 链接)\n", (unsigned long)base);
+        exit(2);
+    }
+}
+
+// 在任何固件代码运行前完成映射
+__attribute__((constructor(101)))
+static void _HostMapInit(void)
+{
+    _Map(FLASH_BASE, HOST_FLASH_SIZE);
+    _Map(PERIPH_BASE, HOST_PERIPH_SIZE);
+    _Map(HOST_CORE_BASE, HOST_CORE_SIZE);
+    memset((void *)FLASH_BASE, 0xFF, HOST_FLASH_SIZE);
+    Host_Flash_Init();
+    Host_Reset();
+}
+
+void Host_Mcu_Reset(void)
+{
+    GPIO_TypeDef *ports[] = { GPIOA, GPIOB, GPIOC, GPIOD, GPIOE };
+    uint8_t i;
+
+    memset((void *)PERIPH_BASE, 0, HOST_PERIPH_SIZE);
+    memset((void *)HOST_CORE_BASE, 0, HOST_CORE_SIZE);
+    for (i = 0; i < sizeof(ports) / sizeof(ports[0]); i++) {
+        ports[i]->IDR = 0xFFFF;     // 输入默认上拉空闲
+    }
+    USART1->SR = USART_FLAG_TXE;
+    USART2->SR = USART_FLAG_TXE;
+    s_Primask = 0;
+    s_ExclAddr = NULL;
+    s_PreemptHook = NULL;
+    s_IdleHook = NULL;
+    memset(s_IrqEnabled, 0, sizeof(s_IrqEnabled));
+}
+
+void Host_Reset(void)
+{
+    Host_Mcu_Reset();
+    Host_Clock_Reset();
+    Host_Periph_Reset();
+    Host_I2CDetachAll();
+}
+
+/* ============================================================
+ *                 内建函数
+ * ============================================================ */
+
+void Host_SetPreemptHook(uint8_t (*hook)(uint8_t site)) { s_PreemptHook = hook; }
+uint8_t Host_IrqMasked(void) { return s_Primask; }
+
+static void _PreemptPoint(uint8_t site)
+{
+    if (s_PreemptHook == NULL || s_InPreempt || s_Primask) return;
+    s_InPreempt = 1;
+    if (s_PreemptHook(site)) {
+        s_ExclAddr = NULL;  // 异常进入/返回清除本地独占监视器
+    }
+    s_InPreempt = 0;
+}
+
+// 开中断时立即投递屏蔽期间到期的外设事件
+void __enable_irq(void)
+{
+    s_Primask = 0;
+    Host_RunUntil(Host_NowUs());
+}
+
+void __disable_irq(void) { s_Primask = 1; }
+void __NOP(void) {}
+void __DSB(void) { __sync_synchronize(); }
+void __ISB(void) { __sync_synchronize(); }
+
+void __DMB(void)
+{
+    _PreemptPoint(HOST_SITE_DMB);
+    __sync_synchronize();
+}
+
+uint32_t __LDREXW(uint32_t *addr)
+{
+    uint32_t v = *(volatile uint32_t *)addr;
+    s_ExclAddr = addr;
+    _PreemptPoint(HOST_SITE_LDREX);
+    return v;
+}
+
+uint32_t __STREXW(uint32_t value, uint32_t *addr)
+{
+    _PreemptPoint(HOST_SITE_STREX);
+    if (s_ExclAddr != addr) return 1;
+    *(volatile uint32_t *)addr = value;
+    s_ExclAddr = NULL;
+    return 0;
+}
+
+void __CLREX(void) { s_ExclAddr = NULL; }
+
+void Host_SetIdleHook(void (*hook)(void)) { s_IdleHook = hook; }
+
+// 挂起的中断即使在 PRIMASK 置位时也能唤醒内核，因此这里不检查 s_Primask
+void __WFI(void)
+{
+    if (s_IdleHook) s_IdleHook();
+    else Host_Idle();
+}
+
+uint32_t SysTick_Config(uint32_t ticks)
+{
+    SysTick->LOAD = ticks - 1;
+    SysTick->VAL = 0;
+    SysTick->CTRL = 0x07;
+    return 0;
+}
+
+/* ============================================================
+ *                 NVIC / 向量
+ * ============================================================ */
+
+#define HOST_WEAK_HANDLER(name) __attribute__((weak)) void name(void) {}
+HOST_WEAK_HANDLER(SysTick_Handler)
+HOST_WEAK_HANDLER(EXTI0_IRQHandler)
+HOST_WEAK_HANDLER(EXTI1_IRQHandler)
+HOST_WEAK_HANDLER(EXTI2_IRQHandler)
+HOST_WEAK_HANDLER(EXTI3_IRQHandler)
+HOST_WEAK_HANDLER(EXTI4_IRQHandler)
+HOST_WEAK_HANDLER(EXTI9_5_IRQHandler)
+HOST_WEAK_HANDLER(EXTI15_10_IRQHandler)
+HOST_WEAK_HANDLER(DMA1_Channel1_IRQHandler)
+HOST_WEAK_HANDLER(DMA1_Channel4_IRQHandler)
+HOST_WEAK_HANDLER(DMA1_Channel5_IRQHandler)
+HOST_WEAK_HANDLER(DMA1_Channel7_IRQHandler)
+HOST_WEAK_HANDLER(USART1_IRQHandler)
+HOST_WEAK_HANDLER(USART2_IRQHandler)
+
+void NVIC_PriorityGroupConfig(uint32_t NVIC_PriorityGroup) { (void)NVIC_PriorityGroup; }
+
+void NVIC_Init(NVIC_InitTypeDef* NVIC_InitStruct)
+{
+    s_IrqEnabled[NVIC_InitStruct->NVIC_IRQChannel & 63] =
+        (NVIC_InitStruct->NVIC_IRQChannelCmd != DISABLE);
+}
+
+uint8_t Host_IrqEnabled(IRQn_Type irq)
+{
+    return (irq >= 0) ? s_IrqEnabled[irq & 63] : 1;
+}
+
+void Host_RaiseIrq(IRQn_Type irq)
+{
+    if (!Host_IrqEnabled(irq)) return;
+
+    switch (irq) {
+        case SysTick_IRQn:        SysTick_Handler(); break;
+        case EXTI0_IRQn:          EXTI0_IRQHandler(); break;
+        case EXTI1_IRQn:          EXTI1_IRQHandler(); break;
+        case EXTI2_IRQn:          EXTI2_IRQHandler(); break;
+        case EXTI3_IRQn:          EXTI3_IRQHandler(); break;
+        case EXTI4_IRQn:          EXTI4_IRQHandler(); break;
+        case EXTI9_5_IRQn:        EXTI9_5_IRQHandler(); break;
+        case EXTI15_10_IRQn:      EXTI15_10_IRQHandler(); break;
+        case DMA1_Channel1_IRQn:  DMA1_Channel1_IRQHandler(); break;
+        case DMA1_Channel4_IRQn:  DMA1_Channel4_IRQHandler(); break;
+        case DMA1_Channel5_IRQn:  DMA1_Channel5_IRQHandler(); break;
+        case DMA1_Channel7_IRQn:  DMA1_Channel7_IRQHandler(); break;
+        case USART1_IRQn:         USART1_IRQHandler(); break;
+        case USART2_IRQn:         USART2_IRQHandler(); break;
+        default: break;
+    }
+}
+
+/* ============================================================
+ *                 RCC (时钟门控不建模)
+ * ============================================================ */
+
+void RCC_APB2PeriphClockCmd(uint32_t RCC_APB2Periph, FunctionalState NewState) { (void)RCC_APB2Periph; (void)NewState; }
+void RCC_APB1PeriphClockCmd(uint32_t RCC_APB1Periph, FunctionalState NewState) { (void)RCC_APB1Periph; (void)NewState; }
+void RCC_AHBPeriphClockCmd(uint32_t RCC_AHBPeriph, FunctionalState NewState)   { (void)RCC_AHBPeriph; (void)NewState; }
+void RCC_ADCCLKConfig(uint32_t RCC_PCLK2)
+{
+    // ADCPRE 位与参考实现相同 (CFGR[15:14])，软件触发转换按此换算耗时
+    RCC->CFGR = (RCC->CFGR & ~RCC_CFGR_ADCPRE) | RCC_PCLK2;
+}
+
+/* ============================================================
+ *                 GPIO / EXTI
+ * ============================================================ */
+
+void GPIO_Init(GPIO_TypeDef* GPIOx, GPIO_InitTypeDef* GPIO_InitStruct)
+{
+    uint8_t pos;
+    uint32_t mode = GPIO_InitStruct->GPIO_Mode & 0x0F;
+
+    // 与参考实现相同的 CRL/CRH 编码，DHT11 等直接改写 CRL 的代码可以读回
+    if (GPIO_InitStruct->GPIO_Mode & 0x10) mode |= GPIO_InitStruct->GPIO_Speed;
+    for (pos = 0; pos < 16; pos++) {
+        if (!(GPIO_InitStruct->GPIO_Pin & (1u << pos))) continue;
+        if (pos < 8) {
+            GPIOx->CRL = (GPIOx->CRL & ~(0x0Fu << (pos * 4))) | (mode << (pos * 4));
+        } else {
+            GPIOx->CRH = (GPIOx->CRH & ~(0x0Fu << ((pos - 8) * 4))) | (mode << ((pos - 8) * 4));
+        }
+        if (GPIO_InitStruct->GPIO_Mode == GPIO_Mode_IPU) GPIOx->ODR |= (1u << pos);
+        if (GPIO_InitStruct->GPIO_Mode == GPIO_Mode_IPD) GPIOx->ODR &= ~(1u << pos);
+    }
+}
+
+void GPIO_SetBits(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)   { GPIOx->ODR |= GPIO_Pin; }
+void GPIO_ResetBits(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin) { GPIOx->ODR &= ~(uint32_t)GPIO_Pin; }
+
+void GPIO_WriteBit(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, BitAction BitVal)
+{
+    if (BitVal != Bit_RESET) GPIO_SetBits(GPIOx, GPIO_Pin);
+    else GPIO_ResetBits(GPIOx, GPIO_Pin);
+}
+
+uint8_t GPIO_ReadInputDataBit(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+    return (GPIOx->IDR & GPIO_Pin) ? (uint8_t)Bit_SET : (uint8_t)Bit_RESET;
+}
+
+uint8_t Host_GetOutput(GPIO_TypeDef *port, uint16_t pin)
+{
+    return (port->ODR & pin) ? 1 : 0;
+}
+
+void GPIO_EXTILineConfig(uint8_t GPIO_PortSource, uint8_t GPIO_PinSource)
+{
+    uint32_t shift = 4 * (GPIO_PinSource & 0x03);
+    AFIO->EXTICR[GPIO_PinSource >> 2] &= ~(0x0Fu << shift);
+    AFIO->EXTICR[GPIO_PinSource >> 2] |= ((uint32_t)GPIO_PortSource << shift);
+}
+
+void EXTI_Init(EXTI_InitTypeDef* EXTI_InitStruct)
+{
+    uint32_t line = EXTI_InitStruct->EXTI_Line;
+    volatile uint32_t *base = (volatile uint32_t *)EXTI_BASE;
+
+    EXTI->IMR &= ~line;
+    EXTI->EMR &= ~line;
+    EXTI->RTSR &= ~line;
+    EXTI->FTSR &= ~line;
+    if (EXTI_InitStruct->EXTI_LineCmd == DISABLE) return;
+
+    base[EXTI_InitStruct->EXTI_Mode / 4] |= line;
+    if (EXTI_InitStruct->EXTI_Trigger == EXTI_Trigger_Rising_Falling) {
+        EXTI->RTSR |= line;
+        EXTI->FTSR |= line;
+    } else {
+        base[EXTI_InitStruct->EXTI_Trigger / 4] |= line;
+    }
+}
+
+ITStatus EXTI_GetITStatus(uint32_t EXTI_Line)
+{
+    return ((EXTI->PR & EXTI_Line) && (EXTI->IMR & EXTI_Line)) ? SET : RESET;
+}
+
+void EXTI_ClearITPendingBit(uint32_t EXTI_Line) { EXTI->PR &= ~EXTI_Line; }
+
+static IRQn_Type _ExtiIrq(uint8_t pos)
+{
+    if (pos <= 4) return (IRQn_Type)(EXTI0_IRQn + pos);
+    return (pos <= 9) ? EXTI9_5_IRQn : EXTI15_10_IRQn;
+}
+
+void Host_SetPin(GPIO_TypeDef *port, uint16_t pin, uint8_t level)
+{
+    uint8_t pos, src;
+    uint32_t old = port->IDR;
+
+    if (level) port->IDR |= pin;
+    else port->IDR &= ~(uint32_t)pin;
+
+    for (pos = 0; pos < 16; pos++) {
+        uint32_t line = 1u << pos;
+        uint8_t was, now;
+
+        if (!(pin & line) || !(EXTI->IMR & line)) continue;
+        src = (AFIO->EXTICR[pos >> 2] >> (4 * (pos & 0x03))) & 0x0F;
+        if (port != (GPIO_TypeDef *)(GPIOA_BASE + src * 0x400)) continue;
+
+        was = (old & line) != 0;
+        now = (port->IDR & line) != 0;
+        if ((was && !now && (EXTI->FTSR & line)) || (!was && now && (EXTI->RTSR & line))) {
+            EXTI->PR |= line;
+            Host_RaiseIrq(_ExtiIrq(pos));
+        }
+    }
+}
+
+/* ============================================================
+ *                 TIM
+ * ============================================================ */
+
+void TIM_TimeBaseInit(TIM_TypeDef* TIMx, TIM_TimeBaseInitTypeDef* TIM_TimeBaseInitStruct)
+{
+    TIMx->ARR = TIM_TimeBaseInitStruct->TIM_Period;
+    TIMx->PSC = TIM_TimeBaseInitStruct->TIM_Prescaler;
+}
+
+void TIM_Cmd(TIM_TypeDef* TIMx, FunctionalState NewState)
+{
+    if (NewState != DISABLE) TIMx->CR1 |= TIM_CR1_CEN;
+    else TIMx->CR1 &= (uint16_t)~TIM_CR1_CEN;
+}
+
+void TIM_ICStructInit(TIM_ICInitTypeDef* TIM_ICInitStruct)
+{
+    TIM_ICInitStruct->TIM_Channel = TIM_Channel_1;
+    TIM_ICInitStruct->TIM_ICPolarity = TIM_ICPolarity_Rising;
+    TIM_ICInitStruct->TIM_ICSelection = TIM_ICSelection_DirectTI;
+    TIM_ICInitStruct->TIM_ICPrescaler = TIM_ICPSC_DIV1;
+    TIM_ICInitStruct->TIM_ICFilter = 0x00;
+}
+
+void TIM_OCStructInit(TIM_OCInitTypeDef* TIM_OCInitStruct)
+{
+    memset(TIM_OCInitStruct, 0, sizeof(*TIM_OCInitStruct));
+    TIM_OCInitStruct->TIM_OCMode = TIM_OCMode_Timing;
+    TIM_OCInitStruct->TIM_OutputState = TIM_OutputState_Disable;
+    TIM_OCInitStruct->TIM_OCPolarity = TIM_OCPolarity_High;
+}
+
+void TIM_ICInit(TIM_TypeDef* TIMx, TIM_ICInitTypeDef* TIM_ICInitStruct) { (void)TIMx; (void)TIM_ICInitStruct; }
+void TIM_OC1Init(TIM_TypeDef* TIMx, TIM_OCInitTypeDef* TIM_OCInitStruct) { TIMx->CCR1 = TIM_OCInitStruct->TIM_Pulse; }
+void TIM_OC2Init(TIM_TypeDef* TIMx, TIM_OCInitTypeDef* TIM_OCInitStruct) { TIMx->CCR2 = TIM_OCInitStruct->TIM_Pulse; }
+void TIM_SetCompare1(TIM_TypeDef* TIMx, uint16_t Compare1) { TIMx->CCR1 = Compare1; }
+void TIM_SetCompare2(TIM_TypeDef* TIMx, uint16_t Compare2) { TIMx->CCR2 = Compare2; }
+void TIM_SetCounter(TIM_TypeDef* TIMx, uint16_t Counter) { TIMx->CNT = Counter; }
+uint16_t TIM_GetCounter(TIM_TypeDef* TIMx) { return (uint16_t)TIMx->CNT; }
+
+void TIM_EncoderInterfaceConfig(TIM_TypeDef* TIMx, uint16_t TIM_EncoderMode,
+                                uint16_t TIM_IC1Polarity, uint16_t TIM_IC2Polarity)
+{
+    (void)TIM_IC1Polarity; (void)TIM_IC2Polarity;
+    TIMx->SMCR = (TIMx->SMCR & (uint16_t)~TIM_SMCR_SMS) | TIM_EncoderMode;
+}
+
+void TIM_SelectOutputTrigger(TIM_TypeDef* TIMx, uint16_t TIM_TRGOSource)
+{
+    TIMx->CR2 = (TIMx->CR2 & (uint16_t)~TIM_CR2_MMS) | TIM_TRGOSource;
+}
+
+void TIM_CCxCmd(TIM_TypeDef* TIMx, uint16_t TIM_Channel, uint16_t TIM_CCx)
+{
+    TIMx->CCER &= (uint16_t)~(TIM_CCER_CC1E << TIM_Channel);
+    TIMx->CCER |= (uint16_t)(TIM_CCx << TIM_Channel);
+}
+
+void TIM_DMACmd(TIM_TypeDef* TIMx, uint16_t TIM_DMASource, FunctionalState NewState)
+{
+    if (NewState != DISABLE) TIMx->DIER |= TIM_DMASource;
+    else TIMx->DIER &= (uint16_t)~TIM_DMASource;
+}
+
+void TIM_ClearFlag(TIM_TypeDef* TIMx, uint16_t TIM_FLAG) { TIMx->SR = (uint16_t)~TIM_FLAG; }
+
+/* ============================================================
+ *                 USART
+ * ============================================================ */
+
+static volatile uint16_t *_UsartCr(USART_TypeDef* USARTx, uint16_t it)
+{
+    switch ((it >> 5) & 0x07) {
+        case 1:  return &USARTx->CR1;
+        case 2:  return &USARTx->CR2;
+        default: return &USARTx->CR3;
+    }
+}
+
+void USART_Init(USART_TypeDef* USARTx, USART_InitTypeDef* USART_InitStruct)
+{
+    // BRR 按 72MHz (USART1) / 36MHz (USART2) 计算，仅用于回读波特率
+    uint32_t pclk = (USARTx == USART1) ? HOST_CORE_CLOCK_HZ : HOST_CORE_CLOCK_HZ / 2;
+    USARTx->BRR = (uint16_t)(pclk / USART_InitStruct->USART_BaudRate);
+    USARTx->CR1 = (USARTx->CR1 & ~(USART_CR1_TE | USART_CR1_RE)) | USART_InitStruct->USART_Mode;
+}
+
+void USART_Cmd(USART_TypeDef* USARTx, FunctionalState NewState)
+{
+    if (NewState != DISABLE) USARTx->CR1 |= USART_CR1_UE;
+    else USARTx->CR1 &= (uint16_t)~USART_CR1_UE;
+}
+
+void USART_ITConfig(USART_TypeDef* USARTx, uint16_t USART_IT, FunctionalState NewState)
+{
+    volatile uint16_t *cr = _UsartCr(USARTx, USART_IT);
+    uint16_t mask = (uint16_t)(1u << (USART_IT & 0x1F));
+
+    if (NewState != DISABLE) *cr |= mask;
+    else *cr &= (uint16_t)~mask;
+}
+
+ITStatus USART_GetITStatus(USART_TypeDef* USARTx, uint16_t USART_IT)
+{
+    uint16_t en = *_UsartCr(USARTx, USART_IT) & (uint16_t)(1u << (USART_IT & 0x1F));
+    uint16_t flag = USARTx->SR & (uint16_t)(1u << (USART_IT >> 8));
+    return (en && flag) ? SET : RESET;
+}
+
+FlagStatus USART_GetFlagStatus(USART_TypeDef* USARTx, uint16_t USART_FLAG)
+{
+    return (USARTx->SR & USART_FLAG) ? SET : RESET;
+}
+
+void USART_DMACmd(USART_TypeDef* USARTx, uint16_t USART_DMAReq, FunctionalState NewState)
+{
+    if (NewState != DISABLE) USARTx->CR3 |= USART_DMAReq;
+    else USARTx->CR3 &= (uint16_t)~USART_DMAReq;
+}
+
+/* ============================================================
+ *                 ADC (转换由 host_periph.c 按 TIM3 节拍产生)
+ * ============================================================ */
+
+void ADC_Init(ADC_TypeDef* ADCx, ADC_InitTypeDef* ADC_InitStruct) { (void)ADCx; (void)ADC_InitStruct; }
+void ADC_RegularChannelConfig(ADC_TypeDef* ADCx, uint8_t ADC_Channel, uint8_t Rank, uint8_t ADC_SampleTime)
+{
+    // 只记录采样时间 (SMPR2，通道 0~9)，供软件触发转换计算耗时
+    (void)Rank;
+    if (ADC_Channel <= ADC_Channel_9) {
+        ADCx->SMPR2 = (ADCx->SMPR2 & ~(7u << (ADC_Channel * 3))) | ((uint32_t)ADC_SampleTime << (ADC_Channel * 3));
+    }
+}
+
+void ADC_SoftwareStartConvCmd(ADC_TypeDef* ADCx, FunctionalState NewState)
+{
+    // 采样时间 x2 (1.5 ~ 239.5 个 ADC 时钟)，转换另需 12.5 个
+    static const uint16_t smp_x2[8] = { 3, 15, 27, 57, 83, 111, 143, 479 };
+    uint32_t div = 2u * (((RCC->CFGR & RCC_CFGR_ADCPRE) >> 14) + 1u);
+    uint32_t clocks_x2 = smp_x2[ADCx->SMPR2 & 7u] + 25u;   // LDR 使用通道 0
+
+    if (NewState == DISABLE || !(ADCx->CR2 & ADC_CR2_ADON)) return;
+    Host_Clock_AdvanceNs((uint32_t)((uint64_t)clocks_x2 * div * 1000000000ULL / (2ULL * HOST_CORE_CLOCK_HZ)));
+    ADCx->DR = Host_Periph_AdcSample();
+    ADCx->SR |= ADC_FLAG_EOC;
+}
+
+FlagStatus ADC_GetFlagStatus(ADC_TypeDef* ADCx, uint8_t ADC_FLAG)
+{
+    return (ADCx->SR & ADC_FLAG) ? SET : RESET;
+}
+
+uint16_t ADC_GetConversionValue(ADC_TypeDef* ADCx)
+{
+    ADCx->SR &= ~(uint32_t)ADC_FLAG_EOC;   // 读 DR 清除 EOC
+    return (uint16_t)ADCx->DR;
+}
+
+void ADC_DMACmd(ADC_TypeDef* ADCx, FunctionalState NewState) { (void)ADCx; (void)NewState; }
+void ADC_Cmd(ADC_TypeDef* ADCx, FunctionalState NewState)
+{
+    if (NewState != DISABLE) ADCx->CR2 |= ADC_CR2_ADON;
+    else ADCx->CR2 &= ~ADC_CR2_ADON;
+}
+void ADC_ResetCalibration(ADC_TypeDef* ADCx) { (void)ADCx; }
+void ADC_StartCalibration(ADC_TypeDef* ADCx) { (void)ADCx; }
+FlagStatus ADC_GetResetCalibrationStatus(ADC_TypeDef* ADCx) { (void)ADCx; return RESET; }
+FlagStatus ADC_GetCalibrationStatus(ADC_TypeDef* ADCx) { (void)ADCx; return RESET; }
+void ADC_ExternalTrigConvCmd(ADC_TypeDef* ADCx, FunctionalState NewState)
+{
+    if (NewState != DISABLE) ADCx->CR2 |= ADC_CR2_EXTTRIG;
+    else ADCx->CR2 &= ~ADC_CR2_EXTTRIG;
+}
+
+/* ============================================================
+ *                 DMA (传输由 host_periph.c 建模)
+ * ============================================================ */
+
+void DMA_DeInit(DMA_Channel_TypeDef* DMAy_Channelx)
+{
+    DMAy_Channelx->CCR = 0;
+    DMAy_Channelx->CNDTR = 0;
+    DMAy_Channelx->CPAR = 0;
+    DMAy_Channelx->CMAR = 0;
+}
+
+void DMA_Init(DMA_Channel_TypeDef* DMAy_Channelx, DMA_InitTypeDef* DMA_InitStruct)
+{
+    DMAy_Channelx->CCR = DMA_InitStruct->DMA_DIR | DMA_InitStruct->DMA_Mode |
+                         DMA_InitStruct->DMA_PeripheralInc | DMA_InitStruct->DMA_MemoryInc |
+                         DMA_InitStruct->DMA_PeripheralDataSize | DMA_InitStruct->DMA_MemoryDataSize |
+                         DMA_InitStruct->DMA_Priority | DMA_InitStruct->DMA_M2M;
+    DMAy_Channelx->CNDTR = DMA_InitStruct->DMA_BufferSize;
+    DMAy_Channelx->CPAR = DMA_InitStruct->DMA_PeripheralBaseAddr;
+    DMAy_Channelx->CMAR = DMA_InitStruct->DMA_MemoryBaseAddr;
+}
+
+void DMA_Cmd(DMA_Channel_TypeDef* DMAy_Channelx, FunctionalState NewState)
+{
+    if (NewState != DISABLE) DMAy_Channelx->CCR |= DMA_CCR1_EN;
+    else DMAy_Channelx->CCR &= (uint16_t)~DMA_CCR1_EN;
+    Host_Periph_OnDmaCmd(DMAy_Channelx, NewState);
+}
+
+void DMA_ITConfig(DMA_Channel_TypeDef* DMAy_Channelx, uint32_t DMA_IT, FunctionalState NewState)
+{
+    if (NewState != DISABLE) DMAy_Channelx->CCR |= DMA_IT;
+    else DMAy_Channelx->CCR &= ~DMA_IT;
+}
+
+void DMA_SetCurrDataCounter(DMA_Channel_TypeDef* DMAy_Channelx, uint16_t DataNumber)
+{
+    DMAy_Channelx->CNDTR = DataNumber;
+}
+
+uint16_t DMA_GetCurrDataCounter(DMA_Channel_TypeDef* DMAy_Channelx)
+{
+    return (uint16_t)DMAy_Channelx->CNDTR;
+}
+
+// 固件只使用 DMA1，标志位即 DMA1->ISR 中的位
+FlagStatus DMA_GetFlagStatus(uint32_t DMAy_FLAG) { return (DMA1->ISR & DMAy_FLAG) ? SET : RESET; }
+void DMA_ClearFlag(uint32_t DMAy_FLAG) { DMA1->ISR &= ~DMAy_FLAG; }
+ITStatus DMA_GetITStatus(uint32_t DMAy_IT) { return (DMA1->ISR & DMAy_IT) ? SET : RESET; }
+void DMA_ClearITPendingBit(uint32_t DMAy_IT) { DMA1->ISR &= ~DMAy_IT; }
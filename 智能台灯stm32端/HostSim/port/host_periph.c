@@ -0,0 +1,314 @@
+/**
+  ******************************************************************************
+  * @file    host_periph.c
+  * @brief   外设行为模型：USART1 DMA 收发、USART2 TXE 发送、LDR 的 ADC+DMA、
+  *          DHT11 输入捕获、TIM4 编码器与 TIM3 PWM
+  * @note    1. 串口按 10 位/字节与 BRR 中的波特率计算线上时间
+  *          2. ADC 每 1ms (TIM3 更新) 转换一次，DMA 半满/全满时产生中断
+  *          3. DHT11 在捕获 DMA 使能后约 4.2ms 给出整帧下降沿，由固件轮询 TC7
+  ******************************************************************************
+  */
+#include "host_internal.h"
+#include <string.h>
+
+#define HOST_RX_QUEUE_SIZE      4096
+#define HOST_TX_MAX             512
+#define HOST_ADC_PERIOD_US      1000
+#define HOST_DHT_FRAME_US       4200
+#define HOST_DHT_ACK_US         160
+#define HOST_DHT_BIT0_US        78
+#define HOST_DHT_BIT1_US        120
+
+// --- USART1 接收 ---
+static uint8_t  s_RxData[HOST_RX_QUEUE_SIZE];
+static uint16_t s_RxHead, s_RxTail;         // 待到达字节 [tail, head)
+static uint64_t s_RxNextUs;                 // 下一字节到达时刻
+static uint64_t s_RxIdleUs;                 // 帧尾 IDLE 时刻
+static uint16_t s_RxDmaSize;
+
+// --- USART1 发送 ---
+static uint8_t  s_TxData[HOST_TX_MAX];
+static uint16_t s_TxLen;
+static uint64_t s_TxDoneUs;
+static void (*s_TxSink)(const uint8_t *data, uint16_t len, uint64_t t_us);
+
+// --- USART2 发送 ---
+static uint64_t s_LogTxeUs;                 // 移位寄存器空出的时刻
+static void (*s_LogSink)(uint8_t byte);
+
+// --- ADC ---
+static uint16_t s_AdcRaw;
+static uint16_t (*s_AdcSource)(uint64_t t_us);
+static uint64_t s_AdcNextUs;
+static uint16_t s_AdcDmaSize;
+
+// --- DHT11 ---
+static uint8_t  s_DhtFrame[5];
+static uint8_t  s_DhtPresent;
+static uint64_t s_DhtDoneUs;
+
+static Host_PeriphStats_t s_Stats;
+
+static uint32_t _ByteUs(USART_TypeDef *usart)
+{
+    uint32_t pclk = (usart == USART1) ? HOST_CORE_CLOCK_HZ : HOST_CORE_CLOCK_HZ / 2;
+    uint32_t baud = usart->BRR ? pclk / usart->BRR : 115200;
+    return (10u * 1000000u + baud / 2) / baud;
+}
+
+void Host_Periph_Reset(void)
+{
+    s_RxHead = s_RxTail = 0;
+    s_RxNextUs = s_RxIdleUs = HOST_NO_EVENT;
+    s_RxDmaSize = 0;
+    s_TxLen = 0;
+    s_TxDoneUs = HOST_NO_EVENT;
+    s_TxSink = NULL;
+    s_LogTxeUs = 0;
+    s_LogSink = NULL;
+    s_AdcRaw = 2048;
+    s_AdcSource = NULL;
+    s_AdcNextUs = HOST_ADC_PERIOD_US;
+    s_AdcDmaSize = 0;
+    s_DhtPresent = 1;
+    memset(s_DhtFrame, 0, sizeof(s_DhtFrame));
+    Host_SetDht11(45, 25, 1);
+    s_DhtDoneUs = HOST_NO_EVENT;
+    memset(&s_Stats, 0, sizeof(s_Stats));
+}
+
+void Host_GetPeriphStats(Host_PeriphStats_t *stats) { *stats = s_Stats; }
+
+/* ============================================================
+ *                 DMA 使能 (由 host_mcu.c 的 DMA_Cmd 调用)
+ * ============================================================ */
+
+void Host_Periph_OnDmaCmd(DMA_Channel_TypeDef *ch, FunctionalState state)
+{
+    uint64_t now = Host_NowUs();
+
+    if (ch == DMA1_Channel4) {
+        // USART1 TX: 使能即开始搬运，按线上时间完成
+        if (state != DISABLE && ch->CNDTR > 0) {
+            s_TxLen = (uint16_t)(ch->CNDTR > HOST_TX_MAX ? HOST_TX_MAX : ch->CNDTR);
+            memcpy(s_TxData, (const void *)(uintptr_t)ch->CMAR, s_TxLen);
+            s_TxDoneUs = now + (uint64_t)s_TxLen * _ByteUs(USART1);
+        }
+    } else if (ch == DMA1_Channel5) {
+        if (state != DISABLE) s_RxDmaSize = (uint16_t)ch->CNDTR;
+    } else if (ch == DMA1_Channel1) {
+        if (state != DISABLE) s_AdcDmaSize = (uint16_t)ch->CNDTR;
+    } else if (ch == DMA1_Channel7) {
+        // DHT11: 装填捕获即开始等待整帧；停止捕获则丢弃
+        s_DhtDoneUs = (state != DISABLE && s_DhtPresent) ? now + HOST_DHT_FRAME_US : HOST_NO_EVENT;
+    }
+}
+
+/* ============================================================
+ *                 激励接口
+ * ============================================================ */
+
+void Host_UartRx(const uint8_t *data, uint16_t len)
+{
+    uint32_t byte_us = _ByteUs(USART1);
+    uint64_t now = Host_NowUs();
+    uint16_t i;
+
+    for (i = 0; i < len; i++) {
+        uint16_t next = (uint16_t)((s_RxHead + 1) % HOST_RX_QUEUE_SIZE);
+        if (next == s_RxTail) break;
+        s_RxData[s_RxHead] = data[i];
+        s_RxHead = next;
+    }
+    if (s_RxNextUs == HOST_NO_EVENT) s_RxNextUs = now + byte_us;
+}
+
+void Host_SetUartTxSink(void (*sink)(const uint8_t *data, uint16_t len, uint64_t t_us)) { s_TxSink = sink; }
+void Host_SetLogSink(void (*sink)(uint8_t byte)) { s_LogSink = sink; }
+void Host_SetAdc(uint16_t raw) { s_AdcRaw = raw & 0x0FFF; }
+void Host_SetAdcSource(uint16_t (*source)(uint64_t t_us)) { s_AdcSource = source; }
+
+uint16_t Host_Periph_AdcSample(void)
+{
+    uint64_t now = Host_NowUs();
+
+    s_Stats.AdcSamples++;
+    return s_AdcSource ? (s_AdcSource(now) & 0x0FFF) : s_AdcRaw;
+}
+
+void Host_SetDht11(uint8_t humi, uint8_t temp, uint8_t present)
+{
+    s_DhtFrame[0] = humi;
+    s_DhtFrame[1] = 0;
+    s_DhtFrame[2] = temp;
+    s_DhtFrame[3] = 0;
+    s_DhtFrame[4] = (uint8_t)(humi + temp);
+    s_DhtPresent = present;
+}
+
+void Host_Dht11Edges(const uint8_t frame[5], uint16_t base, uint16_t *edges)
+{
+    uint16_t t = base;
+    uint8_t i;
+
+    edges[0] = t;
+    t = (uint16_t)(t + HOST_DHT_ACK_US);
+    edges[1] = t;
+    for (i = 0; i < 40; i++) {
+        uint8_t bit = (frame[i / 8] >> (7 - (i % 8))) & 1;
+        t = (uint16_t)(t + (bit ? HOST_DHT_BIT1_US : HOST_DHT_BIT0_US));
+        edges[i + 2] = t;
+    }
+}
+
+void Host_EncoderTurn(int16_t counts)
+{
+    TIM4->CNT = (uint16_t)(TIM4->CNT + counts);
+}
+
+uint16_t Host_PwmWarm(void) { return (uint16_t)TIM3->CCR1; }
+uint16_t Host_PwmCold(void) { return (uint16_t)TIM3->CCR2; }
+
+/* ============================================================
+ *                 事件调度
+ * ============================================================ */
+
+static uint64_t _LogNext(void)
+{
+    if (!(USART2->CR1 & USART_CR1_TXEIE) || !(USART2->CR1 & USART_CR1_UE)) return HOST_NO_EVENT;
+    return s_LogTxeUs;
+}
+
+static uint64_t _AdcNext(void)
+{
+    if (!(ADC1->CR2 & ADC_CR2_EXTTRIG) || !(DMA1_Channel1->CCR & DMA_CCR1_EN)) return HOST_NO_EVENT;
+    return s_AdcNextUs;
+}
+
+uint64_t Host_Periph_NextEvent(void)
+{
+    uint64_t t = HOST_NO_EVENT;
+    uint64_t c[6];
+    uint8_t i;
+
+    c[0] = s_RxNextUs;
+    c[1] = s_RxIdleUs;
+    c[2] = s_TxDoneUs;
+    c[3] = _LogNext();
+    c[4] = _AdcNext();
+    c[5] = s_DhtDoneUs;
+    for (i = 0; i < 6; i++) {
+        if (c[i] < t) t = c[i];
+    }
+    return t;
+}
+
+static void _ServiceRx(uint64_t now)
+{
+    uint32_t byte_us = _ByteUs(USART1);
+
+    while (s_RxNextUs <= now && s_RxTail != s_RxHead) {
+        DMA_Channel_TypeDef *ch = DMA1_Channel5;
+        if ((ch->CCR & DMA_CCR1_EN) && s_RxDmaSize) {
+            uint16_t pos = (uint16_t)(s_RxDmaSize - ch->CNDTR);
+            ((volatile uint8_t *)(uintptr_t)ch->CMAR)[pos] = s_RxData[s_RxTail];
+            ch->CNDTR = (ch->CNDTR > 1) ? ch->CNDTR - 1 : s_RxDmaSize;
+        }
+        s_RxTail = (uint16_t)((s_RxTail + 1) % HOST_RX_QUEUE_SIZE);
+        s_Stats.UartRxBytes++;
+        if (s_RxTail == s_RxHead) {
+            s_RxIdleUs = s_RxNextUs + byte_us;  // 空闲一帧时间后检测到 IDLE
+            s_RxNextUs = HOST_NO_EVENT;
+        } else {
+            s_RxNextUs += byte_us;
+        }
+    }
+
+    if (s_RxIdleUs <= now) {
+        s_RxIdleUs = HOST_NO_EVENT;
+        USART1->SR |= USART_FLAG_IDLE;
+        if (USART1->CR1 & USART_CR1_IDLEIE) Host_RaiseIrq(USART1_IRQn);
+        USART1->SR &= (uint16_t)~USART_FLAG_IDLE;   // 处理函数已按 SR -> DR 顺序读取
+    }
+}
+
+static void _ServiceTx(uint64_t now)
+{
+    if (s_TxDoneUs > now) return;
+    s_TxDoneUs = HOST_NO_EVENT;
+    s_Stats.UartTxBytes += s_TxLen;
+    if (s_TxSink) s_TxSink(s_TxData, s_TxLen, now);
+    DMA1_Channel4->CNDTR = 0;
+    DMA1->ISR |= DMA1_IT_GL4 | DMA1_IT_TC4;
+    if (DMA1_Channel4->CCR & DMA_IT_TC) Host_RaiseIrq(DMA1_Channel4_IRQn);
+}
+
+static void _ServiceLog(uint64_t now)
+{
+    while (_LogNext() <= now) {
+        USART2->SR |= USART_FLAG_TXE;
+        USART2->DR = 0xFFFF;            // DR 只有 9 位，写入后必然不同于该值
+        Host_RaiseIrq(USART2_IRQn);
+        if (USART2->DR == 0xFFFF) {
+            // 处理函数关闭了 TXE 中断 (缓冲区已空)；中断未使能时一字节后再查
+            s_LogTxeUs = now + _ByteUs(USART2);
+            break;
+        }
+        s_Stats.LogBytes++;
+        if (s_LogSink) s_LogSink((uint8_t)USART2->DR);
+        USART2->SR &= (uint16_t)~USART_FLAG_TXE;
+        s_LogTxeUs = now + _ByteUs(USART2);
+    }
+}
+
+static void _ServiceAdc(uint64_t now)
+{
+    DMA_Channel_TypeDef *ch = DMA1_Channel1;
+
+    while (_AdcNext() <= now) {
+        uint16_t raw = s_AdcSource ? (s_AdcSource(s_AdcNextUs) & 0x0FFF) : s_AdcRaw;
+        uint16_t pos;
+
+        s_AdcNextUs += HOST_ADC_PERIOD_US;
+        if (!s_AdcDmaSize) continue;
+        ADC1->DR = raw;
+        pos = (uint16_t)(s_AdcDmaSize - ch->CNDTR);
+        ((volatile uint16_t *)(uintptr_t)ch->CMAR)[pos] = raw;
+        s_Stats.AdcSamples++;
+        ch->CNDTR--;
+        if (ch->CNDTR == s_AdcDmaSize / 2) {
+            DMA1->ISR |= DMA1_IT_GL1 | DMA1_IT_HT1;
+            if (ch->CCR & DMA_IT_HT) Host_RaiseIrq(DMA1_Channel1_IRQn);
+        } else if (ch->CNDTR == 0) {
+            ch->CNDTR = s_AdcDmaSize;   // 循环模式自动重装
+            DMA1->ISR |= DMA1_IT_GL1 | DMA1_IT_TC1;
+            if (ch->CCR & DMA_IT_TC) Host_RaiseIrq(DMA1_Channel1_IRQn);
+        }
+    }
+    // ADC 未运行时保持节拍对齐
+    if (s_AdcNextUs <= now) s_AdcNextUs = (now / HOST_ADC_PERIOD_US + 1) * HOST_ADC_PERIOD_US;
+}
+
+static void _ServiceDht(uint64_t now)
+{
+    DMA_Channel_TypeDef *ch = DMA1_Channel7;
+
+    if (s_DhtDoneUs > now) return;
+    s_DhtDoneUs = HOST_NO_EVENT;
+    if (!(ch->CCR & DMA_CCR1_EN)) return;
+
+    Host_Dht11Edges(s_DhtFrame, (uint16_t)(now - HOST_DHT_FRAME_US),
+                    (uint16_t *)(uintptr_t)ch->CMAR);
+    ch->CNDTR = 0;
+    DMA1->ISR |= DMA1_FLAG_GL7 | DMA1_FLAG_TC7;
+    s_Stats.DhtFrames++;
+}
+
+void Host_Periph_Service(uint64_t now)
+{
+    _ServiceRx(now);
+    _ServiceTx(now);
+    _ServiceLog(now);
+    _ServiceAdc(now);
+    _ServiceDht(now);
+}
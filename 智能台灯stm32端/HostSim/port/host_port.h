@@ -0,0 +1,196 @@
+#ifndef __HOST_PORT_H
+#define __HOST_PORT_H
+
+/**
+  ******************************************************************************
+  * @file    host_port.h
+  * @brief   主机侧仿真接口 (虚拟时钟、外设激励、器件模型与统计)
+  * @note    1. 固件源文件原样编译，StdPeriph 函数、SystemSupport 与 I2C_Lib
+  *             由 port/ 下的替身实现，仿真器与测试只通过本文件驱动外设
+  *          2. 时间只在 Host_Advance (含 Delay_*、总线/Flash 建模耗时与 __WFI)
+  *             中推进，到期的外设事件在推进过程中按时间顺序以中断形式投递
+  *          3. 默认纯虚拟时间，结果可复现；Host_SetCpuScale 可把主机 CPU 时间
+  *             按倍数折算进虚拟时钟
+  ******************************************************************************
+  */
+
+#include "stm32f10x.h"
+#include <stdint.h>
+
+/* ============================================================
+ *                 生命周期 / 时间 (host_mcu.c, host_clock.c)
+ * ============================================================ */
+
+/**
+  * @brief  清零外设寄存器、虚拟时钟与全部激励/统计 (Flash 内容保留)
+  */
+void     Host_Reset(void);
+
+uint64_t Host_NowUs(void);
+
+/**
+  * @brief  推进虚拟时间，期间投递到期的外设中断
+  */
+void     Host_Advance(uint32_t us);
+void     Host_RunUntil(uint64_t us);
+
+/**
+  * @brief  主机 CPU 时间折算进虚拟时钟的倍数 (0: 不折算，默认)
+  */
+void     Host_SetCpuScale(double scale);
+
+/**
+  * @brief  __WFI 的处理函数，缺省为推进到下一个毫秒节拍
+  */
+void     Host_SetIdleHook(void (*hook)(void));
+void     Host_Idle(void);
+
+/* ============================================================
+ *                 中断 / 抢占点 (host_mcu.c)
+ * ============================================================ */
+
+#define HOST_SITE_LDREX     0   /*!< __LDREXW 读出之后 */
+#define HOST_SITE_STREX     1   /*!< __STREXW 写入之前 */
+#define HOST_SITE_DMB       2   /*!< __DMB 之前 */
+
+/**
+  * @brief  抢占钩子：在 LDREX/STREX/DMB 处调用，返回 1 表示在此处执行了一次
+  *         "中断"，此时与真实内核一样清除独占监视器
+  */
+void     Host_SetPreemptHook(uint8_t (*hook)(uint8_t site));
+uint8_t  Host_IrqMasked(void);
+uint8_t  Host_IrqEnabled(IRQn_Type irq);
+
+/* ============================================================
+ *                 GPIO (host_mcu.c)
+ * ============================================================ */
+
+/**
+  * @brief  设置输入引脚电平 (复位后所有输入为高电平，即上拉空闲)
+  * @note   已配置 EXTI 的引脚在对应边沿产生中断
+  */
+void     Host_SetPin(GPIO_TypeDef *port, uint16_t pin, uint8_t level);
+uint8_t  Host_GetOutput(GPIO_TypeDef *port, uint16_t pin);
+
+/* ============================================================
+ *                 外设激励 (host_periph.c)
+ * ============================================================ */
+
+/**
+  * @brief  USART1 收到一帧：按波特率逐字节写入 RX DMA 缓冲，帧尾产生 IDLE 中断
+  */
+void     Host_UartRx(const uint8_t *data, uint16_t len);
+
+/**
+  * @brief  USART1 发送监听：每个 DMA 块发送完毕时回调 (t_us 为最后一字节离线时刻)
+  */
+void     Host_SetUartTxSink(void (*sink)(const uint8_t *data, uint16_t len, uint64_t t_us));
+
+/**
+  * @brief  USART2 (DLOG) 逐字节监听
+  */
+void     Host_SetLogSink(void (*sink)(uint8_t byte));
+
+/**
+  * @brief  LDR 的 ADC 原始值 (TIM3 每 1ms 触发一次转换)；source 非空时优先使用
+  */
+void     Host_SetAdc(uint16_t raw);
+void     Host_SetAdcSource(uint16_t (*source)(uint64_t t_us));
+
+/**
+  * @brief  DHT11 下一次读取的结果；present 为 0 时不应答 (读取超时)
+  */
+void     Host_SetDht11(uint8_t humi, uint8_t temp, uint8_t present);
+
+/**
+  * @brief  按 DHT11 时序生成下降沿捕获值 (与 TIM2 CCR2 的 DMA 结果同格式)
+  * @param  base 第一个下降沿的计数值 (16 位回绕)
+  */
+void     Host_Dht11Edges(const uint8_t frame[5], uint16_t base, uint16_t *edges);
+
+/**
+  * @brief  旋转编码器 (TIM4 计数值增减，正为顺时针)
+  */
+void     Host_EncoderTurn(int16_t counts);
+
+uint16_t Host_PwmWarm(void);
+uint16_t Host_PwmCold(void);
+
+typedef struct {
+    uint32_t UartTxBytes;
+    uint32_t UartRxBytes;
+    uint32_t LogBytes;
+    uint32_t AdcSamples;
+    uint32_t DhtFrames;
+} Host_PeriphStats_t;
+
+void     Host_GetPeriphStats(Host_PeriphStats_t *stats);
+
+/* ============================================================
+ *                 片内 Flash (host_flash.c)
+ * ============================================================ */
+
+typedef struct {
+    uint32_t Erases;
+    uint32_t Programs;      /*!< 半字编程次数 (ProgramWord 计 2 次) */
+    uint32_t Errors;        /*!< 对未擦除单元编程等失败次数 */
+    uint64_t BusyUs;
+} Host_FlashStats_t;
+
+/**
+  * @brief  擦除整个模拟 Flash 并清零统计
+  */
+void     Host_FlashReset(void);
+void     Host_GetFlashStats(Host_FlashStats_t *stats);
+
+/**
+  * @brief  掉电注入：再成功执行 ops 次擦除/编程后，下一次操作时调用 on_cut
+  * @param  torn 0: 该操作完全未执行; 1: 该操作只完成一半
+  *              (擦除只擦前半页，编程只写入一半的 0 位)
+  * @note   on_cut 一般 longjmp 回测试主体，模拟断电后重新上电
+  */
+void     Host_FlashArmCut(uint32_t ops, uint8_t torn, void (*on_cut)(void));
+void     Host_FlashDisarmCut(void);
+
+/* ============================================================
+ *                 I2C 总线与器件模型 (host_i2c.c, host_dev_*.c)
+ * ============================================================ */
+
+typedef struct Host_I2CDev {
+    const char *Name;
+    I2C_TypeDef *Bus;
+    uint8_t Addr;                   /*!< 8 位写地址 */
+    // 器件行为 (返回 0 应答, 1 不应答)
+    uint8_t (*Write)(struct Host_I2CDev *dev, const uint8_t *data, uint16_t len);
+    uint8_t (*Read)(struct Host_I2CDev *dev, uint8_t reg, uint8_t *data, uint16_t len);
+    // 统计
+    uint32_t Txn;                   /*!< 总线事务数 (一次 START..STOP，读操作含重复起始) */
+    uint32_t Bytes;                 /*!< 线上字节数 (含地址字节) */
+    uint64_t BusyUs;
+    struct Host_I2CDev *Next;
+} Host_I2CDev_t;
+
+// 软件 I2C 每字节耗时 (与 Config.h 中 UI_FLUSH_BYTE_BUDGET 的估算一致)
+#define HOST_I2C_US_PER_BYTE    30
+
+void     Host_I2CAttach(Host_I2CDev_t *dev);
+void     Host_I2CDetachAll(void);
+void     Host_I2CClearStats(void);
+
+/**
+  * @brief  SSD1306 显存模型 (I2C1, 0x78)
+  * @note   器件模型的 Attach 可重复调用，用于复位器件状态与统计
+  */
+Host_I2CDev_t *Host_OledAttach(void);
+const uint8_t *Host_OledGddram(void);   /*!< 8 页 x 128 列，SSD1306 页格式 */
+uint8_t  Host_OledWritePbm(const char *path);
+
+/**
+  * @brief  PAJ7620 寄存器模型 (I2C2, 0xE6)
+  * @param  int_wired INT 引脚是否接到 PB5 (0: 未接线，PB5 一直为上拉高电平)
+  */
+Host_I2CDev_t *Host_PajAttach(uint8_t int_wired);
+void     Host_PajGesture(uint8_t flag1, uint8_t flag2);
+void     Host_PajObject(uint8_t brightness);
+
+#endif
@@ -0,0 +1,348 @@
+/**
+  ******************************************************************************
+  * @file    lamp_sim.c
+  * @brief   主机侧整机仿真：原样运行固件 main，按脚本注入外设激励，
+  *          结束时按任务输出 CPU 时间与总线/Flash/串口统计
+  * @note    1. 用法: lamp_sim <脚本> [--cpu-scale x] [--paj-int] [--uart-out f]
+  *                   [--dlog-out f] [--oled-pbm f]
+  *          2. 脚本每行 "<时刻ms> <命令> [参数]"，时刻须递增，# 开头为注释:
+  *               dht <湿度> <温度> | dht off       DHT11 下一次读取结果
+  *               ldr <0~4095>                       LDR 的 ADC 原始值
+  *               uart <文本>                        ESP32 -> STM32 一行 (自动补 \n)
+  *               enc <计数>                         编码器 TIM4 计数增减 (EC11 每格 4 个计数)
+  *               key down | key up                  PB1 按键
+  *               gesture <flag1> [flag2]            PAJ7620 手势标志 (可用 0x 前缀)
+  *               prox <亮度>                        PAJ7620 物体亮度
+  *               expect uart <子串>                 上一次 expect uart 之后的发送中须包含
+  *               expect warm|cold <op> <值>         PWM 比较值，op 为 > < = >= <=
+  *               end                                结束仿真
+  *          3. 任务 CPU 时间分两列：虚拟 us 为固件观测到的耗时 (总线、Flash、
+  *             延时等建模耗时)；主机 us 为任务在主机上实际消耗的 CPU 时间，
+  *             按比例可估算纯计算部分在目标上的量级 (--cpu-scale 可将其折算
+  *             进虚拟时钟)
+  *          4. 固件须以 SCHED_USE_WFI 1 构建：仿真器在 __WFI 处推进时间与执行脚本
+  ******************************************************************************
+  */
+#include "host_port.h"
+#include "Scheduler.h"
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+int Firmware_Main(void);
+
+#define SIM_MAX_TASKS       16
+#define SIM_MAX_LINE        512
+
+/* ============================================================
+ *                 任务计时 (包装 Sched_Register)
+ * ============================================================ */
+
+typedef struct {
+    Sched_Task_t    *Task;
+    Sched_TaskFunc_t Func;
+    uint32_t Runs;
+    uint64_t VirtUs;
+    uint64_t VirtMaxUs;
+    uint64_t HostNs;
+    uint64_t HostMaxNs;
+} SimTask_t;
+
+static SimTask_t s_Tasks[SIM_MAX_TASKS];
+static uint8_t   s_TaskCount = 0;
+
+static uint64_t _HostNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void _RunTask(uint8_t idx)
+{
+    SimTask_t *t = &s_Tasks[idx];
+    uint64_t v0 = Host_NowUs();
+    uint64_t h0 = _HostNs();
+    uint64_t dv, dh;
+
+    t->Func();
+
+    dh = _HostNs() - h0;
+    dv = Host_NowUs() - v0;
+    t->Runs++;
+    t->VirtUs += dv;
+    t->HostNs += dh;
+    if (dv > t->VirtMaxUs) t->VirtMaxUs = dv;
+    if (dh > t->HostMaxNs) t->HostMaxNs = dh;
+}
+
+#define SIM_TRAMP(n) static void _Tramp##n(void) { _RunTask(n); }
+SIM_TRAMP(0)  SIM_TRAMP(1)  SIM_TRAMP(2)  SIM_TRAMP(3)
+SIM_TRAMP(4)  SIM_TRAMP(5)  SIM_TRAMP(6)  SIM_TRAMP(7)
+SIM_TRAMP(8)  SIM_TRAMP(9)  SIM_TRAMP(10) SIM_TRAMP(11)
+SIM_TRAMP(12) SIM_TRAMP(13) SIM_TRAMP(14) SIM_TRAMP(15)
+
+static const Sched_TaskFunc_t s_Tramps[SIM_MAX_TASKS] = {
+    _Tramp0,  _Tramp1,  _Tramp2,  _Tramp3,  _Tramp4,  _Tramp5,  _Tramp6,  _Tramp7,
+    _Tramp8,  _Tramp9,  _Tramp10, _Tramp11, _Tramp12, _Tramp13, _Tramp14, _Tramp15,
+};
+
+void __real_Sched_Register(Sched_Task_t *task);
+
+void __wrap_Sched_Register(Sched_Task_t *task)
+{
+    if (s_TaskCount < SIM_MAX_TASKS) {
+        SimTask_t *t = &s_Tasks[s_TaskCount];
+        memset(t, 0, sizeof(*t));
+        t->Task = task;
+        t->Func = task->Func;
+        task->Func = s_Tramps[s_TaskCount];
+        s_TaskCount++;
+    }
+    __real_Sched_Register(task);
+}
+
+/* ============================================================
+ *                 输出捕获
+ * ============================================================ */
+
+static char    *s_TxLog = NULL;         // USART1 发送内容 (以 \0 结尾)
+static size_t   s_TxLen = 0, s_TxCap = 0;
+static size_t   s_TxMark = 0;           // 上一次 expect uart 检查到的位置
+static FILE    *s_UartOut = NULL;
+static FILE    *s_DlogOut = NULL;
+
+static void _OnUartTx(const uint8_t *data, uint16_t len, uint64_t t_us)
+{
+    (void)t_us;
+    if (s_TxLen + len + 1 > s_TxCap) {
+        s_TxCap = (s_TxLen + len + 1) * 2;
+        s_TxLog = realloc(s_TxLog, s_TxCap);
+    }
+    memcpy(s_TxLog + s_TxLen, data, len);
+    s_TxLen += len;
+    s_TxLog[s_TxLen] = '\0';
+    if (s_UartOut) fwrite(data, 1, len, s_UartOut);
+}
+
+static void _OnLogByte(uint8_t byte)
+{
+    if (s_DlogOut) fputc(byte, s_DlogOut);
+}
+
+/* ============================================================
+ *                 脚本
+ * ============================================================ */
+
+static FILE    *s_Script = NULL;
+static char     s_Line[SIM_MAX_LINE];
+static uint64_t s_LineUs = 0;
+static uint8_t  s_HaveLine = 0;
+static uint32_t s_LineNo = 0;
+static uint64_t s_EndUs = UINT64_MAX;
+static uint32_t s_Failures = 0;
+static jmp_buf  s_Exit;
+
+// 读取下一条有效命令；s_Line 指向命令部分
+static uint8_t _NextLine(void)
+{
+    char buf[SIM_MAX_LINE];
+
+    while (fgets(buf, sizeof(buf), s_Script)) {
+        char *p = buf, *end;
+        unsigned long ms;
+
+        s_LineNo++;
+        buf[strcspn(buf, "\r\n")] = '\0';
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '\0' || *p == '#') continue;
+        ms = strtoul(p, &end, 10);
+        if (end == p) {
+            fprintf(stderr, "script:%u: 缺少时刻\n", (unsigned)s_LineNo);
+            exit(2);
+        }
+        while (*end == ' ' || *end == '\t') end++;
+        s_LineUs = (uint64_t)ms * 1000;
+        snprintf(s_Line, sizeof(s_Line), "%s", end);
+        return 1;
+    }
+    return 0;
+}
+
+static uint8_t _Compare(long v, const char *op, long ref)
+{
+    if (strcmp(op, ">") == 0)  return v > ref;
+    if (strcmp(op, "<") == 0)  return v < ref;
+    if (strcmp(op, ">=") == 0) return v >= ref;
+    if (strcmp(op, "<=") == 0) return v <= ref;
+    return v == ref;
+}
+
+static void _Fail(const char *what)
+{
+    fprintf(stderr, "script:%u @%llums: FAIL %s\n", (unsigned)s_LineNo,
+            (unsigned long long)(Host_NowUs() / 1000), what);
+    s_Failures++;
+}
+
+static void _Execute(char *cmd)
+{
+    char *arg = cmd + strcspn(cmd, " \t");
+
+    if (*arg) *arg++ = '\0';
+    while (*arg == ' ' || *arg == '\t') arg++;
+
+    if (strcmp(cmd, "dht") == 0) {
+        unsigned h = 0, t = 0;
+        if (strncmp(arg, "off", 3) == 0) Host_SetDht11(0, 0, 0);
+        else if (sscanf(arg, "%u %u", &h, &t) == 2) Host_SetDht11((uint8_t)h, (uint8_t)t, 1);
+    } else if (strcmp(cmd, "ldr") == 0) {
+        Host_SetAdc((uint16_t)strtoul(arg, NULL, 0));
+    } else if (strcmp(cmd, "uart") == 0) {
+        char frame[SIM_MAX_LINE + 1];
+        int n = snprintf(frame, sizeof(frame), "%s\n", arg);
+        Host_UartRx((const uint8_t *)frame, (uint16_t)n);
+    } else if (strcmp(cmd, "enc") == 0) {
+        Host_EncoderTurn((int16_t)strtol(arg, NULL, 0));
+    } else if (strcmp(cmd, "key") == 0) {
+        Host_SetPin(GPIOB, GPIO_Pin_1, strncmp(arg, "down", 4) == 0 ? 0 : 1);
+    } else if (strcmp(cmd, "gesture") == 0) {
+        char *end;
+        unsigned long f1 = strtoul(arg, &end, 0);
+        unsigned long f2 = strtoul(end, NULL, 0);
+        Host_PajGesture((uint8_t)f1, (uint8_t)f2);
+    } else if (strcmp(cmd, "prox") == 0) {
+        Host_PajObject((uint8_t)strtoul(arg, NULL, 0));
+    } else if (strcmp(cmd, "expect") == 0) {
+        char what[16], op[4];
+        long ref;
+        if (strncmp(arg, "uart ", 5) == 0) {
+            if (!s_TxLog || !strstr(s_TxLog + s_TxMark, arg + 5)) _Fail(arg);
+            s_TxMark = s_TxLen;
+        } else if (sscanf(arg, "%15s %3s %ld", what, op, &ref) == 3) {
+            long v = (strcmp(what, "warm") == 0) ? Host_PwmWarm() : Host_PwmCold();
+            if (!_Compare(v, op, ref)) {
+                char msg[64];
+                snprintf(msg, sizeof(msg), "%s = %ld, 期望 %s %ld", what, v, op, ref);
+                _Fail(msg);
+            }
+        } else {
+            _Fail(arg);
+        }
+    } else if (strcmp(cmd, "end") == 0) {
+        s_EndUs = Host_NowUs();
+    } else {
+        fprintf(stderr, "script:%u: 未知命令 %s\n", (unsigned)s_LineNo, cmd);
+        exit(2);
+    }
+}
+
+// __WFI: 推进到下一个唤醒点，再执行到期的脚本命令
+static void _Idle(void)
+{
+    Host_Idle();
+    while (s_HaveLine && s_LineUs <= Host_NowUs()) {
+        _Execute(s_Line);
+        s_HaveLine = _NextLine();
+        if (!s_HaveLine && s_EndUs == UINT64_MAX) s_EndUs = s_LineUs + 1000000;
+    }
+    if (Host_NowUs() >= s_EndUs) longjmp(s_Exit, 1);
+}
+
+/* ============================================================
+ *                 报告
+ * ============================================================ */
+
+static void _Report(Host_I2CDev_t **devs, uint8_t dev_count)
+{
+    uint64_t dur = Host_NowUs();
+    Host_PeriphStats_t ps;
+    Host_FlashStats_t fs;
+    uint64_t host_total = 0;
+    uint8_t i;
+
+    if (dur == 0) dur = 1;
+    for (i = 0; i < s_TaskCount; i++) host_total += s_Tasks[i].HostNs;
+
+    printf("仿真时长 %llu ms\n\n", (unsigned long long)(dur / 1000));
+    printf("%-8s %5s %7s %10s %7s %6s %10s %8s %6s %4s\n",
+           "task", "per", "runs", "virt_us", "max_us", "cpu%", "host_us", "host_max", "jit", "miss");
+    for (i = 0; i < s_TaskCount; i++) {
+        SimTask_t *t = &s_Tasks[i];
+        printf("%-8s %5u %7u %10llu %7llu %6.2f %10.1f %8.1f %6u %4u\n",
+               t->Task->Name, t->Task->PeriodMs, t->Runs,
+               (unsigned long long)t->VirtUs, (unsigned long long)t->VirtMaxUs,
+               100.0 * (double)t->VirtUs / (double)dur,
+               t->HostNs / 1000.0, t->HostMaxNs / 1000.0,
+               t->Task->MaxLateMs, t->Task->DeadlineMiss);
+    }
+    printf("(主机 CPU 合计 %.1f ms)\n\n", host_total / 1e6);
+
+    printf("%-8s %7s %8s %9s %6s\n", "i2c", "txn", "bytes", "busy_us", "util%");
+    for (i = 0; i < dev_count; i++) {
+        printf("%-8s %7u %8u %9llu %6.2f\n", devs[i]->Name, devs[i]->Txn, devs[i]->Bytes,
+               (unsigned long long)devs[i]->BusyUs, 100.0 * (double)devs[i]->BusyUs / (double)dur);
+    }
+
+    Host_GetFlashStats(&fs);
+    Host_GetPeriphStats(&ps);
+    printf("\nflash: erase %u, program %u, error %u, busy %llu us\n",
+           fs.Erases, fs.Programs, fs.Errors, (unsigned long long)fs.BusyUs);
+    printf("uart: tx %u B, rx %u B; dlog %u B; adc %u; dht %u\n",
+           ps.UartTxBytes, ps.UartRxBytes, ps.LogBytes, ps.AdcSamples, ps.DhtFrames);
+}
+
+int main(int argc, char **argv)
+{
+    Host_I2CDev_t *devs[2];
+    const char *pbm = NULL;
+    double cpu_scale = 0.0;
+    uint8_t paj_int = 0;
+    int i;
+
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <script> [--cpu-scale x] [--paj-int] "
+                        "[--uart-out f] [--dlog-out f] [--oled-pbm f]\n", argv[0]);
+        return 2;
+    }
+    s_Script = fopen(argv[1], "r");
+    if (!s_Script) {
+        perror(argv[1]);
+        return 2;
+    }
+    for (i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--paj-int") == 0) paj_int = 1;
+        else if (i + 1 >= argc) break;
+        else if (strcmp(argv[i], "--cpu-scale") == 0) cpu_scale = atof(argv[++i]);
+        else if (strcmp(argv[i], "--uart-out") == 0) s_UartOut = fopen(argv[++i], "wb");
+        else if (strcmp(argv[i], "--dlog-out") == 0) s_DlogOut = fopen(argv[++i], "wb");
+        else if (strcmp(argv[i], "--oled-pbm") == 0) pbm = argv[++i];
+    }
+
+    Host_Reset();
+    devs[0] = Host_OledAttach();
+    devs[1] = Host_PajAttach(paj_int);
+    Host_SetUartTxSink(_OnUartTx);
+    Host_SetLogSink(_OnLogByte);
+    Host_SetIdleHook(_Idle);
+    Host_SetCpuScale(cpu_scale);
+
+    s_HaveLine = _NextLine();
+    if (!s_HaveLine) s_EndUs = 1000000;
+
+    if (setjmp(s_Exit) == 0) {
+        Firmware_Main();
+    }
+
+    _Report(devs, 2);
+    if (pbm) Host_OledWritePbm(pbm);
+    if (s_UartOut) fclose(s_UartOut);
+    if (s_DlogOut) fclose(s_DlogOut);
+    if (s_Failures) {
+        printf("\n%u 项检查失败\n", (unsigned)s_Failures);
+        return 1;
+    }
+    return 0;
+}
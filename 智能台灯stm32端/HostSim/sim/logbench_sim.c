@@ -0,0 +1,109 @@
+/**
+  ******************************************************************************
+  * @file    logbench_sim.c
+  * @brief   文本 / 二进制日志两条路径的主机侧对比：单次格式化/编码耗时与线上字节数
+  * @note    1. 用法: logbench_sim [--rounds n]
+  *          2. 直接包含 DLog.c，用例与固件 {"cmd":"logbench"} (DLog_Bench) 相同，
+  *             调用同样的 _BenchText / _BenchBin；循环 n 次取平均，避免单次计时
+  *             的计时器开销 (DLog_Bench 在目标板上以 DWT 周期计时，主机上为 ns)
+  *          3. 线上时间按各自的串口计算：文本 (DLOG_MODE 1) 走协议串口 USART1，
+  *             二进制 (DLOG_MODE 2) 走 LogPort (USART2, DLOG_BAUDRATE)，8N1 每字节 10 位
+  *          4. 二进制记录须比文本短，否则返回非 0 (供 ctest 使用)
+  ******************************************************************************
+  */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static uint64_t _HostNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// 本程序不链接虚拟时钟，Profiler 钩子改为主机计时
+#undef  PROF_NOW
+#undef  PROF_COUNTER_RESET
+#define PROF_NOW()              ((uint32_t)_HostNs())
+#define PROF_COUNTER_RESET()    ((void)0)
+#define PROF_ENABLE             1
+
+#include "DLog.c"
+
+/* ============================================================
+ *                 DLog.c 依赖的替身 (只编码，不发送)
+ * ============================================================ */
+
+void     LogPort_Init(void)                                 {}
+uint8_t  LogPort_Write(const uint8_t *data, uint16_t len)   { (void)data; (void)len; return 1; }
+int      USART_DMA_Send(uint8_t *data, uint16_t len)        { (void)data; return len; }
+int      USART_DMA_Printf(const char *fmt, ...)             { (void)fmt; return 0; }
+uint32_t System_GetTick(void)                               { return 0; }
+
+uint8_t g_Sink[128];    // 全局可见，避免拷贝被优化掉
+
+#define TXT_BAUD    USART_DMA_BAUDRATE
+#define BIN_BAUD    DLOG_BAUDRATE
+
+// 0: 无参数  1: 三个整数  2: 一个字符串
+static const char *const s_Cases[3] = { "0-noarg", "1-3int", "2-str" };
+
+// 与 DLog_Bench 相同的三个用例
+static uint16_t _Text(uint8_t c, uint32_t r)
+{
+    switch (c) {
+        case 0:  return _BenchText(g_Sink, "[Ctrl] Focus -> CCT\r\n");
+        case 1:  return _BenchText(g_Sink, "[Persist] Restored Bri=%d CCT=%d Auto=%d\r\n", 500 + (int)(r & 15), 50, 1);
+        default: return _BenchText(g_Sink, "[Ctrl] Mode -> %s\r\n", r & 1 ? "LOCAL" : "UI");
+    }
+}
+
+static uint16_t _Bin(uint8_t c, uint32_t r)
+{
+    switch (c) {
+        case 0:  return _BenchBin(g_Sink, 10, "");
+        case 1:  return _BenchBin(g_Sink, 20, "ddd", 500 + (int)(r & 15), 50, 1);
+        default: return _BenchBin(g_Sink, 30, "s", r & 1 ? "LOCAL" : "UI");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t rounds = 1000000, r;
+    uint8_t c;
+    int fail = 0;
+
+    if (argc == 3 && strcmp(argv[1], "--rounds") == 0) rounds = (uint32_t)strtoul(argv[2], NULL, 0);
+    else if (argc != 1) {
+        fprintf(stderr, "usage: %s [--rounds n]\n", argv[0]);
+        return 2;
+    }
+    if (rounds == 0) rounds = 1;
+
+    printf("%-10s %6s %6s %9s %9s %10s %10s\n",
+           "case", "txt_b", "bin_b", "txt_ns", "bin_ns", "txt_wire", "bin_wire");
+    for (c = 0; c < 3; c++) {
+        uint64_t t0, t_txt, t_bin;
+        uint16_t b_txt = 0, b_bin = 0;
+
+        t0 = _HostNs();
+        for (r = 0; r < rounds; r++) b_txt = _Text(c, r);
+        t_txt = _HostNs() - t0;
+
+        t0 = _HostNs();
+        for (r = 0; r < rounds; r++) b_bin = _Bin(c, r);
+        t_bin = _HostNs() - t0;
+
+        // 线上时间 (us)
+        printf("%-10s %6u %6u %9.1f %9.1f %8.1fus %8.1fus\n", s_Cases[c], b_txt, b_bin,
+               (double)t_txt / rounds, (double)t_bin / rounds,
+               b_txt * 10e6 / TXT_BAUD, b_bin * 10e6 / BIN_BAUD);
+        if (b_bin >= b_txt) fail = 1;
+    }
+    printf("(主机 ns/次，%u 次平均；文本 %u bps，二进制 %u bps)\n",
+           (unsigned)rounds, (unsigned)TXT_BAUD, (unsigned)BIN_BAUD);
+    return fail;
+}
@@ -0,0 +1,130 @@
+/**
+  ******************************************************************************
+  * @file    paj_trace_sim.c
+  * @brief   PAJ7620 读取方式对比：按手势轨迹驱动驱动状态机，统计 I2C 总线
+  *          占用与手势到 Hook 的延迟
+  * @note    1. 用法: paj_trace_sim_<poll|int> <轨迹> [--unwired]
+  *          2. 与调度器相同，每 5ms 调用一次 PAJ7620_Process_StateMachine
+  *          3. 轨迹中每个手势都必须触发对应 Hook，否则返回非 0 (供 ctest 使用)
+  ******************************************************************************
+  */
+#include "host_port.h"
+#include "PAJ7620.h"
+#include "Config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_TASK_PERIOD_US  5000
+#define SIM_MAX_PENDING     16
+#define SIM_MAX_SAMPLES     256
+
+static uint64_t s_Pending[SIM_MAX_PENDING];    // 已注入、尚未触发 Hook 的手势时刻
+static uint8_t  s_PendHead, s_PendCount;
+static uint32_t s_LatUs[SIM_MAX_SAMPLES];
+static uint32_t s_LatCount;
+static uint32_t s_Injected, s_Hooks, s_ProxFrames;
+
+static void _OnGesture(void)
+{
+    uint64_t t0;
+
+    s_Hooks++;
+    if (!s_PendCount) return;
+    t0 = s_Pending[s_PendHead];
+    s_PendHead = (uint8_t)((s_PendHead + 1) % SIM_MAX_PENDING);
+    s_PendCount--;
+    if (s_LatCount < SIM_MAX_SAMPLES) s_LatUs[s_LatCount++] = (uint32_t)(Host_NowUs() - t0);
+}
+
+void PAJ7620_Hook_OnUp(void)                 { _OnGesture(); }
+void PAJ7620_Hook_OnDown(void)               { _OnGesture(); }
+void PAJ7620_Hook_OnLeft(void)               { _OnGesture(); }
+void PAJ7620_Hook_OnRight(void)              { _OnGesture(); }
+void PAJ7620_Hook_OnForward(void)            { _OnGesture(); }
+void PAJ7620_Hook_OnBackward(void)           { _OnGesture(); }
+void PAJ7620_Hook_OnClockwise(void)          { _OnGesture(); }
+void PAJ7620_Hook_OnCounterClockwise(void)   { _OnGesture(); }
+void PAJ7620_Hook_OnWave(void)               { _OnGesture(); }
+void PAJ7620_Hook_OnProximity(uint8_t b)     { (void)b; s_ProxFrames++; }
+
+static int _CmpU32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void _Inject(const char *cmd, const char *arg)
+{
+    if (strcmp(cmd, "gesture") == 0) {
+        char *end;
+        unsigned long f1 = strtoul(arg, &end, 0);
+        unsigned long f2 = strtoul(end, NULL, 0);
+        Host_PajGesture((uint8_t)f1, (uint8_t)f2);
+        if (s_PendCount < SIM_MAX_PENDING) {
+            s_Pending[(s_PendHead + s_PendCount) % SIM_MAX_PENDING] = Host_NowUs();
+            s_PendCount++;
+        }
+        s_Injected++;
+    } else if (strcmp(cmd, "prox") == 0) {
+        Host_PajObject((uint8_t)strtoul(arg, NULL, 0));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Host_I2CDev_t *paj;
+    FILE *fp;
+    char line[128];
+    uint64_t next_task = 0, end_us = 0;
+    uint8_t wired = 1;
+    uint64_t sum = 0;
+    uint32_t i;
+
+    if (argc < 2 || !(fp = fopen(argv[1], "r"))) {
+        fprintf(stderr, "usage: %s <轨迹> [--unwired]\n", argv[0]);
+        return 2;
+    }
+    if (argc > 2 && strcmp(argv[2], "--unwired") == 0) wired = 0;
+
+    Host_Reset();
+    paj = Host_PajAttach(wired);
+    if (PAJ7620_Init() != 0) return 2;
+    Host_I2CClearStats();
+
+    while (fgets(line, sizeof(line), fp)) {
+        char cmd[16] = "", arg[64] = "";
+        unsigned long ms;
+
+        if (line[0] == '#' || sscanf(line, "%lu %15s %63[^\n]", &ms, cmd, arg) < 2) continue;
+        // 运行到该时刻：期间按任务周期调用状态机
+        while (next_task <= (uint64_t)ms * 1000) {
+            Host_RunUntil(next_task);
+            PAJ7620_Process_StateMachine();
+            next_task += SIM_TASK_PERIOD_US;
+        }
+        Host_RunUntil((uint64_t)ms * 1000);
+        if (strcmp(cmd, "end") == 0) {
+            end_us = (uint64_t)ms * 1000;
+            break;
+        }
+        _Inject(cmd, arg);
+    }
+    fclose(fp);
+    if (end_us == 0) end_us = Host_NowUs();
+
+    qsort(s_LatUs, s_LatCount, sizeof(s_LatUs[0]), _CmpU32);
+    for (i = 0; i < s_LatCount; i++) sum += s_LatUs[i];
+
+    printf("模式: %s%s, 时长 %.1f s\n", PAJ_USE_INT_PIN ? "INT" : "轮询",
+           (PAJ_USE_INT_PIN && !wired) ? " (INT 未接线)" : "", end_us / 1e6);
+    printf("I2C: %u 事务, %u 字节, 占用 %llu us (%.2f%%)\n", paj->Txn, paj->Bytes,
+           (unsigned long long)paj->BusyUs, 100.0 * (double)paj->BusyUs / (double)end_us);
+    printf("手势: 注入 %u, 触发 Hook %u, 近距帧 %u\n", s_Injected, s_Hooks, s_ProxFrames);
+    if (s_LatCount) {
+        printf("延迟 ms: 平均 %.1f, p50 %.1f, p90 %.1f, 最大 %.1f\n",
+               sum / 1000.0 / s_LatCount, s_LatUs[s_LatCount / 2] / 1000.0,
+               s_LatUs[s_LatCount * 9 / 10] / 1000.0, s_LatUs[s_LatCount - 1] / 1000.0);
+    }
+    return (s_Hooks == s_Injected && s_PendCount == 0) ? 0 : 1;
+}
@@ -0,0 +1,517 @@
+/**
+  ******************************************************************************
+  * @file    trace_e2e_sim.c
+  * @brief   端到端延迟追踪仿真：原样运行固件 main (PROTO_TRACE_ENABLE=1)，
+  *          面板、MQTT 与 ESP32 按时延模型接入 USART1，按跳输出分位数与直方图
+  * @note    1. 用法: trace_e2e_sim [--count n] [--seed s] [--mqtt lo hi]
+  *                   [--esp lo hi] [--ui lo hi] [--cpu-scale x] [--json file]
+  *             区间单位 ms，均匀分布；stm32 跳默认只含建模耗时，纯解析计算需用
+  *             --cpu-scale 折算 (同 lamp_sim)
+  *          2. 两条链路各追踪 n 次：
+  *               面板指令: 面板 -> MQTT -> ESP32 -> UART -> STM32 (PWM) -> trace 回执
+  *                         -> ESP32 -> MQTT -> 面板
+  *               本地操作: 编码器 -> STM32 节流上报 state(tid/age) -> ESP32
+  *                         -> MQTT -> 面板界面应用
+  *          3. 各跳按面板 tracing.py 的公式由设备上报的相对时间戳计算 (名称一致)，
+  *             同时以仿真的统一时钟得到真实值 (true_pwm / true_slider)，两者之差
+  *             即为面板估算 (MQTT 单程取往返一半等) 的误差
+  *          4. UART 线上时间、STM32 任务调度与解析耗时来自固件仿真；MQTT/ESP32/
+  *             界面为模型参数，直方图桶与 trace_report.py 相同
+  *          5. 任一追踪未完成时返回非 0 (供 ctest 使用)
+  *          6. ESP32 的各跳由 ESP32 工程的 latency_trace.c 原样记录 (esp_timer 取虚拟时钟)，
+  *             调用顺序与 agent_mqtt.c / dev_stm32.c 相同，发布的追踪结果即 Trace_Finish 的输出
+  *          7. --json 按面板收到的时间顺序输出 JSON Lines，供面板 bench/trace_replay.py
+  *             回放给 tracing.py 并与本程序的结果核对：
+  *               {"t":us,"sent":tid}          面板发出带 tid 的指令
+  *               {"t":us,"status":tid}        面板收到带 tid 的状态 (本地操作)
+  *               {"t":us,"device":{...}}      面板收到设备的追踪结果 (Trace_Finish 输出)
+  *               {"t":us,"applied":tid}       状态已应用到界面
+  *               {"expect":{...}}             本程序算出的各跳 (ms)，字段同 tracing.py
+  ******************************************************************************
+  */
+#include "host_port.h"
+#include "latency_trace.h"
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int Firmware_Main(void);
+
+#define SIM_MAX_TRACES      1024
+#define SIM_MAX_EVENTS      64
+#define SIM_CMD_PERIOD_US   150000      // 面板指令间隔 (单条在途，避免两帧合并为一次 IDLE)
+#define SIM_ENC_PERIOD_US   500000      // 编码器操作间隔 (> 200ms 上报节流)
+#define SIM_SETTLE_US       3000000     // 上电后等待初始化完成
+#define SIM_LINE_MAX        256
+#define SIM_TRACE_JSON_MAX  192
+
+/* ============================================================
+ *                 时延模型
+ * ============================================================ */
+
+typedef struct { uint32_t Lo, Hi; } SimRange_t;    // us
+
+static SimRange_t s_Mqtt = { 4000, 30000 };         // 面板 <-> Broker <-> ESP32 单程
+static SimRange_t s_Esp  = { 300, 2000 };           // ESP32 事件总线 + 业务处理
+static SimRange_t s_Ui   = { 0, 100000 };           // 面板界面帧 (UI_FRAME_MS = 100)
+static uint32_t   s_Seed = 1;
+
+static uint32_t _Rand(SimRange_t r)
+{
+    s_Seed = s_Seed * 1103515245u + 12345u;
+    if (r.Hi <= r.Lo) return r.Lo;
+    return r.Lo + (s_Seed >> 8) % (r.Hi - r.Lo + 1);
+}
+
+// latency_trace.c 的时间源：ESP32 与仿真共用统一时钟
+int64_t esp_timer_get_time(void)
+{
+    return (int64_t)Host_NowUs();
+}
+
+/* ============================================================
+ *                 追踪记录
+ * ============================================================ */
+
+typedef enum { SRC_PANEL = 0, SRC_STM32 } SimSrc_t;
+
+typedef struct {
+    uint64_t PanelTx;       // 面板发出 / 本地操作时刻
+    uint64_t EspRx;         // ESP32 收到 MQTT 指令
+    uint64_t UartTx;        // ESP32 写入 UART
+    uint64_t Pwm;           // PWM 实际改变
+    uint64_t UartRx;        // ESP32 收到 STM32 回执/上报 (最后一字节)
+    uint64_t MqttTx;        // ESP32 发布追踪结果
+    uint64_t StatusAt;      // 面板收到
+    uint64_t AppliedAt;     // 面板界面应用 (本地操作)
+    uint32_t Stm32Us;       // 设备上报: trace.us 或 state.age * 1000
+    uint32_t Tid;           // 追踪编号 (面板指令为序号 + 1，本地操作取 state 上报的 tid)
+    char     Json[SIM_TRACE_JSON_MAX];  // ESP32 发布的追踪结果，空表示已被覆盖或超时
+    uint8_t  Done;
+} SimTrace_t;
+
+static SimTrace_t s_Trace[2][SIM_MAX_TRACES];
+static uint32_t   s_Count = 200;
+static uint32_t   s_Sent[2], s_Done[2];
+static uint32_t   s_Published[2];       // Trace_Finish 有输出的条数
+
+/* ============================================================
+ *                 模型侧事件 (按时间执行，固件在 __WFI 处让出)
+ * ============================================================ */
+
+typedef enum { EV_PANEL_TX, EV_ESP_RX, EV_ESP_UART_TX, EV_ESP_PUBLISH, EV_PANEL_RX, EV_UI_APPLY, EV_ENC } SimEvType_t;
+
+typedef struct {
+    uint64_t    At;
+    SimEvType_t Type;
+    SimSrc_t    Src;
+    uint32_t    Idx;
+} SimEvent_t;
+
+static SimEvent_t s_Events[SIM_MAX_EVENTS];
+static uint8_t    s_EventCount;
+static jmp_buf    s_Exit;
+static uint16_t   s_LastWarm;
+static int32_t    s_PwmWait = -1;           // 等待 PWM 改变的面板追踪
+
+static void _Post(uint64_t at, SimEvType_t type, SimSrc_t src, uint32_t idx)
+{
+    if (s_EventCount >= SIM_MAX_EVENTS) {
+        fprintf(stderr, "事件队列溢出\n");
+        exit(2);
+    }
+    s_Events[s_EventCount].At = at;
+    s_Events[s_EventCount].Type = type;
+    s_Events[s_EventCount].Src = src;
+    s_Events[s_EventCount].Idx = idx;
+    s_EventCount++;
+}
+
+static void _Fire(const SimEvent_t *ev)
+{
+    uint64_t now = Host_NowUs();
+    SimTrace_t *t = &s_Trace[ev->Src][ev->Idx];
+
+    switch (ev->Type) {
+    case EV_PANEL_TX:
+        // 面板发出带 tid 的调光指令，每次取不同的 PWM 值以便观察生效时刻
+        t->PanelTx = now;
+        t->Tid = ev->Idx + 1;
+        _Post(now + _Rand(s_Mqtt), EV_ESP_RX, SRC_PANEL, ev->Idx);
+        if (ev->Idx + 1 < s_Count) _Post(now + SIM_CMD_PERIOD_US, EV_PANEL_TX, SRC_PANEL, ev->Idx + 1);
+        else _Post(now + SIM_CMD_PERIOD_US, EV_ENC, SRC_STM32, 0);
+        s_Sent[SRC_PANEL]++;
+        break;
+    case EV_ESP_RX:
+        // agent_mqtt.c: 收到带 tid 的面板指令 (固件忙时模型事件会晚于计划时刻执行，取实际时刻)
+        t->EspRx = now;
+        Trace_Begin(t->Tid, TRACE_ORIGIN_PANEL, TRACE_HOP_MQTT_RX);
+        _Post(now + _Rand(s_Esp), EV_ESP_UART_TX, SRC_PANEL, ev->Idx);
+        break;
+    case EV_ESP_UART_TX: {
+        // dev_stm32.c Dev_STM32_Set_Light: 只有进行中的面板追踪才附带 tid
+        char frame[96];
+        uint32_t tid = Trace_Pending(TRACE_ORIGIN_PANEL, TRACE_HOP_UART_TX);
+        int n = snprintf(frame, sizeof(frame), "{\"cmd\":\"light\",\"warm\":%u,\"cold\":%u,\"tid\":%u}\n",
+                         (unsigned)(100 + ev->Idx % 2 * 400), 200u, (unsigned)tid);
+        if (!tid) n = snprintf(frame, sizeof(frame), "{\"cmd\":\"light\",\"warm\":%u,\"cold\":%u}\n",
+                               (unsigned)(100 + ev->Idx % 2 * 400), 200u);
+        t->UartTx = now;
+        s_LastWarm = Host_PwmWarm();
+        s_PwmWait = (int32_t)ev->Idx;
+        Host_UartRx((const uint8_t *)frame, (uint16_t)n);
+        Trace_Mark(tid, TRACE_HOP_UART_TX);
+        break;
+    }
+    case EV_ESP_PUBLISH:
+        // agent_mqtt.c: 发布追踪结果
+        if (Trace_Finish(t->Tid, t->Json, sizeof(t->Json))) s_Published[ev->Src]++;
+        t->MqttTx = now;
+        t->StatusAt = now + _Rand(s_Mqtt);
+        _Post(t->StatusAt, EV_PANEL_RX, ev->Src, ev->Idx);
+        break;
+    case EV_PANEL_RX:
+        if (ev->Src == SRC_STM32) {
+            t->AppliedAt = now + _Rand(s_Ui);
+            _Post(t->AppliedAt, EV_UI_APPLY, ev->Src, ev->Idx);
+        } else {
+            t->Done = 1;
+            s_Done[SRC_PANEL]++;
+        }
+        break;
+    case EV_UI_APPLY:
+        t->Done = 1;
+        s_Done[SRC_STM32]++;
+        break;
+    case EV_ENC:
+        // 正反交替，避免亮度触顶后不再产生上报
+        t->PanelTx = now;
+        Host_EncoderTurn((ev->Idx & 1) ? -4 : 4);
+        if (ev->Idx + 1 < s_Count) _Post(now + SIM_ENC_PERIOD_US, EV_ENC, SRC_STM32, ev->Idx + 1);
+        s_Sent[SRC_STM32]++;
+        break;
+    }
+}
+
+/* ============================================================
+ *                 ESP32 侧：解析 STM32 上报
+ * ============================================================ */
+
+static char     s_Line[SIM_LINE_MAX];
+static uint16_t s_LineLen;
+static uint32_t s_LocalIdx;                 // 下一条 state 上报对应的本地操作
+
+static void _OnLine(const char *line, uint64_t t_us)
+{
+    const char *p;
+    unsigned long tid, val;
+    SimTrace_t *t;
+
+    if (strstr(line, "\"ev\":\"trace\"")) {
+        if (!(p = strstr(line, "\"tid\":")) || sscanf(p, "\"tid\":%lu", &tid) != 1) return;
+        if (!(p = strstr(line, "\"us\":")) || sscanf(p, "\"us\":%lu", &val) != 1) return;
+        if (tid == 0 || tid > s_Count) return;
+        t = &s_Trace[SRC_PANEL][tid - 1];
+        t->UartRx = t_us;
+        t->Stm32Us = (uint32_t)val;
+        Trace_Mark((uint32_t)tid, TRACE_HOP_UART_RX);
+        Trace_SetRemote((uint32_t)tid, (uint32_t)val);
+        _Post(t_us + _Rand(s_Esp), EV_ESP_PUBLISH, SRC_PANEL, (uint32_t)(tid - 1));
+    } else if (strstr(line, "\"ev\":\"state\"") && s_Sent[SRC_STM32]) {
+        if (!(p = strstr(line, "\"age\":")) || sscanf(p, "\"age\":%lu", &val) != 1) return;
+        if (!(p = strstr(line, "\"tid\":")) || sscanf(p, "\"tid\":%lu", &tid) != 1) return;
+        if (s_LocalIdx >= s_Count) return;
+        t = &s_Trace[SRC_STM32][s_LocalIdx];
+        t->UartRx = t_us;
+        t->Stm32Us = (uint32_t)val * 1000;
+        t->Tid = (uint32_t)tid;
+        Trace_Begin(t->Tid, TRACE_ORIGIN_STM32, TRACE_HOP_UART_RX);
+        Trace_SetRemote(t->Tid, t->Stm32Us);
+        _Post(t_us + _Rand(s_Esp), EV_ESP_PUBLISH, SRC_STM32, s_LocalIdx);
+        s_LocalIdx++;
+    }
+}
+
+static void _OnUartTx(const uint8_t *data, uint16_t len, uint64_t t_us)
+{
+    uint16_t i;
+
+    for (i = 0; i < len; i++) {
+        if (data[i] == '\n') {
+            s_Line[s_LineLen] = '\0';
+            _OnLine(s_Line, t_us);
+            s_LineLen = 0;
+        } else if (s_LineLen < SIM_LINE_MAX - 1) {
+            s_Line[s_LineLen++] = (char)data[i];
+        }
+    }
+}
+
+// __WFI: 先记录本轮任务造成的 PWM 变化，再推进到下一个唤醒点 (节拍、外设或
+// 模型事件，取最早者) 并执行到期的模型事件
+static void _Idle(void)
+{
+    uint64_t now = Host_NowUs();
+    uint64_t next = UINT64_MAX;
+    uint8_t i;
+
+    if (s_PwmWait >= 0 && Host_PwmWarm() != s_LastWarm) {
+        s_Trace[SRC_PANEL][s_PwmWait].Pwm = now;
+        s_PwmWait = -1;
+    }
+    for (i = 0; i < s_EventCount; i++) {
+        if (s_Events[i].At < next) next = s_Events[i].At;
+    }
+    if (next > now && next < (now / 1000 + 1) * 1000) Host_RunUntil(next);
+    else Host_Idle();
+    for (i = 0; i < s_EventCount; ) {
+        if (s_Events[i].At <= Host_NowUs()) {
+            SimEvent_t ev = s_Events[i];
+            s_Events[i] = s_Events[--s_EventCount];
+            _Fire(&ev);
+            i = 0;      // 事件可能追加新事件，重新扫描
+        } else {
+            i++;
+        }
+    }
+    if (s_Done[SRC_PANEL] + s_Done[SRC_STM32] >= 2 * s_Count ||
+        Host_NowUs() > SIM_SETTLE_US + (uint64_t)s_Count * (SIM_CMD_PERIOD_US + SIM_ENC_PERIOD_US) + 5000000)
+        longjmp(s_Exit, 1);
+}
+
+/* ============================================================
+ *                 统计 (桶与 trace_report.py 一致)
+ * ============================================================ */
+
+static const double s_BucketsMs[] = { 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000 };
+#define SIM_BUCKETS     (sizeof(s_BucketsMs) / sizeof(s_BucketsMs[0]))
+#define SIM_BAR_WIDTH   40
+
+static int _CmpDouble(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double _Pct(const double *v, uint32_t n, double p)
+{
+    double k = p / 100.0 * (double)(n - 1) + 0.5;
+    return v[(uint32_t)k < n ? (uint32_t)k : n - 1];
+}
+
+static void _Hop(const char *name, double *v, uint32_t n)
+{
+    uint32_t counts[SIM_BUCKETS + 1] = { 0 };
+    uint32_t i, b, peak = 1, first = SIM_BUCKETS, last = 0;
+
+    if (!n) return;
+    qsort(v, n, sizeof(double), _CmpDouble);
+    printf("  %-12s%9.1f%9.1f%9.1f%9.1f\n", name, _Pct(v, n, 50), _Pct(v, n, 90), _Pct(v, n, 99), v[n - 1]);
+    for (i = 0; i < n; i++) {
+        for (b = 0; b < SIM_BUCKETS && v[i] > s_BucketsMs[b]; b++) {}
+        counts[b]++;
+    }
+    for (b = 0; b <= SIM_BUCKETS; b++) {
+        if (!counts[b]) continue;
+        if (counts[b] > peak) peak = counts[b];
+        if (b < first) first = b;
+        last = b;
+    }
+    for (b = first; b <= last; b++) {
+        char bar[SIM_BAR_WIDTH + 1];
+        uint32_t w = (counts[b] * SIM_BAR_WIDTH + peak / 2) / peak;
+        char label[16];
+        if (counts[b] && !w) w = 1;
+        memset(bar, '#', w);
+        bar[w] = '\0';
+        if (b < SIM_BUCKETS) snprintf(label, sizeof(label), "<= %g", s_BucketsMs[b]);
+        else snprintf(label, sizeof(label), " > %g", s_BucketsMs[SIM_BUCKETS - 1]);
+        printf("    %7s ms |%-40s| %u\n", label, bar, (unsigned)counts[b]);
+    }
+}
+
+#define MS(a, b)    (((double)(a) - (double)(b)) / 1000.0)
+
+static void _Report(void)
+{
+    static double v[8][SIM_MAX_TRACES];
+    static const char *panel_hops[] = { "mqtt_rtt", "esp_to_uart", "uart_rtt", "stm32",
+                                        "esp_publish", "to_pwm", "total", "true_pwm" };
+    static const char *local_hops[] = { "stm32", "esp", "mqtt_est", "ui", "to_slider", "true_slider" };
+    double rtt_last = 0.0, est_err = 0.0, local_err = 0.0;
+    uint32_t i, h, n = 0;
+
+    printf("模型: MQTT 单程 %.1f~%.1f ms, ESP32 %.1f~%.1f ms, 界面 %.1f~%.1f ms\n\n",
+           s_Mqtt.Lo / 1000.0, s_Mqtt.Hi / 1000.0, s_Esp.Lo / 1000.0, s_Esp.Hi / 1000.0,
+           s_Ui.Lo / 1000.0, s_Ui.Hi / 1000.0);
+
+    // 面板指令：ESP32 上报的时间戳均相对其收到 MQTT 指令的时刻
+    for (i = 0; i < s_Count; i++) {
+        SimTrace_t *t = &s_Trace[SRC_PANEL][i];
+        double stm32, total, mqtt_rtt, uart_rtt;
+        if (!t->Done) continue;
+        stm32 = t->Stm32Us / 1000.0;
+        total = MS(t->StatusAt, t->PanelTx);
+        mqtt_rtt = total - MS(t->MqttTx, t->EspRx);
+        uart_rtt = MS(t->UartRx, t->UartTx) - stm32;
+        v[0][n] = mqtt_rtt;
+        v[1][n] = MS(t->UartTx, t->EspRx);
+        v[2][n] = uart_rtt;
+        v[3][n] = stm32;
+        v[4][n] = MS(t->MqttTx, t->UartRx);
+        v[5][n] = mqtt_rtt / 2 + v[1][n] + uart_rtt / 2 + stm32;
+        v[6][n] = total;
+        v[7][n] = MS(t->Pwm, t->PanelTx);
+        est_err += v[5][n] - v[7][n];
+        rtt_last = mqtt_rtt;
+        n++;
+    }
+    printf("== 面板指令 -> PWM 生效：%u/%u 条\n", (unsigned)n, (unsigned)s_Count);
+    printf("  %-12s%9s%9s%9s%9s\n", "跳", "p50", "p90", "p99", "max");
+    for (h = 0; h < 8; h++) _Hop(panel_hops[h], v[h], n);
+    if (n) printf("  to_pwm 估算 - 真实 平均 %+.2f ms\n\n", est_err / n);
+
+    // 本地操作：与 tracing.py 相同，MQTT 单程取最近一次面板指令测得往返的一半
+    n = 0;
+    for (i = 0; i < s_Count; i++) {
+        SimTrace_t *t = &s_Trace[SRC_STM32][i];
+        if (!t->Done) continue;
+        v[0][n] = t->Stm32Us / 1000.0;
+        v[1][n] = MS(t->MqttTx, t->UartRx);
+        v[2][n] = rtt_last / 2;
+        v[3][n] = MS(t->AppliedAt, t->StatusAt);
+        v[4][n] = v[0][n] + v[1][n] + v[2][n] + v[3][n];
+        v[5][n] = MS(t->AppliedAt, t->PanelTx);
+        local_err += v[4][n] - v[5][n];
+        n++;
+    }
+    printf("== 本地操作 -> 面板滑块：%u/%u 条\n", (unsigned)n, (unsigned)s_Count);
+    printf("  %-12s%9s%9s%9s%9s\n", "跳", "p50", "p90", "p99", "max");
+    for (h = 0; h < 6; h++) _Hop(local_hops[h], v[h], n);
+    if (n) printf("  to_slider 估算 - 真实 平均 %+.2f ms\n", local_err / n);
+    printf("\nTrace_Finish 输出: 面板 %u/%u, 本地 %u/%u\n",
+           (unsigned)s_Published[SRC_PANEL], (unsigned)s_Count,
+           (unsigned)s_Published[SRC_STM32], (unsigned)s_Count);
+}
+
+/* ============================================================
+ *                 --json：面板侧收到的消息 (按时间排序)
+ * ============================================================ */
+
+typedef struct {
+    uint64_t At;
+    uint8_t  Order;         // 同一时刻的先后 (状态先于追踪结果)
+    uint8_t  Kind;          // 0: sent  1: status  2: device  3: applied
+    SimTrace_t *Trace;
+} SimMsg_t;
+
+static int _CmpMsg(const void *a, const void *b)
+{
+    const SimMsg_t *x = a, *y = b;
+    if (x->At != y->At) return x->At < y->At ? -1 : 1;
+    return (int)x->Order - (int)y->Order;
+}
+
+static void _WriteJson(const char *path)
+{
+    static SimMsg_t msgs[SIM_MAX_TRACES * 6];
+    static const char *kinds[] = { "sent", "status", "device", "applied" };
+    double rtt_last = -1.0;
+    uint32_t i, n = 0;
+    FILE *f = fopen(path, "w");
+
+    if (!f) {
+        fprintf(stderr, "无法写入 %s\n", path);
+        exit(2);
+    }
+    for (i = 0; i < s_Count; i++) {
+        SimTrace_t *p = &s_Trace[SRC_PANEL][i], *l = &s_Trace[SRC_STM32][i];
+        if (p->Done) {
+            msgs[n++] = (SimMsg_t){ p->PanelTx, 0, 0, p };
+            if (p->Json[0]) msgs[n++] = (SimMsg_t){ p->StatusAt, 2, 2, p };
+        }
+        if (l->Done) {
+            msgs[n++] = (SimMsg_t){ l->StatusAt, 1, 1, l };
+            if (l->Json[0]) msgs[n++] = (SimMsg_t){ l->StatusAt, 2, 2, l };
+            msgs[n++] = (SimMsg_t){ l->AppliedAt, 3, 3, l };
+        }
+    }
+    qsort(msgs, n, sizeof(msgs[0]), _CmpMsg);
+
+    for (i = 0; i < n; i++) {
+        SimTrace_t *t = msgs[i].Trace;
+        if (msgs[i].Kind == 2) fprintf(f, "{\"t\":%llu,\"device\":%s}\n", (unsigned long long)msgs[i].At, t->Json);
+        else fprintf(f, "{\"t\":%llu,\"%s\":%u}\n", (unsigned long long)msgs[i].At, kinds[msgs[i].Kind], (unsigned)t->Tid);
+
+        // 追踪结果到达时 tracing.py 完成一条记录：紧随其后输出本程序的各跳
+        if (msgs[i].Kind == 2 && t >= s_Trace[SRC_PANEL] && t < s_Trace[SRC_PANEL] + SIM_MAX_TRACES) {
+            double stm32 = t->Stm32Us / 1000.0, total = MS(t->StatusAt, t->PanelTx);
+            double mqtt_rtt = total - MS(t->MqttTx, t->EspRx), uart_rtt = MS(t->UartRx, t->UartTx) - stm32;
+            rtt_last = mqtt_rtt;
+            fprintf(f, "{\"expect\":{\"src\":\"panel\",\"tid\":%u,\"mqtt_rtt\":%.3f,\"esp_to_uart\":%.3f,"
+                       "\"uart_rtt\":%.3f,\"stm32\":%.3f,\"esp_publish\":%.3f,\"to_pwm\":%.3f,\"total\":%.3f}}\n",
+                    (unsigned)t->Tid, mqtt_rtt, MS(t->UartTx, t->EspRx), uart_rtt, stm32, MS(t->MqttTx, t->UartRx),
+                    mqtt_rtt / 2 + MS(t->UartTx, t->EspRx) + uart_rtt / 2 + stm32, total);
+        } else if (msgs[i].Kind == 3 && t->Json[0]) {
+            double stm32 = t->Stm32Us / 1000.0, esp = MS(t->MqttTx, t->UartRx), ui = MS(t->AppliedAt, t->StatusAt);
+            double est = rtt_last >= 0 ? rtt_last / 2 : 0.0;
+            fprintf(f, "{\"expect\":{\"src\":\"stm32\",\"tid\":%u,\"stm32\":%.3f,\"esp\":%.3f,"
+                       "\"mqtt_est\":%.3f,\"ui\":%.3f,\"to_slider\":%.3f}}\n",
+                    (unsigned)t->Tid, stm32, esp, est, ui, stm32 + esp + est + ui);
+        }
+    }
+    fclose(f);
+}
+
+static SimRange_t _ParseRange(char **argv)
+{
+    SimRange_t r;
+    r.Lo = (uint32_t)(atof(argv[0]) * 1000);
+    r.Hi = (uint32_t)(atof(argv[1]) * 1000);
+    return r;
+}
+
+int main(int argc, char **argv)
+{
+    double cpu_scale = 0.0;
+    const char *json = NULL;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--count") == 0 && i + 1 < argc) s_Count = (uint32_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) s_Seed = (uint32_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--mqtt") == 0 && i + 2 < argc) { s_Mqtt = _ParseRange(&argv[i + 1]); i += 2; }
+        else if (strcmp(argv[i], "--esp") == 0 && i + 2 < argc)  { s_Esp = _ParseRange(&argv[i + 1]); i += 2; }
+        else if (strcmp(argv[i], "--ui") == 0 && i + 2 < argc)   { s_Ui = _ParseRange(&argv[i + 1]); i += 2; }
+        else if (strcmp(argv[i], "--cpu-scale") == 0 && i + 1 < argc) cpu_scale = atof(argv[++i]);
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) json = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [--count n] [--seed s] [--mqtt lo hi] [--esp lo hi] [--ui lo hi] [--cpu-scale x]"
+                            " [--json file]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (s_Count == 0 || s_Count > SIM_MAX_TRACES) s_Count = SIM_MAX_TRACES;
+
+    Host_Reset();
+    Host_OledAttach();
+    Host_PajAttach(0);
+    Host_SetUartTxSink(_OnUartTx);
+    Host_SetIdleHook(_Idle);
+    Host_SetCpuScale(cpu_scale);
+    _Post(SIM_SETTLE_US, EV_PANEL_TX, SRC_PANEL, 0);
+
+    if (setjmp(s_Exit) == 0) {
+        Firmware_Main();
+    }
+
+    _Report();
+    if (json) _WriteJson(json);
+    if (s_Done[SRC_PANEL] < s_Count || s_Done[SRC_STM32] < s_Count) {
+        printf("\n追踪未完成: 面板 %u/%u, 本地 %u/%u\n", (unsigned)s_Done[SRC_PANEL], (unsigned)s_Count,
+               (unsigned)s_Done[SRC_STM32], (unsigned)s_Count);
+        return 1;
+    }
+    return 0;
+}
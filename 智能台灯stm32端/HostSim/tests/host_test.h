@@ -0,0 +1,36 @@
+#ifndef __HOST_TEST_H
+#define __HOST_TEST_H
+
+/**
+  ******************************************************************************
+  * @file    host_test.h
+  * @brief   HostSim 单元测试的最小断言集 (每个测试为独立可执行文件，由 ctest 运行)
+  * @note    失败只记录并继续，main 末尾用 TEST_DONE() 返回失败数
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+
+static int s_TestFailures = 0;
+
+#define TEST_CHECK(cond) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "%s:%d: CHECK(%s) 失败\n", __FILE__, __LINE__, #cond); \
+        s_TestFailures++; \
+    } \
+} while (0)
+
+#define TEST_EQ(actual, expected) do { \
+    long long _a = (long long)(actual), _e = (long long)(expected); \
+    if (_a != _e) { \
+        fprintf(stderr, "%s:%d: %s = %lld, 期望 %lld\n", __FILE__, __LINE__, #actual, _a, _e); \
+        s_TestFailures++; \
+    } \
+} while (0)
+
+#define TEST_DONE() do { \
+    if (s_TestFailures) fprintf(stderr, "%d 项失败\n", s_TestFailures); \
+    return s_TestFailures ? 1 : 0; \
+} while (0)
+
+#endif
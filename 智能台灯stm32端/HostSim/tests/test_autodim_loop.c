@@ -0,0 +1,162 @@
+/**
+  ******************************************************************************
+  * @file    test_autodim_loop.c
+  * @brief   自动调光闭环阶跃响应：AutoDim + 真实 LDR 采样/滤波 + 一阶灯光/房间模型
+  * @note    1. 被控对象：照度 y (0-1000，与 LDR_GetLuxPercentage 同一刻度)
+  *             tau x dy/dt = ambient + G x brightness - y，tau = 100ms
+  *             (光敏电阻响应时间)，G 为灯对传感器的增益，随安装距离变化
+  *          2. y 经 ADC 源 (raw = y x 4095 / 1000，叠加 +-40 LSB 噪声) 进入
+  *             真实的 DMA + 块平均 + IIR 链路，控制器每 AUTODIM_PERIOD_MS
+  *             读取 LDR_GetLuxPercentage
+  *          3. 判据：进入 +-HYST_OUT 后不再离开，最后 15s 输出无任何变化
+  *             (无极限环)，超调不超过目标的 10%
+  ******************************************************************************
+  */
+#include "host_port.h"
+#include "host_test.h"
+#include "LDR.h"
+#include "AutoDim.h"
+#include <stdlib.h>
+
+#define PLANT_TAU_MS    100.0
+
+static double   s_Y;            // 照度 (0-1000)
+static double   s_Ambient;
+static double   s_Gain;
+static int16_t  s_Bri;
+static uint8_t  s_Inverted;     // 模拟分压接反 (光越强电压越低)
+static uint32_t s_Seed = 1;
+
+static uint16_t _Adc(uint64_t t_us)
+{
+    double y = s_Inverted ? 1000.0 - s_Y : s_Y;
+    int32_t raw = (int32_t)(y * 4095.0 / 1000.0);
+
+    (void)t_us;
+    s_Seed = s_Seed * 1103515245u + 12345u;
+    raw += (int32_t)((s_Seed >> 16) % 81) - 40;
+    if (raw < 0) raw = 0;
+    if (raw > 4095) raw = 4095;
+    return (uint16_t)raw;
+}
+
+static void _PlantMs(void)
+{
+    double y_ss = s_Ambient + s_Gain * s_Bri;
+
+    if (y_ss > 1000.0) y_ss = 1000.0;
+    s_Y += (y_ss - s_Y) / PLANT_TAU_MS;
+    Host_Advance(1000);
+}
+
+typedef struct {
+    uint32_t SettleMs;      // 最后一次进入 +-HYST_OUT 的时刻 (0xFFFFFFFF: 未进入)
+    int32_t  Overshoot;     // 超过目标的最大量
+    uint32_t LateChanges;   // 最后 15s 的输出变化次数
+    int32_t  FinalErr;
+    int16_t  FinalBri;
+} LoopResult_t;
+
+static LoopResult_t _Run(int16_t target, uint32_t duration_ms)
+{
+    AutoDim_t ctl;
+    LoopResult_t r = { 0xFFFFFFFFu, 0, 0, 0, 0 };
+    uint32_t ms;
+    int16_t lux = 0, out;
+    uint8_t inside = 0;
+
+    AutoDim_Init(&ctl, s_Bri);
+    s_Bri = ctl.Output;
+    for (ms = 1; ms <= duration_ms; ms++) {
+        _PlantMs();
+        if (ms % AUTODIM_PERIOD_MS) continue;
+
+        lux = (int16_t)LDR_GetLuxPercentage();
+        out = AutoDim_Step(&ctl, target, lux);
+        if (out != s_Bri && ms > duration_ms - 15000) r.LateChanges++;
+        s_Bri = out;
+
+        if (lux - target > r.Overshoot) r.Overshoot = lux - target;
+        if (abs(lux - target) <= AUTODIM_HYST_OUT) {
+            if (!inside) r.SettleMs = ms;
+            inside = 1;
+        } else {
+            inside = 0;
+            r.SettleMs = 0xFFFFFFFFu;
+        }
+    }
+    r.FinalErr = lux - target;
+    r.FinalBri = s_Bri;
+    return r;
+}
+
+static void _Settle(double ambient, double gain, int16_t bri)
+{
+    s_Ambient = ambient;
+    s_Gain = gain;
+    s_Bri = bri;
+    s_Y = ambient + gain * bri;
+    Host_Advance(3000000);  // 让 LDR 滤波器收敛到初始照度
+}
+
+// 目标 600，从亮度 100 起步；返回是否满足判据
+static uint8_t _StepCase(double gain, uint8_t verbose)
+{
+    LoopResult_t r;
+    uint8_t ok;
+
+    _Settle(100.0, gain, 100);
+    r = _Run(600, 40000);
+    ok = (r.SettleMs != 0xFFFFFFFFu && r.LateChanges == 0 && r.Overshoot <= 60) ? 1 : 0;
+    if (verbose) {
+        printf("G=%.2f  进入带内 %5d ms  超调 %3d  末 15s 变化 %2u  终差 %3d  亮度 %4d  %s\n",
+               gain, (r.SettleMs == 0xFFFFFFFFu) ? -1 : (int)r.SettleMs, r.Overshoot, r.LateChanges, r.FinalErr, r.FinalBri,
+               ok ? "" : "(不满足)");
+    }
+    return ok;
+}
+
+int main(void)
+{
+    static const double gains[] = { 0.5, 0.75, 1.0, 1.25, 1.5 };
+    LoopResult_t r;
+    double g;
+    uint8_t i;
+
+    Host_Reset();
+    Host_SetAdcSource(_Adc);
+    LDR_Init();
+    TIM_Cmd(TIM3, ENABLE);
+
+    // 1. 常见安装增益：阶跃 100 -> 600 全部满足判据
+    for (i = 0; i < sizeof(gains) / sizeof(gains[0]); i++) {
+        TEST_CHECK(_StepCase(gains[i], 1));
+    }
+
+    // 2. 稳定裕度：增益加大到首次不满足判据为止
+    for (g = 1.5; g <= 8.0 && _StepCase(g, 0); g += 0.25) {
+    }
+    printf("增益裕度：G <= %.2f 满足判据\n", g - 0.25);
+    _StepCase(g, 1);
+    TEST_CHECK(g >= 2.5);
+
+    // 3. 环境光扰动：稳定后环境光 +200，控制器调低亮度重新稳定
+    _Settle(100.0, 1.0, 100);
+    r = _Run(600, 30000);
+    s_Ambient = 300.0;
+    r = _Run(600, 30000);
+    printf("扰动 +200: 进入带内 %u ms, 终差 %d, 亮度 %d\n", r.SettleMs, r.FinalErr, r.FinalBri);
+    TEST_CHECK(r.SettleMs < 30000 && r.LateChanges == 0);
+    TEST_CHECK(r.FinalBri < 400);
+
+    // 4. 符号：分压接反时读数随灯光增大而减小 (初始读数 800 > 目标)，
+    //    控制器降亮度反而使读数继续升高，正反馈把亮度推到下限
+    s_Inverted = 1;
+    _Settle(100.0, 1.0, 100);
+    r = _Run(600, 30000);
+    printf("接反: 亮度 %d, 终差 %d\n", r.FinalBri, r.FinalErr);
+    TEST_EQ(r.FinalBri, AUTODIM_OUT_MIN);
+    s_Inverted = 0;
+
+    TEST_DONE();
+}
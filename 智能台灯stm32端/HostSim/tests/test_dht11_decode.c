@@ -0,0 +1,160 @@
+/**
+  ******************************************************************************
+  * @file    test_dht11_decode.c
+  * @brief   DHT11_Decode 的帧判定 (正常/校验错/无应答/位宽越界/捕获不足)
+  * @note    1. 捕获数组：经仿真的 TIM2 输入捕获 + DMA1_Channel7 完整读一帧，
+  *             直接取 DMA 目标缓冲区 (CMAR) 中的时间戳
+  *          2. 合成数组：Host_Dht11Edges 生成，再叠加抖动或改写个别时间戳
+  *          3. 时间戳为 16 位回绕计数，基准放在 0xFF00 附近覆盖回绕
+  ******************************************************************************
+  */
+#include "host_port.h"
+#include "host_test.h"
+#include "DHT11.h"
+#include <string.h>
+
+static DHT11_Status_t s_Status;
+static uint8_t s_Temp, s_Humi, s_Done;
+
+static void _OnRead(DHT11_Status_t status, uint8_t temp, uint8_t humi)
+{
+    s_Status = status;
+    s_Temp = temp;
+    s_Humi = humi;
+    s_Done = 1;
+}
+
+// 整个读取流程：起始信号 -> 捕获 -> 解码/超时，主循环每 1ms 调一次 Process
+static void _ReadOnce(void)
+{
+    uint32_t ms;
+
+    s_Done = 0;
+    TEST_EQ(DHT11_StartRead(_OnRead), 0);
+    for (ms = 0; ms < 100 && !s_Done; ms++) {
+        Host_Advance(1000);
+        DHT11_Process();
+    }
+    TEST_CHECK(s_Done);
+}
+
+static void _Frame(uint8_t humi, uint8_t temp, uint8_t frame[5])
+{
+    frame[0] = humi;
+    frame[1] = 0;
+    frame[2] = temp;
+    frame[3] = 0;
+    frame[4] = (uint8_t)(humi + temp);
+}
+
+/* --- 捕获数组 --- */
+static void _TestCaptured(void)
+{
+    uint16_t edges[DHT11_EDGE_COUNT];
+    uint8_t out[5];
+
+    Host_SetDht11(60, 25, 1);
+    _ReadOnce();
+    TEST_EQ(s_Status, DHT11_OK);
+    TEST_EQ(s_Temp, 25);
+    TEST_EQ(s_Humi, 60);
+
+    memcpy(edges, (const void *)(uintptr_t)DMA1_Channel7->CMAR, sizeof(edges));
+    TEST_EQ(DHT11_Decode(edges, out), DHT11_OK);
+    TEST_EQ(out[0], 60);
+    TEST_EQ(out[2], 25);
+    TEST_EQ(out[4], 85);
+
+    // 最后一位 (校验和最低位) 由 '1' 改为 '0'：后一个下降沿提前 42us
+    edges[41] = (uint16_t)(edges[41] - 42);
+    TEST_EQ(DHT11_Decode(edges, out), DHT11_ERR_CHECKSUM);
+
+    // 传感器不在线：捕获不到任何下降沿，由帧超时结束
+    Host_SetDht11(60, 25, 0);
+    _ReadOnce();
+    TEST_EQ(s_Status, DHT11_ERR_TIMEOUT);
+
+    Host_SetDht11(45, 25, 1);
+    _ReadOnce();
+    TEST_EQ(s_Status, DHT11_OK);
+    TEST_EQ(s_Humi, 45);
+}
+
+/* --- 合成数组 --- */
+static void _TestSynthetic(void)
+{
+    uint8_t frame[5], out[5];
+    uint16_t edges[DHT11_EDGE_COUNT], bad[DHT11_EDGE_COUNT];
+    uint8_t i;
+
+    // 正常帧，基准 0xFF00 使时间戳在第 3 个数据位附近回绕
+    _Frame(99, 40, frame);
+    Host_Dht11Edges(frame, 0xFF00, edges);
+    TEST_EQ(DHT11_Decode(edges, out), DHT11_OK);
+    TEST_EQ(out[0], 99);
+    TEST_EQ(out[2], 40);
+
+    // 抖动：每个下降沿 +-8us 交替偏移 (脉宽 +-16us)，仍在判定窗口内
+    memcpy(bad, edges, sizeof(bad));
+    for (i = 1; i < DHT11_EDGE_COUNT; i++) bad[i] = (uint16_t)(bad[i] + ((i & 1) ? 8 : -8));
+    TEST_EQ(DHT11_Decode(bad, out), DHT11_OK);
+    TEST_EQ(out[0], 99);
+
+    // 校验和错误
+    frame[4]++;
+    Host_Dht11Edges(frame, 0x1234, bad);
+    TEST_EQ(DHT11_Decode(bad, out), DHT11_ERR_CHECKSUM);
+    frame[4]--;
+
+    // 无应答：第一个下降沿后直接是数据位 (应答脉宽只有一个位宽)
+    memcpy(bad, edges, sizeof(bad));
+    bad[1] = (uint16_t)(bad[0] + 78);
+    TEST_EQ(DHT11_Decode(bad, out), DHT11_ERR_TIMING);
+
+    // 应答过长 (>220us)
+    memcpy(bad, edges, sizeof(bad));
+    bad[0] = (uint16_t)(bad[1] - 221);
+    TEST_EQ(DHT11_Decode(bad, out), DHT11_ERR_TIMING);
+
+    // 数据位越界：过短 (59us，毛刺) 与过长 (161us，漏掉一个沿)
+    memcpy(bad, edges, sizeof(bad));
+    bad[20] = (uint16_t)(bad[19] + 59);
+    TEST_EQ(DHT11_Decode(bad, out), DHT11_ERR_TIMING);
+    memcpy(bad, edges, sizeof(bad));
+    for (i = 20; i < DHT11_EDGE_COUNT; i++) bad[i] = (uint16_t)(bad[i] + 200);
+    TEST_EQ(DHT11_Decode(bad, out), DHT11_ERR_TIMING);
+
+    // 判定窗口边界：60/160us 仍接受，100us 判 '0'，101us 判 '1'
+    for (i = 1; i < DHT11_EDGE_COUNT; i++) edges[i] = (uint16_t)(edges[i - 1] + (i == 1 ? 160 : 60));
+    TEST_EQ(DHT11_Decode(edges, out), DHT11_OK);
+    TEST_EQ(out[0], 0x00);
+    for (i = 2; i < DHT11_EDGE_COUNT; i++) edges[i] = (uint16_t)(edges[i - 1] + ((i - 2) < 8 ? 160 : 100));
+    TEST_EQ(DHT11_Decode(edges, out), DHT11_ERR_CHECKSUM);
+    TEST_EQ(out[0], 0xFF);
+    TEST_EQ(out[1], 0x00);
+    edges[10] = (uint16_t)(edges[9] + 101);     // 第 9 位 (out[1] 最高位)
+    for (i = 11; i < DHT11_EDGE_COUNT; i++) edges[i] = (uint16_t)(edges[i - 1] + 100);
+    TEST_EQ(DHT11_Decode(edges, out), DHT11_ERR_CHECKSUM);
+    TEST_EQ(out[1], 0x80);
+
+    // 捕获不足：DMA 只写入了前 20 个下降沿，其余仍是上次装填前的清零值
+    _Frame(60, 25, frame);
+    Host_Dht11Edges(frame, 0x4000, edges);
+    memset(&edges[20], 0, sizeof(edges) - 20 * sizeof(edges[0]));
+    TEST_EQ(DHT11_Decode(edges, out), DHT11_ERR_TIMING);
+    // 最后一个下降沿丢失
+    Host_Dht11Edges(frame, 0x4000, edges);
+    edges[41] = 0;
+    TEST_EQ(DHT11_Decode(edges, out), DHT11_ERR_TIMING);
+}
+
+int main(void)
+{
+    Host_Reset();
+    TEST_EQ(DHT11_Init(), 0);
+
+    _TestCaptured();
+    _TestSynthetic();
+
+    TEST_DONE();
+}
@@ -0,0 +1,148 @@
+/**
+  ******************************************************************************
+  * @file    test_encoder_profile.c
+  * @brief   编码器：TIM4 计数 -> 格数 (余数结转) -> 加速曲线调节量
+  * @note    1. 按脚本在指定时刻给 TIM4 加减计数，并在同一时刻按输入任务的
+  *             方式调用 Encoder_Get，再以该时刻为时间戳调用 EncAccel_Apply
+  *          2. 期望值按 EncoderAccel.c 的整数运算手算 (见各段注释)
+  *          3. 参数取 Config.h：EC11 每格 4 计数，亮度 5~60，色温 5~50，
+  *             转速阈值 5 / 40 格每秒
+  ******************************************************************************
+  */
+#include "host_port.h"
+#include "host_test.h"
+#include "Encoder.h"
+#include "EncoderAccel.h"
+#include "Config.h"
+
+typedef struct {
+    uint32_t TimeMs;
+    int16_t  Counts;        /*!< 本次加到 TIM4 的计数 */
+    int16_t  Detents;       /*!< 期望 Encoder_Get 返回 */
+    int16_t  Delta;         /*!< 期望调节量 */
+} EncStep_t;
+
+static const EncAccel_Profile_t s_Bri = {
+    ENCODER_BRI_MIN_STEP, ENCODER_BRI_MAX_STEP, ENCODER_SLOW_RATE, ENCODER_FAST_RATE
+};
+static const EncAccel_Profile_t s_CCT = {
+    ENCODER_CCT_MIN_STEP, ENCODER_CCT_MAX_STEP, ENCODER_SLOW_RATE, ENCODER_FAST_RATE
+};
+
+static EncAccel_t s_Acc;
+
+static void _RunScript(const char *name, const EncStep_t *steps, uint8_t n,
+                       const EncAccel_Profile_t *profile)
+{
+    uint8_t i;
+    int16_t det, delta;
+
+    for (i = 0; i < n; i++) {
+        Host_RunUntil((uint64_t)steps[i].TimeMs * 1000);
+        Host_EncoderTurn(steps[i].Counts);
+        det = Encoder_Get();
+        delta = EncAccel_Apply(&s_Acc, profile, det, steps[i].TimeMs);
+        if (det != steps[i].Detents || delta != steps[i].Delta) {
+            fprintf(stderr, "%s 第 %u 步 (t=%u, %+d 计数): 格数 %d 调节量 %d，期望 %d / %d\n",
+                    name, i, steps[i].TimeMs, steps[i].Counts, det, delta,
+                    steps[i].Detents, steps[i].Delta);
+            s_TestFailures++;
+        }
+    }
+}
+
+#define RUN(name, steps, profile) _RunScript((name), (steps), sizeof(steps) / sizeof((steps)[0]), (profile))
+
+/* 慢转与余数结转：间隔都超过 150ms，转速恒为 0，每格 5 */
+static const EncStep_t s_Slow[] = {
+    { 1000,  4,  1,  5 },
+    { 1300,  3,  0,  0 },   // 不足一格，余 3
+    { 1600,  1,  1,  5 },   // 3 + 1
+    { 1900,  6,  1,  5 },   // 余 2
+    { 2200,  2,  1,  5 },
+    { 2500, -1,  0,  0 },   // 余 -1
+    { 2800, -3, -1, -5 },
+    { 3100, -4, -1, -5 },   // TIM4 从 0 向下回绕到 65532
+    { 3400,  2,  0,  0 },   // 在两格之间来回拨动不产生调节
+    { 3405, -2,  0,  0 },
+    { 3700, -4, -1, -5 },
+};
+
+/* 匀速 20 格/秒：转速 0 -> 10 -> 15 -> 17 -> 18，
+ * 步长 = 5 + 55 x ((r-5) x 256/35)^2 / 2^16 -> 5, 6, 9, 11, 12 */
+static const EncStep_t s_Steady[] = {
+    { 5000, 4, 1,  5 },
+    { 5050, 4, 1,  6 },
+    { 5100, 4, 1,  9 },
+    { 5150, 4, 1, 11 },
+    { 5200, 4, 1, 12 },
+};
+
+/* 快拨 100 格/秒 (每 20ms 两格)：第一次从静止开始，之后转速 50、75 >= 40
+ * 用满步长 60；反向时转速清零 */
+static const EncStep_t s_Flick[] = {
+    { 7000,  8,  2,  10 },
+    { 7020,  8,  2, 120 },
+    { 7040,  8,  2, 120 },
+    { 7060, -4, -1,  -5 },
+    { 7080, -8, -2,-120 },
+};
+
+/* 色温焦点最大步长 50 */
+static const EncStep_t s_FlickCCT[] = {
+    { 9000,  8,  2,  10 },
+    { 9020,  8,  2, 100 },
+};
+
+// 以恒定转速拨动，返回走完 0~1000 所需的格数
+static uint16_t _DetentsForFullRange(uint16_t rate, uint32_t start_ms)
+{
+    uint32_t t = start_ms, interval = 1000 / rate;
+    int32_t sum = 0;
+    uint16_t n = 0;
+
+    EncAccel_Reset(&s_Acc);
+    while (sum < 1000 && n < 1000) {
+        sum += EncAccel_Apply(&s_Acc, &s_Bri, 1, t);
+        t += interval;
+        n++;
+    }
+    return n;
+}
+
+int main(void)
+{
+    uint16_t slow, fast;
+
+    Host_Reset();
+    Encoder_Init();
+    EncAccel_Reset(&s_Acc);
+
+    RUN("慢转", s_Slow, &s_Bri);
+    RUN("匀速", s_Steady, &s_Bri);
+    RUN("快拨", s_Flick, &s_Bri);
+    RUN("色温快拨", s_FlickCCT, &s_CCT);
+
+    // 一次读不满一格的余数不会在之后丢失：1~3 计数分多次给出，总格数不变
+    Host_RunUntil(20000000);
+    {
+        static const int16_t parts[] = { 1, 2, 3, 1, 1, 3, 2, 2, 1 };   // 共 16 = 4 格
+        int16_t total = 0;
+        uint8_t i;
+
+        for (i = 0; i < sizeof(parts) / sizeof(parts[0]); i++) {
+            Host_EncoderTurn(parts[i]);
+            total += Encoder_Get();
+        }
+        TEST_EQ(total, 4);
+        TEST_EQ(Encoder_Get(), 0);
+    }
+
+    slow = _DetentsForFullRange(4, 30000);
+    fast = _DetentsForFullRange(50, 400000);
+    printf("走完亮度全程: 4 格/秒 %u 格, 50 格/秒 %u 格\n", slow, fast);
+    TEST_EQ(slow, 200);
+    TEST_CHECK(fast <= 25);
+
+    TEST_DONE();
+}
@@ -0,0 +1,257 @@
+/**
+  ******************************************************************************
+  * @file    test_event_queue.c
+  * @brief   事件队列：回绕、满、丢弃计数，以及在 LDREX/STREX/DMB 处被中断
+  *          生产者抢占时的正确性
+  * @note    1. 抢占由 Host_SetPreemptHook 注入：钩子中执行一段 "ISR" 代码，
+  *             返回 1 时与真实内核一样清除独占监视器
+  *          2. 每条事件的四个字段都由同一个序号派生，消费端逐字段校验，
+  *             可发现半条记录；序号按生产者分组，校验各生产者内的先后顺序
+  ******************************************************************************
+  */
+#include "host_port.h"
+#include "host_test.h"
+#include "EventQueue.h"
+#include <string.h>
+
+#define PROD_MAIN   1
+#define PROD_ISR    2
+
+static uint8_t _Post(uint8_t producer, uint32_t seq)
+{
+    return EvtQ_Post(producer, (uint8_t)seq, (uint16_t)(seq * 7), seq);
+}
+
+static uint8_t _Valid(const Event_t *e)
+{
+    return e->Sub == (uint8_t)e->Data && e->Param == (uint16_t)(e->Data * 7);
+}
+
+/* --- 1. 顺序、回绕、满与丢弃 --- */
+static void _TestBasic(void)
+{
+    EvtQ_Stats_t st;
+    Event_t e;
+    uint32_t i, round;
+
+    EvtQ_Init();
+    TEST_EQ(EvtQ_Get(&e), 0);
+
+    // 每轮写 11 条读 11 条，下标跨过多次回绕
+    for (round = 0; round < 10; round++) {
+        for (i = 0; i < 11; i++) TEST_EQ(_Post(PROD_MAIN, round * 11 + i), 1);
+        for (i = 0; i < 11; i++) {
+            TEST_EQ(EvtQ_Get(&e), 1);
+            TEST_EQ(e.Data, round * 11 + i);
+            TEST_CHECK(_Valid(&e));
+        }
+        TEST_EQ(EvtQ_Get(&e), 0);
+    }
+
+    // 满：第 EVTQ_SIZE + 1 条起丢弃，不覆盖旧事件
+    for (i = 0; i < EVTQ_SIZE; i++) TEST_EQ(_Post(PROD_MAIN, 1000 + i), 1);
+    TEST_EQ(_Post(PROD_MAIN, 2000), 0);
+    TEST_EQ(_Post(PROD_MAIN, 2001), 0);
+    EvtQ_GetStats(&st);
+    TEST_EQ(st.Posted, 110 + EVTQ_SIZE);
+    TEST_EQ(st.Dropped, 2);
+    TEST_EQ(st.HighWater, EVTQ_SIZE);
+
+    // 取走一条后恰好能再放一条
+    TEST_EQ(EvtQ_Get(&e), 1);
+    TEST_EQ(e.Data, 1000);
+    TEST_EQ(_Post(PROD_MAIN, 3000), 1);
+    TEST_EQ(_Post(PROD_MAIN, 3001), 0);
+    for (i = 1; i < EVTQ_SIZE; i++) {
+        TEST_EQ(EvtQ_Get(&e), 1);
+        TEST_EQ(e.Data, 1000 + i);
+    }
+    TEST_EQ(EvtQ_Get(&e), 1);
+    TEST_EQ(e.Data, 3000);
+    TEST_EQ(EvtQ_Get(&e), 0);
+}
+
+/* --- 2. 逐个抢占点扫描：主循环投递时在第 k 个抢占点插入一次 ISR 投递 --- */
+static uint32_t s_Hit, s_FireAt, s_IsrSeq;
+static uint8_t  s_FireSite, s_IsrPosts, s_IsrAccepted;
+static int8_t   s_IsrGetResult;
+static uint8_t  s_IsrGetType;
+static uint32_t s_Unpublished;      // 钩子中消费者遇到 "已占用未发布" 槽的次数
+
+static uint8_t _HookSweep(uint8_t site)
+{
+    Event_t e;
+    uint8_t i;
+
+    if (s_Hit++ != s_FireAt) return 0;
+    s_FireSite = site;
+    for (i = 0; i < s_IsrPosts; i++) s_IsrAccepted += _Post(PROD_ISR, s_IsrSeq++);
+    // 主循环生产者已占用槽但尚未发布时，该槽对消费者不可见；已发布则整条可读
+    s_IsrGetResult = (int8_t)EvtQ_Get(&e);
+    if (s_IsrGetResult) {
+        TEST_CHECK(_Valid(&e));
+        s_IsrGetType = e.Type;
+    }
+    return 1;
+}
+
+static void _TestSweep(uint8_t prefill, uint8_t isr_posts)
+{
+    EvtQ_Stats_t st;
+    Event_t e;
+    uint32_t k, got_main, got_isr, total_hits;
+    uint8_t i, ok;
+
+    for (k = 0; ; k++) {
+        EvtQ_Init();
+        for (i = 0; i < prefill; i++) _Post(PROD_ISR, 100 + i);
+        s_Hit = 0;
+        s_FireAt = k;
+        s_FireSite = 0xFF;
+        s_IsrSeq = 0;
+        s_IsrPosts = isr_posts;
+        s_IsrAccepted = 0;
+        s_IsrGetResult = -1;
+        Host_SetPreemptHook(_HookSweep);
+        ok = _Post(PROD_MAIN, 7);
+        Host_SetPreemptHook(NULL);
+        total_hits = s_Hit;
+        if (s_FireSite == 0xFF) break;  // k 超过本次投递经过的抢占点数
+        if (s_FireSite == HOST_SITE_DMB && prefill == 0 && s_IsrGetResult == 0) s_Unpublished++;
+
+        // 钩子里的消费者可能已读走一条
+        got_main = (s_IsrGetResult == 1 && s_IsrGetType == PROD_MAIN) ? 1 : 0;
+        got_isr = (s_IsrGetResult == 1 && s_IsrGetType == PROD_ISR) ? 1 : 0;
+        while (EvtQ_Get(&e)) {
+            TEST_CHECK(_Valid(&e));
+            if (e.Type == PROD_MAIN) got_main++;
+            else got_isr++;
+        }
+        EvtQ_GetStats(&st);
+        TEST_EQ(got_main, ok);
+        TEST_EQ(got_isr, prefill + s_IsrAccepted);
+        TEST_EQ(st.Posted, prefill + s_IsrAccepted + ok);
+        TEST_EQ(st.Posted + st.Dropped, prefill + isr_posts + 1);
+    }
+    printf("抢占扫描 (预填 %2u, ISR 投递 %u): 主循环一次投递经过 %u 个抢占点，逐点插入均一致\n",
+           prefill, isr_posts, total_hits);
+    TEST_CHECK(k >= 3);
+}
+
+/* --- 3. 队列只剩一个空位时 ISR 抢走它：主循环的 STREX 失败，重试后计为丢弃 --- */
+static uint8_t _HookSteal(uint8_t site)
+{
+    if (site != HOST_SITE_LDREX || s_Hit++ != 0) return 0;
+    TEST_EQ(_Post(PROD_ISR, 999), 1);
+    return 1;
+}
+
+static void _TestSteal(void)
+{
+    EvtQ_Stats_t st;
+    Event_t e;
+    uint32_t i;
+
+    EvtQ_Init();
+    for (i = 0; i < EVTQ_SIZE - 1; i++) _Post(PROD_MAIN, i);
+    s_Hit = 0;
+    Host_SetPreemptHook(_HookSteal);
+    TEST_EQ(_Post(PROD_MAIN, 500), 0);
+    Host_SetPreemptHook(NULL);
+
+    EvtQ_GetStats(&st);
+    TEST_EQ(st.Posted, EVTQ_SIZE);
+    TEST_EQ(st.Dropped, 1);
+    for (i = 0; i < EVTQ_SIZE - 1; i++) {
+        TEST_EQ(EvtQ_Get(&e), 1);
+        TEST_EQ(e.Data, i);
+    }
+    TEST_EQ(EvtQ_Get(&e), 1);
+    TEST_EQ(e.Data, 999);
+    TEST_EQ(EvtQ_Get(&e), 0);
+}
+
+/* --- 4. 随机抢占压力：主循环交替投递/消费，ISR 在任意抢占点投递 0~2 条 --- */
+static uint32_t s_Seed = 7;
+static uint32_t s_IsrAttempts;
+
+static uint32_t _Rand(void)
+{
+    s_Seed = s_Seed * 1103515245u + 12345u;
+    return s_Seed >> 16;
+}
+
+static uint8_t _HookRandom(uint8_t site)
+{
+    uint32_t n, i;
+
+    (void)site;
+    if (_Rand() % 8) return 0;
+    n = _Rand() % 3;
+    for (i = 0; i < n; i++) {
+        _Post(PROD_ISR, s_IsrSeq++);
+        s_IsrAttempts++;
+    }
+    return 1;
+}
+
+static void _TestStress(void)
+{
+    EvtQ_Stats_t st;
+    Event_t e;
+    uint32_t iter, main_seq = 0, main_attempts = 0, consumed = 0, torn = 0, reorder = 0;
+    int64_t last_main = -1, last_isr = -1;
+
+    EvtQ_Init();
+    s_IsrSeq = 0;
+    s_IsrAttempts = 0;
+    Host_SetPreemptHook(_HookRandom);
+    for (iter = 0; iter < 200000; iter++) {
+        if (_Rand() % 2) {
+            _Post(PROD_MAIN, main_seq++);
+            main_attempts++;
+        } else if (EvtQ_Get(&e)) {
+            consumed++;
+            if (!_Valid(&e)) torn++;
+            // 被丢弃的序号会空缺，但同一生产者的序号必须递增
+            if (e.Type == PROD_MAIN) {
+                if ((int64_t)e.Data <= last_main) reorder++;
+                last_main = e.Data;
+            } else {
+                if ((int64_t)e.Data <= last_isr) reorder++;
+                last_isr = e.Data;
+            }
+        }
+    }
+    Host_SetPreemptHook(NULL);
+    while (EvtQ_Get(&e)) {
+        consumed++;
+        if (!_Valid(&e)) torn++;
+    }
+
+    EvtQ_GetStats(&st);
+    printf("随机抢占: 投递 %u (主 %u / ISR %u), 成功 %u, 丢弃 %u, 消费 %u, 半条 %u, 乱序 %u\n",
+           main_attempts + s_IsrAttempts, main_attempts, s_IsrAttempts,
+           st.Posted, st.Dropped, consumed, torn, reorder);
+    TEST_EQ(st.Posted + st.Dropped, main_attempts + s_IsrAttempts);
+    TEST_EQ(consumed, st.Posted);
+    TEST_EQ(torn, 0);
+    TEST_EQ(reorder, 0);
+    TEST_CHECK(st.Dropped > 0);
+}
+
+int main(void)
+{
+    Host_Reset();
+
+    _TestBasic();
+    _TestSweep(0, 1);
+    _TestSweep(3, 2);
+    _TestSweep(EVTQ_SIZE - 1, 1);
+    _TestSweep(EVTQ_SIZE - 2, 3);
+    TEST_CHECK(s_Unpublished > 0);
+    _TestSteal();
+    _TestStress();
+
+    TEST_DONE();
+}
@@ -0,0 +1,445 @@
+/**
+  ******************************************************************************
+  * @file    test_key_manager.c
+  * @brief   按键引擎 (Common/KeyEngine) 的按下/松开轨迹回放
+  * @note    1. 只编译 Key.c + KeyManager.c 与本文件，移植层 Key_HAL_* 由本文件
+  *             提供：虚拟节拍 + 脚本化引脚电平，每 5ms 调一次 KeyManager_Tick
+  *          2. 编译两次，时序参数都来自 Common/KeyEngine/KeyConfig.h，区别在调用方式：
+  *             test_key_manager_stm32 按 STM32 input 任务每 5ms 调一次；
+  *             test_key_manager_esp32 定义 KEY_PORT_EVENT_DRIVEN=1，仿照
+  *             key_port_esp32.c：KeyManager_IsIdle 时阻塞到下一个引脚沿，
+  *             否则每 KEY_ACTIVE_POLL_MS (10ms) 调一次，同一组轨迹须得到同样的事件
+  *          3. 期望时刻由配置推出：按下沿经去抖 KEY_DEBOUNCE_TIME_MS 后确认，
+  *             组合窗口 KEY_COMBO_WINDOW_MS，连击间隔 KEY_MULTI_CLICK_GAP_MS，
+  *             长按阈值 KEY_HOLD_TIME_MS (从确认按下起算)
+  *          4. 最后输出 KeyManager_Tick 的主机耗时：注册 1~NUM_KEYS 个键，
+  *             分别在空闲与手势进行中 (各键相隔 100ms 按住，各占一个跟踪器) 计时
+  ******************************************************************************
+  */
+#include "host_test.h"
+#include "KeyManager.h"
+#include <string.h>
+#include <time.h>
+
+#ifndef KEY_PORT_EVENT_DRIVEN
+#define KEY_PORT_EVENT_DRIVEN   0
+#endif
+
+#if KEY_PORT_EVENT_DRIVEN
+#define TICK_MS         10      // key_port_esp32.c 的 KEY_ACTIVE_POLL_MS
+#else
+#define TICK_MS         5
+#endif
+#define NUM_KEYS        5
+#define MAX_EVENTS      64
+
+#define KA  KEY_MASK(0)
+#define KB  KEY_MASK(1)
+
+/* --- 移植层替身 --- */
+static uint32_t s_Now;
+static uint8_t  s_Level[NUM_KEYS];      // 1 = 按下 (ActiveLevel 取 1)
+
+void Key_HAL_Init_Pin(void *port, uint32_t pin, uint8_t active_level)
+{
+    (void)port; (void)pin; (void)active_level;
+}
+
+uint8_t Key_HAL_Read_Pin(void *port, uint32_t pin)
+{
+    (void)port;
+    return s_Level[pin];
+}
+
+uint32_t Key_HAL_GetTick(void) { return s_Now; }
+
+/* --- 事件记录 --- */
+static KeyEvent_t s_Events[MAX_EVENTS];
+static uint8_t    s_EventCount;
+
+void KeyManager_Hook_OnEvent(const KeyEvent_t *evt)
+{
+    if (s_EventCount < MAX_EVENTS) s_Events[s_EventCount++] = *evt;
+}
+
+/* --- 轨迹回放 --- */
+typedef struct {
+    uint32_t TimeMs;
+    uint8_t  Key;
+    uint8_t  Level;
+} KeyEdge_t;
+
+static Key_t s_Keys[NUM_KEYS];
+static uint32_t s_TickCount;            // 回放中 KeyManager_Tick 的调用次数
+
+static void _SetupKeys(const KeyPattern_t *table, uint8_t count, uint8_t keys)
+{
+    uint8_t i;
+
+    s_Now = 1000;
+    memset(s_Level, 0, sizeof(s_Level));
+    s_EventCount = 0;
+    KeyManager_Init();
+    for (i = 0; i < keys; i++) {
+        Key_Init(&s_Keys[i], i, NULL, i, 1);
+        KeyManager_Register(&s_Keys[i]);
+    }
+    if (table) TEST_EQ(KeyManager_SetPatterns(table, count), 0);
+    // 先空转一段，让去抖状态稳定
+    for (i = 0; i < 20; i++) {
+        s_Now += TICK_MS;
+        KeyManager_Tick();
+    }
+    s_EventCount = 0;
+}
+
+static void _Setup(const KeyPattern_t *table, uint8_t count)
+{
+    _SetupKeys(table, count, NUM_KEYS);
+}
+
+// 轨迹中的时刻相对回放起点；回放到 end_ms 为止
+static void _Replay(const KeyEdge_t *edges, uint8_t n, uint32_t end_ms)
+{
+    uint32_t start = s_Now, t = 0;
+    uint8_t e = 0;
+
+    while (t <= end_ms) {
+        s_Now = start + t;
+        while (e < n && edges[e].TimeMs <= t) {
+            s_Level[edges[e].Key] = edges[e].Level;
+            e++;
+        }
+        KeyManager_Tick();
+        s_TickCount++;
+#if KEY_PORT_EVENT_DRIVEN
+        // 空闲：任务阻塞，下一个沿的中断把它唤醒
+        if (KeyManager_IsIdle()) {
+            if (e >= n) break;
+            t = edges[e].TimeMs;
+            continue;
+        }
+#endif
+        t += TICK_MS;
+    }
+    // 事件时间戳改为相对回放起点，便于比较
+    for (e = 0; e < s_EventCount; e++) s_Events[e].Timestamp -= start;
+}
+
+// 不含 UP 的事件序列
+static uint8_t _Gestures(KeyEvent_t *out)
+{
+    uint8_t i, n = 0;
+
+    for (i = 0; i < s_EventCount; i++) {
+        if (s_Events[i].Type != KEY_EVT_UP) out[n++] = s_Events[i];
+    }
+    return n;
+}
+
+static void _Dump(const char *name)
+{
+    uint8_t i;
+
+    fprintf(stderr, "%s 事件序列:\n", name);
+    for (i = 0; i < s_EventCount; i++) {
+        fprintf(stderr, "  t=%4u type=%d mask=0x%02x param=%u\n", s_Events[i].Timestamp,
+                s_Events[i].Type, (unsigned)s_Events[i].Mask, s_Events[i].Param);
+    }
+}
+
+#define EXPECT(name, cond) do { if (!(cond)) { _Dump(name); } TEST_CHECK(cond); } while (0)
+
+// 按下 down_ms 后松开，共 n 次，每次间隔 period_ms
+static uint8_t _Clicks(KeyEdge_t *edges, uint8_t key, uint8_t n, uint32_t t0,
+                       uint32_t down_ms, uint32_t period_ms)
+{
+    uint8_t i;
+
+    for (i = 0; i < n; i++) {
+        edges[2 * i]     = (KeyEdge_t){ t0 + i * period_ms, key, 1 };
+        edges[2 * i + 1] = (KeyEdge_t){ t0 + i * period_ms + down_ms, key, 0 };
+    }
+    return (uint8_t)(2 * n);
+}
+
+/* ============================================================ */
+
+static void _TestClicks(void)
+{
+    KeyEdge_t edges[16];
+    KeyEvent_t g[MAX_EVENTS];
+    uint8_t n, ng;
+    uint32_t release_seen;
+
+    // 单击：松开沿去抖后 + 连击间隔才结算
+    _Setup(NULL, 0);
+    n = _Clicks(edges, 0, 1, 0, 100, 0);
+    _Replay(edges, n, 1000);
+    ng = _Gestures(g);
+    EXPECT("单击", ng == 1 && g[0].Type == KEY_EVT_CLICK && g[0].Mask == KA && g[0].Param == 1);
+    release_seen = 100 + KEY_DEBOUNCE_TIME_MS;
+    TEST_CHECK(g[0].Timestamp > release_seen + KEY_MULTI_CLICK_GAP_MS);
+    TEST_CHECK(g[0].Timestamp <= release_seen + KEY_MULTI_CLICK_GAP_MS + 2 * TICK_MS);
+    TEST_EQ(s_EventCount, 2);   // UP + CLICK
+    TEST_CHECK(KeyManager_IsIdle());
+
+    // 双击
+    _Setup(NULL, 0);
+    n = _Clicks(edges, 0, 2, 0, 80, 200);
+    _Replay(edges, n, 1200);
+    ng = _Gestures(g);
+    EXPECT("双击", ng == 1 && g[0].Type == KEY_EVT_DOUBLE_CLICK && g[0].Param == 2);
+
+    // 三连击
+    _Setup(NULL, 0);
+    n = _Clicks(edges, 0, 3, 0, 80, 200);
+    _Replay(edges, n, 1400);
+    ng = _Gestures(g);
+    EXPECT("三连击", ng == 1 && g[0].Type == KEY_EVT_TRIPLE_CLICK && g[0].Param == 3);
+
+    // 四连击是默认表声明的最大值：第 4 次松开确认时立即输出，不等连击间隔
+    _Setup(NULL, 0);
+    n = _Clicks(edges, 0, 4, 0, 80, 200);
+    _Replay(edges, n, 1600);
+    ng = _Gestures(g);
+    EXPECT("四连击", ng == 1 && g[0].Type == KEY_EVT_QUAD_CLICK && g[0].Param == 4);
+    release_seen = 3 * 200 + 80 + KEY_DEBOUNCE_TIME_MS;
+    TEST_CHECK(g[0].Timestamp >= release_seen && g[0].Timestamp <= release_seen + TICK_MS);
+
+    // 五次：前四次提前结算，第五次重新开始，结算为单击
+    _Setup(NULL, 0);
+    n = _Clicks(edges, 0, 5, 0, 80, 200);
+    _Replay(edges, n, 2000);
+    ng = _Gestures(g);
+    EXPECT("五连击", ng == 2 && g[0].Type == KEY_EVT_QUAD_CLICK && g[1].Type == KEY_EVT_CLICK);
+
+    // 两次按下间隔超过连击间隔：两个单击
+    _Setup(NULL, 0);
+    n = _Clicks(edges, 0, 2, 0, 80, 80 + KEY_MULTI_CLICK_GAP_MS + 60);
+    _Replay(edges, n, 1500);
+    ng = _Gestures(g);
+    EXPECT("间隔过长", ng == 2 && g[0].Type == KEY_EVT_CLICK && g[1].Type == KEY_EVT_CLICK);
+
+    // 自定义表只声明到双击：第 2 次松开立即输出
+    {
+        static const KeyPattern_t table[] = {
+            KM_CLICK(KM_ANY_KEY, 1, KEY_EVT_CLICK),
+            KM_CLICK(KM_ANY_KEY, 2, KEY_EVT_DOUBLE_CLICK),
+        };
+        _Setup(table, 2);
+        n = _Clicks(edges, 0, 2, 0, 80, 200);
+        _Replay(edges, n, 1000);
+        ng = _Gestures(g);
+        release_seen = 200 + 80 + KEY_DEBOUNCE_TIME_MS;
+        EXPECT("最大连击提前结算", ng == 1 && g[0].Type == KEY_EVT_DOUBLE_CLICK &&
+               g[0].Timestamp <= release_seen + TICK_MS);
+    }
+}
+
+static void _TestHold(void)
+{
+    KeyEdge_t edges[8];
+    KeyEvent_t g[MAX_EVENTS];
+    uint8_t ng, i, holding = 0;
+
+    // 长按 1500ms：HOLD_START (按下确认后 KEY_HOLD_TIME_MS)，松开时 HOLD_END + UP
+    _Setup(NULL, 0);
+    edges[0] = (KeyEdge_t){ 0, 0, 1 };
+    edges[1] = (KeyEdge_t){ 1500, 0, 0 };
+    _Replay(edges, 2, 2000);
+    ng = _Gestures(g);
+    EXPECT("长按", ng == 2 && g[0].Type == KEY_EVT_HOLD_START && g[1].Type == KEY_EVT_HOLD_END);
+    TEST_CHECK(g[0].Timestamp >= KEY_DEBOUNCE_TIME_MS + KEY_HOLD_TIME_MS);
+    TEST_CHECK(g[0].Timestamp <= KEY_DEBOUNCE_TIME_MS + KEY_HOLD_TIME_MS + 2 * TICK_MS);
+    TEST_CHECK(g[0].Param >= KEY_HOLD_TIME_MS);
+    // 按下时长：两个沿各自经过相同的去抖
+    TEST_CHECK(g[1].Param >= 1500 - TICK_MS && g[1].Param <= 1500 + TICK_MS);
+    TEST_EQ(s_Events[s_EventCount - 1].Type, KEY_EVT_UP);
+    TEST_EQ(KeyManager_IsIdle(), 1);
+
+    // 长按不足阈值：单击
+    _Setup(NULL, 0);
+    edges[1] = (KeyEdge_t){ KEY_HOLD_TIME_MS - 100, 0, 0 };
+    _Replay(edges, 2, 2000);
+    ng = _Gestures(g);
+    EXPECT("短于长按", ng == 1 && g[0].Type == KEY_EVT_CLICK);
+
+    // 带连发的长按
+    {
+        static const KeyPattern_t table[] = {
+            KM_CLICK(KM_ANY_KEY, 1, KEY_EVT_CLICK),
+            KM_HOLD (KM_ANY_KEY, 500, 100),
+        };
+        _Setup(table, 2);
+        edges[1] = (KeyEdge_t){ 1030, 0, 0 };
+        _Replay(edges, 2, 1500);
+        ng = _Gestures(g);
+        for (i = 0; i < ng; i++) holding += (g[i].Type == KEY_EVT_HOLDING);
+        // 确认按下 20ms，长按起点 520ms，之后每 100ms 一次直到 1050ms 松开确认
+        EXPECT("连发", g[0].Type == KEY_EVT_HOLD_START && holding == 5 &&
+               g[ng - 1].Type == KEY_EVT_HOLD_END);
+    }
+
+    // 长按 A 期间点按 B：修饰键点击，A 的长按不受影响
+    _Setup(NULL, 0);
+    edges[0] = (KeyEdge_t){ 0, 0, 1 };
+    edges[1] = (KeyEdge_t){ 1000, 1, 1 };
+    edges[2] = (KeyEdge_t){ 1100, 1, 0 };
+    edges[3] = (KeyEdge_t){ 1500, 0, 0 };
+    _Replay(edges, 4, 2000);
+    ng = _Gestures(g);
+    EXPECT("修饰键", ng == 3 && g[0].Type == KEY_EVT_HOLD_START &&
+           g[1].Type == KEY_EVT_MODIFIER_CLICK && g[1].Mask == (KA | KB) &&
+           g[2].Type == KEY_EVT_HOLD_END && g[2].Mask == KA);
+}
+
+static void _TestCombos(void)
+{
+    KeyEdge_t edges[16];
+    KeyEvent_t g[MAX_EVENTS];
+    uint8_t ng, i, holds = 0;
+    KeyMask_t seen = 0;
+
+    // A、B 在组合窗口内先后按下：作为一个组合单击
+    _Setup(NULL, 0);
+    edges[0] = (KeyEdge_t){ 0, 0, 1 };
+    edges[1] = (KeyEdge_t){ KEY_COMBO_WINDOW_MS / 2, 1, 1 };
+    edges[2] = (KeyEdge_t){ 150, 0, 0 };
+    edges[3] = (KeyEdge_t){ 150, 1, 0 };
+    _Replay(edges, 4, 1000);
+    ng = _Gestures(g);
+    EXPECT("组合键", ng == 1 && g[0].Type == KEY_EVT_CLICK && g[0].Mask == (KA | KB));
+
+    // 超出窗口：两个独立手势，同时计时
+    _Setup(NULL, 0);
+    edges[0] = (KeyEdge_t){ 0, 0, 1 };
+    edges[1] = (KeyEdge_t){ 200, 1, 1 };
+    edges[2] = (KeyEdge_t){ 300, 1, 0 };
+    edges[3] = (KeyEdge_t){ 1500, 0, 0 };
+    _Replay(edges, 4, 2000);
+    ng = _Gestures(g);
+    EXPECT("独立手势", ng == 3 && g[0].Type == KEY_EVT_CLICK && g[0].Mask == KB &&
+           g[1].Type == KEY_EVT_HOLD_START && g[1].Mask == KA);
+
+    // 跟踪器上限：5 个键相隔 100ms 依次按住，只有前 KM_MAX_TRACKERS 个得到长按
+    _Setup(NULL, 0);
+    for (i = 0; i < NUM_KEYS; i++) {
+        edges[i]            = (KeyEdge_t){ i * 100u, i, 1 };
+        edges[NUM_KEYS + i] = (KeyEdge_t){ 2000, i, 0 };
+    }
+    _Replay(edges, 2 * NUM_KEYS, 2500);
+    ng = _Gestures(g);
+    for (i = 0; i < ng; i++) {
+        if (g[i].Type == KEY_EVT_HOLD_START) {
+            holds++;
+            seen |= g[i].Mask;
+        }
+    }
+    EXPECT("跟踪器上限", holds == KM_MAX_TRACKERS && !(seen & KEY_MASK(NUM_KEYS - 1)));
+    TEST_EQ(KeyManager_IsIdle(), 1);
+
+    // 全部松开后跟踪器释放，最后一个键可以正常使用
+    s_EventCount = 0;
+    edges[0] = (KeyEdge_t){ 0, NUM_KEYS - 1, 1 };
+    edges[1] = (KeyEdge_t){ 100, NUM_KEYS - 1, 0 };
+    _Replay(edges, 2, 1000);
+    ng = _Gestures(g);
+    EXPECT("释放后", ng == 1 && g[0].Type == KEY_EVT_CLICK && g[0].Mask == KEY_MASK(NUM_KEYS - 1));
+}
+
+static void _TestDebounce(void)
+{
+    KeyEdge_t edges[16];
+    uint8_t i;
+
+    // 抖动：1~5ms 的毛刺 (不足一个节拍的会被采样错过)，以及 10ms 的干扰脉冲
+    _Setup(NULL, 0);
+    for (i = 0; i < 6; i++) {
+        edges[2 * i]     = (KeyEdge_t){ i * 40u, 0, 1 };
+        edges[2 * i + 1] = (KeyEdge_t){ i * 40u + 10, 0, 0 };
+    }
+    _Replay(edges, 12, 1000);
+    EXPECT("毛刺", s_EventCount == 0);
+    TEST_EQ(KeyManager_IsIdle(), 1);
+
+    // 稳定按下不足去抖时间 (差一个节拍) 同样被滤除
+    _Setup(NULL, 0);
+    edges[0] = (KeyEdge_t){ 0, 0, 1 };
+    edges[1] = (KeyEdge_t){ KEY_DEBOUNCE_TIME_MS - TICK_MS + 3, 0, 0 };
+    _Replay(edges, 2, 1000);
+    EXPECT("短按", s_EventCount == 0);
+
+    // 刚好达到去抖时间：确认为一次单击
+    _Setup(NULL, 0);
+    edges[1] = (KeyEdge_t){ KEY_DEBOUNCE_TIME_MS + TICK_MS, 0, 0 };
+    _Replay(edges, 2, 1000);
+    EXPECT("去抖边界", s_EventCount == 2 && s_Events[1].Type == KEY_EVT_CLICK);
+}
+
+/* ============================================================
+ *                 KeyManager_Tick 耗时 (主机)
+ * ============================================================ */
+
+#define BENCH_TICKS     200000
+
+static uint64_t _HostNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// 注册 keys 个键，busy 时各键相隔 100ms 按住并进入长按后开始计时
+static double _TickNs(uint8_t keys, uint8_t busy)
+{
+    KeyEdge_t edges[NUM_KEYS];
+    uint64_t t0;
+    uint32_t i;
+
+    _SetupKeys(NULL, 0, keys);
+    if (busy) {
+        for (i = 0; i < keys; i++) edges[i] = (KeyEdge_t){ i * 100u, (uint8_t)i, 1 };
+        _Replay(edges, keys, keys * 100u + KEY_DEBOUNCE_TIME_MS + KEY_HOLD_TIME_MS + 100);
+        TEST_CHECK(!KeyManager_IsIdle());
+    }
+
+    t0 = _HostNs();
+    for (i = 0; i < BENCH_TICKS; i++) {
+        s_Now += TICK_MS;
+        KeyManager_Tick();
+    }
+    t0 = _HostNs() - t0;
+    TEST_EQ(KeyManager_IsIdle(), !busy);
+    return (double)t0 / BENCH_TICKS;
+}
+
+static void _BenchTick(void)
+{
+    uint8_t k;
+    double idle, busy;
+
+    printf("KeyManager_Tick 主机耗时 (%u 次平均):\n", BENCH_TICKS);
+    for (k = 1; k <= NUM_KEYS; k++) {
+        idle = _TickNs(k, 0);
+        busy = _TickNs(k, 1);
+        printf("  %u 键: 空闲 %5.1f ns (%4.1f ns/键)，手势中 %5.1f ns (%4.1f ns/键)\n",
+               k, idle, idle / k, busy, busy / k);
+    }
+}
+
+int main(void)
+{
+    printf("配置: 去抖 %d ms, 组合窗口 %d ms, 长按 %d ms, 连击间隔 %d ms\n",
+           KEY_DEBOUNCE_TIME_MS, KEY_COMBO_WINDOW_MS, KEY_HOLD_TIME_MS, KEY_MULTI_CLICK_GAP_MS);
+
+    _TestClicks();
+    _TestHold();
+    _TestCombos();
+    _TestDebounce();
+    printf("轨迹回放共调用 KeyManager_Tick %lu 次 (%s)\n", (unsigned long)s_TickCount,
+           KEY_PORT_EVENT_DRIVEN ? "空闲阻塞 + 10ms 轮询" : "固定 5ms");
+    _BenchTick();
+
+    TEST_DONE();
+}
@@ -0,0 +1,203 @@
+/**
+  ******************************************************************************
+  * @file    test_kvstore_powercut.c
+  * @brief   KVStore 掉电恢复与擦除次数
+  * @note    1. Flash 替身 (host_flash.c) 为 NOR 语义的 RAM，Host_FlashArmCut
+  *             在第 n 次编程/擦除时 "掉电"：该操作不生效或只完成一半 (撕裂)，
+  *             回调中 longjmp 回到测试，相当于 CPU 停止运行
+  *          2. 对工作负载中的每一次保存、保存中的每一步编程/擦除 (含回收)、
+  *             撕裂与否两种情况各掉电一次，重新上电 (KV_Init) 后检查：
+  *             其它键为最后一次提交的值；被打断的键为旧值或新值 (仅当提交
+  *             标志 CRC 已完整写入)，不会出现第三种值；之后仍可正常写入
+  *          3. 统计 10000 次保存的擦除次数
+  ******************************************************************************
+  */
+#include "host_port.h"
+#include "host_test.h"
+#include "KVStore.h"
+#include "Flash.h"
+#include <setjmp.h>
+#include <string.h>
+
+#define KV_REGION_SIZE  (KV_PAGE_COUNT * FLASH_PAGE_SIZE)
+#define NUM_KEYS        3
+#define SWEEP_SAVES     220     // 覆盖至少两次回收
+
+static const uint8_t s_Len[NUM_KEYS] = { 8, 4, 20 };    // 键 0 与 Persist 快照同长
+
+static uint8_t s_Committed[NUM_KEYS][KV_MAX_VALUE_LEN];
+static uint8_t s_HasValue[NUM_KEYS];
+static jmp_buf s_PowerLoss;
+
+static void _OnCut(void)
+{
+    longjmp(s_PowerLoss, 1);
+}
+
+// 第 i 次保存写哪个键、写什么
+static uint8_t _Workload(uint32_t i, uint8_t *value)
+{
+    uint8_t key = (i % 7 == 0) ? 2 : (i % 3 == 0) ? 1 : 0;
+    uint8_t n;
+
+    for (n = 0; n < s_Len[key]; n++) value[n] = (uint8_t)(i * 31 + n * 7 + key);
+    return key;
+}
+
+static uint32_t _FlashOps(void)
+{
+    Host_FlashStats_t st;
+
+    Host_GetFlashStats(&st);
+    return st.Programs + st.Erases;
+}
+
+static void _CheckKeys(uint8_t skip_key, uint32_t *failures)
+{
+    uint8_t buf[KV_MAX_VALUE_LEN];
+    uint8_t k;
+    KV_Status_t s;
+
+    for (k = 0; k < NUM_KEYS; k++) {
+        if (k == skip_key) continue;
+        s = KV_Read(k, buf, s_Len[k]);
+        if (s_HasValue[k] ? (s != KV_OK || memcmp(buf, s_Committed[k], s_Len[k]) != 0)
+                          : (s != KV_ERR_NOT_FOUND)) {
+            (*failures)++;
+        }
+    }
+}
+
+static void _TestPowerCutSweep(void)
+{
+    static uint8_t snap[KV_REGION_SIZE];
+    uint8_t value[KV_MAX_VALUE_LEN], buf[KV_MAX_VALUE_LEN];
+    uint32_t i, op, ops, cases = 0, got_old = 0, got_new = 0, bad = 0, other_bad = 0, reuse_bad = 0;
+    uint32_t compact_cases = 0;
+    uint8_t key, torn;
+    KV_Status_t s;
+    KV_Stats_t kst;
+    uint16_t seq_before;
+
+    Host_FlashReset();
+    memset(s_HasValue, 0, sizeof(s_HasValue));
+    TEST_EQ(KV_Init(), KV_OK);
+
+    for (i = 0; i < SWEEP_SAVES; i++) {
+        key = _Workload(i, value);
+        memcpy(snap, (const void *)KV_BASE_ADDR, KV_REGION_SIZE);
+
+        // 无掉电跑一次，得到本次保存的编程/擦除步数
+        KV_GetStats(&kst);
+        seq_before = kst.ActiveSeq;
+        ops = _FlashOps();
+        TEST_EQ(KV_Write(key, value, s_Len[key]), KV_OK);
+        ops = _FlashOps() - ops;
+        KV_GetStats(&kst);
+
+        for (op = 0; op < ops; op++) {
+            for (torn = 0; torn < 2; torn++) {
+                memcpy((void *)KV_BASE_ADDR, snap, KV_REGION_SIZE);
+                TEST_EQ(KV_Init(), KV_OK);
+                if (setjmp(s_PowerLoss) == 0) {
+                    Host_FlashArmCut(op, torn, _OnCut);
+                    KV_Write(key, value, s_Len[key]);
+                    Host_FlashDisarmCut();
+                    bad++;                      // 第 op 步必然掉电，不应走到这里
+                    continue;
+                }
+
+                // 重新上电
+                cases++;
+                if (kst.ActiveSeq != seq_before) compact_cases++;
+                TEST_EQ(KV_Init(), KV_OK);
+                _CheckKeys(key, &other_bad);
+                s = KV_Read(key, buf, s_Len[key]);
+                if (s == KV_OK && memcmp(buf, value, s_Len[key]) == 0) {
+                    got_new++;
+                } else if (s_HasValue[key] ? (s == KV_OK && memcmp(buf, s_Committed[key], s_Len[key]) == 0)
+                                           : (s == KV_ERR_NOT_FOUND)) {
+                    got_old++;
+                } else {
+                    bad++;
+                }
+
+                // 恢复后继续可用：重写本次的值并再次上电
+                if (KV_Write(key, value, s_Len[key]) != KV_OK) reuse_bad++;
+                KV_Init();
+                if (KV_Read(key, buf, s_Len[key]) != KV_OK || memcmp(buf, value, s_Len[key]) != 0) reuse_bad++;
+                _CheckKeys(key, &reuse_bad);
+            }
+        }
+
+        // 主时间线：恢复到本次保存成功后的状态
+        memcpy((void *)KV_BASE_ADDR, snap, KV_REGION_SIZE);
+        TEST_EQ(KV_Init(), KV_OK);
+        TEST_EQ(KV_Write(key, value, s_Len[key]), KV_OK);
+        memcpy(s_Committed[key], value, s_Len[key]);
+        s_HasValue[key] = 1;
+    }
+
+    KV_GetStats(&kst);
+    printf("掉电扫描: %u 次保存 (%u 次回收), %u 个掉电点 (其中回收中 %u 个)\n",
+           SWEEP_SAVES, kst.ActiveSeq, cases, compact_cases);
+    printf("  被打断的键恢复为旧值 %u 次, 新值 %u 次, 其它 %u 次; 其它键错误 %u; 恢复后写入错误 %u\n",
+           got_old, got_new, bad, other_bad, reuse_bad);
+    TEST_CHECK(kst.ActiveSeq >= 2);
+    TEST_CHECK(compact_cases > 0);
+    TEST_EQ(bad, 0);
+    TEST_EQ(other_bad, 0);
+    TEST_EQ(reuse_bad, 0);
+}
+
+static void _TestEraseRate(void)
+{
+    uint8_t value[KV_MAX_VALUE_LEN], light[8];
+    Host_FlashStats_t st;
+    KV_Stats_t kst0, kst;
+    uint32_t i;
+
+    // 只保存灯光快照 (Persist 的实际用法)
+    Host_FlashReset();
+    KV_GetStats(&kst0);     // KVStore 的计数从上电起累计
+    TEST_EQ(KV_Init(), KV_OK);
+    for (i = 0; i < 10000; i++) {
+        memset(light, 0, sizeof(light));
+        light[0] = (uint8_t)i;
+        light[1] = (uint8_t)(i >> 8);
+        TEST_EQ(KV_Write(0, light, sizeof(light)), KV_OK);
+    }
+    Host_GetFlashStats(&st);
+    KV_GetStats(&kst);
+    printf("10000 次保存 (8 字节快照): 擦除 %u 次 (初始化 1 次)，每页 %u 次擦除，Flash 忙 %.1f s\n",
+           st.Erases, st.Erases / KV_PAGE_COUNT, st.BusyUs / 1e6);
+    TEST_EQ(st.Erases, kst.Erases - kst0.Erases);
+    TEST_CHECK(st.Erases <= 10000 / 80 + 2);
+
+    // 混合负载
+    Host_FlashReset();
+    TEST_EQ(KV_Init(), KV_OK);
+    for (i = 0; i < 10000; i++) {
+        uint8_t key = _Workload(i, value);
+        TEST_EQ(KV_Write(key, value, s_Len[key]), KV_OK);
+    }
+    Host_GetFlashStats(&st);
+    printf("10000 次保存 (混合 8/4/20 字节): 擦除 %u 次\n", st.Erases);
+
+    // 值未变化的保存不占用 Flash
+    i = st.Erases;
+    TEST_EQ(KV_Write(0, value, s_Len[0]), KV_OK);
+    TEST_EQ(KV_Write(0, value, s_Len[0]), KV_OK);
+    Host_GetFlashStats(&st);
+    TEST_EQ(st.Erases, i);
+}
+
+int main(void)
+{
+    Host_Reset();
+
+    _TestPowerCutSweep();
+    _TestEraseRate();
+
+    TEST_DONE();
+}
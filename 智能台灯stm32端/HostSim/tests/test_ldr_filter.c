@@ -0,0 +1,183 @@
+/**
+  ******************************************************************************
+  * @file    test_ldr_filter.c
+  * @brief   LDR 块平均 + IIR 滤波的阶跃响应与噪声抑制，以及与原先 8 次忙等转换的读取耗时对比
+  * @note    1. ADC 由仿真的 TIM3 TRGO 每 1ms 采样一次，DMA 半满/全满中断
+  *             每 8 个样本做一次块平均，再按 y += (x - y) >> LDR_FILTER_SHIFT 滤波
+  *          2. 理论时间常数 -1 / ln(1 - 2^-SHIFT) x 8ms ≈ 124ms (SHIFT=4)
+  *          3. 噪声：均匀分布 +-200 LSB 加 100Hz 正弦纹波 (幅值 300 LSB)
+  *          4. 读取耗时按虚拟时间计：软件触发转换按采样时间 + 12.5 个 ADC 时钟
+  *             (72MHz / 6) 推进时钟，不含 CPU 指令本身
+  ******************************************************************************
+  */
+#include "host_port.h"
+#include "host_test.h"
+#include "LDR.h"
+#include <math.h>
+
+static uint16_t s_Level;
+static uint16_t s_NoiseAmp, s_RippleAmp;
+static uint32_t s_Seed = 12345;
+
+static uint16_t _Source(uint64_t t_us)
+{
+    int32_t v = s_Level;
+
+    if (s_NoiseAmp) {
+        s_Seed = s_Seed * 1103515245u + 12345u;
+        v += (int32_t)((s_Seed >> 16) % (2u * s_NoiseAmp + 1)) - s_NoiseAmp;
+    }
+    if (s_RippleAmp) v += (int32_t)(s_RippleAmp * sin(2.0 * M_PI * 100.0 * (double)t_us / 1e6));
+    if (v < 0) v = 0;
+    if (v > 4095) v = 4095;
+    return (uint16_t)v;
+}
+
+// 阶跃后达到 from + frac x (to - from) 所需的毫秒数
+static uint32_t _StepTime(uint16_t from, uint16_t to, double frac, uint16_t *final)
+{
+    uint32_t ms, hit = 0;
+    double target = from + frac * ((double)to - from);
+
+    // 收敛到 1 LSB 以内约需 ln(4096 x 256) / ln(16/15) x 8ms ≈ 1.7s
+    s_Level = from;
+    Host_Advance(3000000);
+    TEST_EQ(LDR_GetRawValue(), from);
+
+    s_Level = to;
+    for (ms = 1; ms <= 2000; ms++) {
+        Host_Advance(1000);
+        if (!hit && ((to > from) ? LDR_GetRawValue() >= target : LDR_GetRawValue() <= target)) hit = ms;
+    }
+    *final = LDR_GetRawValue();
+    return hit;
+}
+
+static void _TestStep(void)
+{
+    uint16_t final;
+    uint32_t t63, t95;
+
+    t63 = _StepTime(0, 4000, 0.632, &final);
+    t95 = _StepTime(0, 4000, 0.95, &final);
+    printf("阶跃 0 -> 4000: 63%% %u ms, 95%% %u ms, 终值 %u\n", t63, t95, final);
+    TEST_CHECK(t63 >= 110 && t63 <= 150);
+    TEST_CHECK(t95 >= 340 && t95 <= 420);
+    TEST_EQ(final, 4000);
+
+    t63 = _StepTime(4000, 500, 0.632, &final);
+    printf("阶跃 4000 -> 500: 63%% %u ms, 终值 %u\n", t63, final);
+    TEST_CHECK(t63 >= 110 && t63 <= 150);
+    TEST_EQ(final, 500);
+}
+
+static void _TestNoise(uint16_t noise, uint16_t ripple, double min_ratio)
+{
+    double in_sum = 0, in_sq = 0, out_sum = 0, out_sq = 0, in_std, out_std, v;
+    uint32_t ms, n = 5000;
+
+    s_Level = 2000;
+    s_NoiseAmp = noise;
+    s_RippleAmp = ripple;
+    Host_Advance(1000000);
+
+    for (ms = 0; ms < n; ms++) {
+        Host_Advance(1000);
+        v = _Source(Host_NowUs());
+        in_sum += v;
+        in_sq += v * v;
+        v = LDR_GetRawValue();
+        out_sum += v;
+        out_sq += v * v;
+    }
+    in_std = sqrt(in_sq / n - (in_sum / n) * (in_sum / n));
+    out_std = sqrt(out_sq / n - (out_sum / n) * (out_sum / n));
+    printf("噪声 +-%u 纹波 %u: 输入 std %.1f, 输出 std %.2f (抑制 %.1f 倍), 输出均值 %.1f\n",
+           noise, ripple, in_std, out_std, in_std / out_std, out_sum / n);
+
+    TEST_CHECK(in_std / out_std >= min_ratio);
+    TEST_CHECK(fabs(out_sum / n - 2000.0) < 5.0);
+    s_NoiseAmp = 0;
+    s_RippleAmp = 0;
+}
+
+/* 原实现 (V1 LDR.c)：每次读取连续 8 次软件触发转换，逐次忙等 EOC */
+static uint16_t _OldGetRawValue(uint8_t sample_time)
+{
+    ADC_RegularChannelConfig(ADC1, ADC_Channel_0, 1, sample_time);
+    ADC_SoftwareStartConvCmd(ADC1, ENABLE);
+    while (ADC_GetFlagStatus(ADC1, ADC_FLAG_EOC) == RESET);
+    return ADC_GetConversionValue(ADC1);
+}
+
+static uint16_t _OldLuxPercentage(uint8_t sample_time)
+{
+    uint32_t sum = 0;
+    int i;
+
+    for (i = 0; i < 8; i++) sum += _OldGetRawValue(sample_time);
+    return (uint16_t)((sum / 8 * 1000) / 4095);
+}
+
+// 同一读数：原实现 8 x (55.5 + 12.5) / 12MHz = 45.3us (3264 周期)，改为 239.5 采样后
+// 为 168us (12096 周期)；现在只读滤波器状态，不访问 ADC
+static void _TestReadCost(void)
+{
+    uint64_t t0;
+    uint32_t old55, old239, cur;
+    uint16_t lux_old, lux_cur;
+
+    s_Level = 2000;
+    Host_Advance(2000000);
+
+    // 起点对齐到 1us 边界 (LDR_Init 后的时钟均为整微秒)
+    t0 = Host_NowUs();
+    lux_old = _OldLuxPercentage(ADC_SampleTime_55Cycles5);
+    old55 = (uint32_t)(Host_NowUs() - t0);
+
+    Host_Advance(1);
+    t0 = Host_NowUs();
+    _OldLuxPercentage(ADC_SampleTime_239Cycles5);
+    old239 = (uint32_t)(Host_NowUs() - t0);
+    // 恢复 LDR_Init 的采样时间
+    ADC_RegularChannelConfig(ADC1, ADC_Channel_0, 1, ADC_SampleTime_239Cycles5);
+
+    Host_Advance(1);
+    t0 = Host_NowUs();
+    lux_cur = LDR_GetLuxPercentage();
+    cur = (uint32_t)(Host_NowUs() - t0);
+
+    printf("读取耗时: 原 8 次忙等转换 %u us (55.5 采样) / %u us (239.5 采样)，现 %u us；读数 %u / %u\n",
+           old55, old239, cur, lux_old, lux_cur);
+    TEST_CHECK(old55 == 45);
+    TEST_CHECK(old239 == 168);
+    TEST_EQ(cur, 0);
+    TEST_EQ(lux_old, lux_cur);
+}
+
+int main(void)
+{
+    Host_Reset();
+    Host_SetAdcSource(_Source);
+    LDR_Init();
+    // ADC 由 TIM3 TRGO 触发，仿真中只需 TIM3 计数
+    TIM_Cmd(TIM3, ENABLE);
+
+    _TestStep();
+    // 白噪声：块平均 sqrt(8) x IIR sqrt(31) ≈ 15.7 倍
+    _TestNoise(200, 0, 10.0);
+    // 100Hz 纹波：8ms 块平均后残留 1/8 周期失配，再经 IIR
+    _TestNoise(0, 300, 10.0);
+
+    // 比例换算：0 -> 0，满量程 -> 1000 (光越强读数越大)
+    s_Level = 0;
+    Host_Advance(2000000);
+    TEST_EQ(LDR_GetLuxPercentage(), 0);
+    s_Level = 4095;
+    Host_Advance(2000000);
+    TEST_CHECK(LDR_GetLuxPercentage() >= 999);
+
+    _TestReadCost();
+
+    TEST_DONE();
+}
@@ -0,0 +1,90 @@
+/**
+  ******************************************************************************
+  * @file    test_paj7620_bus.c
+  * @brief   PAJ7620_ReadAllData 每次轮询的 I2C 事务数与线上字节数
+  * @note    "改造前" 按 V10.2 的访问序列 (每次重写 0xEF + 7 次单寄存器读取)
+  *          直接调用 I2C_Lib 复现，与当前驱动在同一寄存器模型上对比
+  ******************************************************************************
+  */
+#include "host_port.h"
+#include "host_test.h"
+#include "I2C_Driver.h"
+#include "PAJ7620.h"
+
+#define POLLS   100
+
+// V10.2 的 ReadAllData 访问序列
+static void _ReadAllDataV102(PAJ7620_Data_t *data)
+{
+    uint8_t v, buf[2];
+
+    I2C_Lib_Write(I2C2, 0xE6, 0xEF, (uint8_t[]){ 0x00 }, 1);
+    I2C_Lib_Read(I2C2, 0xE6, 0x43, &data->GestureFlag1, 1);
+    I2C_Lib_Read(I2C2, 0xE6, 0x44, &data->GestureFlag2, 1);
+    I2C_Lib_Read(I2C2, 0xE6, 0xB0, &data->ObjectBrightness, 1);
+    I2C_Lib_Read(I2C2, 0xE6, 0xB1, &buf[0], 1);
+    I2C_Lib_Read(I2C2, 0xE6, 0xB2, &buf[1], 1);
+    data->ObjectSize = (uint16_t)buf[0] | ((uint16_t)buf[1] << 8);
+    I2C_Lib_Read(I2C2, 0xE6, 0xC3, &v, 1);
+    data->VelocityX = (int8_t)v;
+    I2C_Lib_Read(I2C2, 0xE6, 0xC5, &v, 1);
+    data->VelocityY = (int8_t)v;
+}
+
+int main(void)
+{
+    Host_I2CDev_t *paj;
+    PAJ7620_Data_t now, old;
+    uint32_t i, txn_old, bytes_old;
+
+    Host_Reset();
+    paj = Host_PajAttach(0);
+    TEST_EQ(PAJ7620_Init(), 0);
+
+    // 改造前
+    Host_I2CClearStats();
+    for (i = 0; i < POLLS; i++) _ReadAllDataV102(&old);
+    txn_old = paj->Txn;
+    bytes_old = paj->Bytes;
+
+    // 当前驱动：Bank 缓存命中，三段连续读取
+    Host_I2CClearStats();
+    for (i = 0; i < POLLS; i++) PAJ7620_ReadAllData(&now);
+
+    printf("每次轮询       事务  字节  总线us\n");
+    printf("改造前 (V10.2) %4u  %4u  %6u\n", txn_old / POLLS, bytes_old / POLLS,
+           txn_old ? bytes_old * HOST_I2C_US_PER_BYTE / POLLS : 0);
+    printf("当前           %4u  %4u  %6u\n", paj->Txn / POLLS, paj->Bytes / POLLS,
+           (uint32_t)(paj->BusyUs / POLLS));
+
+    TEST_EQ(txn_old, 8 * POLLS);
+    TEST_EQ(bytes_old, 31 * POLLS);
+    TEST_EQ(paj->Txn, 3 * POLLS);
+    TEST_EQ(paj->Bytes, 17 * POLLS);
+
+    // 两种读法得到相同的数据 (标志读后清零，每次读前重新置位)
+    Host_PajObject(180);
+    Host_PajGesture(0x04, 0x01);
+    _ReadAllDataV102(&old);
+    Host_PajGesture(0x04, 0x01);
+    PAJ7620_ReadAllData(&now);
+    TEST_EQ(now.IsConnected, 1);
+    TEST_EQ(now.GestureFlag1, old.GestureFlag1);
+    TEST_EQ(now.GestureFlag2, old.GestureFlag2);
+    TEST_EQ(now.ObjectBrightness, 180);
+    TEST_EQ(now.ObjectSize, old.ObjectSize);
+
+    // 通信失败后 Bank 缓存作废，恢复后的第一次轮询重写 0xEF
+    Host_I2CDetachAll();
+    PAJ7620_ReadAllData(&now);
+    TEST_EQ(now.IsConnected, 0);
+    paj = Host_PajAttach(0);
+    PAJ7620_ReadAllData(&now);
+    TEST_EQ(now.IsConnected, 1);
+    TEST_EQ(paj->Txn, 4);
+    TEST_EQ(paj->Bytes, 3 + 17);
+    PAJ7620_ReadAllData(&now);
+    TEST_EQ(paj->Txn, 4 + 3);
+
+    TEST_DONE();
+}
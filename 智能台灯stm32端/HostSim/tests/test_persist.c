@@ -0,0 +1,312 @@
+/**
+  ******************************************************************************
+  * @file    test_persist.c
+  * @brief   Persist：安静期合并写入、最长推迟 30s、改回原值取消写入，以及
+  *          按真实交互节奏统计每小时的 Flash 写入与擦除次数
+  * @note    1. 真实的 Persist + KVStore + ControlManager + Protocol 运行在虚拟时钟上，
+  *             Flash 替身 (host_flash.c) 计数编程/擦除并按手册耗时推进时间
+  *          2. 按固件的任务周期调用：Protocol_Process 每 20ms，Persist_Task 每 100ms；
+  *             编码器与手势按输入任务分发后的方式直接调用 Control_OnEncoder /
+  *             Control_OnGesture，上位机指令经 Host_UartRx 从 USART1 收入
+  *          3. 每次 Persist_Task 按 Flash 计数判断是否写入/擦除，并检查同一次调用
+  *             不会既擦页又写记录 (回收与写入分在两个调度步骤)
+  ******************************************************************************
+  */
+#include "host_port.h"
+#include "host_test.h"
+#include "Persist.h"
+#include "KVStore.h"
+#include "SystemModel.h"
+#include "ControlManager.h"
+#include "Protocol.h"
+#include "USART_DMA.h"
+#include "PAJ7620.h"
+#include "SystemSupport.h"
+#include <stdio.h>
+#include <string.h>
+
+// 与 Persist.c 一致
+#define QUIET_MS            3000
+#define MAX_DELAY_MS        30000
+#define PERSIST_PERIOD_MS   100
+#define PROTO_PERIOD_MS     20
+#define STEP_MS             10
+
+#define MAX_WRITES          256
+
+static uint32_t s_Now;                      // 任务节拍 (毫秒，不含 Flash 忙时间)
+static uint32_t s_WriteMs[MAX_WRITES];      // 每次写入记录的时刻 (System_GetTick)
+static uint32_t s_Writes, s_Erases;
+static uint32_t s_BothInOneCall;            // 同一次调用既擦除又写入
+static uint32_t s_MaxCallUs, s_MaxEraseCallUs;
+static uint32_t s_LastChangeMs;             // 最近一次交互的时刻
+static uint32_t s_MinEraseQuietMs;          // 擦页时距最近一次交互的最短时间
+
+static void _PersistStep(void)
+{
+    Host_FlashStats_t a, b;
+    KV_Stats_t ka, kb;
+    uint64_t t0 = Host_NowUs();
+    uint32_t tick = System_GetTick(), us;
+
+    Host_GetFlashStats(&a);
+    KV_GetStats(&ka);
+    Persist_Task();
+    Host_GetFlashStats(&b);
+    KV_GetStats(&kb);
+    us = (uint32_t)(Host_NowUs() - t0);
+
+    // 写入按追加的记录数计 (回收时搬运有效记录的编程不算)
+    if (kb.Writes != ka.Writes) {
+        if (s_Writes < MAX_WRITES) s_WriteMs[s_Writes] = System_GetTick();
+        s_Writes++;
+    }
+    if (b.Erases != a.Erases) {
+        s_Erases += b.Erases - a.Erases;
+        if (us > s_MaxEraseCallUs) s_MaxEraseCallUs = us;
+        if (tick - s_LastChangeMs < s_MinEraseQuietMs) s_MinEraseQuietMs = tick - s_LastChangeMs;
+        if (kb.Writes != ka.Writes) s_BothInOneCall++;
+    } else if (us > s_MaxCallUs) {
+        s_MaxCallUs = us;
+    }
+}
+
+// 按任务周期运行 ms 毫秒
+static void _Run(uint32_t ms)
+{
+    uint32_t end = s_Now + ms;
+
+    while (s_Now < end) {
+        Host_RunUntil((uint64_t)(s_Now + STEP_MS) * 1000);
+        s_Now += STEP_MS;
+        if (s_Now % PROTO_PERIOD_MS == 0) Protocol_Process();
+        if (s_Now % PERSIST_PERIOD_MS == 0) _PersistStep();
+    }
+}
+
+static void _Encoder(int16_t detents)
+{
+    Control_OnEncoder(detents, System_GetTick());
+    s_LastChangeMs = System_GetTick();
+}
+
+static void _Gesture(uint8_t gesture)
+{
+    Control_OnGesture(gesture);
+    s_LastChangeMs = System_GetTick();
+}
+
+static void _ProtoLight(uint16_t warm, uint16_t cold)
+{
+    char buf[64];
+    int n = snprintf(buf, sizeof(buf), "{\"cmd\":\"light\",\"warm\":%u,\"cold\":%u}\n", warm, cold);
+
+    Host_UartRx((const uint8_t *)buf, (uint16_t)n);
+    s_LastChangeMs = System_GetTick();
+}
+
+// 上电：空 Flash，默认状态
+static void _Boot(void)
+{
+    Host_Reset();
+    Host_FlashReset();
+    s_Now = 0;
+    SystemModel_Init();
+    USART_DMA_Init();
+    Protocol_Init();
+    Persist_Init();
+    Control_Init();
+    _Run(1000);
+}
+
+static void _ClearCounts(void)
+{
+    s_Writes = s_Erases = s_BothInOneCall = 0;
+    s_MaxCallUs = s_MaxEraseCallUs = 0;
+    s_MinEraseQuietMs = 0xFFFFFFFFu;
+}
+
+/* ============================================================
+ *                 用例
+ * ============================================================ */
+
+// 3s 内连续转动编码器：转动期间不写，停止后安静期满写入一次
+static void test_quiet_coalesce(void)
+{
+    uint8_t i;
+
+    _Boot();
+    _ClearCounts();
+    for (i = 0; i < 30; i++) {
+        _Encoder((i & 1) ? 1 : 2);
+        _Run(100);
+    }
+    TEST_EQ(s_Writes, 0);
+    _Run(10000);
+    TEST_EQ(s_Writes, 1);
+    // 判定安静期满的下一步写入：延迟在 [3000, 3000 + 2 个任务周期] 内
+    TEST_CHECK(s_WriteMs[0] >= s_LastChangeMs + QUIET_MS);
+    TEST_CHECK(s_WriteMs[0] <= s_LastChangeMs + QUIET_MS + 2 * PERSIST_PERIOD_MS);
+    printf("编码器 30 格 / 3s: 写入 %u 次，停止后 %u ms 写入\n",
+           s_Writes, s_WriteMs[0] - s_LastChangeMs);
+}
+
+// 手势调暖后又调回原值：安静期满时与 Flash 一致，不写入
+static void test_revert_cancels(void)
+{
+    int16_t saved = g_SystemModel.Light.ColorTemp;
+
+    _ClearCounts();
+    _Gesture(PAJ7620_GESTURE_LEFT);
+    _Run(1000);
+    TEST_CHECK(g_SystemModel.Light.ColorTemp != saved);
+    _Gesture(PAJ7620_GESTURE_RIGHT);
+    _Run(10000);
+    TEST_EQ(g_SystemModel.Light.ColorTemp, saved);
+    TEST_EQ(s_Writes, 0);
+}
+
+// 上位机滑条持续 75s (每 200ms 一条)：每 30s 至少落盘一次，结束后安静期满再写一次
+static void test_max_delay(void)
+{
+    uint32_t start, i;
+
+    _ClearCounts();
+    start = System_GetTick();
+    for (i = 0; i < 375; i++) {
+        _ProtoLight((uint16_t)(100 + i % 300), (uint16_t)(400 - i % 300));
+        _Run(200);
+    }
+    _Run(5000);
+
+    printf("滑条 75s 连续调节: 写入 %u 次 (t=", s_Writes);
+    for (i = 0; i < s_Writes && i < MAX_WRITES; i++) printf("%s%u", i ? "," : "", s_WriteMs[i] - start);
+    printf(" ms)\n");
+
+    TEST_EQ(s_Writes, 3);
+    TEST_CHECK(s_WriteMs[0] - start <= MAX_DELAY_MS + 2 * PERSIST_PERIOD_MS);
+    TEST_CHECK(s_WriteMs[1] - s_WriteMs[0] <= MAX_DELAY_MS + 2 * PERSIST_PERIOD_MS);
+    TEST_CHECK(s_WriteMs[2] >= s_LastChangeMs + QUIET_MS);
+    TEST_CHECK(s_WriteMs[2] <= s_LastChangeMs + QUIET_MS + 2 * PERSIST_PERIOD_MS);
+}
+
+// 重新上电后恢复最后写入的状态
+static void test_restore(void)
+{
+    int16_t bri = g_SystemModel.Light.Brightness, cct = g_SystemModel.Light.ColorTemp;
+
+    SystemModel_Init();
+    Persist_Init();
+    TEST_EQ(g_SystemModel.Light.Brightness, bri);
+    TEST_EQ(g_SystemModel.Light.ColorTemp, cct);
+}
+
+/* ============================================================
+ *                 一小时交互负载
+ * ============================================================ */
+
+static uint32_t s_Seed;
+
+static uint32_t _Rand(uint32_t n)
+{
+    s_Seed = s_Seed * 1103515245u + 12345u;
+    return (s_Seed >> 16) % n;
+}
+
+// 一次交互：编码器 1~4s、1~3 个手势或上位机滑条 2~6s，返回持续的毫秒数
+static uint32_t _Session(void)
+{
+    uint32_t t0 = s_Now, n, i;
+
+    switch (_Rand(3)) {
+        case 0:
+            n = 10 + _Rand(30);
+            for (i = 0; i < n; i++) {
+                _Encoder(_Rand(2) ? 1 : -1);
+                _Run(50 + 10 * _Rand(10));
+            }
+            break;
+        case 1:
+            n = 1 + _Rand(3);
+            for (i = 0; i < n; i++) {
+                _Gesture(_Rand(2) ? PAJ7620_GESTURE_UP : PAJ7620_GESTURE_LEFT);
+                _Run(1000);
+            }
+            break;
+        default:
+            n = 20 + _Rand(40);
+            for (i = 0; i < n; i++) {
+                _ProtoLight((uint16_t)_Rand(500), (uint16_t)_Rand(500));
+                _Run(100);
+            }
+            break;
+    }
+    return s_Now - t0;
+}
+
+// 每 1~8 分钟一次交互，连续运行 24h，按小时平均
+#define DAY_HOURS   24
+
+static void test_writes_per_hour(void)
+{
+    uint32_t end, sessions = 0, long_ms = 0, d;
+    double years;
+
+    _Boot();
+    _ClearCounts();
+    s_Seed = 38;
+    end = s_Now + DAY_HOURS * 3600000u;
+    while (s_Now < end) {
+        d = _Session();
+        sessions++;
+        if (d > MAX_DELAY_MS) long_ms += d;
+        _Run(60000 + 1000 * _Rand(420));
+    }
+
+    // 页擦写寿命按 F103 手册 10k 次，KV_PAGE_COUNT 页轮换
+    years = s_Erases ? 10000.0 * KV_PAGE_COUNT / s_Erases * DAY_HOURS / 24 / 365 : 0;
+    printf("%uh 交互负载: %u 次交互 -> 写入 %.1f 次/h，擦除 %.2f 次/h (按 24h 连续使用约 %.0f 年)\n",
+           DAY_HOURS, sessions, (double)s_Writes / DAY_HOURS, (double)s_Erases / DAY_HOURS, years);
+    printf("  单次 Persist_Task 最长: 写入/空闲 %u us，擦除 %u us (距最近交互至少 %u ms)；同一次既擦除又写入 %u 次\n",
+           s_MaxCallUs, s_MaxEraseCallUs, s_MinEraseQuietMs, s_BothInOneCall);
+
+    // 每次交互至多一次写入 (超过 30s 的交互每 30s 多一次)
+    TEST_CHECK(s_Writes >= sessions / 2);
+    TEST_CHECK(s_Writes <= sessions + long_ms / MAX_DELAY_MS);
+    TEST_CHECK(s_Erases >= 1);
+    TEST_CHECK(s_Erases <= s_Writes / 40 + 1);
+    TEST_EQ(s_BothInOneCall, 0);
+    // 写一条记录只有若干次半字编程，不含擦除的调用不超过 1ms；
+    // 擦页 (约 20ms) 单独占一步，且只发生在交互停止满安静期之后
+    TEST_CHECK(s_MaxCallUs < 1000);
+    TEST_CHECK(s_MaxEraseCallUs < 21000);
+    TEST_CHECK(s_MinEraseQuietMs >= QUIET_MS);
+}
+
+// 最坏情况：上位机滑条整小时不停 (每 100ms 一条)，写入受 30s 上限约束
+static void test_writes_per_hour_continuous(void)
+{
+    uint32_t i;
+
+    _Boot();
+    _ClearCounts();
+    for (i = 0; i < 36000; i++) {
+        _ProtoLight((uint16_t)(i % 500), (uint16_t)(500 - i % 500));
+        _Run(100);
+    }
+    printf("1h 连续滑条: 写入 %u 次/h，擦除 %u 次/h\n", s_Writes, s_Erases);
+    TEST_CHECK(s_Writes <= 3600000 / MAX_DELAY_MS + 1);
+    TEST_CHECK(s_Writes >= 3600000 / (MAX_DELAY_MS + 2 * PERSIST_PERIOD_MS) - 1);
+    TEST_EQ(s_BothInOneCall, 0);
+}
+
+int main(void)
+{
+    test_quiet_coalesce();
+    test_revert_cancels();
+    test_max_delay();
+    test_restore();
+    test_writes_per_hour();
+    test_writes_per_hour_continuous();
+    TEST_DONE();
+}
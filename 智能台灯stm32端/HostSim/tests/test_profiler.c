@@ -0,0 +1,150 @@
+/**
+  ******************************************************************************
+  * @file    test_profiler.c
+  * @brief   Profiler：最小/最大/平均/直方图统计、计数器回绕与 Prof_Format 输出
+  * @note    1. 单独编译 Profiler.c (不链接固件)，PROF_ENABLE=1；PROF_NOW 与
+  *             PROF_COUNTER_RESET 替换为函数式的模拟计数器，同时验证两个钩子
+  *             可以按函数形式覆盖
+  *          2. 探针链表为全局状态，各用例按首次记录顺序依次追加探针
+  ******************************************************************************
+  */
+#include <stdint.h>
+
+static uint32_t s_Cycles;
+static uint32_t s_CounterResets;
+
+static uint32_t Test_ProfNow(void)          { return s_Cycles; }
+static void     Test_ProfCounterReset(void) { s_Cycles = 0; s_CounterResets++; }
+
+// HostSim 强制包含的 host_cm3.h 已把两个钩子指向虚拟时钟，这里改为测试自己的计数器
+#undef  PROF_NOW
+#undef  PROF_COUNTER_RESET
+#define PROF_ENABLE             1
+#define PROF_NOW()              Test_ProfNow()
+#define PROF_COUNTER_RESET()    Test_ProfCounterReset()
+
+#include "Profiler.c"
+#include "host_test.h"
+#include <string.h>
+
+PROF_DEFINE(s_ProfA, "a");
+PROF_DEFINE(s_ProfB, "bb");
+PROF_DEFINE(s_ProfSat, "sat");
+
+// 以模拟计数器运行一段耗时为 cycles 的代码块
+static void _Run(Prof_Probe_t *probe, uint32_t cycles)
+{
+    uint32_t start = PROF_NOW();
+    s_Cycles += cycles;
+    Prof_Record(probe, PROF_NOW() - start);
+}
+
+static void _RunA(uint32_t cycles)
+{
+    PROF_BEGIN(s_ProfA);
+    s_Cycles += cycles;
+    PROF_END(s_ProfA);
+}
+
+static void test_init_resets_counter(void)
+{
+    s_Cycles = 12345;
+    Prof_Init();
+    TEST_EQ(s_CounterResets, 1);
+    TEST_EQ(s_Cycles, 0);
+}
+
+static void test_min_max_avg(void)
+{
+    char buf[160];
+
+    _RunA(100);
+    _RunA(300);
+    _RunA(200);
+    TEST_EQ(s_ProfA.Count, 3);
+    TEST_EQ(s_ProfA.MinCyc, 100);
+    TEST_EQ(s_ProfA.MaxCyc, 300);
+    TEST_EQ(s_ProfA.TotalCyc, 600);
+    TEST_CHECK(s_ProfA.Linked);
+
+    TEST_EQ(Prof_Format(0, buf, sizeof(buf), 0), strlen(buf));
+    TEST_CHECK(strcmp(buf, "{\"ev\":\"prof\",\"i\":0,\"n\":\"a\",\"c\":3,\"mn\":100,\"mx\":300,\"av\":200,"
+                           "\"h\":[2,1,0,0,0,0,0,0]}") == 0);
+}
+
+// 计数器回绕：无符号差值仍为真实耗时
+static void test_wraparound(void)
+{
+    s_Cycles = 0xFFFFFF00u;
+    _Run(&s_ProfB, 0x200);
+    TEST_EQ(s_ProfB.MinCyc, 0x200);
+    TEST_EQ(s_ProfB.MaxCyc, 0x200);
+    TEST_EQ(s_ProfB.Hist[1], 1);
+}
+
+// 4 倍分档的边界：256 << 2k 进入第 k+1 档，最后一档收容更大的值
+static void test_hist_bins(void)
+{
+    static const uint32_t edges[PROF_HIST_BINS - 1] = {
+        256, 1024, 4096, 16384, 65536, 262144, 1048576,
+    };
+    uint8_t i;
+
+    for (i = 0; i < PROF_HIST_BINS - 1; i++) {
+        TEST_EQ(_HistBin(edges[i] - 1), i);
+        TEST_EQ(_HistBin(edges[i]), i + 1);
+    }
+    TEST_EQ(_HistBin(0), 0);
+    TEST_EQ(_HistBin(0xFFFFFFFFu), PROF_HIST_BINS - 1);
+}
+
+// 各档次数饱和于 0xFFFF，总次数与总周期不饱和
+static void test_hist_saturates(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < 70000; i++) _Run(&s_ProfSat, 10);
+    TEST_EQ(s_ProfSat.Hist[0], 0xFFFF);
+    TEST_EQ(s_ProfSat.Count, 70000);
+    TEST_EQ(s_ProfSat.TotalCyc, 700000);
+}
+
+static void test_format(void)
+{
+    char buf[160];
+    uint16_t n;
+
+    // 探针按首次记录顺序编号
+    TEST_CHECK(Prof_Format(1, buf, sizeof(buf), 0) > 0);
+    TEST_CHECK(strstr(buf, "\"i\":1,\"n\":\"bb\"") != NULL);
+    TEST_CHECK(Prof_Format(2, buf, sizeof(buf), 0) > 0);
+    TEST_CHECK(strstr(buf, "\"n\":\"sat\",\"c\":70000,\"mn\":10,\"mx\":10,\"av\":10,\"h\":[65535,") != NULL);
+    TEST_EQ(Prof_Format(3, buf, sizeof(buf), 0), 0);
+
+    // 缓冲区放不下整行时不输出，也不清零
+    n = Prof_Format(0, buf, sizeof(buf), 0);
+    TEST_EQ(Prof_Format(0, buf, n, 1), 0);
+    TEST_EQ(Prof_Format(0, buf, 0, 1), 0);
+    TEST_EQ(s_ProfA.Count, 3);
+    TEST_EQ(Prof_Format(0, buf, (uint16_t)(n + 1), 1), n);
+
+    // 清零后最小值输出为 0 而不是 0xFFFFFFFF，再次记录重新统计
+    TEST_EQ(s_ProfA.Count, 0);
+    Prof_Format(0, buf, sizeof(buf), 0);
+    TEST_CHECK(strcmp(buf, "{\"ev\":\"prof\",\"i\":0,\"n\":\"a\",\"c\":0,\"mn\":0,\"mx\":0,\"av\":0,"
+                           "\"h\":[0,0,0,0,0,0,0,0]}") == 0);
+    _RunA(5000);
+    Prof_Format(0, buf, sizeof(buf), 0);
+    TEST_CHECK(strstr(buf, "\"c\":1,\"mn\":5000,\"mx\":5000,\"av\":5000,\"h\":[0,0,0,1,") != NULL);
+}
+
+int main(void)
+{
+    test_init_resets_counter();
+    test_min_max_avg();
+    test_wraparound();
+    test_hist_bins();
+    test_hist_saturates();
+    test_format();
+    TEST_DONE();
+}
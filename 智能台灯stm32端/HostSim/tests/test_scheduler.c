@@ -0,0 +1,186 @@
+/**
+  ******************************************************************************
+  * @file    test_scheduler.c
+  * @brief   协作式调度器：周期/顺序/抖动/截止/追赶/事件唤醒与长时间统计
+  * @note    任务函数用 Host_Advance 模拟运行耗时；空闲时 Sched_Run 进入
+  *          __WFI，虚拟时钟前进到下一个节拍，因此循环按虚拟时间结束
+  ******************************************************************************
+  */
+#include "host_port.h"
+#include "host_test.h"
+#include "Scheduler.h"
+#include "SystemSupport.h"
+#include <stdint.h>
+#include <string.h>
+
+#define LOG_MAX     64
+
+static char     s_Log[LOG_MAX];     // 运行顺序 (任务名首字母)
+static uint8_t  s_LogLen;
+static uint32_t s_StartMs[LOG_MAX]; // 任务 A 每次开始运行的时刻
+static uint8_t  s_StartLen;
+
+static void _Log(char c)
+{
+    if (s_LogLen < LOG_MAX - 1) s_Log[s_LogLen++] = c;
+}
+
+static void _TaskA(void)
+{
+    if (s_StartLen < LOG_MAX) s_StartMs[s_StartLen++] = System_GetTick();
+    _Log('A');
+    Host_Advance(200);
+}
+static void _TaskB(void) { _Log('B'); Host_Advance(100); }
+static void _TaskE(void) { _Log('E'); }
+static void _TaskHeavy(void) { Host_Advance(7000); }
+static void _TaskStall(void) { Host_Advance(35000); }
+static void _TaskLong(void) { Host_Advance(900000); }
+
+static void _RunUntilMs(uint32_t ms)
+{
+    while (Host_NowUs() < (uint64_t)ms * 1000) Sched_Run();
+}
+
+static void _Reset(void)
+{
+    Host_Reset();
+    Host_SetIdleHook(NULL);
+    Sched_Init();
+    s_LogLen = 0;
+    s_StartLen = 0;
+}
+
+/* --- 1. 周期、注册顺序、无漂移 --- */
+static void _TestPeriodic(void)
+{
+    static Sched_Task_t a, b;
+    uint8_t i;
+
+    _Reset();
+    a = (Sched_Task_t)SCHED_TASK("a", _TaskA, 10, 0);
+    b = (Sched_Task_t)SCHED_TASK("b", _TaskB, 25, 0);
+    Sched_Register(&a);
+    Sched_Register(&b);
+    _RunUntilMs(1000);
+
+    TEST_EQ(a.RunCount, 99);            // 10, 20 ... 990
+    TEST_EQ(b.RunCount, 39);
+    TEST_EQ(a.TotalUs, 99 * 200);
+    TEST_EQ(a.MaxRunUs, 200);
+    // 10A 20A 25B 30A 40A 50AB：t=50ms 两者同时到期，先注册的 A 先运行
+    TEST_CHECK(strncmp(s_Log, "AABAAAB", 7) == 0);
+    // B 占用 0.1ms 不会推迟 A 的释放时刻 (固定节拍)
+    for (i = 0; i < s_StartLen; i++) TEST_EQ(s_StartMs[i], 10u * (i + 1));
+    TEST_EQ(a.MaxLateMs, 0);
+}
+
+/* --- 2. 长任务造成的抖动与截止时间 --- */
+static void _TestJitter(void)
+{
+    static Sched_Task_t heavy, light;
+
+    _Reset();
+    heavy = (Sched_Task_t)SCHED_TASK("heavy", _TaskHeavy, 100, 0);
+    light = (Sched_Task_t)SCHED_TASK("light", _TaskB, 10, 5);
+    Sched_Register(&heavy);
+    Sched_Register(&light);
+    _RunUntilMs(1005);
+
+    // 每 100ms 一次，heavy 运行 7ms 期间 light 的释放被推迟
+    printf("抖动: light 最大延迟 %u ms, 错过截止 %u 次 / %u 次运行\n",
+           light.MaxLateMs, light.DeadlineMiss, light.RunCount);
+    TEST_EQ(light.MaxLateMs, 7);
+    TEST_EQ(light.DeadlineMiss, 10);
+    TEST_EQ(heavy.MaxRunUs, 7000);
+}
+
+/* --- 3. 落后超过一个周期时对齐到当前，不补跑 --- */
+static void _TestCatchUp(void)
+{
+    static Sched_Task_t stall, a;
+
+    _Reset();
+    stall = (Sched_Task_t)SCHED_TASK("stall", _TaskStall, 100, 0);
+    a = (Sched_Task_t)SCHED_TASK("a", _TaskA, 10, 0);
+    Sched_Register(&stall);
+    Sched_Register(&a);
+    _RunUntilMs(160);
+
+    // A: 10..90 正常 9 次；100ms 被 stall 占到 135ms，只在 135 补一次，之后 145、155
+    TEST_EQ(a.RunCount, 12);
+    TEST_EQ(s_StartMs[9], 135);
+    TEST_EQ(s_StartMs[10], 145);
+    TEST_EQ(s_StartMs[11], 155);
+    TEST_EQ(a.MaxLateMs, 35);
+}
+
+/* --- 4. 事件任务：中断中 Sched_Signal 把调度器从 WFI 唤醒 --- */
+static Sched_Task_t s_Event;
+static uint32_t s_SignalAtUs;
+static uint32_t s_Idles;
+
+static void _IdleWithIrq(void)
+{
+    uint64_t now = Host_NowUs();
+
+    s_Idles++;
+    // 中断在 12.3ms 到达 (两节拍之间)
+    if (s_SignalAtUs && now < 12300 && now + 1000 > 12300) {
+        Host_RunUntil(12300);
+        Sched_Signal(&s_Event);
+        s_SignalAtUs = 0;
+        return;
+    }
+    Host_Idle();
+}
+
+static void _TestEvent(void)
+{
+    _Reset();
+    s_Event = (Sched_Task_t)SCHED_TASK("evt", _TaskE, 0, 0);
+    Sched_Register(&s_Event);
+    s_SignalAtUs = 12300;
+    s_Idles = 0;
+    Host_SetIdleHook(_IdleWithIrq);
+
+    _RunUntilMs(12);
+    TEST_EQ(s_Event.RunCount, 0);
+    Sched_Run();            // 休眠中被中断唤醒
+    TEST_EQ(Host_NowUs(), 12300);
+    Sched_Run();            // 下一轮立即运行事件任务
+    TEST_EQ(s_Event.RunCount, 1);
+    TEST_EQ(Host_NowUs(), 12300);
+    _RunUntilMs(100);
+    TEST_EQ(s_Event.RunCount, 1);
+    // 无任务可做时每个节拍休眠一次
+    TEST_CHECK(s_Idles >= 99 && s_Idles <= 101);
+    Host_SetIdleHook(NULL);
+}
+
+/* --- 5. 关闭周期打印时的长时间统计 (不会在 71 分钟处回绕) --- */
+static void _TestLongRun(void)
+{
+    static Sched_Task_t lng;
+
+    _Reset();
+    lng = (Sched_Task_t)SCHED_TASK("long", _TaskLong, 1000, 0);
+    Sched_Register(&lng);
+    _RunUntilMs(80u * 60u * 1000u);
+
+    printf("80 分钟: %u 次运行, 累计 %llu us\n", lng.RunCount, (unsigned long long)lng.TotalUs);
+    TEST_EQ(lng.RunCount, 4799);
+    TEST_EQ(lng.TotalUs, 4799ULL * 900000ULL);
+    TEST_CHECK(lng.TotalUs > UINT32_MAX);
+}
+
+int main(void)
+{
+    _TestPeriodic();
+    _TestJitter();
+    _TestCatchUp();
+    _TestEvent();
+    _TestLongRun();
+
+    TEST_DONE();
+}
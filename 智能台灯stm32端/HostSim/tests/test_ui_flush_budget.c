@@ -0,0 +1,90 @@
+/**
+  ******************************************************************************
+  * @file    test_ui_flush_budget.c
+  * @brief   分片刷新的单次调用阻塞时间 (最坏重绘：整屏清除 + 全部控件每帧变化)
+  * @note    软件 I2C 期间 CPU 忙等，阻塞时间即调用前后的虚拟时间差；
+  *          每次 UIManager_Task / UIManager_Flush 不应超过
+  *          UI_FLUSH_BYTE_BUDGET x HOST_I2C_US_PER_BYTE；
+  *          预算小于单段开销时 OLED_RefreshStep 仍须每次推进，最终刷完整屏
+  ******************************************************************************
+  */
+#include "host_port.h"
+#include "host_test.h"
+#include "OLED.h"
+#include "UIManager.h"
+#include "SystemModel.h"
+#include "Config.h"
+
+#define FRAMES      200
+
+static uint64_t s_MaxTaskUs, s_MaxFlushUs;
+static uint32_t s_Calls;
+
+static void _Call(void (*fn)(void), uint64_t *max_us)
+{
+    uint64_t t0 = Host_NowUs(), dt;
+
+    fn();
+    dt = Host_NowUs() - t0;
+    if (dt > *max_us) *max_us = dt;
+    s_Calls++;
+}
+
+int main(void)
+{
+    uint64_t t0, full_us;
+    uint32_t frame, step;
+    uint16_t budget;
+    const uint32_t limit_us = UI_FLUSH_BYTE_BUDGET * HOST_I2C_US_PER_BYTE;
+
+    Host_Reset();
+    Host_OledAttach();
+
+    // 对照：整屏清除后一次性阻塞刷新
+    UIManager_Init();
+    t0 = Host_NowUs();
+    OLED_Refresh();
+    full_us = Host_NowUs() - t0;
+
+    // 分片：与调度器相同，UI 任务 100ms、刷新任务 5ms (每个 UI 周期 20 次刷新)
+    UIManager_Init();
+    for (frame = 0; frame < FRAMES; frame++) {
+        // 最坏情况：所有绑定值每帧都变化，每 10 帧再整屏清除一次
+        g_SystemModel.Light.Brightness = (int16_t)((frame * 137) % 1001);
+        g_SystemModel.Light.ColorTemp = (int16_t)((frame * 251) % 1001);
+        g_SystemModel.Light.Focus = (frame & 1) ? FOCUS_COLOR_TEMP : FOCUS_BRIGHTNESS;
+        g_SystemModel.Light.AutoMode = (frame & 2) ? 1 : 0;
+        g_SystemModel.Sensor.Temperature = (frame % 7 == 0) ? -99.0f : (float)(frame % 40);
+        g_SystemModel.Sensor.Humidity = (float)(frame % 100);
+        g_SystemModel.Sensor.Lux = (float)((frame * 37) % 1000);
+        if (frame % 10 == 0) {
+            OLED_Clear();
+            UIManager_Init();
+        }
+
+        _Call(UIManager_Task, &s_MaxTaskUs);
+        for (step = 0; step < 20; step++) _Call(UIManager_Flush, &s_MaxFlushUs);
+    }
+
+    printf("整屏阻塞刷新      %6llu us\n", (unsigned long long)full_us);
+    printf("分片 (预算 %u B)  UIManager_Task 最大 %llu us, UIManager_Flush 最大 %llu us (%u 次调用)\n",
+           UI_FLUSH_BYTE_BUDGET, (unsigned long long)s_MaxTaskUs,
+           (unsigned long long)s_MaxFlushUs, s_Calls);
+    printf("上限 %u us\n", limit_us);
+
+    TEST_CHECK(s_MaxTaskUs <= limit_us);
+    TEST_CHECK(s_MaxFlushUs <= limit_us);
+    TEST_CHECK(s_MaxFlushUs > 0);
+    TEST_CHECK(full_us > 10 * limit_us);
+
+    // 过小的预算 (含 0)：每次至少发送 1 字节显存，整屏 1024 字节必能刷完
+    for (budget = 0; budget <= 8; budget += 4) {
+        OLED_Clear();
+        for (step = 0; step < 2048 && !OLED_RefreshStep(budget); step++) {}
+        printf("预算 %u B: %u 次调用刷完整屏\n", budget, step + 1);
+        TEST_CHECK(step < 2048);
+        TEST_EQ(OLED_IsRefreshPending(), 0);
+    }
+
+    TEST_DONE();
+}
@@ -0,0 +1,178 @@
+/**
+  ******************************************************************************
+  * @file    test_ui_render.c
+  * @brief   主页渲染的像素等价性与每帧 I2C 字节数 (显存 + 脏区间刷新 + 控件)
+  * @note    1. 基线为 V6.3 的画法：sprintf 整行后逐字形写屏，每个字形
+  *             2 x (3 条定位命令) + 16 次单字节数据传输，在测试中原样复现
+  *          2. 两种画法分别写入 SSD1306 模型，比较 GDDRAM；行 2/3 第 15~16 列
+  *             的亮度/色温进度条为控件化后新增内容，不参与比较
+  *          3. 各场景的画面输出为 ui_home_<n>.pbm (构建目录)
+  *          4. 超出字段宽度的数值 (湿度 100、负零) 按饱和后的文本比较
+  ******************************************************************************
+  */
+#include "host_port.h"
+#include "host_test.h"
+#include "I2C_Driver.h"
+#include "OLED.h"
+#include "UIManager.h"
+#include "SystemModel.h"
+#include <stdio.h>
+#include <string.h>
+
+extern const uint8_t OLED_F8x16[][16];
+
+static Host_I2CDev_t *s_Oled;
+
+/* --- V6.3 写屏方式 --- */
+static void _V63Command(uint8_t cmd)
+{
+    uint8_t data[2] = { 0x00, cmd };
+    I2C_Lib_WriteDirect(I2C1, 0x78, data, 2);
+}
+
+static void _V63Data(uint8_t byte)
+{
+    uint8_t data[2] = { 0x40, byte };
+    I2C_Lib_WriteDirect(I2C1, 0x78, data, 2);
+}
+
+static void _V63SetCursor(uint8_t y, uint8_t x)
+{
+    _V63Command(0xB0 | y);
+    _V63Command(0x10 | ((x & 0xF0) >> 4));
+    _V63Command(0x00 | (x & 0x0F));
+}
+
+static void _V63ShowString(uint8_t line, uint8_t col, const char *str)
+{
+    uint8_t i, c;
+
+    for (c = col; *str; str++, c++) {
+        if (c > 16) continue;   // 第 17 列起超出屏幕 (模型按页内回绕，与实屏一致地丢弃)
+        _V63SetCursor((line - 1) * 2, (c - 1) * 8);
+        for (i = 0; i < 8; i++) _V63Data(OLED_F8x16[*str - ' '][i]);
+        _V63SetCursor((line - 1) * 2 + 1, (c - 1) * 8);
+        for (i = 0; i < 8; i++) _V63Data(OLED_F8x16[*str - ' '][i + 8]);
+    }
+}
+
+// V6.3 UI_Draw_Home_Page 的三行文本
+static void _V63Lines(char *l2, char *l3, char *l4)
+{
+    SystemModel_t *m = &g_SystemModel;
+
+    sprintf(l2, "Bri: %-4d  %s", m->Light.Brightness, m->Light.Focus == FOCUS_BRIGHTNESS ? "[F]" : "   ");
+    sprintf(l3, "CCT: %-4d  %s", m->Light.ColorTemp, m->Light.Focus == FOCUS_COLOR_TEMP ? "[F]" : "   ");
+    if (m->Sensor.Temperature <= -90.0f) {
+        strcpy(l4, "Sensor Error!   ");
+    } else {
+        int lux = (int)(m->Sensor.Lux / 10.0f);
+        if (lux > 100) lux = 100;
+        sprintf(l4, "%2.0fC %2.0f%% L:%3d%%", m->Sensor.Temperature, m->Sensor.Humidity, lux);
+    }
+}
+
+/* --- 当前画法 --- */
+static void _Settle(void)
+{
+    uint8_t k;
+
+    for (k = 0; k < 3; k++) {
+        UIManager_Task();
+        while (OLED_IsRefreshPending()) UIManager_Flush();
+    }
+}
+
+static uint8_t _Masked(uint8_t page, uint8_t x)
+{
+    return (page >= 2 && page <= 5 && x >= 112);
+}
+
+static void _SetModel(int16_t bri, int16_t cct, uint8_t focus, float t, float h, float lux)
+{
+    g_SystemModel.Light.Brightness = bri;
+    g_SystemModel.Light.ColorTemp = cct;
+    g_SystemModel.Light.Focus = focus;
+    g_SystemModel.Light.AutoMode = 0;
+    g_SystemModel.Sensor.Temperature = t;
+    g_SystemModel.Sensor.Humidity = h;
+    g_SystemModel.Sensor.Lux = lux;
+}
+
+// l4_fixed 非空时行 4 按该文本作为期望 (V6.3 在超宽数值上的显示有意不保留)
+static void _CheckScene(uint8_t n, const char *l4_fixed)
+{
+    uint8_t ref[8 * 128], page, x;
+    char l2[32], l3[32], l4[32], path[32];
+    uint32_t diff = 0;
+
+    // 基线
+    Host_OledAttach();
+    _V63ShowString(1, 1, "--- SMART LAMP ---");
+    _V63Lines(l2, l3, l4);
+    if (l4_fixed) snprintf(l4, sizeof(l4), "%s", l4_fixed);
+    _V63ShowString(2, 1, l2);
+    _V63ShowString(3, 1, l3);
+    _V63ShowString(4, 1, l4);
+    memcpy(ref, Host_OledGddram(), sizeof(ref));
+
+    // 当前
+    Host_OledAttach();
+    UIManager_Init();
+    _Settle();
+    for (page = 0; page < 8; page++) {
+        for (x = 0; x < 128; x++) {
+            if (!_Masked(page, x) && ref[page * 128 + x] != Host_OledGddram()[page * 128 + x]) diff++;
+        }
+    }
+    printf("场景 %u: \"%s\" / \"%s\" / \"%s\"  差异列 %u\n", n, l2, l3, l4, diff);
+    TEST_EQ(diff, 0);
+    snprintf(path, sizeof(path), "ui_home_%u.pbm", n);
+    Host_OledWritePbm(path);
+}
+
+// 一次模型变化在两种画法下的 I2C 字节数
+static void _Bytes(const char *what, uint32_t v63_glyphs)
+{
+    uint32_t before = s_Oled->Bytes;
+
+    _Settle();
+    printf("%-20s 当前 %5u B   V6.3 %5u B (%u 个字形)\n", what, s_Oled->Bytes - before,
+           v63_glyphs * 66, v63_glyphs);
+}
+
+int main(void)
+{
+    Host_Reset();
+    s_Oled = Host_OledAttach();
+
+    // 像素等价
+    _SetModel(500, 300, FOCUS_BRIGHTNESS, 25.6f, 60.0f, 455.0f);
+    _CheckScene(1, NULL);
+    _SetModel(1000, 0, FOCUS_COLOR_TEMP, 9.0f, 5.0f, 1000.0f);
+    _CheckScene(2, NULL);
+    // V6.3 显示为 "-0C 100% L:  0%" (负零、湿度挤占后面的列)，现饱和为两位
+    _SetModel(5, 995, FOCUS_BRIGHTNESS, -0.4f, 99.5f, 0.0f);
+    _CheckScene(3, " 0C 99% L:  0%");
+    _SetModel(500, 300, FOCUS_BRIGHTNESS, -99.0f, 0.0f, 0.0f);
+    _CheckScene(4, NULL);
+
+    // 每帧字节数 (V6.3 每次变化重画整行 14 个字形，标题在初始化时画一次)
+    printf("\n");
+    Host_OledAttach();
+    _SetModel(500, 300, FOCUS_BRIGHTNESS, 25.0f, 60.0f, 450.0f);
+    UIManager_Init();
+    _Bytes("上电首帧", 16 + 14 * 3);
+    _Bytes("无变化", 0);
+    TEST_EQ(OLED_IsRefreshPending(), 0);
+    g_SystemModel.Light.Brightness = 510;
+    _Bytes("亮度 500 -> 510", 14);
+    g_SystemModel.Light.Focus = FOCUS_COLOR_TEMP;
+    _Bytes("焦点切换", 28);
+    g_SystemModel.Sensor.Temperature = 26.0f;
+    _Bytes("温度 25 -> 26", 14);
+    g_SystemModel.Sensor.Temperature = -99.0f;
+    _Bytes("传感器故障", 16);
+
+    TEST_DONE();
+}
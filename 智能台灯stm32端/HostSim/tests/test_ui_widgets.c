@@ -0,0 +1,190 @@
+/**
+  ******************************************************************************
+  * @file    test_ui_widgets.c
+  * @brief   控件格式化 (饱和、四舍五入、故障行) 与旋钮连转时的写屏量
+  * @note    1. 链接时包装 OLED_ShowString / OLED_ShowBar，记录控件写入的文本
+  *             与字形数，再交给原函数写显存
+  *          2. 旋钮连转：每 20ms 调一次亮度，UI 任务 100ms、刷新任务 5ms，
+  *             共 10s；V6.3 每次变化整行重画 14 个字形，每个字形 66B
+  ******************************************************************************
+  */
+#include "host_port.h"
+#include "host_test.h"
+#include "OLED.h"
+#include "UIWidget.h"
+#include "UIManager.h"
+#include "SystemModel.h"
+#include <string.h>
+
+#define V63_GLYPHS_PER_CHANGE   14
+#define V63_BYTES_PER_GLYPH     66
+
+/* --- 包装：记录文本 --- */
+void __real_OLED_ShowString(uint8_t Line, uint8_t Column, char *String);
+void __real_OLED_ShowBar(uint8_t Line, uint8_t Column, uint8_t Width, uint8_t Fill);
+
+static char     s_Text[4][17];      // 控件写过的字符，按行列记录
+static uint32_t s_Glyphs = 0;
+
+void __wrap_OLED_ShowString(uint8_t Line, uint8_t Column, char *String)
+{
+    uint8_t c = Column;
+    const char *p;
+
+    for (p = String; *p && c <= 16; p++, c++) {
+        s_Text[Line - 1][c - 1] = *p;
+        s_Glyphs++;
+    }
+    __real_OLED_ShowString(Line, Column, String);
+}
+
+void __wrap_OLED_ShowBar(uint8_t Line, uint8_t Column, uint8_t Width, uint8_t Fill)
+{
+    s_Glyphs += Width;
+    __real_OLED_ShowBar(Line, Column, Width, Fill);
+}
+
+static void _ClearText(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < 4; i++) {
+        memset(s_Text[i], ' ', 16);
+        s_Text[i][16] = '\0';
+    }
+}
+
+/* --- 单个数值控件的格式化 --- */
+static int32_t s_Val;
+static int32_t _GetVal(void) { return s_Val; }
+
+static UIWidget_t s_Right2[] = { UI_VALUE(1, 1, 2, UI_ALIGN_RIGHT, _GetVal) };
+static UIWidget_t s_Left4[]  = { UI_VALUE(1, 1, 4, UI_ALIGN_LEFT, _GetVal) };
+
+static void _CheckFormat(UIWidget_t *w, int32_t val, const char *expect)
+{
+    s_Val = val;
+    _ClearText();
+    UIWidget_Invalidate(w, 1);
+    UIWidget_Update(w, 1);
+    if (strncmp(s_Text[0], expect, strlen(expect)) != 0) {
+        fprintf(stderr, "值 %ld 显示为 \"%.*s\"，期望 \"%s\"\n",
+                (long)val, (int)strlen(expect), s_Text[0], expect);
+        s_TestFailures++;
+    }
+}
+
+static void _TestFormat(void)
+{
+    _CheckFormat(s_Right2, 0,      " 0");
+    _CheckFormat(s_Right2, 7,      " 7");
+    _CheckFormat(s_Right2, 99,     "99");
+    _CheckFormat(s_Right2, 100,    "99");
+    _CheckFormat(s_Right2, -5,     "-5");
+    _CheckFormat(s_Right2, -10,    "-9");
+    _CheckFormat(s_Right2, -2147483647, "-9");
+    _CheckFormat(s_Right2, UI_VALUE_INVALID, "--");
+    _CheckFormat(s_Left4,  500,    "500 ");
+    _CheckFormat(s_Left4,  12345,  "9999");
+    _CheckFormat(s_Left4,  -1234,  "-999");
+    _CheckFormat(s_Left4,  2147483647, "9999");
+}
+
+/* --- 主页行 4：四舍五入与故障提示 --- */
+static void _Frame(void)
+{
+    while (OLED_IsRefreshPending()) UIManager_Flush();
+    UIManager_Task();
+    while (OLED_IsRefreshPending()) UIManager_Flush();
+}
+
+static void _CheckLine4(const char *expect)
+{
+    _Frame();
+    if (strcmp(s_Text[3], expect) != 0) {
+        fprintf(stderr, "行 4 \"%s\"，期望 \"%s\"\n", s_Text[3], expect);
+        s_TestFailures++;
+    }
+}
+
+static void _TestEnvRow(void)
+{
+    g_SystemModel.Light.AutoMode = 0;
+    g_SystemModel.Sensor.Lux = 450.0f;
+    g_SystemModel.Sensor.Temperature = 25.6f;
+    g_SystemModel.Sensor.Humidity = 59.5f;
+    _ClearText();
+    UIManager_Init();
+    _CheckLine4("26C 60% L: 45%  ");
+
+    g_SystemModel.Sensor.Temperature = -0.4f;
+    g_SystemModel.Sensor.Humidity = 100.0f;
+    _CheckLine4(" 0C 99% L: 45%  ");
+
+    g_SystemModel.Sensor.Temperature = -12.0f;
+    g_SystemModel.Light.AutoMode = 1;
+    _CheckLine4("-9C 99% L: 45% A");
+
+    g_SystemModel.Sensor.Temperature = -99.0f;
+    _CheckLine4("Sensor Error!   ");
+
+    g_SystemModel.Sensor.Temperature = 24.4f;
+    g_SystemModel.Sensor.Humidity = 40.0f;
+    _CheckLine4("24C 40% L: 45% A");
+}
+
+/* --- 旋钮连转 --- */
+static void _TestEncoderSpin(void)
+{
+    Host_I2CDev_t *oled = Host_OledAttach();
+    uint64_t t0, t;
+    uint32_t changes = 0, glyphs, bytes, v63_bytes;
+    int16_t bri = 0, dir = 10;
+
+    g_SystemModel.Sensor.Temperature = 25.0f;
+    g_SystemModel.Sensor.Humidity = 50.0f;
+    g_SystemModel.Light.Focus = FOCUS_BRIGHTNESS;
+    UIManager_Init();
+    _Frame();
+
+    s_Glyphs = 0;
+    Host_I2CClearStats();
+    t0 = Host_NowUs();
+    for (t = 0; t < 10000000ULL; t += 5000) {
+        Host_RunUntil(t0 + t);
+        if (t % 20000 == 0) {
+            bri += dir;
+            if (bri >= 1000 || bri <= 0) dir = -dir;
+            g_SystemModel.Light.Brightness = bri;
+        }
+        if (t % 100000 == 0) {
+            UIManager_Task();
+            changes++;
+        }
+        UIManager_Flush();
+    }
+    glyphs = s_Glyphs;
+    bytes = oled->Bytes;
+    v63_bytes = changes * V63_GLYPHS_PER_CHANGE * V63_BYTES_PER_GLYPH;
+
+    printf("旋钮连转 10s: %u 次 UI 更新, 字形 %u (%u/s), I2C %u B (%u B/s)\n",
+           changes, glyphs, glyphs / 10, bytes, bytes / 10);
+    printf("V6.3 估算: 字形 %u/s, I2C %u B/s\n",
+           changes * V63_GLYPHS_PER_CHANGE / 10, v63_bytes / 10);
+
+    // 每次只改动亮度数值 (4 字) 与进度条 (2 字)
+    TEST_CHECK(glyphs <= changes * 6);
+    TEST_CHECK(bytes * 4 < v63_bytes);
+}
+
+int main(void)
+{
+    Host_Reset();
+    Host_OledAttach();
+
+    _TestFormat();
+    _TestEnvRow();
+    _TestEncoderSpin();
+
+    TEST_DONE();
+}
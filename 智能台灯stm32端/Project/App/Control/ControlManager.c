@@ -2,17 +2,25 @@
 /**
   ******************************************************************************
   * @file    ControlManager.c
-  * @brief   业务逻辑控制器 (V13.1 Proximity Sync Fix)
-  * @note    修复无极调光结束后状态不同步的问题
+  * @brief   业务逻辑控制器 (V13.2 Ambient Auto-Dim)
+  * @note    V13.1 修复无极调光结束后状态不同步的问题
+  *          V13.2 新增环境光闭环自动调光：四连击 / 顺时针手势 / "auto" 指令切换，
+  *                自动模式下编码器与上下手势调整的是目标照度而非亮度
+  *          V13.3 编码器步长随转速自适应，亮度/色温各自一条加速曲线
+  *          V13.4 调试输出改用 DLOG 二进制日志，不再占用协议串口
   ******************************************************************************
   */
 #include "ControlManager.h"
 #include "LightCtrl.h"
 #include "Protocol.h"
-#include "USART_DMA.h"
+#include "DLog.h"
 #include "SystemModel.h"
 #include "PAJ7620.h"
 #include "SystemSupport.h"
+#include "SensorHub.h"
+#include "AutoDim.h"
+#include "EncoderAccel.h"
+#include "Config.h"
 #include <string.h>
 #include <stdlib.h> // for abs()
 
@@ -34,23 +42,64 @@ static uint8_t  s_ProxLocked = 0;
 static uint8_t  s_ProxLastStableVal = 0;
 static uint32_t s_ProxStableTick = 0;
 
+// --- 编码器加速曲线 (按焦点区分) ---
+static const EncAccel_Profile_t s_EncProfileBri = {
+    ENCODER_BRI_MIN_STEP, ENCODER_BRI_MAX_STEP, ENCODER_SLOW_RATE, ENCODER_FAST_RATE
+};
+static const EncAccel_Profile_t s_EncProfileCCT = {
+    ENCODER_CCT_MIN_STEP, ENCODER_CCT_MAX_STEP, ENCODER_SLOW_RATE, ENCODER_FAST_RATE
+};
+static EncAccel_t s_EncAccel;
+
+// --- 自动调光 ---
+static AutoDim_t s_AutoDim;
+static uint32_t  s_AutoTick = 0;
+
+static void Control_SetAutoMode(uint8_t enable) {
+    if (enable && !g_SystemModel.Light.AutoMode) {
+        // 以当前亮度为起点，保证切入时无跳变
+        AutoDim_Init(&s_AutoDim, g_SystemModel.Light.Brightness);
+        s_AutoTick = System_GetTick();
+    }
+    g_SystemModel.Light.AutoMode = enable;
+    DLOG(CTRL_AUTO_DIM, "[Ctrl] Auto Dim -> %s (target %d)",
+         enable ? "ON" : "OFF", g_SystemModel.Light.AutoTarget);
+}
+
+static void _AdjustAutoTarget(int16_t delta) {
+    int16_t target = g_SystemModel.Light.AutoTarget + delta;
+    if (target < 0) target = 0;
+    if (target > 1000) target = 1000;
+    g_SystemModel.Light.AutoTarget = target;
+}
+
+// 手动设置亮度会打断自动模式
+static void _ExitAutoOnManual(void) {
+    if (g_SystemModel.Light.AutoMode) Control_SetAutoMode(0);
+}
+
 // --- 内部回调 ---
 static void _OnProto_Mode(uint8_t mode) {
-    s_Mode = (mode == 0) ? CTRL_MODE_LOCAL : CTRL_MODE_REMOTE_UI;
-    USART_DMA_Printf("[Ctrl] Mode -> %s\r\n", s_Mode == CTRL_MODE_LOCAL ? "LOCAL" : "UI");
+    Control_SetMode(mode);
 }
 
 static void _OnProto_Light(uint16_t warm, uint16_t cold) {
+    _ExitAutoOnManual();
     LightCtrl_SetRawPWM(warm, cold);
 }
 
+static void _OnProto_Auto(uint8_t enable, int16_t target) {
+    if (target >= 0) _AdjustAutoTarget(target - g_SystemModel.Light.AutoTarget);
+    Control_SetAutoMode(enable);
+}
+
 static void Control_ToggleMode(void) {
     if (s_Mode == CTRL_MODE_LOCAL) {
         s_Mode = CTRL_MODE_REMOTE_UI;
     } else {
         s_Mode = CTRL_MODE_LOCAL;
     }
-    USART_DMA_Printf("[Ctrl] Toggle Mode -> %s\r\n", s_Mode == CTRL_MODE_LOCAL ? "LOCAL" : "UI");
+    DLOG(CTRL_TOGGLE_MODE, "[Ctrl] Toggle Mode -> %s", s_Mode == CTRL_MODE_LOCAL ? "LOCAL" : "UI");
 }
 
 // --- 初始化 ---
@@ -58,24 +107,29 @@ void Control_Init(void) {
     LightCtrl_Init();
     Protocol_SetModeCallback(_OnProto_Mode);
     Protocol_SetLightCallback(_OnProto_Light);
+    Protocol_SetAutoCallback(_OnProto_Auto);
+    EncAccel_Reset(&s_EncAccel);
 }
 
 // --- 事件处理 ---
 
-void Control_OnEncoder(int16_t diff) {
+void Control_OnEncoder(int16_t detents, uint32_t timestamp) {
+    // 长按期间临时调色温，与焦点为色温时使用同一条曲线
+    uint8_t adjust_cct = s_IsLongPressing || (g_SystemModel.Light.Focus == FOCUS_COLOR_TEMP);
+    int16_t diff = EncAccel_Apply(&s_EncAccel, adjust_cct ? &s_EncProfileCCT : &s_EncProfileBri,
+                                  detents, timestamp);
+
     if(s_Mode == CTRL_MODE_REMOTE_UI){
         Protocol_Report_Encoder(diff);
     }
     
     if (s_Mode == CTRL_MODE_LOCAL) {
-        if (s_IsLongPressing) {
+        if (adjust_cct) {
             LightCtrl_AdjustColorTemp(diff);
+        } else if (g_SystemModel.Light.AutoMode) {
+            _AdjustAutoTarget(diff);
         } else {
-            if (g_SystemModel.Light.Focus == FOCUS_BRIGHTNESS) {
-                LightCtrl_AdjustBrightness(diff);
-            } else {
-                LightCtrl_AdjustColorTemp(diff);
-            }
+            LightCtrl_AdjustBrightness(diff);
         }
     }
 }
@@ -87,29 +141,33 @@ void Control_OnKey(const char* key_name, const char* action) {
     {
         if (strcmp(action, "hold") == 0) {
             s_IsLongPressing = 1;
-            USART_DMA_Printf("[Ctrl] Long Press START (ColorTemp Mode)\r\n");
+            DLOG(CTRL_LONG_PRESS_START, "[Ctrl] Long Press START (ColorTemp Mode)");
         }
         else if (strcmp(action, "release") == 0) {
             s_IsLongPressing = 0;
             g_SystemModel.Light.Focus = FOCUS_BRIGHTNESS;
-            USART_DMA_Printf("[Ctrl] Long Press END\r\n");
+            DLOG(CTRL_LONG_PRESS_END, "[Ctrl] Long Press END");
         }
         else if (strcmp(action, "triple") == 0) {
             Control_ToggleMode();
         }
+        else if (strcmp(action, "quad") == 0) {
+            Control_SetAutoMode(!g_SystemModel.Light.AutoMode);
+        }
         else if (strcmp(action, "click") == 0) {
             if (g_SystemModel.Light.Focus == FOCUS_BRIGHTNESS) {
                 g_SystemModel.Light.Focus = FOCUS_COLOR_TEMP;
-                USART_DMA_Printf("[Ctrl] Focus -> CCT\r\n");
+                DLOG(CTRL_FOCUS_CCT, "[Ctrl] Focus -> CCT");
             } else {
                 g_SystemModel.Light.Focus = FOCUS_BRIGHTNESS;
-                USART_DMA_Printf("[Ctrl] Focus -> Bri\r\n");
+                DLOG(CTRL_FOCUS_BRI, "[Ctrl] Focus -> Bri");
             }
         }
         else if (strcmp(action, "double") == 0) {
             if (s_Mode == CTRL_MODE_LOCAL) {
+                _ExitAutoOnManual();
                 LightCtrl_SetRawPWM(250, 250); 
-                USART_DMA_Printf("[Ctrl] Reset (Double Click)\r\n");
+                DLOG(CTRL_RESET, "[Ctrl] Reset (Double Click)");
             }
         }
     }
@@ -121,10 +179,12 @@ void Control_OnGesture(uint8_t gesture) {
     if (s_Mode == CTRL_MODE_LOCAL) {
         switch(gesture) {
             case PAJ7620_GESTURE_UP:
-                LightCtrl_AdjustBrightness(200);
+                if (g_SystemModel.Light.AutoMode) _AdjustAutoTarget(100);
+                else LightCtrl_AdjustBrightness(200);
                 break;
             case PAJ7620_GESTURE_DOWN:
-                LightCtrl_AdjustBrightness(-200);
+                if (g_SystemModel.Light.AutoMode) _AdjustAutoTarget(-100);
+                else LightCtrl_AdjustBrightness(-200);
                 break;
             case PAJ7620_GESTURE_LEFT:
                 LightCtrl_AdjustColorTemp(200);
@@ -132,15 +192,20 @@ void Control_OnGesture(uint8_t gesture) {
             case PAJ7620_GESTURE_RIGHT:
                 LightCtrl_AdjustColorTemp(-200);
                 break;
+            case PAJ7620_GESTURE_CLOCKWISE:
+                Control_SetAutoMode(!g_SystemModel.Light.AutoMode);
+                break;
             case PAJ7620_GESTURE_FORWARD:
+                _ExitAutoOnManual();
                 s_ProxLocked = 0;
                 s_ProxLastStableVal = 0;
                 s_ProxStableTick = System_GetTick();
-                USART_DMA_Printf("[Ctrl] Local: Enter Proximity Mode\r\n");
+                DLOG(CTRL_PROX_ENTER, "[Ctrl] Local: Enter Proximity Mode");
                 break;
             case PAJ7620_GESTURE_BACKWARD:
+                _ExitAutoOnManual();
                 LightCtrl_SetRawPWM(0, 0);
-                USART_DMA_Printf("[Ctrl] Local: OFF\r\n");
+                DLOG(CTRL_LOCAL_OFF, "[Ctrl] Local: OFF");
                 break;
             default: break;
         }
@@ -160,7 +225,7 @@ void Control_OnProximity(uint8_t brightness) {
     else {
         if (System_GetTick() - s_ProxStableTick > PROX_LOCK_TIME_MS) {
             s_ProxLocked = 1;
-            USART_DMA_Printf("\r\n>> [Prox] Auto-Locked! <<\r\n");
+            DLOG(CTRL_PROX_LOCKED, ">> [Prox] Auto-Locked! <<");
             return;
         }
     }
@@ -205,13 +270,38 @@ void Control_OnProximityExit(void) {
     // 强制上报最终的灯光状态给 ESP32
     LightCtrl_ForceReport();
     
-    USART_DMA_Printf("[Ctrl] Local: Exit Proximity Mode & Report State\r\n");
+    DLOG(CTRL_PROX_EXIT, "[Ctrl] Local: Exit Proximity Mode & Report State");
 }
 
 void Control_Task(void) {
+    // 自动调光闭环 (仅本地模式；UI 模式下灯光由上位机接管)
+    if (g_SystemModel.Light.AutoMode && s_Mode == CTRL_MODE_LOCAL &&
+        (System_GetTick() - s_AutoTick >= AUTODIM_PERIOD_MS))
+    {
+        s_AutoTick = System_GetTick();
+        // 亮度被其他途径改写过 (如远程模式期间)，从新的亮度重新起步
+        if (s_AutoDim.Output != g_SystemModel.Light.Brightness) {
+            AutoDim_Init(&s_AutoDim, g_SystemModel.Light.Brightness);
+        }
+        int16_t out = AutoDim_Step(&s_AutoDim, g_SystemModel.Light.AutoTarget,
+                                   (int16_t)SensorHub_GetLux());
+        if (out != g_SystemModel.Light.Brightness) {
+            LightCtrl_AdjustBrightness(out - g_SystemModel.Light.Brightness);
+        }
+    }
+
     LightCtrl_Task();
 }
 
+void Control_SetMode(uint8_t mode) {
+    s_Mode = (mode == 0) ? CTRL_MODE_LOCAL : CTRL_MODE_REMOTE_UI;
+    DLOG(CTRL_MODE, "[Ctrl] Mode -> %s", s_Mode == CTRL_MODE_LOCAL ? "LOCAL" : "UI");
+}
+
+uint8_t Control_GetMode(void) {
+    return (uint8_t)s_Mode;
+}
+
 uint8_t Control_GetFocus(void) {
     return (uint8_t)g_SystemModel.Light.Focus;
 }
@@ -9,12 +9,17 @@ void Control_Init(void);
 void Control_Task(void); // 周期性调用
 
 // 事件入口
-void Control_OnEncoder(int16_t diff);
+/**
+ * @brief 处理编码器旋转
+ * @param detents   旋转格数 (带符号)
+ * @param timestamp 采样时刻 (ms)，用于估计转速选择步长
+ */
+void Control_OnEncoder(int16_t detents, uint32_t timestamp);
 
 /**
  * @brief 处理按键事件
  * @param key_name 按键标识符 (如 "ModeSW")
- * @param action   动作类型 ("click", "double", "hold", "release")
+ * @param action   动作类型 ("click", "double", "triple", "quad", "hold", "release")
  */
 void Control_OnKey(const char* key_name, const char* action);
 
@@ -27,5 +32,9 @@ void Control_OnProximityExit(void);
 // 状态查询
 uint8_t Control_GetFocus(void); // 0:Bri, 1:CCT
 
+// 控制模式 (0: 本地, 1: 上位机 UI)，可在 Control_Init 之前调用以恢复保存的模式
+void Control_SetMode(uint8_t mode);
+uint8_t Control_GetMode(void);
+
 #endif
 
@@ -0,0 +1,63 @@
+/* App/Control/EncoderAccel.c */
+/**
+  ******************************************************************************
+  * @file    EncoderAccel.c
+  * @brief   编码器加速曲线实现
+  * @note    转速由相邻两次增量的时间差估计，并做 1/2 指数平滑；
+  *          步长在 SlowRate~FastRate 之间按平方曲线过渡，低速段更平缓。
+  ******************************************************************************
+  */
+#include "EncoderAccel.h"
+
+// 超过该间隔没有转动视为重新开始，第一格总是精调步长
+#define ENC_ACCEL_IDLE_MS   150
+
+void EncAccel_Reset(EncAccel_t *acc)
+{
+    acc->LastTick = 0;
+    acc->Rate = 0;
+    acc->LastDir = 0;
+}
+
+int16_t EncAccel_Apply(EncAccel_t *acc, const EncAccel_Profile_t *profile,
+                       int16_t detents, uint32_t now)
+{
+    uint32_t dt, inst_rate, frac_q8, gain_q8;
+    int8_t dir;
+    uint16_t abs_det;
+    int32_t step, out;
+
+    if (detents == 0) return 0;
+
+    dir = (detents > 0) ? 1 : -1;
+    abs_det = (uint16_t)((detents > 0) ? detents : -detents);
+    dt = now - acc->LastTick;
+    acc->LastTick = now;
+
+    // 1. 估计转速 (停顿或换向时清零，避免残留速度带来一次大跳)
+    if (dt > ENC_ACCEL_IDLE_MS || dir != acc->LastDir) {
+        acc->Rate = 0;
+    } else {
+        if (dt == 0) dt = 1;
+        inst_rate = (uint32_t)abs_det * 1000 / dt;
+        if (inst_rate > 0xFFFF) inst_rate = 0xFFFF;
+        acc->Rate = (uint16_t)((acc->Rate + inst_rate) / 2);
+    }
+    acc->LastDir = dir;
+
+    // 2. 转速 -> 步长 (平方曲线)
+    if (acc->Rate <= profile->SlowRate) {
+        frac_q8 = 0;
+    } else if (acc->Rate >= profile->FastRate) {
+        frac_q8 = 256;
+    } else {
+        frac_q8 = (uint32_t)(acc->Rate - profile->SlowRate) * 256 / (profile->FastRate - profile->SlowRate);
+    }
+    gain_q8 = (frac_q8 * frac_q8) >> 8;
+    step = profile->MinStep + (int32_t)(((uint32_t)(profile->MaxStep - profile->MinStep) * gain_q8) >> 8);
+
+    out = (int32_t)detents * step;
+    if (out > 32767) out = 32767;
+    if (out < -32767) out = -32767;
+    return (int16_t)out;
+}
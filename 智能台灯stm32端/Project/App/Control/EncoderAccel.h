@@ -0,0 +1,46 @@
+/* App/Control/EncoderAccel.h */
+#ifndef __ENCODER_ACCEL_H
+#define __ENCODER_ACCEL_H
+
+#include <stdint.h>
+
+/**
+  ******************************************************************************
+  * @file    EncoderAccel.h
+  * @brief   编码器速度自适应步长 (加速曲线)
+  * @note    纯算法模块：输入带时间戳的格数增量，输出调节量。
+  *          慢转时每格 MinStep 便于精调，快拨时每格逐渐放大到 MaxStep。
+  ******************************************************************************
+  */
+
+/**
+  * @brief 加速曲线参数 (每个调节焦点一份)
+  */
+typedef struct {
+    uint8_t  MinStep;       /*!< 慢速时每格步长 */
+    uint8_t  MaxStep;       /*!< 快速时每格步长 */
+    uint16_t SlowRate;      /*!< 低于该转速 (格/秒) 使用 MinStep */
+    uint16_t FastRate;      /*!< 高于该转速 (格/秒) 使用 MaxStep */
+} EncAccel_Profile_t;
+
+/**
+  * @brief 速度估计状态
+  */
+typedef struct {
+    uint32_t LastTick;      /*!< 上一次增量的时间戳 */
+    uint16_t Rate;          /*!< 平滑后的转速 (格/秒) */
+    int8_t   LastDir;       /*!< 上一次旋转方向 */
+} EncAccel_t;
+
+void EncAccel_Reset(EncAccel_t *acc);
+
+/**
+  * @brief  将格数增量换算为调节量
+  * @param  detents: 本次格数 (带符号)
+  * @param  now:     增量产生的时刻 (ms)
+  * @retval 调节量 (与 detents 同号)
+  */
+int16_t EncAccel_Apply(EncAccel_t *acc, const EncAccel_Profile_t *profile,
+                       int16_t detents, uint32_t now);
+
+#endif
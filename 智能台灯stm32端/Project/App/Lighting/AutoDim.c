@@ -0,0 +1,52 @@
+/**
+  ******************************************************************************
+  * @file    AutoDim.c
+  * @brief   环境光闭环自动调光实现
+  * @note    u = Kp*e + ΣKi*e，积分限幅抗饱和；迟滞带内冻结输出，
+  *          输出变化率限制在 AUTODIM_MAX_STEP/周期，避免肉眼可见的跳变。
+  ******************************************************************************
+  */
+#include "AutoDim.h"
+
+static int32_t _Clamp32(int32_t val, int32_t min, int32_t max) {
+    if (val < min) return min;
+    if (val > max) return max;
+    return val;
+}
+
+void AutoDim_Init(AutoDim_t *ctl, int16_t initial_output)
+{
+    initial_output = (int16_t)_Clamp32(initial_output, AUTODIM_OUT_MIN, AUTODIM_OUT_MAX);
+    ctl->Output = initial_output;
+    ctl->IntegralQ8 = (int32_t)initial_output << 8;   // 误差为 0 时输出保持不变
+    ctl->Holding = 0;
+}
+
+int16_t AutoDim_Step(AutoDim_t *ctl, int16_t setpoint, int16_t measured)
+{
+    int32_t err = (int32_t)setpoint - measured;
+    int32_t abs_err = (err < 0) ? -err : err;
+    int32_t target, delta;
+
+    // 1. 迟滞: 进入/退出保持的阈值不同，防止在目标附近来回抖动
+    if (ctl->Holding) {
+        if (abs_err <= AUTODIM_HYST_OUT) return ctl->Output;
+        ctl->Holding = 0;
+    } else if (abs_err < AUTODIM_HYST_IN) {
+        ctl->Holding = 1;
+        return ctl->Output;
+    }
+
+    // 2. PI (积分项限制在输出范围内，抗饱和)
+    ctl->IntegralQ8 += err * AUTODIM_KI_Q8;
+    ctl->IntegralQ8 = _Clamp32(ctl->IntegralQ8, (int32_t)AUTODIM_OUT_MIN << 8, (int32_t)AUTODIM_OUT_MAX << 8);
+
+    target = (err * AUTODIM_KP_Q8 + ctl->IntegralQ8) >> 8;
+    target = _Clamp32(target, AUTODIM_OUT_MIN, AUTODIM_OUT_MAX);
+
+    // 3. 限速
+    delta = _Clamp32(target - ctl->Output, -AUTODIM_MAX_STEP, AUTODIM_MAX_STEP);
+    ctl->Output = (int16_t)(ctl->Output + delta);
+
+    return ctl->Output;
+}
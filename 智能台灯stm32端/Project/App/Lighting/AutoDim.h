@@ -0,0 +1,50 @@
+/**
+  ******************************************************************************
+  * @file    AutoDim.h
+  * @brief   环境光闭环自动调光 (PI 控制器)
+  * @note    纯算法模块，不访问硬件：输入目标照度与实测照度 (均为 0-1000)，
+  *          输出灯光亮度 (0-1000)。需以固定周期 AUTODIM_PERIOD_MS 调用 Step。
+  *          参数整定见 HostSim/tests/test_autodim_loop.c：灯对传感器增益 G 在
+  *          0.5~1.5 内阶跃 2.6~8.8s 进入迟滞带、超调 <= 25，G <= 3.0 无极限环；
+  *          实测照度须随亮度增大 (LDR_INVERT)，接反时亮度会被推到下限。
+  ******************************************************************************
+  */
+#ifndef __AUTO_DIM_H
+#define __AUTO_DIM_H
+
+#include <stdint.h>
+
+// --- 配置参数 ---
+#define AUTODIM_PERIOD_MS       200     // 控制周期 (PWM 最高更新率 5Hz)
+#define AUTODIM_KP_Q8           128     // 比例增益 0.5  (Q8)
+#define AUTODIM_KI_Q8           32      // 积分增益 0.125/周期 (Q8)
+#define AUTODIM_HYST_IN         10      // |误差| 小于该值时进入保持 (停止调节)
+#define AUTODIM_HYST_OUT        30      // |误差| 大于该值时退出保持
+#define AUTODIM_MAX_STEP        20      // 每周期亮度最大变化量 (限速 100/s)
+#define AUTODIM_OUT_MIN         50      // 自动模式下不把灯完全关掉
+#define AUTODIM_OUT_MAX         1000
+
+/**
+  * @brief 控制器状态
+  */
+typedef struct {
+    int32_t IntegralQ8;     /*!< 积分项 (Q8)，已做抗饱和限幅 */
+    int16_t Output;         /*!< 当前输出亮度 */
+    uint8_t Holding;        /*!< 1: 误差在迟滞带内，保持输出 */
+} AutoDim_t;
+
+/**
+  * @brief  初始化控制器
+  * @param  initial_output: 当前实际亮度，用于无扰切换
+  */
+void AutoDim_Init(AutoDim_t *ctl, int16_t initial_output);
+
+/**
+  * @brief  执行一个控制周期
+  * @param  setpoint: 目标照度 (0-1000)
+  * @param  measured: 滤波后的实测照度 (0-1000)
+  * @retval 新的亮度输出 (AUTODIM_OUT_MIN ~ AUTODIM_OUT_MAX)
+  */
+int16_t AutoDim_Step(AutoDim_t *ctl, int16_t setpoint, int16_t measured);
+
+#endif
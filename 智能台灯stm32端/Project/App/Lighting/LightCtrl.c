@@ -1,7 +1,8 @@
 /**
   ******************************************************************************
   * @file    LightCtrl.c
-  * @brief   灯光控制业务逻辑 (V6.3 Force Report Support)
+  * @brief   灯光控制业务逻辑 (V6.4 Trace Age)
+  * @note    V6.4 状态上报附带从首次本地改动到上报的时长，用于端到端延迟追踪
   ******************************************************************************
   */
 #include "LightCtrl.h"
@@ -13,6 +14,7 @@
 // --- 内部变量 ---
 static uint8_t s_IsDirty = 0;
 static uint32_t s_LastChangeTime = 0;
+static uint32_t s_FirstChangeTime = 0; // 本轮脏数据中最早一次改动的时间
 
 // 缓存当前的 PWM 值，用于上报
 static uint16_t s_CurrWarm = 0;
@@ -25,6 +27,13 @@ static int16_t _Clamp(int16_t val, int16_t min, int16_t max) {
     return val;
 }
 
+// 记录改动时间 (节流上报)
+static void _MarkDirty(void) {
+    s_LastChangeTime = System_GetTick();
+    if (!s_IsDirty) s_FirstChangeTime = s_LastChangeTime;
+    s_IsDirty = 1;
+}
+
 // 将模型数据应用到硬件
 static void _ApplyModelToHardware(void) {
     uint16_t warm, cold;
@@ -52,9 +61,7 @@ void LightCtrl_AdjustBrightness(int16_t delta) {
     g_SystemModel.Light.Brightness = _Clamp(g_SystemModel.Light.Brightness, 0, 1000);
     
     _ApplyModelToHardware();
-    
-    s_IsDirty = 1;
-    s_LastChangeTime = System_GetTick();
+    _MarkDirty();
 }
 
 void LightCtrl_AdjustColorTemp(int16_t delta) {
@@ -62,9 +69,7 @@ void LightCtrl_AdjustColorTemp(int16_t delta) {
     g_SystemModel.Light.ColorTemp = _Clamp(g_SystemModel.Light.ColorTemp, 0, 1000);
     
     _ApplyModelToHardware();
-    
-    s_IsDirty = 1;
-    s_LastChangeTime = System_GetTick();
+    _MarkDirty();
 }
 
 // 远程控制接口
@@ -94,13 +99,14 @@ uint16_t LightCtrl_GetColorTemp(void) { return g_SystemModel.Light.ColorTemp; }
 void LightCtrl_Task(void) {
     // 节流上报：上报 Warm/Cold 值
     if (s_IsDirty && (System_GetTick() - s_LastChangeTime > 200)) {
-        Protocol_Report_State(s_CurrWarm, s_CurrCold);
+        Protocol_Report_State(s_CurrWarm, s_CurrCold, System_GetTick() - s_FirstChangeTime);
         s_IsDirty = 0;
     }
 }
 
 // [新增] 强制上报当前灯光状态
 void LightCtrl_ForceReport(void) {
-    Protocol_Report_State(s_CurrWarm, s_CurrCold);
+    Protocol_Report_State(s_CurrWarm, s_CurrCold,
+                          s_IsDirty ? System_GetTick() - s_FirstChangeTime : 0);
     s_IsDirty = 0; // 上报后清除脏标记，避免重复上报
 }
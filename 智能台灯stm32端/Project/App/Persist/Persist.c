@@ -0,0 +1,145 @@
+/**
+  ******************************************************************************
+  * @file    Persist.c
+  * @brief   灯光状态掉电保存服务实现
+  ******************************************************************************
+  */
+#include "Persist.h"
+#include "KVStore.h"
+#include "SystemModel.h"
+#include "ControlManager.h"
+#include "SystemSupport.h"
+#include "DLog.h"
+#include <string.h>
+
+// --- 配置参数 ---
+#define PERSIST_KEY_LIGHT       0       // KVStore 键号
+#define PERSIST_QUIET_MS        3000    // 状态稳定多久后写入
+#define PERSIST_MAX_DELAY_MS    30000   // 持续变化时的最长推迟时间
+
+/**
+  * @brief 保存到 Flash 的快照 (修改结构体后长度变化，旧记录自动作废)
+  */
+typedef struct {
+    int16_t Brightness;
+    int16_t ColorTemp;
+    int16_t AutoTarget;
+    uint8_t AutoMode;
+    uint8_t CtrlMode;
+} Persist_Snapshot_t;
+
+typedef enum {
+    PERSIST_IDLE = 0,       // 与 Flash 一致
+    PERSIST_PENDING,        // 有变化，等待安静期
+    PERSIST_COMPACT,        // 空间不足，本步只做回收
+    PERSIST_WRITE           // 本步写入记录
+} Persist_State_t;
+
+static Persist_State_t    s_State = PERSIST_IDLE;
+static Persist_Snapshot_t s_Saved;          // Flash 中的内容
+static Persist_Snapshot_t s_Last;           // 上一次观察到的内容
+static uint32_t           s_LastChangeTick = 0;
+static uint32_t           s_FirstChangeTick = 0;
+
+static void _TakeSnapshot(Persist_Snapshot_t *snap)
+{
+    memset(snap, 0, sizeof(*snap)); // 清零填充字节，保证 memcmp 可靠
+    snap->Brightness = g_SystemModel.Light.Brightness;
+    snap->ColorTemp  = g_SystemModel.Light.ColorTemp;
+    snap->AutoTarget = g_SystemModel.Light.AutoTarget;
+    snap->AutoMode   = g_SystemModel.Light.AutoMode;
+    snap->CtrlMode   = Control_GetMode();
+}
+
+static uint8_t _InRange(int16_t val)
+{
+    return (val >= 0 && val <= 1000);
+}
+
+void Persist_Init(void)
+{
+    Persist_Snapshot_t snap;
+
+    if (KV_Init() != KV_OK) {
+        DLOG(PERSIST_FLASH_INIT_FAIL, "[Persist] Flash Init Failed!");
+    }
+
+    memset(&snap, 0, sizeof(snap));
+    if (KV_Read(PERSIST_KEY_LIGHT, &snap, sizeof(snap)) == KV_OK &&
+        _InRange(snap.Brightness) && _InRange(snap.ColorTemp) && _InRange(snap.AutoTarget))
+    {
+        g_SystemModel.Light.Brightness = snap.Brightness;
+        g_SystemModel.Light.ColorTemp  = snap.ColorTemp;
+        g_SystemModel.Light.AutoTarget = snap.AutoTarget;
+        g_SystemModel.Light.AutoMode   = snap.AutoMode ? 1 : 0;
+        Control_SetMode(snap.CtrlMode);
+        DLOG(PERSIST_RESTORED, "[Persist] Restored Bri=%d CCT=%d Auto=%d",
+             snap.Brightness, snap.ColorTemp, snap.AutoMode);
+    }
+    else
+    {
+        DLOG(PERSIST_DEFAULTS, "[Persist] No saved state, using defaults.");
+    }
+
+    // 以当前 (恢复后的) 状态为基准，避免上电后立刻写一次
+    _TakeSnapshot(&s_Saved);
+    s_Last = s_Saved;
+    s_State = PERSIST_IDLE;
+}
+
+void Persist_Task(void)
+{
+    uint32_t now = System_GetTick();
+    Persist_Snapshot_t cur;
+
+    _TakeSnapshot(&cur);
+
+    // 1. 跟踪变化：每次变化都重新开始安静期计时
+    if (memcmp(&cur, &s_Last, sizeof(cur)) != 0) {
+        if (s_State == PERSIST_IDLE) s_FirstChangeTick = now;
+        s_Last = cur;
+        s_LastChangeTick = now;
+        if (s_State == PERSIST_IDLE) s_State = PERSIST_PENDING;
+    }
+
+    switch (s_State)
+    {
+        case PERSIST_PENDING:
+            // 改回了与 Flash 相同的值，无需写入
+            if (memcmp(&s_Last, &s_Saved, sizeof(s_Saved)) == 0) {
+                s_State = PERSIST_IDLE;
+                break;
+            }
+            if ((now - s_LastChangeTick >= PERSIST_QUIET_MS) ||
+                (now - s_FirstChangeTick >= PERSIST_MAX_DELAY_MS)) {
+                s_State = KV_NeedsCompact(sizeof(Persist_Snapshot_t)) ? PERSIST_COMPACT : PERSIST_WRITE;
+            }
+            break;
+
+        case PERSIST_COMPACT:
+            if (KV_Compact() != KV_OK) {
+                DLOG(PERSIST_COMPACT_FAIL, "[Persist] Compact Failed!");
+                s_State = PERSIST_IDLE; // 放弃本次，下次变化时重试
+                break;
+            }
+            s_State = PERSIST_WRITE;
+            break;
+
+        case PERSIST_WRITE:
+            if (KV_Write(PERSIST_KEY_LIGHT, &s_Last, sizeof(s_Last)) == KV_OK) {
+                s_Saved = s_Last;
+            } else {
+                DLOG(PERSIST_WRITE_FAIL, "[Persist] Write Failed!");
+            }
+            // 写入期间若又有变化，下一轮会重新进入 PENDING
+            s_State = PERSIST_IDLE;
+            if (memcmp(&s_Last, &s_Saved, sizeof(s_Saved)) != 0) {
+                s_FirstChangeTick = now;
+                s_State = PERSIST_PENDING;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef __PERSIST_H
+#define __PERSIST_H
+
+#include <stdint.h>
+
+/**
+  ******************************************************************************
+  * @file    Persist.h
+  * @brief   灯光状态掉电保存服务
+  * @note    1. 上电时 (LightCtrl_Init 之前) 从 KVStore 恢复亮度/色温/自动调光/控制模式
+  *          2. 运行时周期性比较快照，变化停止 PERSIST_QUIET_MS 后才写入，
+  *             连续调节期间的多次变化合并为一次写入
+  *          3. 写入拆成多个调度步骤：需要回收 (擦页) 时先单独执行回收，
+  *             下一步才写记录，单次任务不会同时承担擦除和写入
+  ******************************************************************************
+  */
+
+/**
+  * @brief  初始化存储并恢复上次状态到 g_SystemModel 与 ControlManager
+  * @note   必须在 SystemModel_Init 之后、Control_Init 之前调用
+  */
+void Persist_Init(void);
+
+/**
+  * @brief  周期任务 (建议 100ms)
+  */
+void Persist_Task(void);
+
+#endif
@@ -1,6 +1,10 @@
 /* App/Protocol/Protocol.c */
 #include "Protocol.h"
 #include "USART_DMA.h"
+#include "SystemSupport.h"
+#include "Profiler.h"
+#include "DLog.h"
+#include "Config.h"
 #include "cJSON.h"
 #include <string.h>
 #include <stdio.h>
@@ -14,6 +18,44 @@ static uint16_t s_AppRxLen = 0;
 // --- 回调函数 ---
 static Proto_ModeCallback_t s_ModeCb = NULL;
 static Proto_LightCallback_t s_LightCb = NULL;
+static Proto_AutoCallback_t s_AutoCb = NULL;
+
+#if PROTO_TRACE_ENABLE
+// 本机发起的追踪编号 (随 state 上报)
+static uint32_t s_TraceId = 0;
+#endif
+
+#if PROF_ENABLE
+PROF_DEFINE(s_ProfProto, "proto");
+
+// 耗时统计输出进度：-1 表示空闲；每轮只在发送缓冲区较空时输出，避免挤掉业务帧
+#define PROF_DUMP_MAX_USAGE     50
+static int16_t s_ProfCursor = -1;
+static uint8_t s_ProfReset = 0;
+
+static void _ProfDumpStep(void)
+{
+    char buf[192];
+    uint16_t n;
+
+    while (s_ProfCursor >= 0 && USART_DMA_GetUsage() <= PROF_DUMP_MAX_USAGE)
+    {
+        n = Prof_Format((uint8_t)s_ProfCursor, buf, sizeof(buf) - 2, s_ProfReset);
+        if (n == 0)
+        {
+            // 结束行附带探针数与 CPU 频率，上位机据此把周期换算为时间
+            USART_DMA_Printf("{\"ev\":\"prof\",\"end\":%d,\"hz\":%lu}\r\n",
+                             s_ProfCursor, (unsigned long)SYSTEM_CORE_CLOCK);
+            s_ProfCursor = -1;
+            break;
+        }
+        buf[n++] = '\r';
+        buf[n++] = '\n';
+        USART_DMA_Send((uint8_t*)buf, n);
+        s_ProfCursor++;
+    }
+}
+#endif
 
 // --- 内部辅助：检查 QoS 水位线 ---
 static int _CheckQoS(void)
@@ -25,6 +67,9 @@ static int _CheckQoS(void)
 // --- 内部辅助：解析 JSON 指令 ---
 static void _ParseJsonCmd(char* json_str)
 {
+#if PROTO_TRACE_ENABLE
+    uint32_t rx_us = System_GetMicros(); // 帧已完整收到，开始解析
+#endif
     cJSON *root = cJSON_Parse(json_str);
     if (root)
     {
@@ -49,14 +94,50 @@ static void _ParseJsonCmd(char* json_str)
                 if (cJSON_IsNumber(warm) && cJSON_IsNumber(cold) && s_LightCb)
                 {
                     s_LightCb((uint16_t)warm->valueint, (uint16_t)cold->valueint);
+#if PROTO_TRACE_ENABLE
+                    // 带追踪编号的指令：回执从收到整帧到 PWM 生效的耗时
+                    cJSON *tid = cJSON_GetObjectItem(root, "tid");
+                    if (cJSON_IsNumber(tid))
+                    {
+                        USART_DMA_Printf("{\"ev\":\"trace\",\"tid\":%lu,\"us\":%lu}\r\n",
+                                         (unsigned long)tid->valuedouble,
+                                         (unsigned long)(System_GetMicros() - rx_us));
+                    }
+#endif
                 }
             }
+            // 3. 自动调光指令 {"cmd":"auto","val":1,"target":400}，target 可省略
+            else if (strcmp(cmd->valuestring, "auto") == 0)
+            {
+                cJSON *val = cJSON_GetObjectItem(root, "val");
+                cJSON *target = cJSON_GetObjectItem(root, "target");
+
+                if (cJSON_IsNumber(val) && s_AutoCb)
+                {
+                    s_AutoCb((uint8_t)(val->valueint != 0),
+                             cJSON_IsNumber(target) ? (int16_t)target->valueint : -1);
+                }
+            }
+#if PROF_ENABLE
+            // 4. 耗时统计输出 {"cmd":"prof","reset":1}，reset 可省略
+            else if (strcmp(cmd->valuestring, "prof") == 0)
+            {
+                cJSON *reset = cJSON_GetObjectItem(root, "reset");
+                s_ProfReset = (uint8_t)(cJSON_IsNumber(reset) && reset->valueint != 0);
+                s_ProfCursor = 0;
+            }
+            // 5. 日志开销对比 {"cmd":"logbench"}
+            else if (strcmp(cmd->valuestring, "logbench") == 0)
+            {
+                DLog_Bench();
+            }
+#endif
         }
         cJSON_Delete(root);
     }
     else
     {
-        USART_DMA_Printf("[Proto] JSON Parse Error: %s\r\n", json_str);
+        DLOG(PROTO_PARSE_ERR, "[Proto] JSON Parse Error: %s", json_str);
     }
 }
 
@@ -68,6 +149,8 @@ void Protocol_Init(void)
 
 void Protocol_Process(void)
 {
+    PROF_BEGIN(s_ProfProto);
+
     // 1. 从 DMA 驱动层拉取新数据
     uint8_t temp_buf[128];
     uint16_t len = USART_DMA_ReadRxBuffer(temp_buf, sizeof(temp_buf));
@@ -85,7 +168,7 @@ void Protocol_Process(void)
         {
             // 溢出保护：清空缓冲区
             s_AppRxLen = 0;
-            USART_DMA_Printf("[Proto] Buffer Overflow! Reset.\r\n");
+            DLOG(PROTO_RX_OVERFLOW, "[Proto] Buffer Overflow! Reset.");
         }
     }
 
@@ -133,10 +216,16 @@ void Protocol_Process(void)
             }
         }
     }
+
+#if PROF_ENABLE
+    _ProfDumpStep();
+#endif
+    PROF_END(s_ProfProto);
 }
 
 void Protocol_SetModeCallback(Proto_ModeCallback_t cb) { s_ModeCb = cb; }
 void Protocol_SetLightCallback(Proto_LightCallback_t cb) { s_LightCb = cb; }
+void Protocol_SetAutoCallback(Proto_AutoCallback_t cb) { s_AutoCb = cb; }
 
 /* --- 发送接口实现 (保持不变) --- */
 
@@ -155,11 +244,17 @@ void Protocol_Report_Gesture(uint8_t gesture)
     USART_DMA_Printf("{\"ev\":\"gest\",\"val\":%d}\r\n", gesture);
 }
 
-void Protocol_Report_State(uint16_t warm, uint16_t cold)
+void Protocol_Report_State(uint16_t warm, uint16_t cold, uint32_t age_ms)
 {
     if (_CheckQoS())
     {
+#if PROTO_TRACE_ENABLE
+        USART_DMA_Printf("{\"ev\":\"state\",\"warm\":%d,\"cold\":%d,\"tid\":%lu,\"age\":%lu}\r\n",
+                         warm, cold, (unsigned long)++s_TraceId, (unsigned long)age_ms);
+#else
+        (void)age_ms;
         USART_DMA_Printf("{\"ev\":\"state\",\"warm\":%d,\"cold\":%d}\r\n", warm, cold);
+#endif
     }
 }
 
@@ -10,6 +10,7 @@
 /* --- 回调函数类型定义 --- */
 typedef void (*Proto_ModeCallback_t)(uint8_t mode);
 typedef void (*Proto_LightCallback_t)(uint16_t warm, uint16_t cold);
+typedef void (*Proto_AutoCallback_t)(uint8_t enable, int16_t target); // target < 0 表示不修改目标
 
 /* --- 基础接口 --- */
 void Protocol_Init(void);
@@ -23,6 +24,7 @@ void Protocol_Process(void);
 /* --- 回调注册 --- */
 void Protocol_SetModeCallback(Proto_ModeCallback_t cb);
 void Protocol_SetLightCallback(Proto_LightCallback_t cb);
+void Protocol_SetAutoCallback(Proto_AutoCallback_t cb);
 
 /* --- 发送接口 (高优先级) --- */
 void Protocol_Report_Encoder(int16_t diff);
@@ -30,7 +32,12 @@ void Protocol_Report_Key(const char* name, const char* action);
 void Protocol_Report_Gesture(uint8_t gesture);
 
 /* --- 发送接口 (低优先级 - QoS) --- */
-void Protocol_Report_State(uint16_t warm, uint16_t cold);
+/**
+ * @brief 上报灯光状态
+ * @param age_ms 本次状态对应的最早一次本地操作距今的时间 (ms)
+ * @note  PROTO_TRACE_ENABLE 时附带递增的 tid 与 age，ESP32 据此追踪"旋钮 -> 面板"的延迟
+ */
+void Protocol_Report_State(uint16_t warm, uint16_t cold, uint32_t age_ms);
 void Protocol_Report_Env(int8_t temp, uint8_t humi, uint16_t lux);
 void Protocol_Report_Heartbeat(uint32_t uptime);
 
@@ -1,24 +1,54 @@
 /**
   * @file    SensorHub.c
-  * @brief   传感器中心 (V6.5 Data Sync Fix)
+  * @brief   传感器中心 (V6.7 Profiled)
+  * @note    DHT11 读取改为异步：Task 只发起读取，结果在回调中写入模型并上报
+  *          V6.7 SensorHub_Task 接入耗时探针
+  *          V6.8 调试输出改用 DLOG
   */
 #include "SensorHub.h"
 #include "DHT11.h"
 #include "LDR.h"          // <--- 新增
 #include "Protocol.h"
-#include "USART_DMA.h"
+#include "DLog.h"
 #include "SystemModel.h"  // <--- 新增：用于更新本地模型
+#include "Profiler.h"
+
+PROF_DEFINE(s_ProfSensor, "sensor");
+
+// 最近一次光强采样，随温湿度一起上报
+static uint16_t s_LastLux = 0;
+
+// DHT11 读取完成回调 (主循环上下文)
+static void _OnDHT11Result(DHT11_Status_t status, uint8_t temp_int, uint8_t humi_int)
+{
+    if (status == DHT11_OK)
+    {
+        // 【关键修复】更新本地数据模型 (供 OLED 显示)
+        g_SystemModel.Sensor.Temperature = (float)temp_int;
+        g_SystemModel.Sensor.Humidity = (float)humi_int;
+        g_SystemModel.Sensor.Lux = (float)s_LastLux;
+
+        // 上报给 ESP32
+        Protocol_Report_Env((int8_t)temp_int, humi_int, s_LastLux);
+    }
+    else
+    {
+        // 读取失败处理
+        g_SystemModel.Sensor.Temperature = -99.0f; // 错误码
+        DLOG(SENSOR_DHT_READ_ERR, "[Sensor] DHT11 Read Error (%d)", status);
+    }
+}
 
 void SensorHub_Init(void)
 {
-    // 初始化 DHT11
+    // 初始化 DHT11 (仅配置硬件，是否在线由第一次读取结果判断)
     if (DHT11_Init() == 0)
     {
-        USART_DMA_Printf("[Sensor] DHT11 Init Success.\r\n");
+        DLOG(SENSOR_DHT_INIT_OK, "[Sensor] DHT11 Init Success.");
     }
     else
     {
-        USART_DMA_Printf("[Sensor] DHT11 Init Failed!\r\n");
+        DLOG(SENSOR_DHT_INIT_FAIL, "[Sensor] DHT11 Init Failed!");
         // 设置错误标记
         g_SystemModel.Sensor.Temperature = -99.0f;
     }
@@ -29,27 +59,27 @@ void SensorHub_Init(void)
 
 void SensorHub_Task(void)
 {
-    uint8_t temp_int, humi_int;
-    uint16_t lux_percent = 0;
-    
+    PROF_BEGIN(s_ProfSensor);
+
     // 1. 读取光强
-    lux_percent = LDR_GetLuxPercentage();
+    s_LastLux = LDR_GetLuxPercentage();
     
-    // 2. 读取温湿度
-    if (DHT11_Read_Data(&temp_int, &humi_int) == 0)
-    {
-        // 【关键修复】更新本地数据模型 (供 OLED 显示)
-        g_SystemModel.Sensor.Temperature = (float)temp_int;
-        g_SystemModel.Sensor.Humidity = (float)humi_int;
-        g_SystemModel.Sensor.Lux = (float)lux_percent;
-
-        // 上报给 ESP32
-        Protocol_Report_Env((int8_t)temp_int, humi_int, lux_percent);
-    }
-    else
+    // 2. 发起温湿度读取 (结果在 _OnDHT11Result 中处理)
+    if (DHT11_StartRead(_OnDHT11Result) != 0)
     {
-        // 读取失败处理
-        g_SystemModel.Sensor.Temperature = -99.0f; // 错误码
-        USART_DMA_Printf("[Sensor] DHT11 Read Error\r\n");
+        DLOG(SENSOR_DHT_BUSY, "[Sensor] DHT11 Busy");
     }
+
+    PROF_END(s_ProfSensor);
+}
+
+void SensorHub_Process(void)
+{
+    DHT11_Process();
+}
+
+uint16_t SensorHub_GetLux(void)
+{
+    // LDR 已在 DMA 中断内完成滤波，这里直接读取，开销为 O(1)
+    return LDR_GetLuxPercentage();
 }
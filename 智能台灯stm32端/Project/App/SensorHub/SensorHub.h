@@ -1,7 +1,11 @@
 #ifndef __SENSOR_HUB_H
 #define __SENSOR_HUB_H
 
+#include <stdint.h>
+
 void SensorHub_Init(void);
 void SensorHub_Task(void); // 周期性调用 (建议 2秒一次)
+void SensorHub_Process(void); // 主循环高频调用，推进异步读取
+uint16_t SensorHub_GetLux(void); // 滤波后的实时光强 (0-1000)，供自动调光闭环使用
 
 #endif
@@ -52,6 +52,8 @@ void SystemModel_Init(void)
     g_SystemModel.Light.ColorTemp = 500;
     g_SystemModel.Light.Focus = FOCUS_BRIGHTNESS;
     g_SystemModel.Light.IsLongPressMode = 0;
+    g_SystemModel.Light.AutoMode = 0;
+    g_SystemModel.Light.AutoTarget = 500;
 
     // 3. 设置传感器默认值
     g_SystemModel.Sensor.Temperature = 0.0f;
@@ -26,7 +26,8 @@ typedef struct {
     int16_t ColorTemp;       /*!< 当前色温值 (0-1000) */
     uint8_t IsLongPressMode; /*!< 是否处于长按临时模式 (0/1) */
     LightFocus_t Focus;      /*!< 当前编码器控制焦点 */
-    // uint8_t AutoMode;     /*!< 自动调光模式 (预留) */
+    uint8_t AutoMode;        /*!< 环境光自动调光模式 (0/1) */
+    int16_t AutoTarget;      /*!< 自动调光目标照度 (0-1000, 与 LDR 同标度) */
 } Model_Light_t;
 
 /**
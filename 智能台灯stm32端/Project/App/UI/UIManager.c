@@ -1,83 +1,157 @@
 /**
   * @file    UIManager.c
-  * @brief   UI 管理器实现 (V6.3 Force Refresh)
+  * @brief   UI 管理器实现 (V7.2 Sensor Error Row)
+  * @note    显存写屏按 UI_FLUSH_BYTE_BUDGET 分片进行，避免整屏刷新阻塞主循环
+  *          主页由控件表描述，每个控件只在自身绑定值变化时重绘
+  *          V7.1 UIManager_Task 接入耗时探针
+  *          V7.2 恢复传感器故障时行 4 的 "Sensor Error!" 提示；温湿度四舍五入显示
   */
 #include "UIManager.h"
+#include "UIWidget.h"
 #include "SystemModel.h"
 #include "OLED.h"
-#include <stdio.h>
-#include <string.h>
+#include "Profiler.h"
+#include "Config.h"
 
-static SystemModel_t s_LastModel;
+PROF_DEFINE(s_ProfUI, "ui");
 
-static void UI_Draw_Home_Page(void);
+static volatile uint8_t s_FrameInFlight = 0; // 上一帧是否仍在分片写屏
+
+/* ============================================================
+ *      模型字段绑定 (全部返回整数)
+ * ============================================================ */
+static int32_t _GetBrightness(void) { return g_SystemModel.Light.Brightness; }
+static int32_t _GetColorTemp(void)  { return g_SystemModel.Light.ColorTemp; }
+static int32_t _GetFocusBri(void)   { return g_SystemModel.Light.Focus == FOCUS_BRIGHTNESS; }
+static int32_t _GetFocusCCT(void)   { return g_SystemModel.Light.Focus == FOCUS_COLOR_TEMP; }
+static int32_t _GetAutoMode(void)   { return g_SystemModel.Light.AutoMode != 0; }
+
+// 温度 <= -90 为 SensorHub 约定的故障码
+static uint8_t _IsSensorError(void) {
+    return g_SystemModel.Sensor.Temperature <= -90.0f;
+}
+
+// 四舍五入取整 (与旧版 "%2.0f" 的显示一致)
+static int32_t _Round(float v) {
+    return (int32_t)(v >= 0.0f ? v + 0.5f : v - 0.5f);
+}
+
+static int32_t _GetTemperature(void) {
+    if (_IsSensorError()) return UI_VALUE_INVALID;
+    return _Round(g_SystemModel.Sensor.Temperature);
+}
+static int32_t _GetHumidity(void) {
+    if (_IsSensorError()) return UI_VALUE_INVALID;
+    return _Round(g_SystemModel.Sensor.Humidity);
+}
+static int32_t _GetLuxPercent(void) {
+    int32_t lux_percent = (int32_t)g_SystemModel.Sensor.Lux / 10;
+    if (lux_percent > 100) lux_percent = 100;
+    return lux_percent;
+}
+
+static const char* const s_FocusIcons[] = { "   ", "[F]" };
+static const char* const s_AutoIcons[]  = { " ", "A" };
+
+/* ============================================================
+ *      主页控件表
+ *      行 2: "Bri: 500   [F]##"   行 3: "CCT: 500   [F]##"
+ *      行 4: "25C 60% L: 45% A"  (A: 自动调光)，传感器故障时为 "Sensor Error!"
+ * ============================================================ */
+static UIWidget_t s_HomePage[] = {
+    UI_LABEL(1, 1,  "--- SMART LAMP ---"),
+
+    UI_LABEL(2, 1,  "Bri:"),
+    UI_VALUE(2, 6,  4, UI_ALIGN_LEFT, _GetBrightness),
+    UI_ICON (2, 12, 3, s_FocusIcons, _GetFocusBri),
+    UI_BAR  (2, 15, 2, _GetBrightness, 0, 1000),
+
+    UI_LABEL(3, 1,  "CCT:"),
+    UI_VALUE(3, 6,  4, UI_ALIGN_LEFT, _GetColorTemp),
+    UI_ICON (3, 12, 3, s_FocusIcons, _GetFocusCCT),
+    UI_BAR  (3, 15, 2, _GetColorTemp, 0, 1000),
+
+};
+
+// 行 4 在传感器正常/故障时分别显示下面两组控件之一 (各自写满 16 列，不留空隙)
+static UIWidget_t s_EnvRow[] = {
+    UI_VALUE(4, 1,  2, UI_ALIGN_RIGHT, _GetTemperature),
+    UI_LABEL(4, 3,  "C "),
+    UI_VALUE(4, 5,  2, UI_ALIGN_RIGHT, _GetHumidity),
+    UI_LABEL(4, 7,  "% "),
+    UI_LABEL(4, 9,  "L:"),
+    UI_VALUE(4, 11, 3, UI_ALIGN_RIGHT, _GetLuxPercent),
+    UI_LABEL(4, 14, "% "),
+    UI_ICON (4, 16, 1, s_AutoIcons, _GetAutoMode),
+};
+
+static UIWidget_t s_EnvError[] = {
+    UI_LABEL(4, 1,  "Sensor Error!   "),
+};
+
+#define HOME_WIDGET_COUNT   (sizeof(s_HomePage) / sizeof(s_HomePage[0]))
+#define ENV_ROW_COUNT       (sizeof(s_EnvRow) / sizeof(s_EnvRow[0]))
+#define ENV_ERROR_COUNT     (sizeof(s_EnvError) / sizeof(s_EnvError[0]))
+
+static uint8_t s_EnvShowError = 0;  // 行 4 当前显示的是哪一组
+
+static void _UpdateEnvRow(void)
+{
+    uint8_t err = _IsSensorError();
+
+    // 切换时整组重绘 (两组都写满 16 列，互相覆盖)
+    if (err != s_EnvShowError) {
+        s_EnvShowError = err;
+        UIWidget_Invalidate(err ? s_EnvError : s_EnvRow, err ? ENV_ERROR_COUNT : ENV_ROW_COUNT);
+    }
+    if (err) UIWidget_Update(s_EnvError, ENV_ERROR_COUNT);
+    else     UIWidget_Update(s_EnvRow, ENV_ROW_COUNT);
+}
+
+// 帧刷新完成回调 (由 OLED_RefreshStep 调用)
+static void _OnFrameFlushed(void)
+{
+    s_FrameInFlight = 0;
+}
 
 void UIManager_Init(void)
 {
     OLED_Init();
+    OLED_SetRefreshDoneCallback(_OnFrameFlushed);
     
-    // 强制清屏并显示标题，不检查 IsReady
+    // 强制清屏，不检查 IsReady
+    // 此处只写显存，整屏内容由主循环中的 UIManager_Flush 分片送出
     OLED_Clear();
-    OLED_ShowString(1, 1, "--- SMART LAMP ---");
+    s_FrameInFlight = 1;
 
-    // 初始化上一帧数据为非法值，确保第一次进入 Task 时强制全屏刷新
-    memset(&s_LastModel, 0xFF, sizeof(SystemModel_t));
+    // 清屏后所有控件 (含标题) 都需要在第一次 Task 时重绘
+    UIWidget_Invalidate(s_HomePage, HOME_WIDGET_COUNT);
+    UIWidget_Invalidate(s_EnvRow, ENV_ROW_COUNT);
+    UIWidget_Invalidate(s_EnvError, ENV_ERROR_COUNT);
+    s_EnvShowError = _IsSensorError();
 }
 
 void UIManager_Task(void)
 {
+    PROF_BEGIN(s_ProfUI);
+
     // 【修改点】暂时移除离线检测，强制刷新，排除 I2C ACK 失败导致的黑屏
     // if (OLED_IsReady() == 0) return;
 
-    UI_Draw_Home_Page();
-    s_LastModel = g_SystemModel;
-}
-
-static void UI_Draw_Home_Page(void)
-{
-    char str[18];
-    SystemModel_t *curr = &g_SystemModel;
-    SystemModel_t *last = &s_LastModel;
-
-    // --- 1. 刷新亮度 ---
-    if (curr->Light.Brightness != last->Light.Brightness || 
-        curr->Light.Focus != last->Light.Focus)
+    // 上一帧写完之前不绘制新帧，保证屏幕上每帧内容来自同一份模型快照
+    if (!s_FrameInFlight)
     {
-        sprintf(str, "Bri: %-4d  %s", 
-                curr->Light.Brightness, 
-                (curr->Light.Focus == FOCUS_BRIGHTNESS) ? "[F]" : "   ");
-        OLED_ShowString(2, 1, str);
+        UIWidget_Update(s_HomePage, HOME_WIDGET_COUNT);
+        _UpdateEnvRow();
+        s_FrameInFlight = OLED_IsRefreshPending();
     }
 
-    // --- 2. 刷新色温 ---
-    if (curr->Light.ColorTemp != last->Light.ColorTemp || 
-        curr->Light.Focus != last->Light.Focus)
-    {
-        sprintf(str, "CCT: %-4d  %s", 
-                curr->Light.ColorTemp, 
-                (curr->Light.Focus == FOCUS_COLOR_TEMP) ? "[F]" : "   ");
-        OLED_ShowString(3, 1, str);
-    }
+    UIManager_Flush();
 
-    // --- 3. 刷新环境数据 ---
-    if (curr->Sensor.Temperature != last->Sensor.Temperature || 
-        curr->Sensor.Humidity != last->Sensor.Humidity ||
-        curr->Sensor.Lux != last->Sensor.Lux)
-    {
-        if (curr->Sensor.Temperature <= -90.0f)
-        {
-            OLED_ShowString(4, 1, "Sensor Error!   ");
-        }
-        else
-        {
-            int lux_percent = (int)(curr->Sensor.Lux / 10.0f);
-            if(lux_percent > 100) lux_percent = 100;
-
-            sprintf(str, "%2.0fC %2.0f%% L:%3d%%", 
-                    curr->Sensor.Temperature, 
-                    curr->Sensor.Humidity,
-                    lux_percent);
-            OLED_ShowString(4, 1, str);
-        }
-    }
+    PROF_END(s_ProfUI);
+}
+
+void UIManager_Flush(void)
+{
+    OLED_RefreshStep(UI_FLUSH_BYTE_BUDGET);
 }
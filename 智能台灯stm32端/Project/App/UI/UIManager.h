@@ -18,7 +18,15 @@ void UIManager_Init(void);
   * @brief  UI 刷新任务
   * @note   建议在主循环中以较低频率调用 (如 100ms/次)
   *         函数内部会自动进行脏检测，仅刷新变化的数据。
+  *         新内容写入显存后由 UIManager_Flush 分片送往屏幕。
   */
 void UIManager_Task(void);
 
+/**
+  * @brief  UI 分片写屏
+  * @note   需在主循环中高频调用，每次最多发送 UI_FLUSH_BYTE_BUDGET 字节，
+  *         未写完的部分在下次调用时继续。
+  */
+void UIManager_Flush(void);
+
 #endif
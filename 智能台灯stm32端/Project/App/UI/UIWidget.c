@@ -0,0 +1,113 @@
+/**
+  ******************************************************************************
+  * @file    UIWidget.c
+  * @brief   保留模式 UI 控件实现
+  * @note    V1.1: 数值超出字段宽度时饱和显示，不再截掉符号或高位
+  ******************************************************************************
+  */
+#include "UIWidget.h"
+#include "OLED.h"
+
+#define UI_MAX_WIDTH    16  // 一行最多 16 个字符
+
+// --- 整数格式化 (替代 sprintf，不依赖浮点) ---
+// 输出恰好 width 个字符；超出宽度时饱和到可显示的最大/最小值 (宽 2: 100 -> "99", -10 -> "-9")
+static void _FormatInt(char *buf, int32_t val, uint8_t width, uint8_t align)
+{
+    char digits[12];
+    uint8_t n = 0, neg = 0, len, pad, i;
+    uint32_t u, max_pos = 1, max_neg;
+
+    for (i = 0; i < width && i < 9; i++) max_pos *= 10;
+    max_neg = max_pos / 10;         // 负数要留一位给符号
+    max_pos -= 1;
+    max_neg = (max_neg > 0) ? max_neg - 1 : 0;
+
+    if (val == UI_VALUE_INVALID) {
+        digits[n++] = '-';
+        digits[n++] = '-';
+    } else {
+        if (val < 0) { neg = 1; u = (uint32_t)(-val); }
+        else         { u = (uint32_t)val; }
+        if (neg && u > max_neg) u = max_neg;
+        if (!neg && u > max_pos) u = max_pos;
+        if (u == 0) neg = 0;
+        do {
+            digits[n++] = '0' + (u % 10);
+            u /= 10;
+        } while (u != 0);
+        if (neg) digits[n++] = '-';
+    }
+
+    len = (n > width) ? width : n;
+    pad = width - len;
+
+    // digits 为逆序
+    if (align == UI_ALIGN_RIGHT) {
+        for (i = 0; i < pad; i++) buf[i] = ' ';
+        for (i = 0; i < len; i++) buf[pad + i] = digits[len - 1 - i];
+    } else {
+        for (i = 0; i < len; i++) buf[i] = digits[len - 1 - i];
+        for (i = 0; i < pad; i++) buf[len + i] = ' ';
+    }
+    buf[width] = '\0';
+}
+
+static void _Render(UIWidget_t *w, int32_t val)
+{
+    char buf[UI_MAX_WIDTH + 1];
+    int32_t fill;
+
+    switch (w->Type)
+    {
+        case UI_WIDGET_LABEL:
+            OLED_ShowString(w->Line, w->Column, (char*)w->Text);
+            break;
+
+        case UI_WIDGET_VALUE:
+            _FormatInt(buf, val, w->Width, w->Align);
+            OLED_ShowString(w->Line, w->Column, buf);
+            break;
+
+        case UI_WIDGET_BAR:
+            // 换算为填充像素数 (每字符 8 像素)
+            if (val < w->Min) val = w->Min;
+            if (val > w->Max) val = w->Max;
+            fill = (val - w->Min) * (w->Width * 8) / (w->Max - w->Min);
+            OLED_ShowBar(w->Line, w->Column, w->Width, (uint8_t)fill);
+            break;
+
+        case UI_WIDGET_ICON:
+            OLED_ShowString(w->Line, w->Column, (char*)w->Icons[val]);
+            break;
+    }
+}
+
+void UIWidget_Invalidate(UIWidget_t *widgets, uint8_t count)
+{
+    uint8_t i;
+    for (i = 0; i < count; i++) {
+        widgets[i].Valid = 0;
+    }
+}
+
+uint8_t UIWidget_Update(UIWidget_t *widgets, uint8_t count)
+{
+    uint8_t i, rendered = 0;
+    int32_t val;
+    UIWidget_t *w;
+
+    for (i = 0; i < count; i++)
+    {
+        w = &widgets[i];
+        val = (w->Get != 0) ? w->Get() : 0;
+
+        if (w->Valid && w->Cache == val) continue;
+
+        _Render(w, val);
+        w->Cache = val;
+        w->Valid = 1;
+        rendered++;
+    }
+    return rendered;
+}
@@ -0,0 +1,75 @@
+/**
+  ******************************************************************************
+  * @file    UIWidget.h
+  * @brief   保留模式 UI 控件 (Label / Value / Bar / Icon)
+  * @note    每个控件绑定一个模型字段读取函数并缓存上次渲染的值，
+  *          只有绑定值变化时才重新写入显存，数值格式化全部使用整数运算。
+  ******************************************************************************
+  */
+#ifndef __UI_WIDGET_H
+#define __UI_WIDGET_H
+
+#include <stdint.h>
+
+/** @brief 绑定值无效 (如传感器故障)，数值控件显示为 "--" */
+#define UI_VALUE_INVALID    ((int32_t)0x80000000)
+
+/** @brief 数值控件对齐方式 */
+#define UI_ALIGN_LEFT       0
+#define UI_ALIGN_RIGHT      1
+
+/**
+  * @brief 控件类型
+  */
+typedef enum {
+    UI_WIDGET_LABEL = 0,    /*!< 静态文本，只绘制一次 */
+    UI_WIDGET_VALUE,        /*!< 整数数值 */
+    UI_WIDGET_BAR,          /*!< 水平进度条 */
+    UI_WIDGET_ICON          /*!< 按状态索引从表中选取文本 */
+} UIWidgetType_t;
+
+/** @brief 模型字段读取函数 */
+typedef int32_t (*UIWidgetGetter_t)(void);
+
+/**
+  * @brief 控件对象
+  */
+typedef struct {
+    UIWidgetType_t      Type;
+    uint8_t             Line;       /*!< 行 (1-4) */
+    uint8_t             Column;     /*!< 起始列 (1-16) */
+    uint8_t             Width;      /*!< 占用字符数 */
+    uint8_t             Align;      /*!< VALUE: 对齐方式 */
+    const char*         Text;       /*!< LABEL: 文本 */
+    const char* const*  Icons;      /*!< ICON: 各状态文本 (每项 Width 个字符) */
+    UIWidgetGetter_t    Get;        /*!< 绑定的模型字段 (LABEL 为 NULL) */
+    int32_t             Min;        /*!< BAR: 量程下限 */
+    int32_t             Max;        /*!< BAR: 量程上限 */
+
+    int32_t             Cache;      /*!< 上次渲染时的绑定值 */
+    uint8_t             Valid;      /*!< Cache 是否有效 (0 = 下次必须重绘) */
+} UIWidget_t;
+
+/* --- 静态初始化宏 --- */
+#define UI_LABEL(line, col, text) \
+    { UI_WIDGET_LABEL, (line), (col), sizeof(text) - 1, UI_ALIGN_LEFT, (text), 0, 0, 0, 0, 0, 0 }
+#define UI_VALUE(line, col, width, align, getter) \
+    { UI_WIDGET_VALUE, (line), (col), (width), (align), 0, 0, (getter), 0, 0, 0, 0 }
+#define UI_BAR(line, col, width, getter, min, max) \
+    { UI_WIDGET_BAR, (line), (col), (width), UI_ALIGN_LEFT, 0, 0, (getter), (min), (max), 0, 0 }
+#define UI_ICON(line, col, width, icons, getter) \
+    { UI_WIDGET_ICON, (line), (col), (width), UI_ALIGN_LEFT, 0, (icons), (getter), 0, 0, 0, 0 }
+
+/**
+  * @brief  使一组控件的缓存失效，下次 Update 时全部重绘
+  */
+void UIWidget_Invalidate(UIWidget_t *widgets, uint8_t count);
+
+/**
+  * @brief  刷新一组控件
+  * @note   仅绑定值变化 (或缓存失效) 的控件会写入显存
+  * @retval 本次实际重绘的控件数
+  */
+uint8_t UIWidget_Update(UIWidget_t *widgets, uint8_t count);
+
+#endif
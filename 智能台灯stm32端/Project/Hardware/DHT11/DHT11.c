@@ -1,108 +1,124 @@
 /**
   ******************************************************************************
   * @file    DHT11.c
-  * @brief   DHT11 温湿度传感器驱动实现
+  * @brief   DHT11 温湿度传感器驱动实现 (V2.0 非阻塞)
+  * @note    协议时序 (下降沿到下降沿):
+  *          - 应答: 80us 低 + 80us 高            ≈ 160us
+  *          - 数据 '0': 50us 低 + 26~28us 高     ≈ 78us
+  *          - 数据 '1': 50us 低 + 70us 高        ≈ 120us
   ******************************************************************************
   */
 #include "DHT11.h"
-#include "SystemSupport.h" // 需要 Delay_us
+#include "SystemSupport.h" // 需要 System_GetTick
 
 #define DHT11_IO_PORT    GPIOA
 #define DHT11_IO_PIN     GPIO_Pin_1
 #define DHT11_RCC        RCC_APB2Periph_GPIOA
 
+/* 捕获资源: PA1 = TIM2_CH2, 其 DMA 请求固定在 DMA1_Channel7 */
+#define DHT11_TIM        TIM2
+#define DHT11_DMA_CH     DMA1_Channel7
+#define DHT11_DMA_FLAG   (DMA1_FLAG_GL7 | DMA1_FLAG_TC7 | DMA1_FLAG_HT7 | DMA1_FLAG_TE7)
+
+/* 时序参数 */
+#define DHT11_START_LOW_MS      20      // 主机起始低电平 (>= 18ms)
+#define DHT11_FRAME_TIMEOUT_MS  10      // 释放总线后等待整帧的最长时间 (整帧约 4~5ms)
+#define DHT11_ACK_MIN_US        120
+#define DHT11_ACK_MAX_US        220
+#define DHT11_BIT_MIN_US        60
+#define DHT11_BIT_MAX_US        160
+#define DHT11_BIT_ONE_US        100     // 大于该值判为 '1'
+
 /* 内部宏：控制 GPIO 输入输出 */
 #define DHT11_IO_OUT()   {GPIOA->CRL &= 0xFFFFFF0F; GPIOA->CRL |= 0x00000030;} // PA1 推挽输出
 #define DHT11_IO_IN()    {GPIOA->CRL &= 0xFFFFFF0F; GPIOA->CRL |= 0x00000080;} // PA1 上拉输入
 
 /* 内部宏：读写电平 */
 #define DHT11_DQ_OUT(x)  GPIO_WriteBit(DHT11_IO_PORT, DHT11_IO_PIN, (BitAction)(x))
-#define DHT11_DQ_IN      GPIO_ReadInputDataBit(DHT11_IO_PORT, DHT11_IO_PIN)
+
+/* 读取流程状态 */
+typedef enum {
+    DHT11_STATE_IDLE = 0,
+    DHT11_STATE_START_LOW,      // 主机拉低中
+    DHT11_STATE_CAPTURING       // 已释放总线，DMA 记录下降沿
+} DHT11_State_t;
+
+static DHT11_State_t    s_State = DHT11_STATE_IDLE;
+static uint32_t         s_StateTick = 0;
+static DHT11_Callback_t s_Callback = 0;
+static uint16_t         s_Edges[DHT11_EDGE_COUNT]; // DMA 目标: CCR2 捕获值
 
 /**
-  * @brief  复位 DHT11
+  * @brief  配置 TIM2 (1MHz 自由计数) + CH2 下降沿捕获 + DMA
   */
-static void DHT11_Rst(void)
+static void DHT11_Capture_Init(void)
 {
-    DHT11_IO_OUT();     // 设置为输出
-    DHT11_DQ_OUT(0);    // 拉低数据线
-    Delay_ms(20);       // 拉低至少 18ms
-    DHT11_DQ_OUT(1);    // 拉高数据线
-    Delay_us(30);       // 主机拉高 20~40us
+    TIM_TimeBaseInitTypeDef TIM_TimeBaseInitStructure;
+    TIM_ICInitTypeDef TIM_ICInitStructure;
+    DMA_InitTypeDef DMA_InitStructure;
+
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM2, ENABLE);
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+
+    TIM_TimeBaseInitStructure.TIM_ClockDivision = TIM_CKD_DIV1;
+    TIM_TimeBaseInitStructure.TIM_CounterMode = TIM_CounterMode_Up;
+    TIM_TimeBaseInitStructure.TIM_Prescaler = 72 - 1;       // 1us 分辨率
+    TIM_TimeBaseInitStructure.TIM_Period = 0xFFFF;          // 差值按 16 位回绕计算
+    TIM_TimeBaseInitStructure.TIM_RepetitionCounter = 0;
+    TIM_TimeBaseInit(DHT11_TIM, &TIM_TimeBaseInitStructure);
+
+    TIM_ICStructInit(&TIM_ICInitStructure);
+    TIM_ICInitStructure.TIM_Channel = TIM_Channel_2;
+    TIM_ICInitStructure.TIM_ICPolarity = TIM_ICPolarity_Falling;
+    TIM_ICInitStructure.TIM_ICSelection = TIM_ICSelection_DirectTI;
+    TIM_ICInitStructure.TIM_ICPrescaler = TIM_ICPSC_DIV1;
+    TIM_ICInitStructure.TIM_ICFilter = 0x3;                 // 滤除 ~100ns 毛刺
+    TIM_ICInit(DHT11_TIM, &TIM_ICInitStructure);
+    TIM_CCxCmd(DHT11_TIM, TIM_Channel_2, TIM_CCx_Disable);  // 发起读取时再打开
+
+    DMA_DeInit(DHT11_DMA_CH);
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&DHT11_TIM->CCR2;
+    DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)s_Edges;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralSRC;
+    DMA_InitStructure.DMA_BufferSize = DHT11_EDGE_COUNT;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_HalfWord;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_HalfWord;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+    DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+    DMA_Init(DHT11_DMA_CH, &DMA_InitStructure);
+
+    TIM_DMACmd(DHT11_TIM, TIM_DMA_CC2, ENABLE);
+    TIM_Cmd(DHT11_TIM, ENABLE);
 }
 
 /**
-  * @brief  检查 DHT11 是否响应
-  * @retval 0: 存在, 1: 不存在
+  * @brief  重新装填 DMA 并打开捕获
   */
-static uint8_t DHT11_Check(void)
+static void DHT11_Capture_Arm(void)
 {
-    uint8_t retry = 0;
-    DHT11_IO_IN();      // 设置为输入
-    
-    // 等待 DHT11 拉低 (响应信号)
-    while (DHT11_DQ_IN && retry < 100)
-    {
-        retry++;
-        Delay_us(1);
-    }
-    if (retry >= 100) return 1;
-    
-    retry = 0;
-    // 等待 DHT11 拉高 (响应结束)
-    while (!DHT11_DQ_IN && retry < 100)
-    {
-        retry++;
-        Delay_us(1);
-    }
-    if (retry >= 100) return 1;
-    
-    return 0;
+    DMA_Cmd(DHT11_DMA_CH, DISABLE);
+    DMA_ClearFlag(DHT11_DMA_FLAG);
+    DMA_SetCurrDataCounter(DHT11_DMA_CH, DHT11_EDGE_COUNT);
+    DMA_Cmd(DHT11_DMA_CH, ENABLE);
+
+    TIM_ClearFlag(DHT11_TIM, TIM_FLAG_CC2 | TIM_FLAG_CC2OF);
+    TIM_CCxCmd(DHT11_TIM, TIM_Channel_2, TIM_CCx_Enable);
 }
 
-/**
-  * @brief  读取一位数据
-  */
-static uint8_t DHT11_Read_Bit(void)
+static void DHT11_Capture_Stop(void)
 {
-    uint8_t retry = 0;
-    
-    // 等待变为低电平 (上一位数据结束，开始下一位)
-    while (DHT11_DQ_IN && retry < 100)
-    {
-        retry++;
-        Delay_us(1);
-    }
-    
-    retry = 0;
-    // 等待变为高电平 (数据开始传输)
-    while (!DHT11_DQ_IN && retry < 100)
-    {
-        retry++;
-        Delay_us(1);
-    }
-    
-    // 延时 40us 后检测电平
-    // '0': 高电平持续 26-28us
-    // '1': 高电平持续 70us
-    Delay_us(40);
-    
-    if (DHT11_DQ_IN) return 1;
-    else return 0;
+    TIM_CCxCmd(DHT11_TIM, TIM_Channel_2, TIM_CCx_Disable);
+    DMA_Cmd(DHT11_DMA_CH, DISABLE);
 }
 
-/**
-  * @brief  读取一个字节
-  */
-static uint8_t DHT11_Read_Byte(void)
+static void DHT11_Finish(DHT11_Status_t status, uint8_t temp, uint8_t humi)
 {
-    uint8_t i, dat = 0;
-    for (i = 0; i < 8; i++)
-    {
-        dat <<= 1;
-        dat |= DHT11_Read_Bit();
-    }
-    return dat;
+    DHT11_Callback_t cb = s_Callback;
+    s_State = DHT11_STATE_IDLE;
+    if (cb) cb(status, temp, humi);
 }
 
 /**
@@ -113,38 +129,93 @@ uint8_t DHT11_Init(void)
     GPIO_InitTypeDef GPIO_InitStructure;
     RCC_APB2PeriphClockCmd(DHT11_RCC, ENABLE);
     
+    // 空闲时上拉输入 (总线释放)，同时作为 TIM2_CH2 的捕获输入
+    GPIO_SetBits(DHT11_IO_PORT, DHT11_IO_PIN);
     GPIO_InitStructure.GPIO_Pin = DHT11_IO_PIN;
-    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_Out_PP; // 初始推挽输出
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IPU;
     GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
     GPIO_Init(DHT11_IO_PORT, &GPIO_InitStructure);
     
-    DHT11_Rst();
-    return DHT11_Check();
+    DHT11_Capture_Init();
+    s_State = DHT11_STATE_IDLE;
+    return 0;
 }
 
-/**
-  * @brief  读取温湿度数据
-  */
-uint8_t DHT11_Read_Data(uint8_t *temp, uint8_t *humi)
+uint8_t DHT11_StartRead(DHT11_Callback_t cb)
+{
+    if (s_State != DHT11_STATE_IDLE) return 1;
+
+    s_Callback = cb;
+    DHT11_IO_OUT();     // 设置为输出
+    DHT11_DQ_OUT(0);    // 拉低数据线，保持 DHT11_START_LOW_MS
+    s_StateTick = System_GetTick();
+    s_State = DHT11_STATE_START_LOW;
+    return 0;
+}
+
+void DHT11_Process(void)
 {
     uint8_t buf[5];
+    DHT11_Status_t status;
+    uint32_t now = System_GetTick();
+
+    switch (s_State)
+    {
+        case DHT11_STATE_START_LOW:
+            if (now - s_StateTick > DHT11_START_LOW_MS)
+            {
+                // 先装填捕获再释放总线: 释放产生的上升沿不会被记录
+                DHT11_Capture_Arm();
+                DHT11_DQ_OUT(1);    // ODR=1 选择上拉
+                DHT11_IO_IN();
+                s_StateTick = now;
+                s_State = DHT11_STATE_CAPTURING;
+            }
+            break;
+
+        case DHT11_STATE_CAPTURING:
+            if (DMA_GetFlagStatus(DMA1_FLAG_TC7) != RESET)
+            {
+                DHT11_Capture_Stop();
+                status = DHT11_Decode(s_Edges, buf);
+                // 只使用整数部分: buf[0] 湿度, buf[2] 温度
+                DHT11_Finish(status, buf[2], buf[0]);
+            }
+            else if (now - s_StateTick > DHT11_FRAME_TIMEOUT_MS)
+            {
+                DHT11_Capture_Stop();
+                DHT11_Finish(DHT11_ERR_TIMEOUT, 0, 0);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+DHT11_Status_t DHT11_Decode(const uint16_t *edges, uint8_t out[5])
+{
     uint8_t i;
-    
-    DHT11_Rst();
-    if (DHT11_Check() == 0)
+    uint16_t width;
+
+    for (i = 0; i < 5; i++) out[i] = 0;
+
+    // 1. 应答脉冲
+    width = (uint16_t)(edges[1] - edges[0]);
+    if (width < DHT11_ACK_MIN_US || width > DHT11_ACK_MAX_US) return DHT11_ERR_TIMING;
+
+    // 2. 40 位数据，高位在前
+    for (i = 0; i < 40; i++)
     {
-        for (i = 0; i < 5; i++)
-        {
-            buf[i] = DHT11_Read_Byte();
-        }
-        
-        // 校验和检查: buf[4] == buf[0] + buf[1] + buf[2] + buf[3]
-        if (buf[4] == (buf[0] + buf[1] + buf[2] + buf[3]))
-        {
-            *humi = buf[0]; // 湿度整数部分
-            *temp = buf[2]; // 温度整数部分
-            return 0;
-        }
+        width = (uint16_t)(edges[i + 2] - edges[i + 1]);
+        if (width < DHT11_BIT_MIN_US || width > DHT11_BIT_MAX_US) return DHT11_ERR_TIMING;
+
+        out[i / 8] <<= 1;
+        if (width > DHT11_BIT_ONE_US) out[i / 8] |= 1;
     }
-    return 1;
+
+    // 3. 校验和检查: buf[4] == buf[0] + buf[1] + buf[2] + buf[3]
+    if (out[4] != (uint8_t)(out[0] + out[1] + out[2] + out[3])) return DHT11_ERR_CHECKSUM;
+
+    return DHT11_OK;
 }
@@ -1,9 +1,12 @@
 /**
   ******************************************************************************
   * @file    DHT11.h
-  * @brief   DHT11 温湿度传感器驱动
+  * @brief   DHT11 温湿度传感器驱动 (V2.0 非阻塞)
   * @note    单总线协议，对时序要求严格
-  *          引脚: PA1
+  *          引脚: PA1 (TIM2_CH2)
+  *          起始信号的 20ms 低电平由 SysTick 计时，应答与 40 位数据由
+  *          TIM2 输入捕获 + DMA1_Channel7 记录下降沿时间戳，CPU 不参与
+  *          逐位采样。帧结束后在 DHT11_Process() 中解码并回调结果。
   ******************************************************************************
   */
 #ifndef __DHT11_H
@@ -11,18 +14,53 @@
 
 #include "stm32f10x.h"
 
+/** @brief 一帧下降沿数: 应答 1 + 数据位起始 40 + 结束低电平 1 */
+#define DHT11_EDGE_COUNT    42
+
+/**
+  * @brief 读取结果
+  */
+typedef enum {
+    DHT11_OK = 0,
+    DHT11_ERR_TIMEOUT,      /*!< 传感器无应答或帧不完整 */
+    DHT11_ERR_TIMING,       /*!< 脉宽超出协议范围 (干扰) */
+    DHT11_ERR_CHECKSUM      /*!< 校验和错误 */
+} DHT11_Status_t;
+
+/**
+  * @brief 读取完成回调 (在 DHT11_Process 中调用，非中断上下文)
+  * @param status 读取结果
+  * @param temp   温度整数部分 (仅 status == DHT11_OK 时有效)
+  * @param humi   湿度整数部分 (仅 status == DHT11_OK 时有效)
+  */
+typedef void (*DHT11_Callback_t)(DHT11_Status_t status, uint8_t temp, uint8_t humi);
+
 /**
-  * @brief  DHT11 初始化
-  * @retval 0: 成功 (检测到设备), 1: 失败
+  * @brief  DHT11 初始化 (GPIO + TIM2 输入捕获 + DMA)
+  * @retval 0: 成功
+  * @note   不再阻塞等待应答，传感器是否在线由第一次读取结果给出
   */
 uint8_t DHT11_Init(void);
 
 /**
-  * @brief  读取温湿度数据
-  * @param  temp: 温度值指针 (范围 0-50°C)
-  * @param  humi: 湿度值指针 (范围 20-90%)
-  * @retval 0: 读取成功, 1: 读取失败
+  * @brief  发起一次异步读取
+  * @param  cb: 完成回调
+  * @retval 0: 已发起, 1: 上一次读取尚未结束
+  */
+uint8_t DHT11_StartRead(DHT11_Callback_t cb);
+
+/**
+  * @brief  读取流程推进 (需在主循环中调用)
+  * @note   负责结束起始信号、检测帧完成/超时并回调
+  */
+void DHT11_Process(void);
+
+/**
+  * @brief  由下降沿时间戳解码一帧数据 (纯函数，与硬件无关)
+  * @param  edges: 下降沿计数值 (1MHz, 16 位回绕)，共 DHT11_EDGE_COUNT 个
+  * @param  out:   输出 5 字节原始数据 (湿度整数/小数, 温度整数/小数, 校验和)
+  * @retval DHT11_OK / DHT11_ERR_TIMING / DHT11_ERR_CHECKSUM
   */
-uint8_t DHT11_Read_Data(uint8_t *temp, uint8_t *humi);
+DHT11_Status_t DHT11_Decode(const uint16_t *edges, uint8_t out[5]);
 
 #endif
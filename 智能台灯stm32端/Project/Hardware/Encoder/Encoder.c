@@ -40,7 +40,13 @@ void Encoder_Init(void)
 
 int16_t Encoder_Get(void)
 {
+    static int16_t s_Remainder = 0; // 不足一格的脉冲留到下次，避免慢转时丢格
     int16_t raw_count = (int16_t)TIM_GetCounter(TIM4);
+    int16_t detents;
+
     TIM_SetCounter(TIM4, 0);
-    return (raw_count / ENCODER_HW_DIVIDER) * ENCODER_SW_MULTIPLIER;
+    raw_count += s_Remainder;
+    detents = raw_count / ENCODER_HW_DIVIDER;
+    s_Remainder = raw_count - detents * ENCODER_HW_DIVIDER;
+    return detents;
 }
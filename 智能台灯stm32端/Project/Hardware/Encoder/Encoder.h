@@ -11,9 +11,10 @@
 void Encoder_Init(void);
 
 /**
-  * @brief  获取编码器增量值
-  * @return int16_t 增量值 (正数=顺时针, 负数=逆时针)
-  * @note   调用后会自动清零计数器，适合轮询使用
+  * @brief  获取编码器增量格数
+  * @return int16_t 格数 (正数=顺时针, 负数=逆时针)
+  * @note   调用后会自动清零计数器，适合轮询使用；
+  *         换算成调节量由业务层的 EncoderAccel 按转速完成
   */
 int16_t Encoder_Get(void);
 
@@ -0,0 +1,251 @@
+/**
+  ******************************************************************************
+  * @file    KVStore.c
+  * @brief   内部 Flash 键值存储实现
+  * @note    页布局: [Magic:16][Seq:16] [记录] [记录] ... [0xFF...]
+  *          记录:   [Key:8][Len:8][CRC:16] [Data, 补齐到 4 字节]
+  *          写入顺序: Key/Len -> Data -> CRC。CRC 最后写入作为提交标志，
+  *          掉电时 CRC 仍为 0xFFFF 或不匹配，扫描时按 Len 跳过该记录。
+  *          回收时页头最后写入，新页头有效前旧页始终完整。
+  ******************************************************************************
+  */
+#include "KVStore.h"
+#include "Flash.h"
+#include <string.h>
+
+#define KV_PAGE_MAGIC       0x4B56      // "KV"
+#define KV_PAGE_HDR_SIZE    4
+#define KV_REC_HDR_SIZE     4
+#define KV_ALIGN4(n)        (((n) + 3u) & ~3u)
+#define KV_NO_ENTRY         0           // 偏移 0 是页头，不可能是记录
+
+#define KV_PAGE_ADDR(p)     (KV_BASE_ADDR + (uint32_t)(p) * FLASH_PAGE_SIZE)
+
+static uint8_t  s_ActivePage = 0;
+static uint16_t s_ActiveSeq = 0;
+static uint16_t s_WriteOff = KV_PAGE_HDR_SIZE;
+static uint16_t s_Index[KV_MAX_KEYS];   // 每个键最新有效记录在活动页内的偏移
+
+static uint32_t s_Writes = 0;
+static uint32_t s_Erases = 0;
+
+/* ============================================================
+ *                 内部辅助
+ * ============================================================ */
+
+// CRC16-CCITT (0x1021)，覆盖 Key、Len 与数据；0xFFFF 保留给“未提交”
+static uint16_t _Crc16(uint8_t key, uint8_t len, const uint8_t *data)
+{
+    uint16_t crc = 0xFFFF;
+    uint8_t hdr[2];
+    uint16_t i, total = (uint16_t)len + 2;
+
+    hdr[0] = key;
+    hdr[1] = len;
+    for (i = 0; i < total; i++) {
+        uint8_t b = (i < 2) ? hdr[i] : data[i - 2];
+        uint8_t bit;
+        crc ^= (uint16_t)b << 8;
+        for (bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return (crc == 0xFFFF) ? 0 : crc;
+}
+
+static uint8_t _ProgramBytes(uint32_t addr, const uint8_t *data, uint8_t len)
+{
+    uint8_t i;
+    for (i = 0; i < len; i += 2) {
+        uint16_t hw = data[i];
+        hw |= (i + 1 < len) ? ((uint16_t)data[i + 1] << 8) : 0xFF00;
+        if (Flash_ProgramHalfWord(addr + i, hw) != 0) return 1;
+    }
+    return 0;
+}
+
+// 在指定页追加一条记录，成功返回 0
+static uint8_t _AppendRecord(uint8_t page, uint16_t off, uint8_t key, const uint8_t *data, uint8_t len)
+{
+    uint32_t addr = KV_PAGE_ADDR(page) + off;
+
+    if (Flash_ProgramHalfWord(addr, (uint16_t)key | ((uint16_t)len << 8)) != 0) return 1;
+    if (_ProgramBytes(addr + KV_REC_HDR_SIZE, data, len) != 0) return 1;
+    if (Flash_ProgramHalfWord(addr + 2, _Crc16(key, len, data)) != 0) return 1;
+    return 0;
+}
+
+static uint8_t _ErasePage(uint8_t page)
+{
+    s_Erases++;
+    return Flash_ErasePage(KV_PAGE_ADDR(page));
+}
+
+// 页头: 先写序号，最后写 Magic 作为页有效标志
+static uint8_t _WritePageHeader(uint8_t page, uint16_t seq)
+{
+    uint32_t addr = KV_PAGE_ADDR(page);
+    if (Flash_ProgramHalfWord(addr + 2, seq) != 0) return 1;
+    return Flash_ProgramHalfWord(addr, KV_PAGE_MAGIC);
+}
+
+// 扫描活动页，重建索引与写指针
+static void _ScanActivePage(void)
+{
+    uint32_t base = KV_PAGE_ADDR(s_ActivePage);
+    uint16_t off = KV_PAGE_HDR_SIZE;
+
+    memset(s_Index, 0, sizeof(s_Index));
+
+    while (off + KV_REC_HDR_SIZE <= FLASH_PAGE_SIZE)
+    {
+        uint32_t hdr = Flash_ReadWord(base + off);
+        uint8_t key = (uint8_t)(hdr & 0xFF);
+        uint8_t len = (uint8_t)((hdr >> 8) & 0xFF);
+        uint16_t crc = (uint16_t)(hdr >> 16);
+        uint16_t rec_size = KV_REC_HDR_SIZE + KV_ALIGN4(len);
+
+        if (hdr == 0xFFFFFFFF) break; // 日志末尾
+
+        // 头部损坏 (掉电撕裂)，无法确定后续位置：放弃剩余空间，下次写入时回收
+        if (key >= KV_MAX_KEYS || len > KV_MAX_VALUE_LEN || off + rec_size > FLASH_PAGE_SIZE) {
+            off = FLASH_PAGE_SIZE;
+            break;
+        }
+
+        // 仅接受已提交且校验正确的记录
+        if (crc != 0xFFFF && crc == _Crc16(key, len, (const uint8_t *)(base + off + KV_REC_HDR_SIZE))) {
+            s_Index[key] = off;
+        }
+        off += rec_size;
+    }
+
+    s_WriteOff = off;
+}
+
+// 把每个键的最新值搬到下一页，成为新的活动页
+KV_Status_t KV_Compact(void)
+{
+    uint8_t target = (uint8_t)((s_ActivePage + 1) % KV_PAGE_COUNT);
+    uint32_t src_base = KV_PAGE_ADDR(s_ActivePage);
+    uint16_t new_index[KV_MAX_KEYS];
+    uint16_t off = KV_PAGE_HDR_SIZE;
+    uint8_t key;
+
+    if (_ErasePage(target) != 0) return KV_ERR_FLASH;
+
+    memset(new_index, 0, sizeof(new_index));
+    for (key = 0; key < KV_MAX_KEYS; key++) {
+        uint32_t rec;
+        uint8_t len;
+
+        if (s_Index[key] == KV_NO_ENTRY) continue;
+        rec = src_base + s_Index[key];
+        len = Flash_ReadByte(rec + 1);
+
+        if (_AppendRecord(target, off, key, (const uint8_t *)(rec + KV_REC_HDR_SIZE), len) != 0) {
+            return KV_ERR_FLASH;
+        }
+        new_index[key] = off;
+        off += KV_REC_HDR_SIZE + KV_ALIGN4(len);
+    }
+
+    // 提交：新页头写入后，新页序号更大，旧页自动作废
+    if (_WritePageHeader(target, (uint16_t)(s_ActiveSeq + 1)) != 0) return KV_ERR_FLASH;
+
+    s_ActivePage = target;
+    s_ActiveSeq++;
+    s_WriteOff = off;
+    memcpy(s_Index, new_index, sizeof(s_Index));
+    return KV_OK;
+}
+
+/* ============================================================
+ *                 接口实现
+ * ============================================================ */
+
+KV_Status_t KV_Init(void)
+{
+    uint8_t page, found = 0;
+
+    // 1. 找到序号最新的有效页 (序号允许回绕，按差值比较)
+    for (page = 0; page < KV_PAGE_COUNT; page++) {
+        uint32_t addr = KV_PAGE_ADDR(page);
+        uint16_t seq;
+
+        if (Flash_ReadHalfWord(addr) != KV_PAGE_MAGIC) continue;
+        seq = Flash_ReadHalfWord(addr + 2);
+        if (!found || (int16_t)(seq - s_ActiveSeq) > 0) {
+            s_ActivePage = page;
+            s_ActiveSeq = seq;
+            found = 1;
+        }
+    }
+
+    // 2. 首次使用：格式化第一页
+    if (!found) {
+        s_ActivePage = 0;
+        s_ActiveSeq = 0;
+        if (_ErasePage(0) != 0 || _WritePageHeader(0, 0) != 0) return KV_ERR_FLASH;
+    }
+
+    // 3. 建立索引
+    _ScanActivePage();
+    return KV_OK;
+}
+
+KV_Status_t KV_Read(uint8_t key, void *buf, uint8_t len)
+{
+    uint32_t rec;
+
+    if (key >= KV_MAX_KEYS) return KV_ERR_PARAM;
+    if (s_Index[key] == KV_NO_ENTRY) return KV_ERR_NOT_FOUND;
+
+    rec = KV_PAGE_ADDR(s_ActivePage) + s_Index[key];
+    if (Flash_ReadByte(rec + 1) != len) return KV_ERR_PARAM; // 结构体版本不匹配
+
+    memcpy(buf, (const void *)(rec + KV_REC_HDR_SIZE), len);
+    return KV_OK;
+}
+
+uint8_t KV_NeedsCompact(uint8_t len)
+{
+    return (s_WriteOff + KV_REC_HDR_SIZE + KV_ALIGN4(len) > FLASH_PAGE_SIZE) ? 1 : 0;
+}
+
+KV_Status_t KV_Write(uint8_t key, const void *data, uint8_t len)
+{
+    uint8_t value[KV_MAX_VALUE_LEN];
+
+    if (key >= KV_MAX_KEYS || len > KV_MAX_VALUE_LEN) return KV_ERR_PARAM;
+
+    // 1. 值未变化则跳过，避免无意义的磨损
+    if (KV_Read(key, value, len) == KV_OK && memcmp(value, data, len) == 0) return KV_OK;
+
+    // 2. 空间不足先回收 (回收后仍放不下说明键太多/值太大)
+    if (KV_NeedsCompact(len)) {
+        if (KV_Compact() != KV_OK) return KV_ERR_FLASH;
+        if (KV_NeedsCompact(len)) return KV_ERR_PARAM;
+    }
+
+    // 3. 追加记录 (先拷贝到 RAM，data 可能就指向 Flash 内的旧记录)
+    memcpy(value, data, len);
+    if (_AppendRecord(s_ActivePage, s_WriteOff, key, value, len) != 0) {
+        // 该位置可能已被部分编程，跳到页尾，下次写入时回收
+        s_WriteOff = FLASH_PAGE_SIZE;
+        return KV_ERR_FLASH;
+    }
+
+    s_Index[key] = s_WriteOff;
+    s_WriteOff += KV_REC_HDR_SIZE + KV_ALIGN4(len);
+    s_Writes++;
+    return KV_OK;
+}
+
+void KV_GetStats(KV_Stats_t *stats)
+{
+    stats->Writes = s_Writes;
+    stats->Erases = s_Erases;
+    stats->FreeBytes = (uint16_t)(FLASH_PAGE_SIZE - s_WriteOff);
+    stats->ActiveSeq = s_ActiveSeq;
+}
@@ -0,0 +1,71 @@
+#ifndef __KV_STORE_H
+#define __KV_STORE_H
+
+#include <stdint.h>
+#include "Config.h"
+
+/**
+  ******************************************************************************
+  * @file    KVStore.h
+  * @brief   内部 Flash 键值存储 (日志结构 + 磨损均衡)
+  * @note    1. 占用 KV_PAGE_COUNT 个连续页，同一时刻只有一页为活动页
+  *          2. 写入只追加记录，不擦除；活动页写满时把每个键的最新值
+  *             搬到下一页 (垃圾回收)，各页轮流擦除
+  *          3. 每条记录带 CRC，掉电造成的半条记录在启动扫描时被丢弃
+  *          4. 启动时建立 RAM 索引，读取为 O(1)
+  ******************************************************************************
+  */
+
+/**
+  * @brief 返回码
+  */
+typedef enum {
+    KV_OK = 0,
+    KV_ERR_NOT_FOUND,       /*!< 键不存在 */
+    KV_ERR_PARAM,           /*!< 键越界或长度超限 */
+    KV_ERR_FLASH            /*!< 擦写失败 */
+} KV_Status_t;
+
+/**
+  * @brief 运行统计
+  */
+typedef struct {
+    uint32_t Writes;        /*!< 实际追加的记录数 (值未变化的写入不计) */
+    uint32_t Erases;        /*!< 本次上电以来的擦除次数 */
+    uint16_t FreeBytes;     /*!< 活动页剩余空间 */
+    uint16_t ActiveSeq;     /*!< 活动页序号 (每次回收 +1) */
+} KV_Stats_t;
+
+/**
+  * @brief  扫描 Flash 并建立索引 (上电调用一次)
+  */
+KV_Status_t KV_Init(void);
+
+/**
+  * @brief  读取键值
+  * @param  key: 0 ~ KV_MAX_KEYS-1
+  * @param  buf: 输出缓冲区
+  * @param  len: 期望长度，必须与写入时一致
+  */
+KV_Status_t KV_Read(uint8_t key, void *buf, uint8_t len);
+
+/**
+  * @brief  写入键值 (值未变化时直接返回，不占用 Flash)
+  * @note   可能触发一次页擦除 (阻塞约 20ms)
+  */
+KV_Status_t KV_Write(uint8_t key, const void *data, uint8_t len);
+
+/**
+  * @brief  写入 len 字节的记录是否需要先回收 (即本次写入会擦页)
+  */
+uint8_t KV_NeedsCompact(uint8_t len);
+
+/**
+  * @brief  立即执行回收 (擦除下一页并搬移有效记录)
+  * @note   供上层在空闲时主动调用，使之后的 KV_Write 不再触发擦除
+  */
+KV_Status_t KV_Compact(void);
+
+void KV_GetStats(KV_Stats_t *stats);
+
+#endif
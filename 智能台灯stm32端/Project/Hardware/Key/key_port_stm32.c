@@ -0,0 +1,39 @@
+/* Hardware/Key/key_port_stm32.c */
+/**
+  ******************************************************************************
+  * @file    key_port_stm32.c
+  * @brief   按键引擎 STM32 移植层 (Common/KeyEngine)
+  * @note    Port 为 GPIO_TypeDef*，Pin 为 GPIO_Pin_x。GPIO 时钟需在外部开启。
+  *          STM32 端按键与编码器共用 5ms 的 input 任务轮询，不使用引脚中断唤醒
+  ******************************************************************************
+  */
+#include "Key.h"
+#include "stm32f10x.h"
+#include "SystemSupport.h" // 提供 System_GetTick()
+
+// 硬件初始化适配
+void Key_HAL_Init_Pin(void *port, uint32_t pin, uint8_t active_level)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+    GPIO_InitStructure.GPIO_Pin = (uint16_t)pin;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+
+    if (active_level == 0) {
+        GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IPU; // 低电平有效 -> 上拉输入
+    } else {
+        GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IPD; // 高电平有效 -> 下拉输入
+    }
+    GPIO_Init((GPIO_TypeDef*)port, &GPIO_InitStructure);
+}
+
+// 硬件读取适配
+uint8_t Key_HAL_Read_Pin(void *port, uint32_t pin)
+{
+    return GPIO_ReadInputDataBit((GPIO_TypeDef*)port, (uint16_t)pin);
+}
+
+// 时间获取适配 (ms)
+uint32_t Key_HAL_GetTick(void)
+{
+    return System_GetTick();
+}
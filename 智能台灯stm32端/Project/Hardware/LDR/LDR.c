@@ -1,9 +1,41 @@
 #include "LDR.h"
 
+#define LDR_BLOCK_SIZE      (LDR_DMA_BUF_SIZE / 2)
+
+// DMA 循环缓冲区 (ADC1->DR)
+static volatile uint16_t s_AdcBuf[LDR_DMA_BUF_SIZE];
+
+// IIR 状态: Q8 定点 (ADC 值 << 8)
+static volatile uint32_t s_FilterQ8 = 0;
+static volatile uint8_t  s_FilterPrimed = 0;
+
+// 块平均后送入 IIR: y += (x - y) >> SHIFT
+static void _FilterBlock(volatile uint16_t *block)
+{
+    uint32_t sum = 0;
+    int32_t x, y;
+    for (int i = 0; i < LDR_BLOCK_SIZE; i++) {
+        sum += block[i];
+    }
+    x = (int32_t)((sum << 8) / LDR_BLOCK_SIZE);
+
+    if (!s_FilterPrimed) {
+        // 第一块直接作为初值，避免上电后从 0 慢慢爬升
+        s_FilterQ8 = (uint32_t)x;
+        s_FilterPrimed = 1;
+        return;
+    }
+    y = (int32_t)s_FilterQ8;
+    y += (x - y) >> LDR_FILTER_SHIFT;
+    s_FilterQ8 = (uint32_t)y;
+}
+
 void LDR_Init(void)
 {
-    // 1. 开启 GPIOA 和 ADC1 时钟
+    // 1. 开启 GPIOA、ADC1、DMA1 时钟 (TIM3 时钟由 LED 模块开启，这里重复打开无副作用)
     RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA | RCC_APB2Periph_ADC1, ENABLE);
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM3, ENABLE);
     
     // 2. 配置 ADC 时钟分频 (72MHz / 6 = 12MHz, 不超过 14MHz)
     RCC_ADCCLKConfig(RCC_PCLK2_Div6);
@@ -14,49 +46,87 @@ void LDR_Init(void)
     GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AIN;
     GPIO_Init(GPIOA, &GPIO_InitStructure);
 
-    // 4. ADC 初始化
+    // 4. DMA1_Channel1: ADC1->DR -> s_AdcBuf (循环模式)
+    DMA_InitTypeDef DMA_InitStructure;
+    DMA_DeInit(DMA1_Channel1);
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&ADC1->DR;
+    DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)s_AdcBuf;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralSRC;
+    DMA_InitStructure.DMA_BufferSize = LDR_DMA_BUF_SIZE;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_HalfWord;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_HalfWord;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Circular;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_Low;
+    DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+    DMA_Init(DMA1_Channel1, &DMA_InitStructure);
+    DMA_ITConfig(DMA1_Channel1, DMA_IT_HT | DMA_IT_TC, ENABLE);
+    DMA_Cmd(DMA1_Channel1, ENABLE);
+
+    NVIC_InitTypeDef NVIC_InitStructure;
+    NVIC_InitStructure.NVIC_IRQChannel = DMA1_Channel1_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 3; // 最低，仅做滤波
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+
+    // 5. ADC 初始化: 单次转换，由 TIM3 TRGO 外部触发
     ADC_InitTypeDef ADC_InitStructure;
     ADC_InitStructure.ADC_Mode = ADC_Mode_Independent;
     ADC_InitStructure.ADC_ScanConvMode = DISABLE;
     ADC_InitStructure.ADC_ContinuousConvMode = DISABLE;
-    ADC_InitStructure.ADC_ExternalTrigConv = ADC_ExternalTrigConv_None;
+    ADC_InitStructure.ADC_ExternalTrigConv = ADC_ExternalTrigConv_T3_TRGO;
     ADC_InitStructure.ADC_DataAlign = ADC_DataAlign_Right;
     ADC_InitStructure.ADC_NbrOfChannel = 1;
     ADC_Init(ADC1, &ADC_InitStructure);
 
-    // 5. 使能 ADC 并校准
+    // 光敏电阻分压阻抗较高，使用最长采样时间
+    ADC_RegularChannelConfig(ADC1, ADC_Channel_0, 1, ADC_SampleTime_239Cycles5);
+    ADC_DMACmd(ADC1, ENABLE);
+
+    // 6. 使能 ADC 并校准
     ADC_Cmd(ADC1, ENABLE);
     
     ADC_ResetCalibration(ADC1);
     while(ADC_GetResetCalibrationStatus(ADC1));
     ADC_StartCalibration(ADC1);
     while(ADC_GetCalibrationStatus(ADC1));
+
+    // 7. TIM3 每个 PWM 周期 (1kHz) 输出一次 TRGO，开始触发转换
+    TIM_SelectOutputTrigger(TIM3, TIM_TRGOSource_Update);
+    ADC_ExternalTrigConvCmd(ADC1, ENABLE);
 }
 
 uint16_t LDR_GetRawValue(void)
 {
-    // 设置序列、通道和采样时间
-    ADC_RegularChannelConfig(ADC1, ADC_Channel_0, 1, ADC_SampleTime_55Cycles5);
-    
-    // 软件触发转换
-    ADC_SoftwareStartConvCmd(ADC1, ENABLE);
-    
-    // 等待转换完成
-    while(ADC_GetFlagStatus(ADC1, ADC_FLAG_EOC) == RESET);
-    
-    return ADC_GetConversionValue(ADC1);
+    // 四舍五入：上升阶跃时 IIR 截断会停在目标下方 1~15 (Q8)，直接右移会一直少 1
+    return (uint16_t)((s_FilterQ8 + 128) >> 8);
 }
 
 uint16_t LDR_GetLuxPercentage(void)
 {
-    uint32_t sum = 0;
-    // 连续采样 8 次取平均值，滤除高频噪声
-    for(int i = 0; i < 8; i++) {
-        sum += LDR_GetRawValue();
+    // 将 0-4095 映射到 0-1000，光越强数值越大 (分压方向由 LDR_INVERT 统一)
+    uint32_t raw = LDR_GetRawValue();
+#if LDR_INVERT
+    raw = 4095 - raw;
+#endif
+    return (uint16_t)((raw * 1000) / 4095);
+}
+
+// --- 中断处理 ---
+
+// DMA 半满 / 全满: 处理刚写完的那一半
+void DMA1_Channel1_IRQHandler(void)
+{
+    if (DMA_GetITStatus(DMA1_IT_HT1))
+    {
+        DMA_ClearITPendingBit(DMA1_IT_HT1);
+        _FilterBlock(&s_AdcBuf[0]);
+    }
+    if (DMA_GetITStatus(DMA1_IT_TC1))
+    {
+        DMA_ClearITPendingBit(DMA1_IT_TC1);
+        _FilterBlock(&s_AdcBuf[LDR_BLOCK_SIZE]);
     }
-    uint16_t avg = sum / 8;
-    
-    // 将 0-4095 映射到 0-1000
-    // 注意：如果你的电路是光强越大电压越高，直接映射即可
-    return (uint16_t)((avg * 1000) / 4095);
 }
@@ -1,20 +1,36 @@
 /**
  * @file LDR.h
  * @brief 光敏电阻驱动，使用 ADC1_IN0 (PA0)
+ * @note  V2.0: ADC 由 TIM3 更新事件 (1kHz) 触发，DMA1_Channel1 循环写入缓冲区，
+ *        半满/全满中断中做块平均 + 一阶 IIR 定点滤波，读取接口为 O(1)。
+ *        V2.1: 读取时对 Q8 滤波值四舍五入，消除上升阶跃后的 1 LSB 稳态偏差。
+ *        V2.2: LDR_INVERT 适配分压方向相反的模块。
  */
 #ifndef __LDR_H
 #define __LDR_H
 
 #include "stm32f10x.h"
 
+// --- 配置 ---
+#define LDR_DMA_BUF_SIZE    16  // DMA 循环缓冲区 (半区 8 个样本做一次块平均)
+// IIR 系数 = 1/2^LDR_FILTER_SHIFT，块更新率 125Hz
+// 时间常数 ≈ 2^SHIFT * 8ms (SHIFT=4 -> 128ms, 截止频率约 1.2Hz)
+#define LDR_FILTER_SHIFT    4
+// 自动调光要求"光越强读数越大"：光敏电阻接 VCC 侧、定值电阻接 GND 时成立；
+// 常见模块把光敏电阻接在 GND 侧 (光越强 AO 电压越低)，此时置 1
+#ifndef LDR_INVERT
+#define LDR_INVERT          0
+#endif
+
 /**
- * @brief 初始化 LDR 所需的 ADC 和 GPIO
+ * @brief 初始化 LDR 所需的 ADC、DMA 和 GPIO
+ * @note  借用 TIM3 (LED PWM, 1kHz) 的 TRGO 作为 ADC 触发源
  */
 void LDR_Init(void);
 
 /**
- * @brief 获取当前环境光强度原始值
- * @return uint16_t ADC 采样值 (0-4095)
+ * @brief 获取滤波后的环境光强度原始值
+ * @return uint16_t ADC 值 (0-4095)
  */
 uint16_t LDR_GetRawValue(void);
 
@@ -0,0 +1,81 @@
+/**
+  ******************************************************************************
+  * @file    LogPort.c
+  * @brief   调试日志专用串口实现 (USART2 TXE 中断发送)
+  ******************************************************************************
+  */
+#include "LogPort.h"
+
+#define LOGPORT_MASK            (LOGPORT_TX_BUF_SIZE - 1)
+
+static uint8_t s_TxBuf[LOGPORT_TX_BUF_SIZE];
+static volatile uint16_t s_TxHead = 0;     // 写入位置 (主循环)
+static volatile uint16_t s_TxTail = 0;     // 读取位置 (中断)
+
+void LogPort_Init(void)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+    USART_InitTypeDef USART_InitStructure;
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA, ENABLE);
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_USART2, ENABLE);
+
+    // PA2 USART2_TX (不使用 RX，PA3 保持默认)
+    GPIO_InitStructure.GPIO_Pin = GPIO_Pin_2;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF_PP;
+    GPIO_Init(GPIOA, &GPIO_InitStructure);
+
+    USART_InitStructure.USART_BaudRate = DLOG_BAUDRATE;
+    USART_InitStructure.USART_WordLength = USART_WordLength_8b;
+    USART_InitStructure.USART_StopBits = USART_StopBits_1;
+    USART_InitStructure.USART_Parity = USART_Parity_No;
+    USART_InitStructure.USART_HardwareFlowControl = USART_HardwareFlowControl_None;
+    USART_InitStructure.USART_Mode = USART_Mode_Tx;
+    USART_Init(USART2, &USART_InitStructure);
+
+    // 最低抢占优先级：日志让位于协议串口 (1) 与传感器中断
+    NVIC_InitStructure.NVIC_IRQChannel = USART2_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 3;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 3;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+
+    s_TxHead = 0;
+    s_TxTail = 0;
+    USART_Cmd(USART2, ENABLE);
+}
+
+uint8_t LogPort_Write(const uint8_t *data, uint16_t len)
+{
+    uint16_t head = s_TxHead;
+    uint16_t used = (uint16_t)((head - s_TxTail) & LOGPORT_MASK);
+    uint16_t i;
+
+    if (len == 0 || len > LOGPORT_TX_BUF_SIZE - 1 - used) return 0;
+
+    for (i = 0; i < len; i++) {
+        s_TxBuf[(head + i) & LOGPORT_MASK] = data[i];
+    }
+    s_TxHead = (head + len) & LOGPORT_MASK;
+
+    // 发送寄存器空中断在缓冲区取空后关闭，写入后重新打开
+    USART_ITConfig(USART2, USART_IT_TXE, ENABLE);
+    return 1;
+}
+
+void USART2_IRQHandler(void)
+{
+    if (USART_GetITStatus(USART2, USART_IT_TXE) != RESET)
+    {
+        uint16_t tail = s_TxTail;
+
+        if (tail == s_TxHead) {
+            USART_ITConfig(USART2, USART_IT_TXE, DISABLE);
+        } else {
+            USART2->DR = s_TxBuf[tail];
+            s_TxTail = (tail + 1) & LOGPORT_MASK;
+        }
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef __LOG_PORT_H
+#define __LOG_PORT_H
+
+#include "stm32f10x.h"
+#include "Config.h"
+
+/**
+  ******************************************************************************
+  * @file    LogPort.h
+  * @brief   调试日志专用串口 (USART2 仅发送, TX = PA2)
+  * @note    1. 与协议串口 USART1 分离，日志不再占用协议发送缓冲区
+  *          2. USART2 的 TX DMA 通道 (DMA1_Channel7) 已被 DHT11 捕获占用，
+  *             改为 TXE 中断逐字节发送，中断优先级低于协议串口与传感器
+  *          3. 写入为整块写入，空间不足时整条丢弃，由调用者统计
+  ******************************************************************************
+  */
+
+#define LOGPORT_TX_BUF_SIZE     256     // 发送环形缓冲区 (2 的幂)
+
+/**
+  * @brief  初始化 USART2 (DLOG_BAUDRATE, 8N1, 仅发送)
+  */
+void LogPort_Init(void);
+
+/**
+  * @brief  写入一段数据
+  * @return 1=成功, 0=空间不足 (未写入任何字节)
+  * @note   仅限主循环上下文调用
+  */
+uint8_t LogPort_Write(const uint8_t *data, uint16_t len);
+
+#endif
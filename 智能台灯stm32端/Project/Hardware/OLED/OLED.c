@@ -1,17 +1,41 @@
 /**
   ******************************************************************************
   * @file    OLED.c
-  * @brief   OLED 驱动 (V6.3 Init Fix)
+  * @brief   OLED 驱动 (V7.1 Sliced Flush)
+  * @note    绘图函数只修改 RAM 显存并记录每页的脏列区间，
+  *          由 OLED_Refresh() 将每段脏区间以一次 I2C 传输写入屏幕。
+  *          V7.1: OLED_RefreshStep() 按字节预算分片刷新，可跨多次调用续传。
   ******************************************************************************
   */
 #include "stm32f10x.h"
 #include "OLED.h"
 #include "OLED_Font.h"
 #include "I2C_Driver.h"
+#include <string.h>
 
 #define OLED_I2C_ADDR   0x78
 #define OLED_I2C        I2C1
 
+#define OLED_CTRL_CMD   0x00    // 控制字节: 后续为命令流
+#define OLED_CTRL_DATA  0x40    // 控制字节: 后续为显存数据流
+
+#define OLED_DIRTY_NONE 0xFF    // 该页无脏区间
+
+// 每段传输的固定开销: 定位 (地址+控制+3 命令) + 数据 (地址+控制)
+#define OLED_CHUNK_OVERHEAD     7
+
+// --- 显存 (128 x 64, 按 SSD1306 页格式排列, 共 1KB) ---
+static uint8_t s_FrameBuf[OLED_PAGES][OLED_WIDTH];
+
+// 每页脏列区间 [s_DirtyStart, s_DirtyEnd]
+static uint8_t s_DirtyStart[OLED_PAGES];
+static uint8_t s_DirtyEnd[OLED_PAGES];
+
+// --- 分片刷新状态 ---
+static uint8_t s_FlushPage = 0;         // 下一次续传从哪一页开始 (轮转，避免饿死)
+static uint8_t s_FramePending = 0;      // 自上次刷完后是否有新内容写入
+static OLED_RefreshDoneCallback_t s_RefreshDoneCb = NULL;
+
 /**
   * @brief  检测 OLED 是否连接正常
   */
@@ -32,47 +56,182 @@ static void OLED_WriteCommand(uint8_t Command)
     I2C_Lib_WriteDirect(OLED_I2C, OLED_I2C_ADDR, data, 2);
 }
 
-static void OLED_WriteData(uint8_t Data)
+void OLED_SetCursor(uint8_t Y, uint8_t X)
 {
-    uint8_t data[2];
-    data[0] = 0x40; 
-    data[1] = Data;
-    I2C_Lib_WriteDirect(OLED_I2C, OLED_I2C_ADDR, data, 2);
+    // 三条定位命令合并为一次传输
+    uint8_t cmd[3];
+    cmd[0] = 0xB0 | Y;
+    cmd[1] = 0x10 | ((X & 0xF0) >> 4);
+    cmd[2] = 0x00 | (X & 0x0F);
+    I2C_Lib_Write(OLED_I2C, OLED_I2C_ADDR, OLED_CTRL_CMD, cmd, 3);
 }
 
-void OLED_SetCursor(uint8_t Y, uint8_t X)
+static void OLED_MarkDirty(uint8_t Page, uint8_t X0, uint8_t X1)
 {
-    OLED_WriteCommand(0xB0 | Y);
-    OLED_WriteCommand(0x10 | ((X & 0xF0) >> 4));
-    OLED_WriteCommand(0x00 | (X & 0x0F));
+    s_FramePending = 1;
+    if (s_DirtyStart[Page] == OLED_DIRTY_NONE)
+    {
+        s_DirtyStart[Page] = X0;
+        s_DirtyEnd[Page] = X1;
+        return;
+    }
+    if (X0 < s_DirtyStart[Page]) s_DirtyStart[Page] = X0;
+    if (X1 > s_DirtyEnd[Page])   s_DirtyEnd[Page] = X1;
 }
 
-void OLED_Clear(void)
+// 将一段数据写入显存，仅内容确实变化的列才记为脏
+static void OLED_BufWrite(uint8_t Page, uint8_t X, const uint8_t *Data, uint8_t Len)
 {
-    uint8_t i, j;
-    for (j = 0; j < 8; j++)
+    uint8_t i;
+    uint8_t first = OLED_DIRTY_NONE, last = 0;
+    uint8_t *dst = &s_FrameBuf[Page][X];
+
+    for (i = 0; i < Len; i++)
     {
-        OLED_SetCursor(j, 0);
-        for (i = 0; i < 128; i++)
+        if (dst[i] != Data[i])
         {
-            OLED_WriteData(0x00);
+            dst[i] = Data[i];
+            if (first == OLED_DIRTY_NONE) first = i;
+            last = i;
         }
     }
+    if (first != OLED_DIRTY_NONE)
+    {
+        OLED_MarkDirty(Page, X + first, X + last);
+    }
 }
 
-void OLED_ShowChar(uint8_t Line, uint8_t Column, char Char)
+/**
+  * @brief  按字节预算刷新一部分脏区间
+  * @note   单页脏区间超出预算时拆段发送，剩余部分留到下次调用；
+  *         预算不足一段的固定开销时按开销 + 1 字节处理，保证每次调用都有进展
+  */
+uint8_t OLED_RefreshStep(uint16_t ByteBudget)
 {
-    uint8_t i;
-    OLED_SetCursor((Line - 1) * 2, (Column - 1) * 8);
-    for (i = 0; i < 8; i++)
+    uint8_t page, start, clean = 0;
+    uint16_t len;
+
+    if (ByteBudget <= OLED_CHUNK_OVERHEAD) ByteBudget = OLED_CHUNK_OVERHEAD + 1;
+
+    while (clean < OLED_PAGES)
+    {
+        page = s_FlushPage;
+        start = s_DirtyStart[page];
+        if (start == OLED_DIRTY_NONE)
+        {
+            s_FlushPage = (page + 1) % OLED_PAGES;
+            clean++;
+            continue;
+        }
+
+        if (ByteBudget <= OLED_CHUNK_OVERHEAD) return 0; // 本次预算用尽
+
+        len = s_DirtyEnd[page] - start + 1;
+        if (len > ByteBudget - OLED_CHUNK_OVERHEAD) len = ByteBudget - OLED_CHUNK_OVERHEAD;
+
+        OLED_SetCursor(page, start);
+        I2C_Lib_Write(OLED_I2C, OLED_I2C_ADDR, OLED_CTRL_DATA, &s_FrameBuf[page][start], len);
+        ByteBudget -= OLED_CHUNK_OVERHEAD + len;
+
+        if (start + len > s_DirtyEnd[page])
+        {
+            s_DirtyStart[page] = OLED_DIRTY_NONE;
+            s_FlushPage = (page + 1) % OLED_PAGES;
+        }
+        else
+        {
+            s_DirtyStart[page] = start + len;
+        }
+        clean = 0;
+    }
+
+    // 所有页都已干净：一帧刷新完成
+    if (s_FramePending)
     {
-        OLED_WriteData(OLED_F8x16[Char - ' '][i]);
+        s_FramePending = 0;
+        if (s_RefreshDoneCb) s_RefreshDoneCb();
     }
-    OLED_SetCursor((Line - 1) * 2 + 1, (Column - 1) * 8);
-    for (i = 0; i < 8; i++)
+    return 1;
+}
+
+/**
+  * @brief  将所有脏区间写入屏幕 (阻塞)
+  */
+void OLED_Refresh(void)
+{
+    while (OLED_RefreshStep(0xFFFF) == 0);
+}
+
+uint8_t OLED_IsRefreshPending(void)
+{
+    return s_FramePending;
+}
+
+void OLED_SetRefreshDoneCallback(OLED_RefreshDoneCallback_t Callback)
+{
+    s_RefreshDoneCb = Callback;
+}
+
+/**
+  * @brief  清空显存
+  * @note   屏幕 GDDRAM 内容未知 (如上电)，因此整屏标脏而不做比较
+  */
+void OLED_Clear(void)
+{
+    uint8_t page;
+    memset(s_FrameBuf, 0, sizeof(s_FrameBuf));
+    for (page = 0; page < OLED_PAGES; page++)
     {
-        OLED_WriteData(OLED_F8x16[Char - ' '][i + 8]);
+        s_DirtyStart[page] = 0;
+        s_DirtyEnd[page] = OLED_WIDTH - 1;
     }
+    s_FramePending = 1;
+}
+
+void OLED_ShowChar(uint8_t Line, uint8_t Column, char Char)
+{
+    uint8_t page, x;
+    // 超出 4 行 x 16 列的字符直接裁掉
+    if (Line < 1 || Line > OLED_PAGES / 2 || Column < 1 || Column > OLED_WIDTH / 8) return;
+
+    page = (Line - 1) * 2;
+    x = (Column - 1) * 8;
+    OLED_BufWrite(page,     x, &OLED_F8x16[Char - ' '][0], 8);
+    OLED_BufWrite(page + 1, x, &OLED_F8x16[Char - ' '][8], 8);
+}
+
+/**
+  * @brief  显示水平进度条 (占一个字符行高度，垂直居中 8 像素)
+  * @param  Width: 占用字符数
+  * @param  Fill:  已填充像素数 (0 ~ Width*8)
+  */
+void OLED_ShowBar(uint8_t Line, uint8_t Column, uint8_t Width, uint8_t Fill)
+{
+    uint8_t upper[OLED_WIDTH], lower[OLED_WIDTH];
+    uint8_t i, page, x, px;
+
+    if (Line < 1 || Line > OLED_PAGES / 2 || Column < 1 || Column > OLED_WIDTH / 8) return;
+    if (Width > OLED_WIDTH / 8 - (Column - 1)) Width = OLED_WIDTH / 8 - (Column - 1);
+
+    px = Width * 8;
+    for (i = 0; i < px; i++)
+    {
+        if (i == 0 || i == px - 1 || i < Fill)
+        {
+            upper[i] = 0xF0;    // 第 4~7 行
+            lower[i] = 0x0F;    // 第 8~11 行
+        }
+        else
+        {
+            upper[i] = 0x10;    // 空白段只画上下边框
+            lower[i] = 0x08;
+        }
+    }
+
+    page = (Line - 1) * 2;
+    x = (Column - 1) * 8;
+    OLED_BufWrite(page,     x, upper, px);
+    OLED_BufWrite(page + 1, x, lower, px);
 }
 
 void OLED_ShowString(uint8_t Line, uint8_t Column, char *String)
@@ -190,5 +349,6 @@ void OLED_Init(void)
     OLED_WriteCommand(0x14);
     OLED_WriteCommand(0xAF); 
 
+    // 仅清空显存并整屏标脏，实际写屏由调用者 (UIManager) 分片完成
     OLED_Clear();
 }
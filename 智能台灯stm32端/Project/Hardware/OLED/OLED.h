@@ -3,6 +3,11 @@
 
 #include "stm32f10x.h"
 
+#define OLED_WIDTH      128
+#define OLED_PAGES      8       // 64 行 / 每页 8 行
+
+typedef void (*OLED_RefreshDoneCallback_t)(void);
+
 void OLED_Init(void);
 void OLED_Clear(void);
 void OLED_ShowChar(uint8_t Line, uint8_t Column, char Char);
@@ -12,6 +17,36 @@ void OLED_ShowSignedNum(uint8_t Line, uint8_t Column, int32_t Number, uint8_t Le
 void OLED_ShowHexNum(uint8_t Line, uint8_t Column, uint32_t Number, uint8_t Length);
 void OLED_ShowBinNum(uint8_t Line, uint8_t Column, uint32_t Number, uint8_t Length);
 
+/**
+  * @brief  [新增] 显示水平进度条
+  * @param  Width: 占用字符数
+  * @param  Fill:  已填充像素数 (0 ~ Width*8)
+  */
+void OLED_ShowBar(uint8_t Line, uint8_t Column, uint8_t Width, uint8_t Fill);
+
+/**
+  * @brief  [新增] 将显存中的脏区间全部刷新到屏幕 (阻塞)
+  * @note   OLED_Clear / OLED_ShowXxx 只修改 RAM 显存，需调用刷新函数才会显示
+  */
+void OLED_Refresh(void);
+
+/**
+  * @brief  [新增] 分片刷新：本次最多发送 ByteBudget 字节 (含 I2C 地址/控制/定位开销)
+  * @note   预算至少按 8 字节 (7 字节开销 + 1 字节数据) 计
+  * @retval 1: 显存已全部写入屏幕, 0: 仍有剩余，下次调用继续
+  */
+uint8_t OLED_RefreshStep(uint16_t ByteBudget);
+
+/**
+  * @brief  [新增] 是否有尚未刷完的帧
+  */
+uint8_t OLED_IsRefreshPending(void);
+
+/**
+  * @brief  [新增] 注册帧刷新完成回调 (在 OLED_RefreshStep 内调用)
+  */
+void OLED_SetRefreshDoneCallback(OLED_RefreshDoneCallback_t Callback);
+
 /**
   * @brief  [新增] 检测 OLED 是否在线
   * @retval 1: 在线, 0: 离线
@@ -1,20 +1,35 @@
 /**
   ******************************************************************************
   * @file    PAJ7620.c
-  * @brief   PAJ7620U2 驱动 (V10.2 Exit Hook)
+  * @brief   PAJ7620U2 驱动 (V10.3 Burst Read)
   * @note    增加退出无极调光的回调
+  *          V10.3: Bank 选择缓存 + 连续地址突发读取，单次轮询 I2C 事务 8 -> 3
+  *          V10.4: INT 引脚中断触发读取，仅近距控制模式下定时轮询
+  *          V10.5: 单帧处理 (读取 + 状态机) 接入耗时探针
+  *          V10.6: 调试输出改用 DLOG
+  *          V10.7: INT 模式增加兜底轮询，INT 未接线的板子仍可识别手势
   ******************************************************************************
   */
 #include "PAJ7620.h"
 #include "I2C_Driver.h"
-#include "USART_DMA.h"
+#include "DLog.h"
 #include "SystemSupport.h"
+#include "Profiler.h"
 #include <string.h>
 
 // --- 配置 ---
 #define PAJ_I2C_PORT            I2C2    
 #define PAJ_I2C_ADDR            0xE6    
 
+// INT 引脚 (低电平有效，读取 INT_FLAG 后释放)
+#define PAJ_INT_PORT            GPIOB
+#define PAJ_INT_PIN             GPIO_Pin_5
+#define PAJ_INT_EXTI_LINE       EXTI_Line5
+
+// Bank 选择寄存器
+#define PAJ_REG_BANK_SEL        0xEF
+#define PAJ_BANK_UNKNOWN        0xFF // 缓存失效 (上电/通信失败后必须重新写入)
+
 // 阈值参数
 #define PAJ_PROXIMITY_EXIT_TH   20   // 退出近距模式的亮度阈值
 #define PAJ_REVERSE_FILTER_TIME 600  // 反向动作过滤时间 (ms)
@@ -23,6 +38,12 @@
 static PAJ_State_t s_State = PAJ_STATE_IDLE;
 static uint8_t s_LastGesture = 0;    // 记录上一次的有效手势
 static uint32_t s_LastGestureTick = 0;
+static uint8_t s_CurBank = PAJ_BANK_UNKNOWN; // 当前已选中的 Bank (寄存器 0xEF 的影子)
+
+// --- 读取调度 ---
+static volatile uint8_t s_IntPending = 0;    // INT 下降沿标志 (ISR 置位)
+static uint32_t s_LastPollTick = 0;
+static uint16_t s_PollInterval = PAJ_POLL_FAST_MS;
 
 // --- 官方初始化数组 ---
 static const uint8_t PAJ7620_Init_Regs[][2] = {
@@ -44,16 +65,68 @@ static const uint8_t PAJ7620_Init_Regs[][2] = {
 
 // --- 底层 I2C ---
 static uint8_t PAJ_Write(uint8_t reg, uint8_t val) {
-    return I2C_Lib_Write(PAJ_I2C_PORT, PAJ_I2C_ADDR, reg, &val, 1);
+    uint8_t ret = I2C_Lib_Write(PAJ_I2C_PORT, PAJ_I2C_ADDR, reg, &val, 1);
+    // 所有对 0xEF 的写入都同步到 Bank 缓存 (包括初始化数组中的切换)
+    if (reg == PAJ_REG_BANK_SEL) {
+        s_CurBank = (ret == 0) ? val : PAJ_BANK_UNKNOWN;
+    }
+    return ret;
 }
 static uint8_t PAJ_Read(uint8_t reg, uint8_t *val) {
     return I2C_Lib_Read(PAJ_I2C_PORT, PAJ_I2C_ADDR, reg, val, 1);
 }
 
+// 连续读取 len 个寄存器 (PAJ7620 读操作地址自动递增)
+static uint8_t PAJ_ReadBurst(uint8_t reg, uint8_t *buf, uint8_t len) {
+    uint8_t ret = I2C_Lib_Read(PAJ_I2C_PORT, PAJ_I2C_ADDR, reg, buf, len);
+    // 通信失败时传感器可能已复位回 Bank 0，下次强制重写
+    if (ret != 0) s_CurBank = PAJ_BANK_UNKNOWN;
+    return ret;
+}
+
+// 仅当 Bank 与缓存不一致时才写 0xEF
+static uint8_t PAJ_SelectBank(uint8_t bank) {
+    if (s_CurBank == bank) return 0;
+    return PAJ_Write(PAJ_REG_BANK_SEL, bank);
+}
+
+#if PAJ_USE_INT_PIN
+// --- INT 引脚: PB5 上拉输入 + EXTI5 下降沿 ---
+static void PAJ_INT_Init(void)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+    EXTI_InitTypeDef EXTI_InitStructure;
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB | RCC_APB2Periph_AFIO, ENABLE);
+
+    GPIO_InitStructure.GPIO_Pin = PAJ_INT_PIN;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IPU;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_Init(PAJ_INT_PORT, &GPIO_InitStructure);
+
+    GPIO_EXTILineConfig(GPIO_PortSourceGPIOB, GPIO_PinSource5);
+
+    EXTI_InitStructure.EXTI_Line = PAJ_INT_EXTI_LINE;
+    EXTI_InitStructure.EXTI_Mode = EXTI_Mode_Interrupt;
+    EXTI_InitStructure.EXTI_Trigger = EXTI_Trigger_Falling;
+    EXTI_InitStructure.EXTI_LineCmd = ENABLE;
+    EXTI_Init(&EXTI_InitStructure);
+
+    // 仅置标志位，优先级低于串口 DMA
+    NVIC_InitStructure.NVIC_IRQChannel = EXTI9_5_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 2;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+}
+#endif
+
 // --- 初始化 ---
 uint8_t PAJ7620_Init(void)
 {
     uint8_t part_id = 0;
+    s_CurBank = PAJ_BANK_UNKNOWN;
     I2C_Lib_Init(PAJ_I2C_PORT);
     Delay_ms(10);
     PAJ_Read(0x00, &part_id); Delay_ms(5);
@@ -63,30 +136,43 @@ uint8_t PAJ7620_Init(void)
     for (int i = 0; i < sizeof(PAJ7620_Init_Regs)/2; i++) {
         PAJ_Write(PAJ7620_Init_Regs[i][0], PAJ7620_Init_Regs[i][1]);
     }
-    PAJ_Write(0xEF, 0x00);
+    PAJ_SelectBank(0);
+
+#if PAJ_USE_INT_PIN
+    PAJ_INT_Init();
+#endif
+    s_IntPending = 1; // 上电后先读一次，清掉初始化期间残留的中断标志
     return 0;
 }
 
 // --- 读取全量数据 ---
+// 寄存器分三段连续读取 (均位于 Bank 0):
+//   0x43~0x44: INT_FLAG1/2   (读后自动清零)
+//   0xB0~0xB2: 亮度 + 尺寸 L/H
+//   0xC3~0xC5: VelX_L, VelX_H, VelY_L
+// 0xB3~0xC2 之间的寄存器不使用，分段读比一次读 22 字节更省总线时间
 void PAJ7620_ReadAllData(PAJ7620_Data_t *data)
 {
-    uint8_t buf[2];
+    uint8_t flag[2];
+    uint8_t obj[3];
+    uint8_t vel[3];
     memset(data, 0, sizeof(PAJ7620_Data_t));
     
-    if (PAJ_Write(0xEF, 0x00) != 0) { data->IsConnected = 0; return; }
+    if (PAJ_SelectBank(0) != 0) { data->IsConnected = 0; return; }
     
-    PAJ_Read(PAJ_ADDR_INT_FLAG1, &data->GestureFlag1);
-    PAJ_Read(PAJ_ADDR_INT_FLAG2, &data->GestureFlag2);
-    PAJ_Read(PAJ_ADDR_OBJ_BRIGHTNESS, &data->ObjectBrightness);
-    PAJ_Read(PAJ_ADDR_OBJ_SIZE_L, &buf[0]);
-    PAJ_Read(PAJ_ADDR_OBJ_SIZE_H, &buf[1]);
-    data->ObjectSize = (uint16_t)buf[0] | ((uint16_t)buf[1] << 8);
+    if (PAJ_ReadBurst(PAJ_ADDR_INT_FLAG1, flag, sizeof(flag)) != 0) { data->IsConnected = 0; return; }
+    data->GestureFlag1 = flag[0];
+    data->GestureFlag2 = flag[1];
     
-    uint8_t vx, vy;
-    PAJ_Read(PAJ_ADDR_VEL_X_L, &vx);
-    PAJ_Read(PAJ_ADDR_VEL_Y_L, &vy);
-    data->VelocityX = (int8_t)vx;
-    data->VelocityY = (int8_t)vy;
+    if (PAJ_ReadBurst(PAJ_ADDR_OBJ_BRIGHTNESS, obj, sizeof(obj)) == 0) {
+        data->ObjectBrightness = obj[0];
+        data->ObjectSize = (uint16_t)obj[1] | ((uint16_t)obj[2] << 8);
+    }
+    
+    if (PAJ_ReadBurst(PAJ_ADDR_VEL_X_L, vel, sizeof(vel)) == 0) {
+        data->VelocityX = (int8_t)vel[0];
+        data->VelocityY = (int8_t)vel[PAJ_ADDR_VEL_Y_L - PAJ_ADDR_VEL_X_L];
+    }
     
     data->IsConnected = 1;
 }
@@ -101,16 +187,46 @@ static uint8_t Is_Reverse_Gesture(uint8_t curr, uint8_t last) {
     return 0;
 }
 
-// --- V10.1 核心逻辑 ---
-void PAJ7620_Process_StateMachine(void)
+// --- 辅助函数：本次调用是否需要访问传感器 ---
+static uint8_t PAJ_IsReadDue(uint32_t now) {
+    // 近距模式需要连续跟踪物体亮度，只能轮询
+    if (s_State == PAJ_STATE_PROXIMITY_CTRL) {
+        return (now - s_LastPollTick >= PAJ_PROX_POLL_MS);
+    }
+#if PAJ_USE_INT_PIN
+    if (s_IntPending) {
+        s_IntPending = 0;
+        return 1;
+    }
+    // 兜底：若边沿丢失，INT 会一直保持低电平直到标志被读走
+    if (GPIO_ReadInputDataBit(PAJ_INT_PORT, PAJ_INT_PIN) == Bit_RESET) return 1;
+    // [新增] INT 未接线时不会有边沿，退化为慢速轮询
+    return (now - s_LastPollTick >= PAJ_INT_FALLBACK_MS);
+#else
+    return (now - s_LastPollTick >= s_PollInterval);
+#endif
+}
+
+PROF_DEFINE(s_ProfGesture, "gesture");
+
+// --- V10.1 核心逻辑 (单帧：读取 + 滤波 + 状态机) ---
+static void PAJ_ProcessFrame(uint32_t now)
 {
     PAJ7620_Data_t data;
+
     PAJ7620_ReadAllData(&data);
     if (!data.IsConnected) return;
 
     uint8_t g1 = data.GestureFlag1;
     uint8_t g2 = data.GestureFlag2;
-    uint32_t now = System_GetTick();
+
+    // 自适应轮询：有手势时加速，空闲时逐步退避 (INT 模式下不使用)
+    if (g1 != 0 || g2 != 0) {
+        s_PollInterval = PAJ_POLL_FAST_MS;
+    } else if (s_PollInterval < PAJ_POLL_SLOW_MS) {
+        s_PollInterval *= 2;
+        if (s_PollInterval > PAJ_POLL_SLOW_MS) s_PollInterval = PAJ_POLL_SLOW_MS;
+    }
 
     // ---------------------------------------------------------
     // 0. 反向手势滤波 (Anti-Rebound Filter)
@@ -149,7 +265,7 @@ void PAJ7620_Process_StateMachine(void)
             if (g1 & PAJ7620_GESTURE_FORWARD) {
                 PAJ7620_Hook_OnForward();
                 s_State = PAJ_STATE_PROXIMITY_CTRL;
-                USART_DMA_Printf("[PAJ] 进入无极调光\r\n");
+                DLOG(PAJ_DIM_ENTER, "[PAJ] 进入无极调光");
             }
             else if (g1 & PAJ7620_GESTURE_BACKWARD)     PAJ7620_Hook_OnBackward();
             else if (g1 & PAJ7620_GESTURE_CLOCKWISE)    PAJ7620_Hook_OnClockwise();
@@ -165,7 +281,7 @@ void PAJ7620_Process_StateMachine(void)
         case PAJ_STATE_PROXIMITY_CTRL:
             if (data.ObjectBrightness < PAJ_PROXIMITY_EXIT_TH) {
                 s_State = PAJ_STATE_IDLE;
-                USART_DMA_Printf("[PAJ] 退出调光\r\n");
+                DLOG(PAJ_DIM_EXIT, "[PAJ] 退出调光");
                 
                 // 退出时设置上一次动作为 FORWARD，防止误触 BACKWARD
                 s_LastGesture = PAJ7620_GESTURE_FORWARD;
@@ -181,6 +297,31 @@ void PAJ7620_Process_StateMachine(void)
     }
 }
 
+void PAJ7620_Process_StateMachine(void)
+{
+    uint32_t now = System_GetTick();
+
+    if (!PAJ_IsReadDue(now)) return;
+    s_LastPollTick = now;
+
+    // 只统计实际读取的帧，未到读取时机的空转调用不计入
+    PROF_BEGIN(s_ProfGesture);
+    PAJ_ProcessFrame(now);
+    PROF_END(s_ProfGesture);
+}
+
+#if PAJ_USE_INT_PIN
+// --- INT 中断：只置标志，I2C 读取放在主循环 ---
+void EXTI9_5_IRQHandler(void)
+{
+    if (EXTI_GetITStatus(PAJ_INT_EXTI_LINE) != RESET)
+    {
+        EXTI_ClearITPendingBit(PAJ_INT_EXTI_LINE);
+        s_IntPending = 1;
+    }
+}
+#endif
+
 // --- Weak Hooks ---
 __weak void PAJ7620_Hook_OnUp(void) {}
 __weak void PAJ7620_Hook_OnDown(void) {}
@@ -47,6 +47,8 @@ void PAJ7620_ReadAllData(PAJ7620_Data_t *data);
 
 /**
  * @brief 核心状态机处理函数 (需在主循环高速调用)
+ * @note  内部自行调度 I2C 访问: IDLE 态由 INT 中断 (或自适应轮询) 触发读取，
+ *        近距控制态按 PAJ_PROX_POLL_MS 周期轮询。未到期时立即返回。
  */
 void PAJ7620_Process_StateMachine(void);
 
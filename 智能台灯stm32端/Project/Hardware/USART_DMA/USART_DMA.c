@@ -89,12 +89,15 @@ void USART_DMA_Init(void)
     NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
     NVIC_Init(&NVIC_InitStructure);
 
-    // USART1 全局中断 (仅用于处理错误，不处理接收)
+    // USART1 全局中断 (处理错误 + 空闲线检测，数据本身仍由 DMA 搬运)
     NVIC_InitStructure.NVIC_IRQChannel = USART1_IRQn;
     NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 1;
     NVIC_InitStructure.NVIC_IRQChannelSubPriority = 1;
     NVIC_Init(&NVIC_InitStructure);
 
+    // 一帧接收结束 (总线空闲) 时通知上层，免去主循环高频轮询
+    USART_ITConfig(USART1, USART_IT_IDLE, ENABLE);
+
     // 8. 使能串口
     USART_Cmd(USART1, ENABLE);
     
@@ -225,11 +228,23 @@ void DMA1_Channel4_IRQHandler(void)
     }
 }
 
-// USART1 错误处理中断 (防止 ORE 导致死机)
+// 接收空闲钩子 (默认空实现，应用层可重写)
+__weak void USART_DMA_Hook_OnRxIdle(void) {}
+
+// USART1 中断：错误处理 (防止 ORE 导致死机) + 空闲线检测
 void USART1_IRQHandler(void)
 {
     volatile uint8_t clear_temp;
     
+    if (USART_GetFlagStatus(USART1, USART_FLAG_IDLE) != RESET)
+    {
+        // 先读 SR 再读 DR 清除 IDLE 标志 (数据已被 DMA 取走，读 DR 无副作用)
+        clear_temp = USART1->SR;
+        clear_temp = USART1->DR;
+        (void)clear_temp;
+        USART_DMA_Hook_OnRxIdle();
+    }
+
     if (USART_GetFlagStatus(USART1, USART_FLAG_ORE) != RESET ||
         USART_GetFlagStatus(USART1, USART_FLAG_NE) != RESET ||
         USART_GetFlagStatus(USART1, USART_FLAG_FE) != RESET ||
@@ -41,4 +41,10 @@ uint8_t USART_DMA_GetUsage(void);
   */
 uint16_t USART_DMA_ReadRxBuffer(uint8_t *output_buf, uint16_t max_len);
 
+/**
+  * @brief  接收空闲钩子 (弱定义，在 USART1 中断中调用)
+  * @note   总线空闲表示一帧数据已接收完毕，可用于唤醒协议解析任务
+  */
+void USART_DMA_Hook_OnRxIdle(void);
+
 #endif
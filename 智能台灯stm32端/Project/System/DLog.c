@@ -0,0 +1,233 @@
+/**
+  ******************************************************************************
+  * @file    DLog.c
+  * @brief   延迟格式化的二进制调试日志实现
+  * @note    编码只做变长整数与字符串拷贝，不调用 vsnprintf
+  ******************************************************************************
+  */
+#include "DLog.h"
+#include "LogPort.h"
+#include "USART_DMA.h"
+#include "SystemSupport.h"
+#include "Profiler.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#if DLOG_MODE == 2 || PROF_ENABLE
+
+static uint8_t* _PutVarint(uint8_t *p, uint32_t v)
+{
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+/**
+  * @brief  编码一条记录
+  * @param  rec 至少 DLOG_MAX_RECORD 字节
+  * @retval 记录总长度
+  */
+static uint8_t _Encode(uint8_t *rec, uint16_t id, uint32_t dt, const char *sig, va_list ap)
+{
+    uint8_t *p = rec + 2;
+    // 为一个 varint (5) 与校验字节预留
+    uint8_t *end = rec + DLOG_MAX_RECORD - 6;
+    uint8_t chk;
+    uint8_t i, n;
+
+    p = _PutVarint(p, id);
+    p = _PutVarint(p, dt);
+
+    for (; *sig && p < end; sig++) {
+        if (*sig == 's') {
+            const char *s = va_arg(ap, const char*);
+            n = 0;
+            if (s) {
+                while (s[n] && n < DLOG_MAX_STR) n++;
+            }
+            if (n > end - p - 1) n = (uint8_t)(end - p - 1);
+            *p++ = n;
+            memcpy(p, s, n);
+            p += n;
+        } else if (*sig == 'd') {
+            int32_t v = va_arg(ap, int32_t);
+            p = _PutVarint(p, ((uint32_t)v << 1) ^ (uint32_t)(v >> 31));   // zigzag
+        } else {
+            p = _PutVarint(p, va_arg(ap, uint32_t));
+        }
+    }
+
+    rec[0] = DLOG_SYNC;
+    rec[1] = (uint8_t)(p - rec - 2);
+    chk = rec[1];
+    for (i = 2; i < rec[1] + 2; i++) chk ^= rec[i];
+    *p++ = chk;
+    return (uint8_t)(p - rec);
+}
+
+#endif
+
+#if DLOG_MODE == 2
+
+static uint32_t s_LastTick = 0;     // 上一条已发出记录的时间
+static uint32_t s_Dropped = 0;      // 未能报告的丢弃条数
+
+static uint8_t _EncodeArgs(uint8_t *rec, uint16_t id, uint32_t dt, const char *sig, ...)
+{
+    va_list ap;
+    uint8_t n;
+
+    va_start(ap, sig);
+    n = _Encode(rec, id, dt, sig, ap);
+    va_end(ap);
+    return n;
+}
+
+void DLog_Write(uint16_t id, const char *sig, ...)
+{
+    uint8_t rec[DLOG_MAX_RECORD];
+    uint32_t now = System_GetTick();
+    va_list ap;
+    uint8_t n;
+
+    // 先补报之前的丢弃条数，仍放不下则本条也丢弃
+    if (s_Dropped) {
+        n = _EncodeArgs(rec, DLOG_ID_DROP, now - s_LastTick, "u", s_Dropped);
+        if (!LogPort_Write(rec, n)) {
+            s_Dropped++;
+            return;
+        }
+        s_Dropped = 0;
+        s_LastTick = now;
+    }
+
+    va_start(ap, sig);
+    n = _Encode(rec, id, now - s_LastTick, sig, ap);
+    va_end(ap);
+
+    if (LogPort_Write(rec, n)) {
+        s_LastTick = now;
+    } else {
+        s_Dropped++;
+    }
+}
+
+#else
+
+void DLog_Write(uint16_t id, const char *sig, ...)
+{
+    (void)id;
+    (void)sig;
+}
+
+#endif
+
+#if DLOG_MODE == 1
+void DLog_Text(const char *fmt, ...)
+{
+    char buf[128];
+    va_list args;
+    int len;
+
+    va_start(args, fmt);
+    len = vsnprintf(buf, sizeof(buf) - 2, fmt, args);
+    va_end(args);
+
+    if (len < 0) return;
+    if (len > (int)sizeof(buf) - 3) len = sizeof(buf) - 3;
+    buf[len++] = '\r';
+    buf[len++] = '\n';
+    USART_DMA_Send((uint8_t*)buf, (uint16_t)len);
+}
+#endif
+
+void DLog_Init(void)
+{
+#if DLOG_MODE == 2
+    LogPort_Init();
+    s_LastTick = 0;
+    s_Dropped = 0;
+    DLog_Write(DLOG_ID_BOOT, "u", (uint32_t)DLOG_TABLE_HASH);
+#endif
+}
+
+/* ============================================================
+ *                 Benchmark
+ * ============================================================ */
+#if PROF_ENABLE
+
+#define BENCH_ROUNDS    16
+
+// 文本路径: 与 USART_DMA_Printf 相同的格式化，再拷贝到模拟的发送缓冲区
+static uint16_t _BenchText(uint8_t *sink, const char *fmt, ...)
+{
+    char buf[128];
+    va_list args;
+    int len;
+
+    va_start(args, fmt);
+    len = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    if (len <= 0) return 0;
+    memcpy(sink, buf, len);
+    return (uint16_t)len;
+}
+
+// 二进制路径: 编码后拷贝到模拟的发送缓冲区
+static uint16_t _BenchBin(uint8_t *sink, uint16_t id, const char *sig, ...)
+{
+    uint8_t rec[DLOG_MAX_RECORD];
+    va_list ap;
+    uint8_t n;
+
+    va_start(ap, sig);
+    n = _Encode(rec, id, 3, sig, ap);
+    va_end(ap);
+    memcpy(sink, rec, n);
+    return n;
+}
+
+void DLog_Bench(void)
+{
+    static uint8_t s_Sink[128];
+    uint16_t bytes[2] = {0, 0};
+    uint32_t cyc[2];
+    uint32_t t0;
+    uint8_t c, r;
+
+    // 用例取自现有日志: 无参数 / 三个整数 / 一个字符串
+    for (c = 0; c < 3; c++) {
+        cyc[0] = cyc[1] = 0;
+        for (r = 0; r < BENCH_ROUNDS; r++) {
+            t0 = PROF_NOW();
+            switch (c) {
+                case 0:  bytes[0] = _BenchText(s_Sink, "[Ctrl] Focus -> CCT\r\n"); break;
+                case 1:  bytes[0] = _BenchText(s_Sink, "[Persist] Restored Bri=%d CCT=%d Auto=%d\r\n", 500 + r, 50, 1); break;
+                default: bytes[0] = _BenchText(s_Sink, "[Ctrl] Mode -> %s\r\n", r & 1 ? "LOCAL" : "UI"); break;
+            }
+            cyc[0] += PROF_NOW() - t0;
+
+            t0 = PROF_NOW();
+            switch (c) {
+                case 0:  bytes[1] = _BenchBin(s_Sink, 10, ""); break;
+                case 1:  bytes[1] = _BenchBin(s_Sink, 20, "ddd", 500 + r, 50, 1); break;
+                default: bytes[1] = _BenchBin(s_Sink, 30, "s", r & 1 ? "LOCAL" : "UI"); break;
+            }
+            cyc[1] += PROF_NOW() - t0;
+        }
+        USART_DMA_Printf("{\"ev\":\"logbench\",\"case\":%d,\"txt_cyc\":%lu,\"txt_b\":%d,"
+                         "\"bin_cyc\":%lu,\"bin_b\":%d}\r\n",
+                         c, (unsigned long)(cyc[0] / BENCH_ROUNDS), bytes[0],
+                         (unsigned long)(cyc[1] / BENCH_ROUNDS), bytes[1]);
+    }
+}
+
+#else
+
+void DLog_Bench(void) {}
+
+#endif
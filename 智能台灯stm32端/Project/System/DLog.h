@@ -0,0 +1,79 @@
+#ifndef __DLOG_H
+#define __DLOG_H
+
+#include <stdint.h>
+#include "Config.h"
+
+/**
+  ******************************************************************************
+  * @file    DLog.h
+  * @brief   延迟格式化的二进制调试日志
+  * @note    1. 用法: DLOG(CTRL_FOCUS_CCT, "[Ctrl] Focus -> CCT");
+  *                   DLOG(PERSIST_RESTORED, "[Persist] Restored Bri=%d", bri);
+  *             名称为全局唯一的标识，格式串不带换行
+  *          2. 新增/修改 DLOG 后运行 Tools/dlog_gen.py 重新生成 DLogIds.h 与
+  *             Tools/dlog_table.json：日志编号固定不变，格式串只保存在日志表中，
+  *             不进入固件；参数个数与格式串不符时编译报错
+  *          3. DLOG_MODE: 0 关闭 (调用展开为空)
+  *                        1 文本，经 USART_DMA_Printf 输出到协议串口 (旧方式)
+  *                        2 二进制记录，经 LogPort (USART2, PA2) 输出，
+  *                          用 Tools/dlog_decode.py 还原为文本
+  *          4. 支持 %d %i %u %x %X %c %s (可带标志/宽度/l 修饰)，
+  *             字符串最多记录 DLOG_MAX_STR 字节
+  *          5. 仅限主循环上下文调用
+  *
+  *          二进制记录: A5 | len | id | dt | 参数... | chk
+  *            id  日志编号 (varint)
+  *            dt  距上一条已发出记录的毫秒数 (varint)
+  *            参数 %d 为 zigzag varint，%u %x %c 为 varint，%s 为长度字节 + 内容
+  *            len 为 id 到参数末尾的字节数，chk 为 len 与这些字节的异或
+  ******************************************************************************
+  */
+
+#define DLOG_SYNC               0xA5
+#define DLOG_MAX_STR            24
+#define DLOG_MAX_RECORD         64
+
+// 保留编号 (日志表从 DLOG_ID_FIRST 开始分配)
+#define DLOG_ID_BOOT            0       /*!< 参数: 日志表校验值 (u)，解码端据此检查日志表是否匹配 */
+#define DLOG_ID_DROP            1       /*!< 参数: 缓冲区满丢弃的条数 (u) */
+#define DLOG_ID_FIRST           2
+
+#if DLOG_MODE == 2
+
+#include "DLogIds.h"
+
+#define DLOG(name, ...)         DLOG_CALL_##name(__VA_ARGS__)
+
+#elif DLOG_MODE == 1
+
+#define DLOG(name, ...)         DLog_Text(__VA_ARGS__)
+
+void DLog_Text(const char *fmt, ...);
+
+#else
+
+#define DLOG(name, ...)         ((void)0)
+
+#endif
+
+/**
+  * @brief  初始化日志通道 (模式 2 时初始化 USART2 并发出启动记录)
+  */
+void DLog_Init(void);
+
+/**
+  * @brief  写入一条二进制记录 (一般通过 DLOG 调用)
+  * @param  sig 参数类型串，每个参数一个字符: d 有符号, u 无符号, s 字符串
+  */
+void DLog_Write(uint16_t id, const char *sig, ...);
+
+/**
+  * @brief  对比文本与二进制两条路径单次日志的周期与线上字节数
+  * @note   需 PROF_ENABLE；每个用例输出一行
+  *         {"ev":"logbench","case":0,"txt_cyc":..,"txt_b":..,"bin_cyc":..,"bin_b":..}
+  *         两条路径均只计格式化/编码与拷贝，不实际发送
+  */
+void DLog_Bench(void);
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef __DLOG_IDS_H
+#define __DLOG_IDS_H
+
+/* 由 Tools/dlog_gen.py 生成，请勿手动修改 */
+
+#define DLOG_TABLE_HASH         0xD33D3D8FUL
+
+#define DLOG_CALL_CTRL_AUTO_DIM(fmt, a0, a1) \
+    DLog_Write(2, "sd", (const char*)(a0), (int32_t)(a1))
+#define DLOG_CALL_CTRL_FOCUS_BRI(fmt) \
+    DLog_Write(3, "")
+#define DLOG_CALL_CTRL_FOCUS_CCT(fmt) \
+    DLog_Write(4, "")
+#define DLOG_CALL_CTRL_LOCAL_OFF(fmt) \
+    DLog_Write(5, "")
+#define DLOG_CALL_CTRL_LONG_PRESS_END(fmt) \
+    DLog_Write(6, "")
+#define DLOG_CALL_CTRL_LONG_PRESS_START(fmt) \
+    DLog_Write(7, "")
+#define DLOG_CALL_CTRL_MODE(fmt, a0) \
+    DLog_Write(8, "s", (const char*)(a0))
+#define DLOG_CALL_CTRL_PROX_ENTER(fmt) \
+    DLog_Write(9, "")
+#define DLOG_CALL_CTRL_PROX_EXIT(fmt) \
+    DLog_Write(10, "")
+#define DLOG_CALL_CTRL_PROX_LOCKED(fmt) \
+    DLog_Write(11, "")
+#define DLOG_CALL_CTRL_RESET(fmt) \
+    DLog_Write(12, "")
+#define DLOG_CALL_CTRL_TOGGLE_MODE(fmt, a0) \
+    DLog_Write(13, "s", (const char*)(a0))
+#define DLOG_CALL_MAIN_BANNER(fmt) \
+    DLog_Write(14, "")
+#define DLOG_CALL_MAIN_EVTQ_OVERFLOW(fmt, a0, a1, a2) \
+    DLog_Write(15, "ddd", (int32_t)(a0), (int32_t)(a1), (int32_t)(a2))
+#define DLOG_CALL_MAIN_GESTURE_FAIL(fmt) \
+    DLog_Write(16, "")
+#define DLOG_CALL_MAIN_GESTURE_READY(fmt) \
+    DLog_Write(17, "")
+#define DLOG_CALL_MAIN_HOLD_DURATION(fmt, a0) \
+    DLog_Write(18, "d", (int32_t)(a0))
+#define DLOG_CALL_PAJ_DIM_ENTER(fmt) \
+    DLog_Write(19, "")
+#define DLOG_CALL_PAJ_DIM_EXIT(fmt) \
+    DLog_Write(20, "")
+#define DLOG_CALL_PERSIST_COMPACT_FAIL(fmt) \
+    DLog_Write(21, "")
+#define DLOG_CALL_PERSIST_DEFAULTS(fmt) \
+    DLog_Write(22, "")
+#define DLOG_CALL_PERSIST_FLASH_INIT_FAIL(fmt) \
+    DLog_Write(23, "")
+#define DLOG_CALL_PERSIST_RESTORED(fmt, a0, a1, a2) \
+    DLog_Write(24, "ddd", (int32_t)(a0), (int32_t)(a1), (int32_t)(a2))
+#define DLOG_CALL_PERSIST_WRITE_FAIL(fmt) \
+    DLog_Write(25, "")
+#define DLOG_CALL_PROTO_PARSE_ERR(fmt, a0) \
+    DLog_Write(26, "s", (const char*)(a0))
+#define DLOG_CALL_PROTO_RX_OVERFLOW(fmt) \
+    DLog_Write(27, "")
+#define DLOG_CALL_SENSOR_DHT_BUSY(fmt) \
+    DLog_Write(28, "")
+#define DLOG_CALL_SENSOR_DHT_INIT_FAIL(fmt) \
+    DLog_Write(29, "")
+#define DLOG_CALL_SENSOR_DHT_INIT_OK(fmt) \
+    DLog_Write(30, "")
+#define DLOG_CALL_SENSOR_DHT_READ_ERR(fmt, a0) \
+    DLog_Write(31, "d", (int32_t)(a0))
+#define DLOG_CALL_SCHED_TASK_STATS(fmt, a0, a1, a2, a3, a4, a5, a6, a7) \
+    DLog_Write(32, "suuuuuuu", (const char*)(a0), (uint32_t)(a1), (uint32_t)(a2), (uint32_t)(a3), (uint32_t)(a4), (uint32_t)(a5), (uint32_t)(a6), (uint32_t)(a7))
+#define DLOG_CALL_SCHED_WINDOW(fmt, a0) \
+    DLog_Write(33, "u", (uint32_t)(a0))
+
+#endif
@@ -0,0 +1,104 @@
+/**
+  ******************************************************************************
+  * @file    EventQueue.c
+  * @brief   中断安全的事件队列实现
+  * @note    写入分两步：先用 LDREX/STREX 原子地占用 s_Head 位置，再填充记录并
+  *          置位该槽的 s_Ready。消费者只读取已置位的槽，因此一个生产者在填充
+  *          中途被更高优先级中断抢占时，消费者会等它写完而不会读到半条记录。
+  ******************************************************************************
+  */
+#include "EventQueue.h"
+#include "SystemSupport.h"
+#include <string.h>
+
+#if (EVTQ_SIZE & (EVTQ_SIZE - 1)) != 0 || EVTQ_SIZE > 128
+#error "EVTQ_SIZE must be a power of two and <= 128"
+#endif
+
+#define EVTQ_MASK   (EVTQ_SIZE - 1)
+
+static Event_t           s_Queue[EVTQ_SIZE];
+static volatile uint8_t  s_Ready[EVTQ_SIZE];
+static volatile uint32_t s_Head = 0;    // 下一个待占用的位置 (多生产者)
+static volatile uint32_t s_Tail = 0;    // 下一个待读取的位置 (单消费者)
+
+static volatile uint32_t s_Posted = 0;
+static volatile uint32_t s_Dropped = 0;
+static volatile uint8_t  s_HighWater = 0;
+
+// 原子自增 (计数器同样可能被多个中断同时修改)
+static void _AtomicInc(volatile uint32_t *p)
+{
+    uint32_t v;
+    do {
+        v = __LDREXW((uint32_t *)p);
+    } while (__STREXW(v + 1, (uint32_t *)p));
+}
+
+void EvtQ_Init(void)
+{
+    memset((void *)s_Ready, 0, sizeof(s_Ready));
+    s_Head = 0;
+    s_Tail = 0;
+    s_Posted = 0;
+    s_Dropped = 0;
+    s_HighWater = 0;
+}
+
+uint8_t EvtQ_Post(uint8_t type, uint8_t sub, uint16_t param, uint32_t data)
+{
+    uint32_t head, depth;
+    Event_t *slot;
+
+    // 1. 占用一个位置
+    do {
+        head = __LDREXW((uint32_t *)&s_Head);
+        depth = head - s_Tail;
+        if (depth >= EVTQ_SIZE) {
+            __CLREX();
+            _AtomicInc(&s_Dropped);
+            return 0;
+        }
+    } while (__STREXW(head + 1, (uint32_t *)&s_Head));
+
+    // 2. 填充记录 (该槽此时只属于本生产者)
+    slot = &s_Queue[head & EVTQ_MASK];
+    slot->Type = type;
+    slot->Sub = sub;
+    slot->Param = param;
+    slot->Data = data;
+    slot->Timestamp = System_GetTick();
+
+    // 3. 发布：记录写完后才对消费者可见
+    __DMB();
+    s_Ready[head & EVTQ_MASK] = 1;
+
+    _AtomicInc(&s_Posted);
+    if (depth + 1 > s_HighWater) s_HighWater = (uint8_t)(depth + 1); // 统计用途，允许偶发不精确
+    return 1;
+}
+
+uint8_t EvtQ_Get(Event_t *evt)
+{
+    uint32_t tail = s_Tail;
+    uint32_t idx = tail & EVTQ_MASK;
+
+    // 队列空，或队头的生产者尚未写完
+    if (tail == s_Head || !s_Ready[idx]) return 0;
+
+    __DMB();
+    *evt = s_Queue[idx];
+    s_Ready[idx] = 0;
+
+    // 先释放槽再推进 s_Tail，生产者看到空位时该槽一定已清零
+    __DMB();
+    s_Tail = tail + 1;
+    return 1;
+}
+
+void EvtQ_GetStats(EvtQ_Stats_t *stats)
+{
+    stats->Posted = s_Posted;
+    stats->Dropped = s_Dropped;
+    stats->HighWater = s_HighWater;
+}
@@ -0,0 +1,66 @@
+#ifndef __EVENT_QUEUE_H
+#define __EVENT_QUEUE_H
+
+#include <stdint.h>
+#include "Config.h"
+
+/**
+  ******************************************************************************
+  * @file    EventQueue.h
+  * @brief   中断安全的事件队列 (多生产者 / 单消费者，无锁)
+  * @note    1. 生产者可以是任意中断或主循环代码，使用 LDREX/STREX 抢占写入位置，
+  *             不关中断
+  *          2. 消费者只有一个：main.c 中的事件分发任务
+  *          3. 队列满时新事件被丢弃并计数，不会覆盖未处理的事件
+  ******************************************************************************
+  */
+
+/**
+  * @brief 事件来源类型
+  */
+typedef enum {
+    EVT_NONE = 0,
+    EVT_KEY,                /*!< Sub: KeyEventType_t, Param: 时长(ms), Data: 按键掩码 */
+    EVT_ENCODER,            /*!< Param: 旋转增量 (int16_t) */
+    EVT_GESTURE,            /*!< Sub: 手势编码 (PAJ7620_GESTURE_xxx) */
+    EVT_PROXIMITY,          /*!< Sub: 物体亮度 (0-255) */
+    EVT_PROXIMITY_EXIT      /*!< 退出无极调光 */
+} EventType_t;
+
+/**
+  * @brief 定长事件记录 (12 字节)
+  */
+typedef struct {
+    uint8_t  Type;          /*!< EventType_t */
+    uint8_t  Sub;           /*!< 子类型 / 8 位参数 */
+    uint16_t Param;         /*!< 16 位参数 */
+    uint32_t Data;          /*!< 32 位参数 */
+    uint32_t Timestamp;     /*!< 入队时刻 (ms) */
+} Event_t;
+
+/**
+  * @brief 运行统计
+  */
+typedef struct {
+    uint32_t Posted;        /*!< 成功入队总数 */
+    uint32_t Dropped;       /*!< 队列满丢弃总数 */
+    uint8_t  HighWater;     /*!< 历史最高占用深度 */
+} EvtQ_Stats_t;
+
+void EvtQ_Init(void);
+
+/**
+  * @brief  投递事件 (ISR 安全，可重入)
+  * @retval 1: 成功, 0: 队列满被丢弃
+  */
+uint8_t EvtQ_Post(uint8_t type, uint8_t sub, uint16_t param, uint32_t data);
+
+/**
+  * @brief  取出一个事件 (仅限单一消费者调用)
+  * @retval 1: 取到事件, 0: 队列空
+  */
+uint8_t EvtQ_Get(Event_t *evt);
+
+void EvtQ_GetStats(EvtQ_Stats_t *stats);
+
+#endif
@@ -0,0 +1,89 @@
+/**
+  ******************************************************************************
+  * @file    Profiler.c
+  * @brief   热点代码周期级耗时统计实现
+  * @note    DWT 寄存器按地址访问 (Profiler.h 的 PROF_NOW / PROF_COUNTER_RESET)，
+  *          不依赖芯片头文件；CYCCNT 为 32 位，72MHz 下约 59 秒回绕一次，
+  *          单次测量以无符号差值计算不受回绕影响。
+  ******************************************************************************
+  */
+#include "Profiler.h"
+#include <stdio.h>
+#include <string.h>
+
+static Prof_Probe_t* s_ProbeList = NULL;
+
+void Prof_Init(void)
+{
+#if PROF_ENABLE
+    PROF_COUNTER_RESET();
+#endif
+}
+
+// 4 倍分档：每右移 2 位升一档
+static uint8_t _HistBin(uint32_t cycles)
+{
+    uint8_t bin = 0;
+
+    while (cycles >= 256 && bin < PROF_HIST_BINS - 1) {
+        cycles >>= 2;
+        bin++;
+    }
+    return bin;
+}
+
+static void _Reset(Prof_Probe_t* p)
+{
+    p->Count = 0;
+    p->MinCyc = 0xFFFFFFFF;
+    p->MaxCyc = 0;
+    p->TotalCyc = 0;
+    memset(p->Hist, 0, sizeof(p->Hist));
+}
+
+void Prof_Record(Prof_Probe_t* probe, uint32_t cycles)
+{
+    uint8_t bin;
+
+    if (!probe->Linked) {
+        // 追加到链表尾，输出顺序与首次执行顺序一致
+        Prof_Probe_t** pp = &s_ProbeList;
+        while (*pp != NULL) pp = &(*pp)->Next;
+        probe->Next = NULL;
+        probe->Linked = 1;
+        *pp = probe;
+    }
+
+    probe->Count++;
+    probe->TotalCyc += cycles;
+    if (cycles < probe->MinCyc) probe->MinCyc = cycles;
+    if (cycles > probe->MaxCyc) probe->MaxCyc = cycles;
+
+    bin = _HistBin(cycles);
+    if (probe->Hist[bin] != 0xFFFF) probe->Hist[bin]++;
+}
+
+uint16_t Prof_Format(uint8_t index, char* buf, uint16_t len, uint8_t reset)
+{
+    Prof_Probe_t* p = s_ProbeList;
+    uint8_t i;
+    uint32_t avg;
+    int n;
+
+    for (i = 0; p != NULL && i < index; i++) p = p->Next;
+    if (p == NULL || len == 0) return 0;
+
+    avg = p->Count ? (uint32_t)(p->TotalCyc / p->Count) : 0;
+    n = snprintf(buf, len,
+                 "{\"ev\":\"prof\",\"i\":%d,\"n\":\"%s\",\"c\":%lu,\"mn\":%lu,\"mx\":%lu,\"av\":%lu,"
+                 "\"h\":[%u,%u,%u,%u,%u,%u,%u,%u]}",
+                 index, p->Name, (unsigned long)p->Count,
+                 (unsigned long)(p->Count ? p->MinCyc : 0), (unsigned long)p->MaxCyc,
+                 (unsigned long)avg,
+                 p->Hist[0], p->Hist[1], p->Hist[2], p->Hist[3],
+                 p->Hist[4], p->Hist[5], p->Hist[6], p->Hist[7]);
+    if (n <= 0 || n >= len) return 0;
+
+    if (reset) _Reset(p);
+    return (uint16_t)n;
+}
@@ -0,0 +1,90 @@
+#ifndef __PROFILER_H
+#define __PROFILER_H
+
+#include <stdint.h>
+#include "Config.h"
+
+/**
+  ******************************************************************************
+  * @file    Profiler.h
+  * @brief   热点代码周期级耗时统计 (DWT CYCCNT)
+  * @note    1. 探针由调用者静态定义，首次记录时自动挂入链表
+  *          2. 在同一代码块内成对使用 PROF_BEGIN / PROF_END，中途 return 的路径不计入
+  *          3. PROF_ENABLE 为 0 时所有宏展开为空，探针不占用 RAM / Flash
+  *          4. 仅限主循环上下文使用 (登记与统计均未做中断保护)
+  *          5. 直方图按 4 倍分档：<256, <1K, <4K, <16K, <64K, <256K, <1M, >=1M 周期
+  *             (72MHz 下约 3.6us, 14us, 57us, 228us, 0.9ms, 3.6ms, 14.6ms)
+  *          6. [修改] PROF_ENABLE 默认关闭；计数器的使能与清零经 PROF_COUNTER_RESET，
+  *             不再对 PROF_NOW() 赋值 (函数式替换时无法作为左值)
+  ******************************************************************************
+  */
+
+#define PROF_HIST_BINS      8
+
+/**
+  * @brief 探针统计
+  */
+typedef struct Prof_Probe {
+    const char*        Name;
+    uint8_t            Linked;        /*!< 已挂入链表 (内部使用) */
+    uint32_t           Count;
+    uint32_t           MinCyc;
+    uint32_t           MaxCyc;
+    uint64_t           TotalCyc;
+    uint16_t           Hist[PROF_HIST_BINS];  /*!< 各档次数 (饱和于 0xFFFF) */
+    struct Prof_Probe* Next;
+} Prof_Probe_t;
+
+// 周期计数器读取与启动 (使能并清零)，主机侧构建可在包含本文件前替换为模拟计数器
+// (PROF_NOW 替换为函数调用时须同时提供 PROF_COUNTER_RESET)
+#ifndef PROF_NOW
+#define PROF_NOW()              (*(volatile uint32_t*)0xE0001004)       /*!< DWT->CYCCNT */
+#endif
+#ifndef PROF_COUNTER_RESET
+#define PROF_COUNTER_RESET() do { \
+    (*(volatile uint32_t*)0xE000EDFC) |= (1UL << 24);   /* DEMCR.TRCENA: 使能 DWT/ITM */ \
+    (*(volatile uint32_t*)0xE0001004) = 0;              /* DWT->CYCCNT */ \
+    (*(volatile uint32_t*)0xE0001000) |= (1UL << 0);    /* DWT->CTRL.CYCCNTENA */ \
+} while (0)
+#endif
+
+#if PROF_ENABLE
+
+/**
+  * @brief 定义探针 (文件作用域)
+  * @example PROF_DEFINE(s_ProfProto, "proto");
+  */
+#define PROF_DEFINE(var, name) \
+    static Prof_Probe_t var = { (name), 0, 0, 0xFFFFFFFF, 0, 0, {0}, 0 }
+
+#define PROF_BEGIN(var)     uint32_t var##_Start = PROF_NOW()
+#define PROF_END(var)       Prof_Record(&var, PROF_NOW() - var##_Start)
+
+#else
+
+#define PROF_DEFINE(var, name)  typedef int var##_Unused
+#define PROF_BEGIN(var)         ((void)0)
+#define PROF_END(var)           ((void)0)
+
+#endif
+
+/**
+  * @brief  使能 DWT 周期计数器 (PROF_ENABLE 为 0 时为空操作)
+  */
+void Prof_Init(void);
+
+/**
+  * @brief  记录一次耗时 (一般通过 PROF_END 调用)
+  */
+void Prof_Record(Prof_Probe_t* probe, uint32_t cycles);
+
+/**
+  * @brief  格式化第 index 个探针的统计为一行紧凑 JSON (不含换行)
+  * @param  reset 输出后清零该探针
+  * @retval 写入长度，0 表示 index 超出探针数量
+  * @note   {"ev":"prof","i":0,"n":"proto","c":次数,"mn":最小,"mx":最大,"av":平均,"h":[8 档]}
+  *         时间单位均为 CPU 周期
+  */
+uint16_t Prof_Format(uint8_t index, char* buf, uint16_t len, uint8_t reset);
+
+#endif
@@ -0,0 +1,135 @@
+/**
+  ******************************************************************************
+  * @file    Scheduler.c
+  * @brief   协作式任务调度器实现
+  * @note    时间基准仍为 1ms SysTick (Delay_ms / DHT11 等依赖它)，因此休眠方式
+  *          为 WFI 等待下一个中断，而不是重编程 SysTick 的完全无节拍模式。
+  *          统计窗口以 ms 节拍计时 (System_GetMicros 约 71 分钟回绕一次)。
+  *          [修改] 统计经 DLOG 输出 (每个任务一条记录)，不再 printf 到协议串口。
+  ******************************************************************************
+  */
+#include "Scheduler.h"
+#include "SystemSupport.h"
+#include "DLog.h"
+#include <stddef.h>
+
+static Sched_Task_t* s_TaskList = NULL;
+static uint32_t      s_StatsStartTick = 0;  // 统计窗口起点 (ms)
+
+void Sched_Init(void)
+{
+    s_TaskList = NULL;
+    s_StatsStartTick = System_GetTick();
+}
+
+void Sched_Register(Sched_Task_t* task)
+{
+    Sched_Task_t** pp = &s_TaskList;
+
+    // 追加到链表尾，保持注册顺序
+    while (*pp != NULL) pp = &(*pp)->Next;
+
+    task->Next = NULL;
+    task->NextRun = System_GetTick() + task->PeriodMs;
+    *pp = task;
+}
+
+void Sched_Signal(Sched_Task_t* task)
+{
+    task->Pending = 1; // 单字节写入为原子操作
+}
+
+// 执行任务并记录耗时
+static void _Execute(Sched_Task_t* task)
+{
+    uint32_t start = System_GetMicros();
+    uint32_t cost;
+
+    task->Func();
+
+    cost = System_GetMicros() - start;
+    task->RunCount++;
+    task->TotalUs += cost;
+    if (cost > task->MaxRunUs) task->MaxRunUs = (cost > 0xFFFF) ? 0xFFFF : (uint16_t)cost;
+}
+
+void Sched_Run(void)
+{
+    Sched_Task_t* task;
+    uint8_t ran = 0;
+
+    for (task = s_TaskList; task != NULL; task = task->Next)
+    {
+        uint32_t now = System_GetTick();
+        uint8_t signaled = task->Pending;
+        uint8_t due = (task->PeriodMs != 0) && ((int32_t)(now - task->NextRun) >= 0);
+
+        if (!signaled && !due) continue;
+
+        // 先清标志再运行，运行期间的新触发不会丢失
+        if (signaled) task->Pending = 0;
+
+        if (due)
+        {
+            uint32_t late = now - task->NextRun;
+
+            if (late > task->MaxLateMs) task->MaxLateMs = (late > 0xFFFF) ? 0xFFFF : (uint16_t)late;
+            if (task->DeadlineMs && late > task->DeadlineMs) task->DeadlineMiss++;
+
+            // 按固定节拍推进，避免累积漂移；落后超过一个周期则直接对齐到当前
+            task->NextRun += task->PeriodMs;
+            if ((int32_t)(now - task->NextRun) >= 0) task->NextRun = now + task->PeriodMs;
+        }
+
+        _Execute(task);
+        ran = 1;
+    }
+
+#if SCHED_USE_WFI
+    if (!ran)
+    {
+        // 关中断检查事件标志，避免“检查后、WFI 前”到来的触发被睡过去
+        __disable_irq();
+        for (task = s_TaskList; task != NULL; task = task->Next) {
+            if (task->Pending) break;
+        }
+        if (task == NULL) __WFI(); // 挂起的中断即使在 PRIMASK 置位时也能唤醒内核
+        __enable_irq();
+    }
+#else
+    (void)ran;
+#endif
+}
+
+void Sched_ResetStats(void)
+{
+    Sched_Task_t* task;
+
+    for (task = s_TaskList; task != NULL; task = task->Next) {
+        task->RunCount = 0;
+        task->TotalUs = 0;
+        task->MaxRunUs = 0;
+        task->MaxLateMs = 0;
+        task->DeadlineMiss = 0;
+    }
+    s_StatsStartTick = System_GetTick();
+}
+
+void Sched_DumpStats(void)
+{
+    Sched_Task_t* task;
+    uint64_t window_us = (uint64_t)(System_GetTick() - s_StatsStartTick) * 1000;
+
+    if (window_us == 0) window_us = 1;
+
+    DLOG(SCHED_WINDOW, "[Sched] window %u ms", (uint32_t)(window_us / 1000));
+    for (task = s_TaskList; task != NULL; task = task->Next) {
+        // 占用率放大 100 倍，以两位小数显示
+        uint32_t cpu_x100 = (uint32_t)((task->TotalUs * 10000) / window_us);
+        DLOG(SCHED_TASK_STATS, "[Sched] %-8s per=%u runs=%u max=%uus jit=%u miss=%u cpu=%u.%02u%%",
+             task->Name, task->PeriodMs, task->RunCount, task->MaxRunUs,
+             task->MaxLateMs, task->DeadlineMiss, cpu_x100 / 100, cpu_x100 % 100);
+    }
+
+    Sched_ResetStats();
+}
@@ -0,0 +1,79 @@
+#ifndef __SCHEDULER_H
+#define __SCHEDULER_H
+
+#include <stdint.h>
+#include "Config.h"
+
+/**
+  ******************************************************************************
+  * @file    Scheduler.h
+  * @brief   协作式任务调度器
+  * @note    1. 任务控制块由调用者静态分配 (与 KeyManager_Register 相同的用法)
+  *          2. 周期任务: PeriodMs > 0，按注册顺序 (即优先级) 依次检查
+  *             事件任务: PeriodMs = 0，仅在 Sched_Signal 后运行一次
+  *             周期任务同样可以被 Sched_Signal 提前唤醒 (不计入抖动统计)
+  *          3. 任务不可阻塞；所有任务都不需要运行时 WFI 休眠，
+  *             由 SysTick 或任意外设中断唤醒
+  ******************************************************************************
+  */
+
+typedef void (*Sched_TaskFunc_t)(void);
+
+/**
+  * @brief 任务控制块
+  */
+typedef struct Sched_Task {
+    // --- 配置 ---
+    const char*       Name;
+    Sched_TaskFunc_t  Func;
+    uint16_t          PeriodMs;       /*!< 0: 事件任务 */
+    uint16_t          DeadlineMs;     /*!< 允许的最大启动延迟 (超过记为一次错过) */
+
+    // --- 运行状态 (内部使用) ---
+    uint32_t          NextRun;        /*!< 下次释放时刻 (ms) */
+    volatile uint8_t  Pending;        /*!< 事件任务触发标志 (可在 ISR 中置位) */
+
+    // --- 统计 (Sched_ResetStats 清零) ---
+    uint32_t          RunCount;
+    uint64_t          TotalUs;        /*!< 统计窗口内累计运行时间 (64 位：不打印统计时窗口不会被重置) */
+    uint16_t          MaxRunUs;       /*!< 单次最长运行时间 */
+    uint16_t          MaxLateMs;      /*!< 最大启动延迟 (抖动) */
+    uint16_t          DeadlineMiss;   /*!< 错过截止时间次数 */
+
+    struct Sched_Task* Next;
+} Sched_Task_t;
+
+/**
+  * @brief 静态初始化宏
+  * @example static Sched_Task_t s_UiTask = SCHED_TASK("ui", UIManager_Task, 100, 20);
+  */
+#define SCHED_TASK(name, func, period, deadline) \
+    { (name), (func), (period), (deadline), 0, 0, 0, 0, 0, 0, 0, 0 }
+
+void Sched_Init(void);
+
+/**
+  * @brief  注册任务 (注册顺序即优先级，先注册的先检查)
+  */
+void Sched_Register(Sched_Task_t* task);
+
+/**
+  * @brief  触发任务在下一轮调度中运行 (ISR 安全)
+  */
+void Sched_Signal(Sched_Task_t* task);
+
+/**
+  * @brief  执行一轮调度：运行所有到期/已触发的任务，无事可做时休眠
+  * @note   在 main 的 while(1) 中循环调用
+  */
+void Sched_Run(void);
+
+/**
+  * @brief  输出各任务统计 (周期/运行次数/最大耗时/最大抖动/CPU 占用率) 并开始新窗口
+  * @note   经 DLOG 输出：一条窗口长度记录，随后每个任务一条记录
+  */
+void Sched_DumpStats(void);
+
+void Sched_ResetStats(void);
+
+#endif
@@ -36,6 +36,23 @@ void System_IncTick(void)
     g_SystemTick++;
 }
 
+/**
+  * @brief  微秒时间戳
+  * @note   SysTick 向下计数；若读取期间发生了 Tick 进位则重读，避免拼出错误的值
+  */
+uint32_t System_GetMicros(void)
+{
+    uint32_t tick, val;
+
+    do {
+        tick = g_SystemTick;
+        val = SysTick->VAL;
+    } while (tick != g_SystemTick);
+
+    return tick * SYSTEM_TICK_PERIOD_US
+         + (SysTick->LOAD - val) / (SystemCoreClock / 1000000);
+}
+
 /* ============================================================
  *                 Delay Functions (阻塞式)
  * ============================================================ */
@@ -22,6 +22,13 @@ uint32_t System_GetTick(void);
   */
 void System_IncTick(void);
 
+/**
+  * @brief  获取微秒级时间戳 (由 Tick 与 SysTick 当前计数值合成)
+  * @note   约 71 分钟回绕一次，只适合计算短时间差 (如任务耗时统计)
+  * @return uint32_t 当前微秒数
+  */
+uint32_t System_GetMicros(void);
+
 /* ============================================================
  *                 Delay Functions (阻塞式)
  * ============================================================ */
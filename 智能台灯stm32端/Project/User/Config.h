@@ -1,6 +1,8 @@
 #ifndef __CONFIG_H
 #define __CONFIG_H
 
+// 带 #ifndef 保护的开关可在编译选项中按构建覆盖 (Keil 的 Define 栏、HostSim 的 -D)
+
 /* ============================================================
  *                 System Settings
  * ============================================================ */
@@ -14,28 +16,105 @@
 // 计算每个节拍的微秒数 (1000Hz -> 1000us = 1ms)
 #define SYSTEM_TICK_PERIOD_US   (1000000 / SYSTEM_TICK_FREQ)
 
+/* ============================================================
+ *                 Scheduler Settings
+ * ============================================================ */
+// 1: 无任务到期时执行 WFI 休眠 (调试时可置 0 方便仿真器单步)
+#ifndef SCHED_USE_WFI
+#define SCHED_USE_WFI           1
+#endif
+// 任务统计打印周期 (ms)，0 表示关闭
+#ifndef SCHED_STATS_REPORT_MS
+#define SCHED_STATS_REPORT_MS   0
+#endif
+
+/* ============================================================
+ *                 Profiler Settings
+ * ============================================================ */
+// 1: 启用 DWT 周期计数探针与 {"cmd":"prof"}/{"cmd":"logbench"} 输出; 0: 探针宏展开为空
+// 默认关闭 (探针本身有开销且占 RAM)，分析性能时置 1
+#ifndef PROF_ENABLE
+#define PROF_ENABLE             0
+#endif
+
+/* ============================================================
+ *                 Debug Log Settings
+ * ============================================================ */
+// 调试日志 DLOG: 0 关闭; 1 文本，经协议串口 USART1 输出 (旧方式);
+// 2 二进制记录，经 USART2 (PA2) 输出，用 Tools/dlog_decode.py 解码
+#ifndef DLOG_MODE
+#define DLOG_MODE               2
+#endif
+// 日志串口波特率 (仅 DLOG_MODE 2)
+#define DLOG_BAUDRATE           460800
+
+/* ============================================================
+ *                 Event Queue Settings
+ * ============================================================ */
+// 事件队列深度 (2 的幂，<= 128)
+#define EVTQ_SIZE               16
+
+/* ============================================================
+ *                 Protocol Settings
+ * ============================================================ */
+// 1: 支持延迟追踪 (light 指令带 tid 时回执 trace 事件，state 上报附带 tid/age)
+// 默认关闭：每条 state 多约 20 字节，且带 tid 的指令多一次回执；测量延迟时置 1
+#ifndef PROTO_TRACE_ENABLE
+#define PROTO_TRACE_ENABLE      0
+#endif
+
 /* ============================================================
  *                 Encoder Settings
  * ============================================================ */
-// 编码器硬件分频系数 (EC11编码器转一格有4个脉冲)
-#define ENCODER_HW_DIVIDER      1
-// 编码器软件乘数 (旋转一格，数值变化量)
-#define ENCODER_SW_MULTIPLIER   15
+// 编码器硬件分频系数：TIM4 为 TI12 四倍频计数，EC11 每格一个完整正交周期 = 4 个计数
+// (每格只有半个周期的型号改为 2)
+#define ENCODER_HW_DIVIDER      4
+// 加速曲线：慢转时每格步长 / 快拨时每格步长 (0-1000 量程)
+// 慢速约 200 格走完全程便于精调，快拨不到一圈即可走完全程
+#define ENCODER_BRI_MIN_STEP    5
+#define ENCODER_BRI_MAX_STEP    60
+#define ENCODER_CCT_MIN_STEP    5
+#define ENCODER_CCT_MAX_STEP    50
+// 转速阈值 (格/秒)：低于 SLOW 用最小步长，高于 FAST 用最大步长
+#define ENCODER_SLOW_RATE       5
+#define ENCODER_FAST_RATE       40
 
 
+/* ============================================================
+ *                 Gesture Sensor Settings
+ * ============================================================ */
+// 1: 使用 PAJ7620 INT 引脚 (PB5, EXTI5) 触发读取; 0: 自适应轮询
+// 置 1 需要把模块的 INT 接到 PB5 (见 docs/04_Hardware_Wiring.md)，默认按未接线的板子轮询
+#ifndef PAJ_USE_INT_PIN
+#define PAJ_USE_INT_PIN         0
+#endif
+// INT 模式下的兜底轮询周期：INT 未接线时 PB5 一直为高电平，手势仍可按此周期读取
+#define PAJ_INT_FALLBACK_MS     200
+// 近距控制模式下的轮询周期 (此时需要连续读取物体亮度)
+#define PAJ_PROX_POLL_MS        20
+// 轮询模式: 有手势活动后的快速周期 / 空闲时退避到的最慢周期
+#define PAJ_POLL_FAST_MS        10
+#define PAJ_POLL_SLOW_MS        80
 
 /* ============================================================
- *                 Key Event Settings (Refactored)
+ *                 UI Settings
  * ============================================================ */
-// --- Key Settings ---
-#define KEY_DEBOUNCE_TIME_MS        20      // 消抖时间
-#define KEY_COMBO_WINDOW_MS         50      // 组合键判定窗口
-#define KEY_HOLD_TIME_MS            800     // 长按触发阈值
-#define KEY_REPEAT_RATE_MS          0       // 长按连发间隔 (0=关闭)
+// OLED 每次分片刷新的最大 I2C 字节数 (软件 I2C 约 30us/字节, 48 字节 ≈ 1.5ms)
+#define UI_FLUSH_BYTE_BUDGET    48
 
+/* ============================================================
+ *                 Storage Settings
+ * ============================================================ */
+// 键值存储占用 Flash 末尾 2 页 (0x0800F800 ~ 0x0800FFFF)
+// 注意: 工程 IROM1 大小已相应缩减为 0xF800，防止代码被链接进该区域
+#define KV_BASE_ADDR            0x0800F800
+#define KV_PAGE_COUNT           2
+#define KV_MAX_KEYS             16      // 键取值 0 ~ KV_MAX_KEYS-1
+#define KV_MAX_VALUE_LEN        32      // 单个值最大字节数
 
-// [新增] 连击判定窗口
-// 松手后，如果在此时间内再次按下，则判定为连击；否则结算为单击
-#define KEY_MULTI_CLICK_GAP_MS      250 
+/* ============================================================
+ *                 Key Event Settings
+ * ============================================================ */
+// 按键时序参数已移至 Common/KeyEngine/KeyConfig.h (与 ESP32 端共用)
 
 #endif
@@ -2,19 +2,29 @@
 /**
   ******************************************************************************
   * @file    main.c
-  * @brief   主程序 (V13.1 Proximity Sync Fix)
+  * @brief   主程序 (V13.2 Scheduler)
   * @note    集成 KeyManager V2.0，支持多键、连击与长按
   *          修复无极调光结束后状态不同步的问题
+  *          V13.2 主循环改为协作式调度器，空闲时 WFI 休眠
+  *          V13.3 输入事件统一经 EventQueue 投递，由 Task_Dispatch 单点分发
+  *          V13.4 灯光状态掉电保存，上电恢复
+  *          V13.5 DWT 周期计数探针 (Profiler)，{"cmd":"prof"} 输出统计
+  *          V13.6 调试输出改用 DLOG 二进制日志 (USART2)，协议串口只传协议帧
   ******************************************************************************
   */
 #include "stm32f10x.h"
 #include "SystemSupport.h"
+#include "Scheduler.h"
+#include "Profiler.h"
+#include "DLog.h"
+#include "EventQueue.h"
 #include "USART_DMA.h"
 #include "Protocol.h"
 #include "ControlManager.h"
 #include "SensorHub.h"
 #include "UIManager.h"
 #include "SystemModel.h"
+#include "Persist.h"
 
 // --- 硬件驱动 ---
 #include "Encoder.h"
@@ -32,29 +42,157 @@ static Key_t Key_Mode;
 // 定义掩码 (方便判断)
 #define MASK_MODE   (1 << KID_MODE)
 
+// 手势模式表 (声明式，KeyManager_SetPatterns 编译为状态机)
+// ModeSW 最多四连击，第四次松开立即输出，不再等待连击窗口
+static const KeyPattern_t s_KeyPatterns[] = {
+    KM_CLICK(MASK_MODE, 1, KEY_EVT_CLICK),
+    KM_CLICK(MASK_MODE, 2, KEY_EVT_DOUBLE_CLICK),
+    KM_CLICK(MASK_MODE, 3, KEY_EVT_TRIPLE_CLICK),
+    KM_CLICK(MASK_MODE, 4, KEY_EVT_QUAD_CLICK),
+    KM_HOLD (MASK_MODE, KEY_HOLD_TIME_MS, KEY_REPEAT_RATE_MS),
+};
+
+static Sched_Task_t s_TaskDispatch;
+
+// 投递事件并唤醒分发任务 (ISR 安全)
+static void _PostEvent(uint8_t type, uint8_t sub, uint16_t param, uint32_t data)
+{
+    EvtQ_Post(type, sub, param, data);
+    Sched_Signal(&s_TaskDispatch);
+}
+
 /* ============================================================
- *      回调函数实现 (连接驱动层与业务层)
+ *      回调函数实现 (驱动层 -> 事件队列)
  * ============================================================ */
 
 // --- 手势事件回调 (离散) ---
-void PAJ7620_Hook_OnUp(void)        { Control_OnGesture(PAJ7620_GESTURE_UP); }
-void PAJ7620_Hook_OnDown(void)      { Control_OnGesture(PAJ7620_GESTURE_DOWN); }
-void PAJ7620_Hook_OnLeft(void)      { Control_OnGesture(PAJ7620_GESTURE_LEFT); }
-void PAJ7620_Hook_OnRight(void)     { Control_OnGesture(PAJ7620_GESTURE_RIGHT); }
-void PAJ7620_Hook_OnForward(void)   { Control_OnGesture(PAJ7620_GESTURE_FORWARD); }
-void PAJ7620_Hook_OnBackward(void)  { Control_OnGesture(PAJ7620_GESTURE_BACKWARD); }
-void PAJ7620_Hook_OnClockwise(void) { Control_OnGesture(PAJ7620_GESTURE_CLOCKWISE); }
-void PAJ7620_Hook_OnCounterClockwise(void) { Control_OnGesture(PAJ7620_GESTURE_COUNTER_CW); }
-void PAJ7620_Hook_OnWave(void)      { Control_OnGesture(PAJ7620_GESTURE_WAVE); }
+void PAJ7620_Hook_OnUp(void)        { _PostEvent(EVT_GESTURE, PAJ7620_GESTURE_UP, 0, 0); }
+void PAJ7620_Hook_OnDown(void)      { _PostEvent(EVT_GESTURE, PAJ7620_GESTURE_DOWN, 0, 0); }
+void PAJ7620_Hook_OnLeft(void)      { _PostEvent(EVT_GESTURE, PAJ7620_GESTURE_LEFT, 0, 0); }
+void PAJ7620_Hook_OnRight(void)     { _PostEvent(EVT_GESTURE, PAJ7620_GESTURE_RIGHT, 0, 0); }
+void PAJ7620_Hook_OnForward(void)   { _PostEvent(EVT_GESTURE, PAJ7620_GESTURE_FORWARD, 0, 0); }
+void PAJ7620_Hook_OnBackward(void)  { _PostEvent(EVT_GESTURE, PAJ7620_GESTURE_BACKWARD, 0, 0); }
+void PAJ7620_Hook_OnClockwise(void) { _PostEvent(EVT_GESTURE, PAJ7620_GESTURE_CLOCKWISE, 0, 0); }
+void PAJ7620_Hook_OnCounterClockwise(void) { _PostEvent(EVT_GESTURE, PAJ7620_GESTURE_COUNTER_CW, 0, 0); }
+void PAJ7620_Hook_OnWave(void)      { _PostEvent(EVT_GESTURE, PAJ7620_GESTURE_WAVE, 0, 0); }
 
 // --- 手势事件回调 (实时) ---
 void PAJ7620_Hook_OnProximity(uint8_t brightness) {
-    Control_OnProximity(brightness);
+    _PostEvent(EVT_PROXIMITY, brightness, 0, 0);
 }
 
 // [新增] 退出无极调光回调
 void PAJ7620_Hook_OnProximityExit(void) {
-    Control_OnProximityExit();
+    _PostEvent(EVT_PROXIMITY_EXIT, 0, 0, 0);
+}
+
+// --- 按键事件回调 ---
+void KeyManager_Hook_OnEvent(const KeyEvent_t *evt) {
+    uint32_t duration = (evt->Param > 0xFFFF) ? 0xFFFF : evt->Param;
+    _PostEvent(EVT_KEY, (uint8_t)evt->Type, (uint16_t)duration, evt->Mask);
+}
+
+/* ============================================================
+ *      任务定义 (注册顺序即优先级)
+ * ============================================================ */
+
+static void Task_Input(void);
+static void Task_Dispatch(void);
+static void Task_Env(void);
+
+// 参数: 名称, 函数, 周期(ms), 允许的最大启动延迟(ms)
+static Sched_Task_t s_TaskDispatch = SCHED_TASK("event", Task_Dispatch,                 0,    0);
+static Sched_Task_t s_TaskProto   = SCHED_TASK("proto",  Protocol_Process,             20,   20);
+static Sched_Task_t s_TaskInput   = SCHED_TASK("input",  Task_Input,                    5,    5);
+static Sched_Task_t s_TaskGesture = SCHED_TASK("gesture",PAJ7620_Process_StateMachine,  5,   10);
+static Sched_Task_t s_TaskSensor  = SCHED_TASK("sensor", SensorHub_Process,             2,    5);
+static Sched_Task_t s_TaskControl = SCHED_TASK("control",Control_Task,                 50,   20);
+static Sched_Task_t s_TaskFlush   = SCHED_TASK("flush",  UIManager_Flush,               5,   20);
+static Sched_Task_t s_TaskUI      = SCHED_TASK("ui",     UIManager_Task,              100,   50);
+static Sched_Task_t s_TaskPersist = SCHED_TASK("persist",Persist_Task,                100,    0);
+static Sched_Task_t s_TaskEnv     = SCHED_TASK("env",    Task_Env,                   2000,  200);
+#if SCHED_STATS_REPORT_MS > 0
+static Sched_Task_t s_TaskStats   = SCHED_TASK("stats",  Sched_DumpStats, SCHED_STATS_REPORT_MS, 0);
+#endif
+
+// 串口收到完整一帧后立即唤醒协议任务 (周期调度仅作兜底)
+void USART_DMA_Hook_OnRxIdle(void) { Sched_Signal(&s_TaskProto); }
+
+// 编码器 + 按键 (只负责采集，事件经队列交给 Task_Dispatch)
+static void Task_Input(void)
+{
+    // 编码器处理
+    int16_t enc_diff = Encoder_Get();
+    if (enc_diff != 0) {
+        _PostEvent(EVT_ENCODER, 0, (uint16_t)enc_diff, 0);
+    }
+
+    // 按键状态机处理 (事件通过 KeyManager_Hook_OnEvent 入队)
+    KeyManager_Tick();
+}
+
+// 按键事件 -> 业务层动作字符串
+static void _DispatchKey(const Event_t *evt)
+{
+    // 仅处理 Mode 键 (未来可扩展组合键)
+    if (evt->Data != MASK_MODE) return;
+
+    char* act_str = NULL;
+    switch (evt->Sub) {
+        case KEY_EVT_CLICK:         act_str = "click";   break;
+        case KEY_EVT_DOUBLE_CLICK:  act_str = "double";  break;
+        case KEY_EVT_TRIPLE_CLICK:  act_str = "triple";  break;
+        case KEY_EVT_QUAD_CLICK:    act_str = "quad";    break;
+        case KEY_EVT_HOLD_START:    act_str = "hold";    break;
+        case KEY_EVT_HOLD_END:      act_str = "release"; break;
+        default: break;
+    }
+    
+    if (act_str != NULL) {
+        // 转发给业务层
+        Control_OnKey("ModeSW", act_str);
+        
+        // 如果是长按结束，还可以打印时长用于调试
+        if (evt->Sub == KEY_EVT_HOLD_END) {
+            DLOG(MAIN_HOLD_DURATION, "[Main] Hold Duration: %d ms", evt->Param);
+        }
+    }
+}
+
+// 单一事件消费者：按入队顺序分发到业务层
+static void Task_Dispatch(void)
+{
+    static uint32_t s_ReportedDrops = 0;
+    Event_t evt;
+    EvtQ_Stats_t stats;
+
+    while (EvtQ_Get(&evt))
+    {
+        switch (evt.Type) {
+            case EVT_KEY:            _DispatchKey(&evt); break;
+            case EVT_ENCODER:        Control_OnEncoder((int16_t)evt.Param, evt.Timestamp); break;
+            case EVT_GESTURE:        Control_OnGesture(evt.Sub); break;
+            case EVT_PROXIMITY:      Control_OnProximity(evt.Sub); break;
+            case EVT_PROXIMITY_EXIT: Control_OnProximityExit(); break;
+            default: break;
+        }
+    }
+
+    EvtQ_GetStats(&stats);
+    if (stats.Dropped != s_ReportedDrops) {
+        DLOG(MAIN_EVTQ_OVERFLOW, "[Main] Event queue overflow: %d dropped (peak %d/%d)",
+             stats.Dropped - s_ReportedDrops, stats.HighWater, EVTQ_SIZE);
+        s_ReportedDrops = stats.Dropped;
+    }
+}
+
+// 传感器 & 心跳
+static void Task_Env(void)
+{
+    static uint32_t hb_count = 0;
+
+    Protocol_Report_Heartbeat(hb_count++);
+    SensorHub_Task();
 }
 
 /* ============================================================
@@ -72,6 +210,9 @@ void Hardware_Init_Keys(void)
     // ModeSW: PB1, 低电平有效 (0)
     Key_Init(&Key_Mode, KID_MODE, GPIOB, GPIO_Pin_1, 0);
     KeyManager_Register(&Key_Mode);
+
+    // 4. 加载手势模式表
+    KeyManager_SetPatterns(s_KeyPatterns, sizeof(s_KeyPatterns) / sizeof(s_KeyPatterns[0]));
 }
 
 /* ============================================================
@@ -81,16 +222,20 @@ int main(void)
 {
     // 1. 基础设施初始化
     System_Init();
+    Prof_Init();
     Delay_ms(100); // 等待电源稳定
     USART_DMA_Init();
+    DLog_Init();
     
-    printf("\r\n=== Smart Lamp System V13.1 (Proximity Sync Fix) ===\r\n");
+    DLOG(MAIN_BANNER, "=== Smart Lamp System V13.6 ===");
 
     // 2. 数据模型初始化 (必须最先)
     SystemModel_Init();
+    EvtQ_Init();
 
     // 3. 业务层初始化
     Protocol_Init();
+    Persist_Init();   // 恢复上次状态 (须在 Control_Init 驱动 PWM 之前)
     Control_Init();   
     SensorHub_Init(); 
     UIManager_Init(); 
@@ -100,85 +245,29 @@ int main(void)
     Hardware_Init_Keys(); // 初始化新按键库
     
     if (PAJ7620_Init() != 0) {
-        printf("[Main] Gesture Init Failed.\r\n");
+        DLOG(MAIN_GESTURE_FAIL, "[Main] Gesture Init Failed.");
     } else {
-        printf("[Main] Gesture Ready.\r\n");
+        DLOG(MAIN_GESTURE_READY, "[Main] Gesture Ready.");
     }
 
-    // 5. 调度器计时器
-    uint32_t tick_50ms = 0;
-    uint32_t tick_100ms = 0;
-    uint32_t tick_2000ms = 0;
-    uint32_t hb_count = 0;
+    // 5. 注册任务 (分发任务最先，输入事件优先处理)
+    Sched_Init();
+    Sched_Register(&s_TaskDispatch);
+    Sched_Register(&s_TaskProto);
+    Sched_Register(&s_TaskInput);
+    Sched_Register(&s_TaskGesture);
+    Sched_Register(&s_TaskSensor);
+    Sched_Register(&s_TaskControl);
+    Sched_Register(&s_TaskFlush);
+    Sched_Register(&s_TaskUI);
+    Sched_Register(&s_TaskPersist);
+    Sched_Register(&s_TaskEnv);
+#if SCHED_STATS_REPORT_MS > 0
+    Sched_Register(&s_TaskStats);
+#endif
 
     while (1)
     {
-        uint32_t now = System_GetTick();
-
-        // --- L1: 实时任务 (尽可能快) ---
-        Protocol_Process(); 
-        
-        // 编码器处理
-        int16_t enc_diff = Encoder_Get();
-        if (enc_diff != 0) {
-            Control_OnEncoder(enc_diff);
-        }
-
-        // 按键状态机处理 (核心逻辑)
-        KeyManager_Tick();
-
-        // 按键事件分发 (适配层)
-        KeyEvent_t k_evt;
-        if (KeyManager_GetEvent(&k_evt))
-        {
-            // 仅处理 Mode 键 (未来可扩展组合键)
-            if (k_evt.Mask == MASK_MODE)
-            {
-                char* act_str = NULL;
-                switch (k_evt.Type) {
-                    case KEY_EVT_CLICK:         act_str = "click";   break;
-                    case KEY_EVT_DOUBLE_CLICK:  act_str = "double";  break;
-                    case KEY_EVT_TRIPLE_CLICK:  act_str = "triple";  break;
-                    case KEY_EVT_HOLD_START:    act_str = "hold";    break;
-                    case KEY_EVT_HOLD_END:      act_str = "release"; break;
-                    default: break;
-                }
-                
-                if (act_str != NULL) {
-                    // 转发给业务层
-                    Control_OnKey("ModeSW", act_str);
-                    
-                    // 如果是长按结束，还可以打印时长用于调试
-                    if (k_evt.Type == KEY_EVT_HOLD_END) {
-                        printf("[Main] Hold Duration: %d ms\r\n", k_evt.Param);
-                    }
-                }
-            }
-        }
-
-        // 手势状态机处理
-        PAJ7620_Process_StateMachine();
-
-        // --- L2: 50ms 任务 (业务逻辑) ---
-        if (now - tick_50ms >= 50)
-        {
-            tick_50ms = now;
-            Control_Task(); 
-        }
-
-        // --- L3: 100ms 任务 (UI 刷新) ---
-        if (now - tick_100ms >= 100)
-        {
-            tick_100ms = now;
-            UIManager_Task(); 
-        }
-
-        // --- L4: 2000ms 任务 (传感器 & 心跳) ---
-        if (now - tick_2000ms >= 2000)
-        {
-            tick_2000ms = now;
-            Protocol_Report_Heartbeat(hb_count++);
-            SensorHub_Task();
-        }
+        Sched_Run();
     }
 }
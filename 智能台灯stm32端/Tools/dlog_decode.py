@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+二进制调试日志解码（记录格式见 Project/System/DLog.h）
+USART2 TX (PA2) 接 USB-TTL，按 DLOG_BAUDRATE 抓取原始字节后：
+    python dlog_decode.py capture.bin
+    python dlog_decode.py --port COM5            # 直接读串口，需要 pyserial
+格式串取自 dlog_table.json（dlog_gen.py 生成），须与固件同一次生成；
+启动记录中的校验值不一致时给出警告。校验失败的字节会被跳过并重新同步。
+"""
+
+import argparse
+import json
+import re
+import sys
+from pathlib import Path
+
+SYNC = 0xA5
+MAX_RECORD = 64                 # 与 DLOG_MAX_RECORD 一致
+MAX_LEN = MAX_RECORD - 3        # 去掉同步、长度、校验字节
+ID_BOOT, ID_DROP = 0, 1
+DEFAULT_BAUD = 460800
+DEFAULT_TABLE = Path(__file__).resolve().parent / "dlog_table.json"
+
+# C 格式转换为 Python：去掉长度修饰，%i/%u 按 %d 输出
+CONV_RE = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(?:hh|h|ll|l)?([diuxXcs%])")
+
+
+def py_format(fmt: str) -> str:
+    def repl(m):
+        conv = m.group(2)
+        if conv == "%":
+            return "%%"
+        return "%" + m.group(1) + ("d" if conv in "iu" else conv)
+    return CONV_RE.sub(repl, fmt)
+
+
+class Reader:
+    def __init__(self, data: bytes):
+        self.data, self.pos = data, 0
+
+    def varint(self) -> int:
+        v, shift = 0, 0
+        while True:
+            if self.pos >= len(self.data) or shift > 28:
+                raise ValueError("varint 越界")
+            b = self.data[self.pos]
+            self.pos += 1
+            v |= (b & 0x7F) << shift
+            if b < 0x80:
+                return v
+            shift += 7
+
+    def string(self) -> str:
+        n = self.data[self.pos]
+        s = self.data[self.pos + 1:self.pos + 1 + n]
+        if len(s) != n:
+            raise ValueError("字符串越界")
+        self.pos += 1 + n
+        return s.decode("utf-8", errors="replace")
+
+
+def decode_args(r: Reader, sig: str) -> list:
+    args = []
+    for t in sig:
+        if r.pos >= len(r.data):
+            break   # 记录在固件端被截断
+        if t == "s":
+            args.append(r.string())
+        elif t == "d":
+            v = r.varint()
+            args.append((v >> 1) ^ -(v & 1))
+        else:
+            args.append(r.varint())
+    return args
+
+
+class Decoder:
+    def __init__(self, table: dict):
+        self.hash = int(table["hash"], 16)
+        self.msgs = {int(k): v for k, v in table["messages"].items()}
+        self.buf = bytearray()
+        self.t_ms = 0
+        self.bad = 0
+
+    def feed(self, data: bytes):
+        self.buf += data
+        while True:
+            start = self.buf.find(SYNC)
+            if start < 0:
+                self.bad += len(self.buf)
+                self.buf.clear()
+                return
+            if start:
+                self.bad += start
+                del self.buf[:start]
+            if len(self.buf) < 2:
+                return
+            n = self.buf[1]
+            if n < 2 or n > MAX_LEN:
+                self.bad += 1
+                del self.buf[0]
+                continue
+            if len(self.buf) < n + 3:
+                return
+            chk = n
+            for b in self.buf[2:n + 2]:
+                chk ^= b
+            if chk != self.buf[n + 2]:
+                self.bad += 1
+                del self.buf[0]
+                continue
+            payload = bytes(self.buf[2:n + 2])
+            del self.buf[:n + 3]
+            try:
+                self.record(payload)
+            except (ValueError, IndexError):
+                self.bad += n + 3
+
+    def record(self, payload: bytes):
+        r = Reader(payload)
+        mid, dt = r.varint(), r.varint()
+        self.t_ms += dt
+        if mid == ID_BOOT:
+            self.t_ms = 0
+            (h,) = decode_args(r, "u") or [None]
+            note = "" if h == self.hash else f"  [警告] 日志表校验值不符：固件 0x{h or 0:08X}，本地 0x{self.hash:08X}"
+            self.emit(f"==== 启动 ===={note}")
+        elif mid == ID_DROP:
+            (n,) = decode_args(r, "u") or [0]
+            self.emit(f"[丢弃 {n} 条]")
+        elif mid in self.msgs:
+            m = self.msgs[mid]
+            args = decode_args(r, m["sig"])
+            try:
+                text = py_format(m["fmt"]) % tuple(args)
+            except (TypeError, ValueError):
+                text = f"{m['fmt']} {args}"     # 截断导致参数不足
+            self.emit(text)
+        else:
+            self.emit(f"[未知编号 {mid}] {payload[r.pos:].hex(' ')}")
+
+    def emit(self, text: str):
+        print(f"[{self.t_ms / 1000:10.3f}] {text}", flush=True)
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="二进制调试日志解码")
+    parser.add_argument("capture", nargs="?", help="抓取的原始字节文件（缺省读标准输入）")
+    parser.add_argument("--port", help="直接读取串口，如 COM5 或 /dev/ttyUSB0")
+    parser.add_argument("--baud", type=int, default=DEFAULT_BAUD, help=f"串口波特率（默认 {DEFAULT_BAUD}）")
+    parser.add_argument("--table", default=str(DEFAULT_TABLE), help="日志表路径")
+    args = parser.parse_args()
+
+    dec = Decoder(json.loads(Path(args.table).read_text(encoding="utf-8")))
+
+    if args.port:
+        try:
+            import serial
+        except ImportError:
+            raise SystemExit("读取串口需要 pyserial：pip install pyserial")
+        with serial.Serial(args.port, args.baud, timeout=0.2) as port:
+            try:
+                while True:
+                    dec.feed(port.read(256))
+            except KeyboardInterrupt:
+                pass
+    else:
+        stream = open(args.capture, "rb") if args.capture else sys.stdin.buffer
+        with stream:
+            while chunk := stream.read(4096):
+                dec.feed(chunk)
+
+    if dec.bad or dec.buf:
+        print(f"[警告] 跳过 {dec.bad} 字节无效数据，末尾 {len(dec.buf)} 字节不完整", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
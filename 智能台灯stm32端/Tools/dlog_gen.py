@@ -0,0 +1,203 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+二进制日志表生成（格式见 Project/System/DLog.h）
+扫描 Project 下源码中的 DLOG(名称, "格式串", 参数...) 调用，生成：
+    Project/System/DLogIds.h   每个名称一个 DLOG_CALL_xxx 宏（编号 + 参数类型串）
+    Tools/dlog_table.json      编号 -> 格式串，供 dlog_decode.py 还原文本
+已分配的编号保持不变，删除的编号不再复用。
+    python dlog_gen.py           重新生成（Keil 编译前自动执行）
+    python dlog_gen.py --check   只检查是否需要重新生成，过期时返回 1
+"""
+
+import argparse
+import json
+import re
+import sys
+import zlib
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+SRC_DIRS = ("Project/App", "Project/Hardware", "Project/System", "Project/User")
+HEADER = ROOT / "Project/System/DLogIds.h"
+TABLE = ROOT / "Tools/dlog_table.json"
+
+ID_FIRST = 2  # 0/1 为启动与丢弃记录，见 DLog.h
+NAME_RE = re.compile(r"[A-Z][A-Z0-9_]*$")
+CONV_RE = re.compile(r"%([-+ #0]*)(\d+|\*)?(?:\.(\d+|\*))?(hh|h|ll|l)?([diuxXcs%])")
+SIG_OF = {"d": "d", "i": "d", "u": "u", "x": "u", "X": "u", "c": "u", "s": "s"}
+CAST_OF = {"d": "(int32_t)", "u": "(uint32_t)", "s": "(const char*)"}
+ESCAPES = {"n": "\n", "r": "\r", "t": "\t", "\\": "\\", '"': '"', "'": "'", "0": "\0"}
+
+
+class GenError(Exception):
+    pass
+
+
+def strip_comments(text: str) -> str:
+    """去掉注释（保留换行以维持行号），字符串与字符常量原样保留"""
+    out, i, n = [], 0, len(text)
+    while i < n:
+        c = text[i]
+        if c in "\"'":
+            j = i + 1
+            while j < n and text[j] != c:
+                j += 2 if text[j] == "\\" else 1
+            out.append(text[i:j + 1])
+            i = j + 1
+        elif text.startswith("//", i):
+            j = text.find("\n", i)
+            i = n if j < 0 else j
+        elif text.startswith("/*", i):
+            j = text.find("*/", i + 2)
+            j = n if j < 0 else j + 2
+            out.append("\n" * text.count("\n", i, j))
+            i = j
+        else:
+            out.append(c)
+            i += 1
+    return "".join(out)
+
+
+def split_call(text: str, start: int):
+    """从 '(' 之后解析到匹配的 ')'，返回 (顶层逗号分隔的参数, 结束位置)"""
+    args, depth, i, cur = [], 0, start, start
+    while i < len(text):
+        c = text[i]
+        if c in "\"'":
+            j = i + 1
+            while j < len(text) and text[j] != c:
+                j += 2 if text[j] == "\\" else 1
+            i = j
+        elif c == "(":
+            depth += 1
+        elif c == ")":
+            if depth == 0:
+                args.append(text[cur:i].strip())
+                return args, i
+            depth -= 1
+        elif c == "," and depth == 0:
+            args.append(text[cur:i].strip())
+            cur = i + 1
+        i += 1
+    raise GenError("括号不匹配")
+
+
+def parse_literal(expr: str) -> str:
+    """拼接相邻的字符串字面量"""
+    parts = re.findall(r'"((?:[^"\\]|\\.)*)"', expr)
+    if not parts or re.sub(r'"(?:[^"\\]|\\.)*"', "", expr).strip():
+        raise GenError("格式串必须是字符串字面量")
+    raw = "".join(parts)
+    return re.sub(r"\\(.)", lambda m: ESCAPES.get(m.group(1), m.group(1)), raw)
+
+
+def signature(fmt: str) -> str:
+    sig = ""
+    for m in CONV_RE.finditer(fmt):
+        if m.group(5) == "%":
+            continue
+        if m.group(2) == "*" or m.group(3) == "*":
+            raise GenError("不支持 * 宽度/精度")
+        sig += SIG_OF[m.group(5)]
+    if "%" in CONV_RE.sub("", fmt):
+        raise GenError(f"不支持的格式: {fmt!r}")
+    return sig
+
+
+def scan() -> dict:
+    found = {}
+    for d in SRC_DIRS:
+        for path in sorted((ROOT / d).rglob("*.[ch]")):
+            text = strip_comments(path.read_text(encoding="utf-8", errors="replace"))
+            for m in re.finditer(r"\bDLOG\s*\(", text):
+                line = text.count("\n", 0, m.start()) + 1
+                file = path.relative_to(ROOT).as_posix()
+                where = f"{file}:{line}"
+                args, _ = split_call(text, m.end())
+                if not NAME_RE.match(args[0]):
+                    continue  # 宏定义本身
+                try:
+                    if len(args) < 2:
+                        raise GenError("缺少格式串")
+                    fmt = parse_literal(args[1])
+                    sig = signature(fmt)
+                    if len(sig) != len(args) - 2:
+                        raise GenError(f"格式串需要 {len(sig)} 个参数，实际 {len(args) - 2} 个")
+                except GenError as e:
+                    raise GenError(f"{where}: {e}") from None
+                name = args[0]
+                if name in found and found[name]["fmt"] != fmt:
+                    raise GenError(f"{where}: {name} 与 {found[name]['where']} 的格式串不同")
+                found.setdefault(name, {"fmt": fmt, "sig": sig, "file": file, "where": where})
+    return found
+
+
+def build(found: dict, old: dict):
+    old_ids = {v["name"]: int(k) for k, v in old.get("messages", {}).items()}
+    next_id = max(old.get("next_id", ID_FIRST), ID_FIRST)
+    messages = {}
+    for name in sorted(found, key=lambda n: (old_ids.get(n, 1 << 16), n)):
+        mid = old_ids.get(name)
+        if mid is None:
+            mid, next_id = next_id, next_id + 1
+        # 表中只记录文件，不记录行号，避免无关改动引起日志表变化
+        messages[mid] = {"name": name, "fmt": found[name]["fmt"], "sig": found[name]["sig"],
+                         "file": found[name]["file"]}
+    if next_id > 0xFFFF:
+        raise GenError("日志编号用尽")
+
+    canon = "".join(f"{k}\t{v['name']}\t{v['sig']}\t{v['fmt']}\n" for k, v in sorted(messages.items()))
+    table_hash = zlib.crc32(canon.encode("utf-8"))
+
+    table = {
+        "hash": f"0x{table_hash:08X}",
+        "next_id": next_id,
+        "messages": {str(k): messages[k] for k in sorted(messages)},
+    }
+    lines = [
+        "#ifndef __DLOG_IDS_H",
+        "#define __DLOG_IDS_H",
+        "",
+        "/* 由 Tools/dlog_gen.py 生成，请勿手动修改 */",
+        "",
+        f"#define DLOG_TABLE_HASH         0x{table_hash:08X}UL",
+        "",
+    ]
+    for mid in sorted(messages):
+        m = messages[mid]
+        params = ["fmt"] + [f"a{i}" for i in range(len(m["sig"]))]
+        args = [str(mid), f'"{m["sig"]}"'] + [f"{CAST_OF[t]}(a{i})" for i, t in enumerate(m["sig"])]
+        lines.append(f"#define DLOG_CALL_{m['name']}({', '.join(params)}) \\")
+        lines.append(f"    DLog_Write({', '.join(args)})")
+    lines += ["", "#endif", ""]
+    return "\n".join(lines), json.dumps(table, ensure_ascii=False, indent=2) + "\n"
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="二进制日志表生成")
+    parser.add_argument("--check", action="store_true", help="只检查，过期时返回 1")
+    args = parser.parse_args()
+
+    old = json.loads(TABLE.read_text(encoding="utf-8")) if TABLE.exists() else {}
+    try:
+        header, table = build(scan(), old)
+    except GenError as e:
+        print(f"dlog_gen: error: {e}", file=sys.stderr)
+        return 2
+
+    current = (HEADER.read_bytes().decode("utf-8") if HEADER.exists() else None,
+               TABLE.read_text(encoding="utf-8") if TABLE.exists() else None)
+    if current == (header, table):
+        return 0
+    if args.check:
+        print("dlog_gen: DLogIds.h / dlog_table.json 需要重新生成", file=sys.stderr)
+        return 1
+    HEADER.write_bytes(header.encode("utf-8"))
+    TABLE.write_text(table, encoding="utf-8")
+    print(f"dlog_gen: {len(json.loads(table)['messages'])} 条日志，校验值 {json.loads(table)['hash']}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
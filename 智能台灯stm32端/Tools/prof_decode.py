@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+STM32 耗时探针统计解码
+向 USART1 发送 {"cmd":"prof"}（或 {"cmd":"prof","reset":1}，输出后清零），
+把串口输出保存为文本后：
+    python prof_decode.py serial.log
+日志中夹杂的其他输出会被忽略；每遇到一次结束行输出一张表，周期按结束行的 hz 换算为微秒。
+"""
+
+import argparse
+import json
+import sys
+
+# 与 Profiler.h 一致的 4 倍分档：第 k 档上界为 256 * 4^k 周期，最后一档收容更大的值
+BIN_EDGES = tuple(256 * 4 ** k for k in range(7))
+DEFAULT_HZ = 72_000_000
+
+
+def bin_label(k: int, hz: int) -> str:
+    if k < len(BIN_EDGES):
+        return f"<{BIN_EDGES[k] * 1e6 / hz:.1f}us"
+    return f">={BIN_EDGES[-1] * 1e6 / hz:.0f}us"
+
+
+def print_table(probes: list, hz: int) -> None:
+    to_us = 1e6 / hz
+    print(f"  {'探针':<10}{'次数':>8}{'min us':>10}{'avg us':>10}{'max us':>10}   分布")
+    for p in probes:
+        hist = " ".join(f"{bin_label(k, hz)}:{n}" for k, n in enumerate(p.get("h", [])) if n)
+        print(f"  {p['n']:<12}{p['c']:>8}{p['mn'] * to_us:>10.1f}"
+              f"{p['av'] * to_us:>10.1f}{p['mx'] * to_us:>10.1f}   {hist}")
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="STM32 耗时探针统计解码")
+    parser.add_argument("log", nargs="?", help="串口输出文本（缺省读标准输入）")
+    args = parser.parse_args()
+
+    stream = open(args.log, "r", encoding="utf-8", errors="ignore") if args.log else sys.stdin
+    probes, dumps = [], 0
+    with stream:
+        for line in stream:
+            start = line.find('{"ev":"prof"')
+            if start < 0:
+                continue
+            try:
+                msg = json.loads(line[start:].strip())
+            except json.JSONDecodeError:
+                continue
+            if "end" in msg:
+                dumps += 1
+                hz = int(msg.get("hz") or DEFAULT_HZ)
+                print(f"== 第 {dumps} 次输出：{len(probes)} 个探针 @ {hz / 1e6:.0f}MHz")
+                print_table(probes, hz)
+                probes = []
+            elif "n" in msg:
+                probes.append(msg)
+
+    if probes:
+        print(f"[警告] 末尾 {len(probes)} 行缺少结束行，输出可能被截断")
+    if dumps == 0:
+        raise SystemExit("未找到探针统计输出")
+
+
+if __name__ == "__main__":
+    main()